@@ -38,6 +38,18 @@ namespace bullseye {
     #endif
     }
 
+    // localtime() shares one static buffer, which breaks when logging from worker threads
+    static inline struct tm internal_localtime(const time_t* time) {
+        struct tm local_time;
+    #ifdef WIN32
+        localtime_s(&local_time, time);
+    #else
+        localtime_r(time, &local_time);
+    #endif
+
+        return local_time;
+    }
+
     static inline void internal_get_current_time_str(char* date_time_str) {
         time_t now_time = time(NULL);
 
@@ -48,7 +60,8 @@ namespace bullseye {
         memset(ms_str, '\0', MS_PART_BUFFER_SIZE * sizeof(char));
 
         snprintf(ms_str, MS_PART_BUFFER_SIZE, "%03ld] ", tp.tv_usec / 1000L);
-        strftime(date_time_str, TIME_BUFFER_SIZE, "[%Y-%m-%d %H:%M:%S.", localtime(&now_time));
+        const struct tm local_time = internal_localtime(&now_time);
+        strftime(date_time_str, TIME_BUFFER_SIZE, "[%Y-%m-%d %H:%M:%S.", &local_time);
         strncat(date_time_str, ms_str, MS_PART_BUFFER_SIZE);
     }
 
@@ -58,7 +71,8 @@ namespace bullseye {
         struct timeval tp;
         internal_gettimeofday(&tp);
 
-        strftime(date_time_str, TIME_BUFFER_SIZE, "%Y-%m-%d", localtime(&now_time));
+        const struct tm local_time = internal_localtime(&now_time);
+        strftime(date_time_str, TIME_BUFFER_SIZE, "%Y-%m-%d", &local_time);
     }
 
     static inline void update_current_day(const char* date_formatted) {
@@ -174,6 +174,12 @@ class RigidBody : public CollisionBody {
         /// Return whether or not the body is sleeping
         bool isSleeping() const;
 
+        /// Return true if the continuous collision detection is enabled for the body
+        bool isCCDEnabled() const;
+
+        /// Enable or disable the continuous collision detection for the body
+        void setIsCCDEnabled(bool isCCDEnabled);
+
         /// Set whether or not the body is active
         virtual void setIsActive(bool isActive) override;
 
@@ -78,6 +78,9 @@ class Collider {
         /// changed by the user
         void setHasCollisionShapeChangedSize(bool hasCollisionShapeChangedSize);
 
+        /// Raycast method with the allocator to use for the temporary memory of the raycast
+        bool raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -173,6 +176,7 @@ class Collider {
         friend class CollisionBody;
         friend class RigidBody;
         friend class BroadPhaseAlgorithm;
+        friend class BroadPhaseRaycastBatchCallback;
         friend class DynamicAABBTree;
         friend class CollisionDetectionSystem;
         friend class PhysicsWorld;
@@ -310,7 +310,8 @@ inline uint CollisionCallback::ContactPair::getNbContactPoints() const {
 
 // Return the penetration depth between the two bodies in contact
 /**
- * @return The penetration depth (larger than zero)
+ * @return The penetration depth (larger than zero, except for a speculative contact of a body with
+ *         continuous collision detection where it is minus the distance between the colliders)
  */
 inline decimal CollisionCallback::ContactPoint::getPenetrationDepth() const {
    return mContactPoint.getPenetrationDepth();
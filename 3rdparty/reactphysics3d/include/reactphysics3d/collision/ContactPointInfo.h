@@ -56,7 +56,7 @@ struct ContactPointInfo {
         /// Normalized normal vector of the collision contact in world space
         Vector3 normal;
 
-        /// Penetration depth of the contact
+        /// Penetration depth of the contact (negative distance between the shapes for a speculative contact)
         decimal penetrationDepth;
 
         /// Contact point of body 1 in local space of body 1
@@ -74,7 +74,6 @@ struct ContactPointInfo {
                            localPoint1(localPt1), localPoint2(localPt2) {
 
             assert(contactNormal.lengthSquare() > decimal(0.8));
-            assert(penDepth > decimal(0.0));
         }
 
         /// Destructor
@@ -89,6 +89,52 @@ struct RaycastInfo {
         RaycastInfo& operator=(const RaycastInfo& raycastInfo) = delete;
 };
 
+// Structure RaycastBatchHit
+/**
+ * This structure contains the closest hit of a ray of a batch raycast
+ * (see PhysicsWorld::raycastBatch()). If the ray has not hit any collider,
+ * the body and collider pointers are null.
+ */
+struct RaycastBatchHit {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Hit point in world-space coordinates
+        Vector3 worldPoint;
+
+        /// Surface normal at hit point in world-space coordinates
+        Vector3 worldNormal;
+
+        /// Fraction distance of the hit point between point1 and point2 of the ray
+        decimal hitFraction;
+
+        /// Mesh subpart index that has been hit (only used for triangles mesh and -1 otherwise)
+        int meshSubpart;
+
+        /// Hit triangle index (only used for triangles mesh and -1 otherwise)
+        int triangleIndex;
+
+        /// Pointer to the hit collision body (null if the ray has not hit anything)
+        CollisionBody* body;
+
+        /// Pointer to the hit collider (null if the ray has not hit anything)
+        Collider* collider;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        RaycastBatchHit() : hitFraction(decimal(1.0)), meshSubpart(-1), triangleIndex(-1), body(nullptr), collider(nullptr) {
+
+        }
+
+        /// Return true if the ray has hit a collider
+        bool isHit() const {
+            return collider != nullptr;
+        }
+};
+
 // Class RaycastCallback
 /**
  * This class can be used to register a callback for ray casting queries.
@@ -0,0 +1,79 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SHAPE_CAST_INFO_H
+#define REACTPHYSICS3D_SHAPE_CAST_INFO_H
+
+// Libraries
+#include <reactphysics3d/mathematics/Vector3.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class CollisionBody;
+class Collider;
+
+// Structure ShapeCastInfo
+/**
+ * This structure contains the information about the first hit of a convex
+ * shape swept along a translation (see PhysicsWorld::shapeCast()).
+ */
+struct ShapeCastInfo {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Hit point on the hit collider in world-space coordinates
+        Vector3 worldPoint;
+
+        /// Surface normal of the hit collider at hit point in world-space coordinates
+        Vector3 worldNormal;
+
+        /// Fraction of the translation where the swept shape hits the collider (time of impact).
+        /// The swept shape touches the collider when it has been moved by hitFraction * translation.
+        decimal hitFraction;
+
+        /// Pointer to the hit collision body
+        CollisionBody* body;
+
+        /// Pointer to the hit collider
+        Collider* collider;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ShapeCastInfo() : hitFraction(decimal(1.0)), body(nullptr), collider(nullptr) {
+
+        }
+
+        /// Destructor
+        ~ShapeCastInfo() = default;
+};
+
+}
+
+#endif
@@ -127,6 +127,23 @@ class DynamicAABBTreeRaycastCallback {
 
 };
 
+// Class DynamicAABBTreeRaycastPacketCallback
+/**
+ * Raycast callback in the Dynamic AABB Tree called when the AABB of a leaf
+ * node is hit by a ray of a packet of rays (see DynamicAABBTree::raycastPacket()).
+ */
+class DynamicAABBTreeRaycastPacketCallback {
+
+    public:
+
+        // Called when the AABB of a leaf node is hit by the ray with a given index in the packet.
+        // The returned value has the same meaning as in DynamicAABBTreeRaycastCallback.
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, uint rayIndex, const Ray& ray)=0;
+
+        virtual ~DynamicAABBTreeRaycastPacketCallback() = default;
+
+};
+
 // Class DynamicAABBTree
 /**
  * This class implements a dynamic AABB tree that is used for broad-phase
@@ -245,6 +262,13 @@ class DynamicAABBTree {
         /// Ray casting method
         void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
 
+        /// Ray casting method with the allocator to use for the traversal stack
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const;
+
+        /// Ray casting method for a packet of at most SIMD_WIDTH rays that traverse the tree together
+        void raycastPacket(const Ray* rays, const decimal* maxFractions, uint nbRays,
+                           DynamicAABBTreeRaycastPacketCallback& callback, MemoryAllocator& stackAllocator) const;
+
         /// Compute the height of the tree
         int computeHeight();
 
@@ -254,6 +278,9 @@ class DynamicAABBTree {
         /// Clear all the nodes and reset the tree
         void reset();
 
+        /// Rebuild the tree top-down with the surface area heuristic (IDs of the objects do not change)
+        void rebuild();
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
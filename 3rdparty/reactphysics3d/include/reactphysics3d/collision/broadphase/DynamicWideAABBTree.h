@@ -0,0 +1,424 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_DYNAMIC_WIDE_AABB_TREE_H
+#define REACTPHYSICS3D_DYNAMIC_WIDE_AABB_TREE_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class MemoryAllocator;
+class Profiler;
+
+/// Maximum number of children of a node of the wide AABB tree (one SIMD lane per child)
+const uint WIDE_TREE_NB_MAX_CHILDREN = SIMD_WIDTH;
+
+// Structure WideTreeNode
+/**
+ * This structure represents an internal node of the dynamic wide AABB tree. The AABBs of
+ * the children are stored quantized on 16 bits per coordinate relative to the AABB of the
+ * node and in structure of arrays layout so that all the children of a node are tested
+ * at once with SIMD instructions.
+ */
+struct WideTreeNode {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Quantized minimum coordinates of the AABBs of the children (one row per axis)
+    uint16 childrenMin[3][WIDE_TREE_NB_MAX_CHILDREN];
+
+    /// Quantized maximum coordinates of the AABBs of the children (one row per axis)
+    uint16 childrenMax[3][WIDE_TREE_NB_MAX_CHILDREN];
+
+    /// Children of the node. A positive value is the ID of an internal node and a value
+    /// smaller than -1 is an encoded object ID (see DynamicWideAABBTree::encodeObject())
+    int32 children[WIDE_TREE_NB_MAX_CHILDREN];
+
+    /// Exact AABB of the node (union of the AABBs of its children)
+    AABB aabb;
+
+    /// Size of a quantization step along each axis
+    Vector3 quantizationStep;
+
+    // A node is either in the tree (has a parent) or in the free nodes list
+    // (has a next node)
+    union {
+
+        /// Parent node ID
+        int32 parentID;
+
+        /// Next allocated node ID
+        int32 nextNodeID;
+    };
+
+    /// Index of the node in the children of its parent
+    uint8 indexInParent;
+
+    /// Number of children of the node (zero if the node is free)
+    uint8 nbChildren;
+
+    /// Height of the node in the tree (zero if the children of the node are objects)
+    uint8 height;
+};
+
+// Structure WideTreeObject
+/**
+ * This structure represents an object (leaf) stored in the dynamic wide AABB tree.
+ */
+struct WideTreeObject {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Fat axis aligned bounding box (AABB) of the object
+    AABB aabb;
+
+    /// Two pieces of data stored with the object
+    union {
+        int32 dataInt[2];
+        void* dataPointer;
+    };
+
+    // An object is either in the tree (is in a node) or in the free objects list
+    // (has a next object)
+    union {
+
+        /// ID of the node containing the object
+        int32 nodeID;
+
+        /// Next allocated object ID
+        int32 nextObjectID;
+    };
+
+    /// Index of the object in the children of its node (-1 if the object is free)
+    int32 indexInNode;
+};
+
+// Class DynamicWideAABBTree
+/**
+ * This class implements a dynamic AABB tree where each internal node has up to
+ * WIDE_TREE_NB_MAX_CHILDREN children (4 with SSE2, 8 with AVX2). The tree is shallower than
+ * the binary DynamicAABBTree and the children of a node are tested together with SIMD
+ * instructions on their quantized AABBs. The quantized AABBs are conservative and the exact
+ * fat AABB of an object is tested before it is reported. Therefore, this tree reports
+ * exactly the same overlapping objects and raycast candidates as the DynamicAABBTree.
+ * The objects are identified by IDs that do not change while the object is in the tree.
+ * The tree is kept balanced as an R-tree: all the objects are at the same depth, a full
+ * node is split in two when a child is added and a node left with a single child is
+ * removed (its child is inserted again).
+ */
+class DynamicWideAABBTree {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Pointer to the memory location of the nodes of the tree
+        WideTreeNode* mNodes;
+
+        /// Pointer to the memory location of the objects of the tree
+        WideTreeObject* mObjects;
+
+        /// ID of the root node of the tree
+        int32 mRootNodeID;
+
+        /// ID of the first node of the list of free (allocated) nodes in the tree that we can use
+        int32 mFreeNodeID;
+
+        /// Number of allocated nodes in the tree
+        int32 mNbAllocatedNodes;
+
+        /// Number of nodes in the tree
+        int32 mNbNodes;
+
+        /// ID of the first object of the list of free (allocated) objects that we can use
+        int32 mFreeObjectID;
+
+        /// Number of allocated objects
+        int32 mNbAllocatedObjects;
+
+        /// Number of objects in the tree
+        int32 mNbObjects;
+
+        /// The fat AABB is the initial AABB inflated by a given percentage of its size.
+        decimal mFatAABBInflatePercentage;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Pointer to the profiler
+		Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Allocate and return a node to use in the tree
+        int32 allocateNode();
+
+        /// Release a node
+        void releaseNode(int32 nodeID);
+
+        /// Allocate and return an object ID
+        int32 allocateObject();
+
+        /// Release an object ID
+        void releaseObject(int32 objectID);
+
+        /// Insert an object in the tree
+        void insertObject(int32 objectID);
+
+        /// Insert a child (object or node) into a node of a given height
+        void insertChild(int32 child, int height);
+
+        /// Add a child to a node or split the node if it is full
+        void addChildOrSplitNode(int32 nodeID, int32 child);
+
+        /// Split a full node in two nodes to add a new child
+        void splitNode(int32 nodeID, int32 child);
+
+        /// Remove an object from the tree
+        void removeObjectFromNode(int32 objectID);
+
+        /// Add a child at the end of the children of a node
+        void addChild(int32 nodeID, int32 child);
+
+        /// Remove the child at a given index of a node
+        void removeChild(int32 nodeID, uint index);
+
+        /// Set the location (node and index) of a child in the tree
+        void setChildLocation(int32 child, int32 nodeID, uint index);
+
+        /// Return the exact AABB of a child
+        const AABB& getChildAABB(int32 child) const;
+
+        /// Recompute the AABB and the quantized children AABBs of a node
+        bool refitNode(int32 nodeID, int changedChildIndex = -1);
+
+        /// Recompute the AABB and the quantized children AABBs of a node and of its ancestors
+        void refitNodeAndAncestors(int32 nodeID, int changedChildIndex = -1);
+
+        /// Quantize the AABB of a child of a node
+        void quantizeChildAABB(WideTreeNode& node, uint index, const AABB& childAABB,
+                               const Vector3& inverseStep) const;
+
+        /// Return the bit mask of the children of a node whose quantized AABB overlaps an AABB
+        uint computeOverlappingChildren(const WideTreeNode& node, const AABB& aabb) const;
+
+        /// Return the bit mask of the children of a node whose quantized AABB is hit by a ray
+        uint computeRayHitChildren(const WideTreeNode& node, const Vector3& rayOrigin,
+                                   const Vector3& rayInverseDirection, decimal maxFraction) const;
+
+        /// Initialize the tree
+        void init();
+
+        /// Return true if a child is an object
+        static bool isObject(int32 child);
+
+        /// Encode an object ID as a child of a node
+        static int32 encodeObject(int32 objectID);
+
+        /// Decode the object ID of a child of a node
+        static int32 decodeObject(int32 child);
+
+#ifndef NDEBUG
+
+        /// Check if the tree structure is valid (for debugging purpose)
+        void check() const;
+
+        /// Check if the node structure is valid (for debugging purpose)
+        void checkNode(int32 nodeID) const;
+
+#endif
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        DynamicWideAABBTree(MemoryAllocator& allocator, decimal fatAABBInflatePercentage = decimal(0.0));
+
+        /// Destructor
+        ~DynamicWideAABBTree();
+
+        /// Deleted copy-constructor
+        DynamicWideAABBTree(const DynamicWideAABBTree& tree) = delete;
+
+        /// Deleted assignment operator
+        DynamicWideAABBTree& operator=(const DynamicWideAABBTree& tree) = delete;
+
+        /// Add an object into the tree (where object data are two integers)
+        int32 addObject(const AABB& aabb, int32 data1, int32 data2);
+
+        /// Add an object into the tree (where object data is a pointer)
+        int32 addObject(const AABB& aabb, void* data);
+
+        /// Remove an object from the tree
+        void removeObject(int32 objectID);
+
+        /// Update the dynamic tree after an object has moved.
+        bool updateObject(int32 objectID, const AABB& newAABB, bool forceReinsert = false);
+
+        /// Return the fat AABB corresponding to a given object ID
+        const AABB& getFatAABB(int32 objectID) const;
+
+        /// Return the pointer to the data array of a given object of the tree
+        int32* getNodeDataInt(int32 objectID) const;
+
+        /// Return the data pointer of a given object of the tree
+        void* getNodeDataPointer(int32 objectID) const;
+
+        /// Report all shapes overlapping with all the shapes in the map in parameter
+        void reportAllShapesOverlappingWithShapes(const List<int32>& nodesToTest, size_t startIndex,
+                                                  size_t endIndex, List<Pair<int32, int32>>& outOverlappingNodes) const;
+
+        /// Report all shapes overlapping with the AABB given in parameter.
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int>& overlappingNodes) const;
+
+        /// Ray casting method
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
+
+        /// Ray casting method with the allocator to use for the traversal stack
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const;
+
+        /// Compute the height of the tree
+        int computeHeight() const;
+
+        /// Return the root AABB of the tree
+        AABB getRootAABB() const;
+
+        /// Clear all the nodes and reset the tree
+        void reset();
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Set the profiler
+		void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+// Return true if a child is an object
+inline bool DynamicWideAABBTree::isObject(int32 child) {
+    return child < -1;
+}
+
+// Encode an object ID as a child of a node
+inline int32 DynamicWideAABBTree::encodeObject(int32 objectID) {
+    assert(objectID >= 0);
+    return -objectID - 2;
+}
+
+// Decode the object ID of a child of a node
+inline int32 DynamicWideAABBTree::decodeObject(int32 child) {
+    assert(isObject(child));
+    return -child - 2;
+}
+
+// Return the fat AABB corresponding to a given object ID
+inline const AABB& DynamicWideAABBTree::getFatAABB(int32 objectID) const {
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    return mObjects[objectID].aabb;
+}
+
+// Return the pointer to the data array of a given object of the tree
+inline int32* DynamicWideAABBTree::getNodeDataInt(int32 objectID) const {
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].indexInNode >= 0);
+    return mObjects[objectID].dataInt;
+}
+
+// Return the data pointer of a given object of the tree
+inline void* DynamicWideAABBTree::getNodeDataPointer(int32 objectID) const {
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].indexInNode >= 0);
+    return mObjects[objectID].dataPointer;
+}
+
+// Return the root AABB of the tree
+inline AABB DynamicWideAABBTree::getRootAABB() const {
+    assert(mRootNodeID != -1);
+    return mNodes[mRootNodeID].aabb;
+}
+
+// Return the exact AABB of a child
+inline const AABB& DynamicWideAABBTree::getChildAABB(int32 child) const {
+    return isObject(child) ? mObjects[decodeObject(child)].aabb : mNodes[child].aabb;
+}
+
+// Add an object into the tree. This method inserts a new object in the tree and
+// returns its ID.
+inline int32 DynamicWideAABBTree::addObject(const AABB& aabb, int32 data1, int32 data2) {
+
+    int32 objectID = allocateObject();
+
+    // Create the fat aabb to use in the tree (inflate the aabb by a constant percentage of its size)
+    const Vector3 gap(aabb.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+    mObjects[objectID].aabb = AABB(aabb.getMin() - gap, aabb.getMax() + gap);
+    mObjects[objectID].dataInt[0] = data1;
+    mObjects[objectID].dataInt[1] = data2;
+
+    insertObject(objectID);
+
+    return objectID;
+}
+
+// Add an object into the tree. This method inserts a new object in the tree and
+// returns its ID.
+inline int32 DynamicWideAABBTree::addObject(const AABB& aabb, void* data) {
+
+    int32 objectID = allocateObject();
+
+    // Create the fat aabb to use in the tree (inflate the aabb by a constant percentage of its size)
+    const Vector3 gap(aabb.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+    mObjects[objectID].aabb = AABB(aabb.getMin() - gap, aabb.getMax() + gap);
+    mObjects[objectID].dataPointer = data;
+
+    insertObject(objectID);
+
+    return objectID;
+}
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+inline void DynamicWideAABBTree::setProfiler(Profiler* profiler) {
+	mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,281 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SWEEP_AND_PRUNE_H
+#define REACTPHYSICS3D_SWEEP_AND_PRUNE_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/containers/List.h>
+#include <reactphysics3d/containers/Pair.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class MemoryAllocator;
+class Profiler;
+
+// Structure SweepAndPruneEndPoint
+/**
+ * This structure represents the minimum or the maximum of the AABB of an object
+ * along one axis in the sorted endpoints arrays of the sweep and prune.
+ */
+struct SweepAndPruneEndPoint {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Coordinate of the endpoint along the axis
+    decimal value;
+
+    /// ID of the object shifted by one bit. The lowest bit is one for a maximum endpoint
+    uint32 data;
+
+    // -------------------- Methods -------------------- //
+
+    /// Return the ID of the object of the endpoint
+    int32 getObjectID() const {
+        return static_cast<int32>(data >> 1);
+    }
+
+    /// Return true if the endpoint is the maximum of the AABB of its object
+    bool isMax() const {
+        return (data & 1) != 0;
+    }
+};
+
+// Structure SweepAndPruneObject
+/**
+ * This structure represents an object stored in the sweep and prune.
+ */
+struct SweepAndPruneObject {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Fat axis aligned bounding box (AABB) of the object
+    AABB aabb;
+
+    /// Two pieces of data stored with the object
+    union {
+        int32 dataInt[2];
+        void* dataPointer;
+    };
+
+    /// Next allocated object ID (only used when the object is free)
+    int32 nextObjectID;
+
+    /// Index of the minimum endpoint of the object in the array of each axis (-1 if the object is free)
+    int32 minEndPoints[3];
+
+    /// Index of the maximum endpoint of the object in the array of each axis
+    int32 maxEndPoints[3];
+};
+
+// Class SweepAndPrune
+/**
+ * This class implements an incremental sweep and prune (sort and sweep) broad-phase. The
+ * minimum and maximum of the fat AABB of each object are kept sorted in one array of
+ * endpoints per axis. When the fat AABB of an object changes, its endpoints are moved with
+ * an insertion sort, which is almost free when the objects move coherently from frame to
+ * frame. A pair of objects can only start to overlap when a minimum endpoint passes a maximum
+ * endpoint of another object (or the opposite). Those pairs are stored in a pair cache until
+ * they are reported with reportNewOverlappingPairs(). The fat AABBs are computed as in the
+ * DynamicAABBTree. The objects are identified by IDs that do not change while the object is
+ * in the sweep and prune.
+ */
+class SweepAndPrune {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Pointer to the memory location of the objects
+        SweepAndPruneObject* mObjects;
+
+        /// Sorted arrays of the endpoints of the objects along each axis
+        SweepAndPruneEndPoint* mEndPoints[3];
+
+        /// ID of the first object of the list of free (allocated) objects that we can use
+        int32 mFreeObjectID;
+
+        /// Number of allocated objects
+        int32 mNbAllocatedObjects;
+
+        /// Number of objects in the sweep and prune
+        int32 mNbObjects;
+
+        /// Pair cache with the pairs of objects that have started to overlap since
+        /// the last call to reportNewOverlappingPairs()
+        List<Pair<int32, int32>> mNewOverlappingPairs;
+
+        /// The fat AABB is the initial AABB inflated by a given percentage of its size.
+        decimal mFatAABBInflatePercentage;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Pointer to the profiler
+		Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Allocate and return an object ID
+        int32 allocateObject();
+
+        /// Release an object ID
+        void releaseObject(int32 objectID);
+
+        /// Move an endpoint to its sorted position in the array of an axis
+        void sortEndPoint(int axis, int32 index, bool addNewOverlappingPairs);
+
+        /// Set the index of an endpoint in its object
+        void setEndPointIndex(int axis, int32 index);
+
+        /// Add a pair of objects whose fat AABBs have started to overlap into the pair cache
+        void addNewOverlappingPair(int32 objectID1, int32 objectID2);
+
+        /// Initialize the sweep and prune
+        void init();
+
+        /// Return true if an endpoint must be before another one in the sorted arrays
+        static bool isEndPointLess(const SweepAndPruneEndPoint& endPoint1,
+                                   const SweepAndPruneEndPoint& endPoint2);
+
+#ifndef NDEBUG
+
+        /// Check if the endpoints arrays are valid (for debugging purpose). This is O(n) so it is
+        /// not called by add and remove, call it manually when debugging
+        void check() const;
+
+#endif
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SweepAndPrune(MemoryAllocator& allocator, decimal fatAABBInflatePercentage = decimal(0.0));
+
+        /// Destructor
+        ~SweepAndPrune();
+
+        /// Deleted copy-constructor
+        SweepAndPrune(const SweepAndPrune& sweepAndPrune) = delete;
+
+        /// Deleted assignment operator
+        SweepAndPrune& operator=(const SweepAndPrune& sweepAndPrune) = delete;
+
+        /// Add an object (where object data is a pointer)
+        int32 addObject(const AABB& aabb, void* data);
+
+        /// Remove an object
+        void removeObject(int32 objectID);
+
+        /// Update the sweep and prune after an object has moved.
+        bool updateObject(int32 objectID, const AABB& newAABB, bool forceReinsert = false);
+
+        /// Return the fat AABB corresponding to a given object ID
+        const AABB& getFatAABB(int32 objectID) const;
+
+        /// Return the data pointer of a given object
+        void* getNodeDataPointer(int32 objectID) const;
+
+        /// Report all shapes overlapping with all the shapes in the map in parameter
+        void reportAllShapesOverlappingWithShapes(const List<int32>& nodesToTest, size_t startIndex,
+                                                  size_t endIndex, List<Pair<int32, int32>>& outOverlappingNodes) const;
+
+        /// Report all the objects overlapping with the AABB given in parameter
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int>& overlappingNodes) const;
+
+        /// Report the pairs of objects that have started to overlap since the last call and clear the pair cache
+        void reportNewOverlappingPairs(List<Pair<int32, int32>>& outOverlappingNodes);
+
+        /// Ray casting method
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
+
+        /// Clear all the objects and reset the sweep and prune
+        void reset();
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Set the profiler
+		void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+// Return true if an endpoint must be before another one in the sorted arrays. A minimum
+// endpoint is before a maximum endpoint with the same value so that touching AABBs are
+// considered as overlapping (as with AABB::testCollision()).
+inline bool SweepAndPrune::isEndPointLess(const SweepAndPruneEndPoint& endPoint1,
+                                          const SweepAndPruneEndPoint& endPoint2) {
+    return endPoint1.value < endPoint2.value ||
+           (endPoint1.value == endPoint2.value && !endPoint1.isMax() && endPoint2.isMax());
+}
+
+// Set the index of an endpoint in its object
+inline void SweepAndPrune::setEndPointIndex(int axis, int32 index) {
+    const SweepAndPruneEndPoint& endPoint = mEndPoints[axis][index];
+    SweepAndPruneObject& object = mObjects[endPoint.getObjectID()];
+    if (endPoint.isMax()) {
+        object.maxEndPoints[axis] = index;
+    }
+    else {
+        object.minEndPoints[axis] = index;
+    }
+}
+
+// Return the fat AABB corresponding to a given object ID
+inline const AABB& SweepAndPrune::getFatAABB(int32 objectID) const {
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    return mObjects[objectID].aabb;
+}
+
+// Return the data pointer of a given object
+inline void* SweepAndPrune::getNodeDataPointer(int32 objectID) const {
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].minEndPoints[0] >= 0);
+    return mObjects[objectID].dataPointer;
+}
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+inline void SweepAndPrune::setProfiler(Profiler* profiler) {
+	mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,119 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+#define	REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseAlgorithm.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+struct BoxVsBoxNarrowPhaseInfoBatch;
+struct LastFrameCollisionInfo;
+struct Vector3;
+class Matrix3x3;
+class Transform;
+
+// Class BoxVsBoxAlgorithm
+/**
+ * This class is used to compute the narrow-phase collision detection
+ * between two box collision shapes. Instead of walking the half-edge
+ * structures of the boxes like the general SAT algorithm does, we test
+ * the 15 potential separating axes of two oriented boxes (3 face normals
+ * of each box and the 9 cross products of their edge directions) in closed
+ * form. The contact points are then computed by clipping the incident face
+ * against the side planes of the reference face or, for an edge vs edge
+ * contact, by computing the closest points between the two edges. The axis
+ * selection uses the same biases and temporal coherence as the SAT algorithm
+ * so that resting contacts keep the same reference face between frames.
+ */
+class BoxVsBoxAlgorithm : public NarrowPhaseAlgorithm {
+
+    protected :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Relative and absolute bias used to favor the same separating axis between frames
+        /// (see SATAlgorithm)
+        static const decimal SEPARATING_AXIS_RELATIVE_TOLERANCE;
+        static const decimal SEPARATING_AXIS_ABSOLUTE_TOLERANCE;
+
+        /// Minimum squared length of the cross product of two edge directions to
+        /// use it as a separating axis (the edges are almost parallel otherwise)
+        static const decimal MIN_EDGES_CROSS_PRODUCT_SQUARE_LENGTH;
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the penetration depth of the boxes along one of the 15 potential separating axes
+        decimal testSeparatingAxis(uint axis, const Vector3& halfExtents1, const Vector3& halfExtents2,
+                                   const Matrix3x3& rotation, const Matrix3x3& absRotation,
+                                   const Vector3& translation, Vector3& normalBox1Space) const;
+
+        /// Return the separating axis (or axis of minimum penetration) of the previous frame
+        uint getPreviousSeparatingAxis(const LastFrameCollisionInfo* lastFrameCollisionInfo) const;
+
+        /// Store the separating axis (or axis of minimum penetration) for the next frame
+        void setPreviousSeparatingAxis(LastFrameCollisionInfo* lastFrameCollisionInfo, uint axis) const;
+
+        /// Clip a polygon with an axis-aligned plane and return the number of vertices of the clipped polygon
+        uint clipPolygonWithAxisPlane(const Vector3* polygonVertices, uint nbVertices, uint planeAxis, decimal planeSide,
+                                      decimal planeOffset, Vector3* clippedVertices) const;
+
+        /// Compute the contact points between a reference face and an incident face of the boxes
+        bool computeFaceContactPoints(uint axis, const Vector3& normalBox1Space, const Transform& box2ToBox1,
+                                      BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint batchIndex) const;
+
+        /// Compute the contact point between an edge of each box
+        void computeEdgeContactPoint(uint axis, const Vector3& normalBox1Space, decimal penetrationDepth,
+                                     const Transform& box2ToBox1, BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch,
+                                     uint batchIndex) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BoxVsBoxAlgorithm() = default;
+
+        /// Destructor
+        virtual ~BoxVsBoxAlgorithm() override = default;
+
+        /// Deleted copy-constructor
+        BoxVsBoxAlgorithm(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Deleted assignment operator
+        BoxVsBoxAlgorithm& operator=(const BoxVsBoxAlgorithm& algorithm) = delete;
+
+        /// Compute the narrow-phase collision detection between two boxes
+        bool testCollision(BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint batchStartIndex, uint batchNbItems,
+                           bool clipWithPreviousAxisIfStillColliding);
+};
+
+}
+
+#endif
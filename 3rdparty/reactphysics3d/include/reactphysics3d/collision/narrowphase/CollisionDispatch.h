@@ -33,6 +33,7 @@
 #include <reactphysics3d/collision/narrowphase/CapsuleVsCapsuleAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/CapsuleVsConvexPolyhedronAlgorithm.h>
 #include <reactphysics3d/collision/narrowphase/ConvexPolyhedronVsConvexPolyhedronAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxAlgorithm.h>
 #include <reactphysics3d/collision/shapes/CollisionShape.h>
 
 namespace reactphysics3d {
@@ -46,7 +47,8 @@ enum class NarrowPhaseAlgorithmType {
     CapsuleVsCapsule,
     SphereVsConvexPolyhedron,
     CapsuleVsConvexPolyhedron,
-    ConvexPolyhedronVsConvexPolyhedron
+    ConvexPolyhedronVsConvexPolyhedron,
+    BoxVsBox
 };
 
 // Class CollisionDispatch
@@ -80,6 +82,13 @@ class CollisionDispatch {
         /// True if the convex polyhedron vs convex polyhedron algorithm is the default one
         bool mIsConvexPolyhedronVsConvexPolyhedronDefault = true;
 
+        /// True if the box vs box algorithm is the default one
+        bool mIsBoxVsBoxDefault = true;
+
+        /// True if the box vs box algorithm is used for the new pairs of boxes (the
+        /// convex polyhedron vs convex polyhedron algorithm is used otherwise)
+        bool mIsBoxVsBoxAlgorithmEnabled = true;
+
         /// Sphere vs Sphere collision algorithm
         SphereVsSphereAlgorithm* mSphereVsSphereAlgorithm;
 
@@ -98,6 +107,9 @@ class CollisionDispatch {
         /// Convex Polyhedron vs Convex Polyhedron collision algorithm
         ConvexPolyhedronVsConvexPolyhedronAlgorithm* mConvexPolyhedronVsConvexPolyhedronAlgorithm;
 
+        /// Box vs Box collision algorithm
+        BoxVsBoxAlgorithm* mBoxVsBoxAlgorithm;
+
         /// Collision detection matrix (algorithms to use)
         NarrowPhaseAlgorithmType mCollisionMatrix[NB_COLLISION_SHAPE_TYPES][NB_COLLISION_SHAPE_TYPES];
 
@@ -156,6 +168,18 @@ class CollisionDispatch {
         /// Get the Convex Polyhedron vs Convex Polyhedron narrow-phase collision detection algorithm
         ConvexPolyhedronVsConvexPolyhedronAlgorithm* getConvexPolyhedronVsConvexPolyhedronAlgorithm();
 
+        /// Set the Box vs Box narrow-phase collision detection algorithm
+        void setBoxVsBoxAlgorithm(BoxVsBoxAlgorithm* algorithm);
+
+        /// Get the Box vs Box narrow-phase collision detection algorithm
+        BoxVsBoxAlgorithm* getBoxVsBoxAlgorithm();
+
+        /// Return true if the box vs box algorithm is used for the pairs of boxes
+        bool isBoxVsBoxAlgorithmEnabled() const;
+
+        /// Enable/Disable the box vs box algorithm for the pairs of boxes
+        void setIsBoxVsBoxAlgorithmEnabled(bool isEnabled);
+
         /// Fill-in the collision detection matrix
         void fillInCollisionMatrix();
 
@@ -163,6 +187,9 @@ class CollisionDispatch {
         NarrowPhaseAlgorithmType selectNarrowPhaseAlgorithm(const CollisionShapeType& shape1Type,
                                                             const CollisionShapeType& shape2Type) const;
 
+        /// Return the corresponding narrow-phase algorithm type to use for two convex collision shapes
+        NarrowPhaseAlgorithmType selectNarrowPhaseAlgorithm(const CollisionShape* shape1, const CollisionShape* shape2) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -202,6 +229,23 @@ inline ConvexPolyhedronVsConvexPolyhedronAlgorithm* CollisionDispatch::getConvex
     return mConvexPolyhedronVsConvexPolyhedronAlgorithm;
 }
 
+// Get the Box vs Box narrow-phase collision detection algorithm
+inline BoxVsBoxAlgorithm* CollisionDispatch::getBoxVsBoxAlgorithm() {
+    return mBoxVsBoxAlgorithm;
+}
+
+// Return true if the box vs box algorithm is used for the pairs of boxes
+inline bool CollisionDispatch::isBoxVsBoxAlgorithmEnabled() const {
+    return mIsBoxVsBoxAlgorithmEnabled;
+}
+
+// Enable/Disable the box vs box algorithm for the pairs of boxes
+/// If it is disabled, the pairs of boxes use the convex polyhedron vs convex polyhedron
+/// algorithm (SAT). Note that this only affects the overlapping pairs created afterwards.
+inline void CollisionDispatch::setIsBoxVsBoxAlgorithmEnabled(bool isEnabled) {
+    mIsBoxVsBoxAlgorithmEnabled = isEnabled;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -214,6 +258,7 @@ inline void CollisionDispatch::setProfiler(Profiler* profiler) {
     mSphereVsConvexPolyhedronAlgorithm->setProfiler(profiler);
     mCapsuleVsConvexPolyhedronAlgorithm->setProfiler(profiler);
     mConvexPolyhedronVsConvexPolyhedronAlgorithm->setProfiler(profiler);
+    mBoxVsBoxAlgorithm->setProfiler(profiler);
 }
 
 #endif
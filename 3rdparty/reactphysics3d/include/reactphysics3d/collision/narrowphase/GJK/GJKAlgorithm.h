@@ -38,6 +38,8 @@ class ContactManifoldInfo;
 struct NarrowPhaseInfoBatch;
 class ConvexShape;
 class Profiler;
+class Transform;
+struct Vector3;
 class VoronoiSimplex;
 template<typename T> class List;
 
@@ -45,6 +47,10 @@ template<typename T> class List;
 constexpr decimal REL_ERROR = decimal(1.0e-3);
 constexpr decimal REL_ERROR_SQUARE = REL_ERROR * REL_ERROR;
 constexpr int MAX_ITERATIONS_GJK_RAYCAST = 32;
+constexpr int MAX_ITERATIONS_CONSERVATIVE_ADVANCEMENT = 32;
+
+/// Distance under which a swept shape is considered to hit another shape
+constexpr decimal CONSERVATIVE_ADVANCEMENT_TOLERANCE = decimal(0.005);
 
 // Class GJKAlgorithm
 /**
@@ -100,6 +106,16 @@ class GJKAlgorithm {
         void testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint batchStartIndex,
                            uint batchNbItems, List<GJKResult>& gjkResults);
 
+        /// Compute the distance and the closest points between two separated convex shapes
+        bool computeDistance(const ConvexShape* shape1, const Transform& transform1,
+                             const ConvexShape* shape2, const Transform& transform2,
+                             decimal& outDistance, Vector3& outPoint1, Vector3& outPoint2, Vector3& outNormal) const;
+
+        /// Compute the time of impact of a convex shape translated toward another one
+        bool computeTimeOfImpact(const ConvexShape* shape1, const Transform& transform1, const Vector3& translation1,
+                                 const ConvexShape* shape2, const Transform& transform2, decimal maxFraction,
+                                 decimal& outHitFraction, Vector3& outHitPoint, Vector3& outHitNormal) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -142,6 +142,9 @@ class RigidBodyComponents : public Components {
         /// Array with the boolean value to know if the body has already been added into an island
         bool* mIsAlreadyInIsland;
 
+        /// Array of boolean values to know if the continuous collision detection is enabled for the body
+        bool* mIsCCDEnabled;
+
         /// For each body, the list of joints entities the body is part of
         List<Entity>* mJoints;
 
@@ -195,6 +198,12 @@ class RigidBodyComponents : public Components {
         /// Set the value to know if the body is allowed to sleep
         void setIsAllowedToSleep(Entity bodyEntity, bool isAllowedToSleep) const;
 
+        /// Return true if the continuous collision detection is enabled for the body
+        bool getIsCCDEnabled(Entity bodyEntity) const;
+
+        /// Set the value to know if the continuous collision detection is enabled for the body
+        void setIsCCDEnabled(Entity bodyEntity, bool isCCDEnabled) const;
+
         /// Return true if the body is sleeping
         bool getIsSleeping(Entity bodyEntity) const;
 
@@ -381,6 +390,22 @@ inline void RigidBodyComponents::setIsAllowedToSleep(Entity bodyEntity, bool isA
     mIsAllowedToSleep[mMapEntityToComponentIndex[bodyEntity]] = isAllowedToSleep;
 }
 
+// Return true if the continuous collision detection is enabled for the body
+inline bool RigidBodyComponents::getIsCCDEnabled(Entity bodyEntity) const {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    return mIsCCDEnabled[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Set the value to know if the continuous collision detection is enabled for the body
+inline void RigidBodyComponents::setIsCCDEnabled(Entity bodyEntity, bool isCCDEnabled) const {
+
+    assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+
+    mIsCCDEnabled[mMapEntityToComponentIndex[bodyEntity]] = isCCDEnabled;
+}
+
 // Return true if the body is sleeping
 inline bool RigidBodyComponents::getIsSleeping(Entity bodyEntity) const {
 
@@ -81,6 +81,15 @@ enum class JointsPositionCorrectionTechnique {BAUMGARTE_JOINTS, NON_LINEAR_GAUSS
 ///                 bodies momentum. This is the option used by default.
 enum class ContactsPositionCorrectionTechnique {BAUMGARTE_CONTACTS, SPLIT_IMPULSES};
 
+/// Data structure used by the broad-phase collision detection
+/// DYNAMIC_AABB_TREE : Binary dynamic AABB tree. This is the option used by default.
+/// DYNAMIC_WIDE_AABB_TREE : Dynamic AABB tree with 4 or 8 children per node (depending on the
+///                          SIMD instructions available) and quantized children AABBs. Shallower
+///                          and faster to query with many colliders.
+/// SWEEP_AND_PRUNE : Incremental sort and sweep of the AABB endpoints on the three axes. Fast
+///                   when the colliders move coherently from frame to frame (raycasts are linear).
+enum class BroadPhaseType {DYNAMIC_AABB_TREE, DYNAMIC_WIDE_AABB_TREE, SWEEP_AND_PRUNE};
+
 // ------------------- Constants ------------------- //
 
 /// Smallest decimal value (negative)
@@ -204,7 +204,8 @@ inline void ContactPoint::setIsRestingContact(bool isRestingContact) {
 
 // Return the penetration depth of the contact
 /**
- * @return the penetration depth (in meters)
+ * @return the penetration depth (in meters), negative for a speculative contact of a body with
+ *         continuous collision detection (the colliders are this distance apart)
  */
 inline decimal ContactPoint::getPenetrationDepth() const {
     return mPenetrationDepth;
@@ -99,6 +99,9 @@ class List {
 
                 }
 
+                /// Assignment operator
+                Iterator& operator=(const Iterator& it) = default;
+
                 /// Deferencable
                 reference operator*() {
                     assert(mCurrentIndex >= 0 && mCurrentIndex < mSize);
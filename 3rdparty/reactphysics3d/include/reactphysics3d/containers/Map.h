@@ -311,6 +311,9 @@ class Map {
 
                 }
 
+                /// Assignment operator
+                Iterator& operator=(const Iterator& it) = default;
+
                 /// Deferencable
                 reference operator*() const {
                     assert(mCurrentEntry >= 0 && mCurrentEntry < mNbUsedEntries);
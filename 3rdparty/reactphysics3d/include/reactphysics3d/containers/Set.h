@@ -306,6 +306,9 @@ class Set {
 
                 }
 
+                /// Assignment operator
+                Iterator& operator=(const Iterator& it) = default;
+
                 /// Deferencable
                 reference operator*() const {
                     assert(mCurrentEntry >= 0 && mCurrentEntry < mNbUsedEntries);
@@ -85,6 +85,9 @@ struct Entity {
         /// Constructor
         Entity(uint32 index, uint32 generation);
 
+        /// Copy-constructor (declared because the assignment operator is user-defined)
+        Entity(const Entity& entity) = default;
+
         /// Return the lookup index of the entity in a array
         uint32 getIndex() const;
 
@@ -0,0 +1,210 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_ISLAND_UNION_FIND_H
+#define REACTPHYSICS3D_ISLAND_UNION_FIND_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/containers/List.h>
+#include <reactphysics3d/engine/Entity.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class IslandUnionFind
+/**
+ * This class keeps the non-static rigid bodies of the world in disjoint sets such that two bodies
+ * connected by a contact or a joint are always in the same set. The sets are kept from one
+ * frame to the next. They are merged when a new constraint connects two sets (union by size where
+ * the bodies of the smaller set take the root of the larger one, so that finding the root of a body
+ * takes constant time). A set is never split when a constraint is removed. It is only marked and its
+ * bodies are reset into separate sets at the next island creation, before the remaining constraints
+ * of those bodies merge them again. The nodes are indexed by the entity index of the bodies.
+ */
+class IslandUnionFind {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Index of a node that does not exist
+        static const uint32 NULL_NODE;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Entity of the body of each node
+        List<Entity> mBodyEntities;
+
+        /// Index of the root node of the set of each node (NULL_NODE if there is no body for this node)
+        List<uint32> mRoots;
+
+        /// Index of the next node of the same set (the root node is the first node of the set)
+        List<uint32> mNextNodes;
+
+        /// Number of nodes of the set of each root node
+        List<uint32> mSizes;
+
+        /// True if the set of a root node may have been disconnected and has to be split
+        List<bool> mIsSplitNeeded;
+
+        /// Index of the island of the set of a root node during the island creation (NULL_NODE otherwise)
+        List<uint32> mIslandIndices;
+
+        /// Root nodes of the sets to split (a node may not be a root node anymore)
+        List<uint32> mRootsToSplit;
+
+        // -------------------- Methods -------------------- //
+
+        /// Return the node of a body (NULL_NODE if the body is not in a set)
+        uint32 getNode(Entity bodyEntity) const;
+
+        /// Mark the set of a root node to be split
+        void markSplitNeeded(uint32 rootNode);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        IslandUnionFind(MemoryAllocator& allocator);
+
+        /// Destructor
+        ~IslandUnionFind() = default;
+
+        /// Deleted copy-constructor
+        IslandUnionFind(const IslandUnionFind& unionFind) = delete;
+
+        /// Deleted assignment operator
+        IslandUnionFind& operator=(const IslandUnionFind& unionFind) = delete;
+
+        /// Add a body in its own set
+        void addBody(Entity bodyEntity);
+
+        /// Remove a body from its set
+        void removeBody(Entity bodyEntity);
+
+        /// Return true if the body is in a set
+        bool hasBody(Entity bodyEntity) const;
+
+        /// Return the root node of the set of a body
+        uint32 findRoot(Entity bodyEntity) const;
+
+        /// Merge the sets of two bodies (nothing happens if one of the bodies is not in a set)
+        void merge(Entity body1Entity, Entity body2Entity);
+
+        /// Mark the set of a body to be split (nothing happens if the body is not in a set)
+        void markSplitNeeded(Entity bodyEntity);
+
+        /// Put each body of the sets to split into its own set and add the bodies to a list
+        void resetSetsToSplit(List<Entity>& outBodyEntities);
+
+        /// Return the number of bodies in the set of a root node
+        uint32 getSetSize(uint32 rootNode) const;
+
+        /// Return the node that follows a given node in its set (NULL_NODE at the end of the set)
+        uint32 getNextNode(uint32 node) const;
+
+        /// Return the entity of the body of a node
+        Entity getBodyEntity(uint32 node) const;
+
+        /// Return the island index of the set of a root node (NULL_NODE if it has no island)
+        uint32 getIslandIndex(uint32 rootNode) const;
+
+        /// Set the island index of the set of a root node
+        void setIslandIndex(uint32 rootNode, uint32 islandIndex);
+
+        /// Remove the island index of the set of a root node
+        void resetIslandIndex(uint32 rootNode);
+
+        /// Return true if a value returned by getNextNode() or getIslandIndex() is a node or an island
+        static bool isValid(uint32 value);
+};
+
+// Return the node of a body (NULL_NODE if the body is not in a set)
+inline uint32 IslandUnionFind::getNode(Entity bodyEntity) const {
+
+    const uint32 node = bodyEntity.getIndex();
+    if (node >= mRoots.size() || mRoots[node] == NULL_NODE || mBodyEntities[node] != bodyEntity) return NULL_NODE;
+
+    return node;
+}
+
+// Return true if the body is in a set
+inline bool IslandUnionFind::hasBody(Entity bodyEntity) const {
+    return getNode(bodyEntity) != NULL_NODE;
+}
+
+// Return the root node of the set of a body
+inline uint32 IslandUnionFind::findRoot(Entity bodyEntity) const {
+
+    const uint32 node = getNode(bodyEntity);
+    assert(node != NULL_NODE);
+
+    return mRoots[node];
+}
+
+// Return the number of bodies in the set of a root node
+inline uint32 IslandUnionFind::getSetSize(uint32 rootNode) const {
+    assert(mRoots[rootNode] == rootNode);
+    return mSizes[rootNode];
+}
+
+// Return the node that follows a given node in its set (NULL_NODE at the end of the set)
+inline uint32 IslandUnionFind::getNextNode(uint32 node) const {
+    return mNextNodes[node];
+}
+
+// Return the entity of the body of a node
+inline Entity IslandUnionFind::getBodyEntity(uint32 node) const {
+    return mBodyEntities[node];
+}
+
+// Return the island index of the set of a root node (NULL_NODE if it has no island)
+inline uint32 IslandUnionFind::getIslandIndex(uint32 rootNode) const {
+    assert(mRoots[rootNode] == rootNode);
+    return mIslandIndices[rootNode];
+}
+
+// Set the island index of the set of a root node
+inline void IslandUnionFind::setIslandIndex(uint32 rootNode, uint32 islandIndex) {
+    assert(mRoots[rootNode] == rootNode);
+    mIslandIndices[rootNode] = islandIndex;
+}
+
+// Remove the island index of the set of a root node
+inline void IslandUnionFind::resetIslandIndex(uint32 rootNode) {
+    assert(mRoots[rootNode] == rootNode);
+    mIslandIndices[rootNode] = NULL_NODE;
+}
+
+// Return true if a value returned by getNextNode() or getIslandIndex() is a node or an island
+inline bool IslandUnionFind::isValid(uint32 value) {
+    return value != NULL_NODE;
+}
+
+}
+
+#endif
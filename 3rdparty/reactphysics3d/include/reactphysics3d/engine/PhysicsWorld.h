@@ -50,6 +50,7 @@
 #include <reactphysics3d/systems/ContactSolverSystem.h>
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/engine/Islands.h>
+#include <reactphysics3d/engine/IslandUnionFind.h>
 #include <reactphysics3d/utils/DebugRenderer.h>
 #include <sstream>
 
@@ -59,6 +60,7 @@ namespace reactphysics3d {
 // Declarations
 class Island;
 class RigidBody;
+class ThreadPool;
 struct JointInfo;
 
 // Class PhysicsWorld
@@ -124,6 +126,22 @@ class PhysicsWorld {
             /// than the value bellow, the manifold are considered to be similar.
             decimal cosAngleSimilarContactManifold;
 
+            /// Number of worker threads used to run the narrow-phase and solve the islands in parallel
+            /// (in addition to the thread calling update()). Zero means that everything is solved on the calling thread.
+            uint nbWorkerThreads;
+
+            /// True if the contacts are solved by batches with SIMD instructions. The result is the
+            /// same as with the scalar contact solver.
+            bool isSimdContactSolverEnabled;
+
+            /// Minimum number of contact manifolds of an island (or of enabled joints in the world) to
+            /// color its constraints into batches without shared bodies that are solved in parallel by
+            /// the worker threads. Zero means that the constraints are never colored.
+            uint islandColoringThreshold;
+
+            /// Data structure used by the broad-phase collision detection
+            BroadPhaseType broadPhaseType;
+
             WorldSettings() {
 
                 worldName = "";
@@ -141,6 +159,10 @@ class PhysicsWorld {
                 defaultSleepAngularVelocity = decimal(3.0) * (PI / decimal(180.0));
                 nbMaxContactManifolds = 3;
                 cosAngleSimilarContactManifold = decimal(0.95);
+                nbWorkerThreads = 0;
+                isSimdContactSolverEnabled = true;
+                islandColoringThreshold = 0;
+                broadPhaseType = BroadPhaseType::DYNAMIC_AABB_TREE;
 
             }
 
@@ -166,6 +188,10 @@ class PhysicsWorld {
                 ss << "defaultSleepAngularVelocity=" << defaultSleepAngularVelocity << std::endl;
                 ss << "nbMaxContactManifolds=" << nbMaxContactManifolds << std::endl;
                 ss << "cosAngleSimilarContactManifold=" << cosAngleSimilarContactManifold << std::endl;
+                ss << "nbWorkerThreads=" << nbWorkerThreads << std::endl;
+                ss << "isSimdContactSolverEnabled=" << isSimdContactSolverEnabled << std::endl;
+                ss << "islandColoringThreshold=" << islandColoringThreshold << std::endl;
+                ss << "broadPhaseType=" << static_cast<int>(broadPhaseType) << std::endl;
 
                 return ss.str();
             }
@@ -241,6 +267,9 @@ class PhysicsWorld {
         /// All the islands of bodies of the current frame
         Islands mIslands;
 
+        /// Sets of connected non-static rigid bodies kept from one frame to the next to create the islands
+        IslandUnionFind mIslandUnionFind;
+
         /// Order in which to process the ContactPairs for contact creation such that
         /// all the contact manifolds and contact points of a given island are packed together
         /// This array contains the indices of the ContactPairs.
@@ -283,6 +312,9 @@ class PhysicsWorld {
         /// Current joint id
         uint mCurrentJointId;
 
+        /// Pool of worker threads used to run the narrow-phase and solve the islands in parallel (null if there is no worker thread)
+        ThreadPool* mThreadPool;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -306,6 +338,9 @@ class PhysicsWorld {
         /// Compute the islands using potential contacts and joints and create the actual contacts.
         void createIslands();
 
+        /// Split the sets of bodies that may have been disconnected since the last frame
+        void splitIslandSets();
+
         /// Put bodies to sleep if needed.
         void updateSleepingBodies(decimal timeStep);
 
@@ -331,6 +366,15 @@ class PhysicsWorld {
         /// Ray cast method
         void raycast(const Ray& ray, RaycastCallback* raycastCallback, unsigned short raycastWithCategoryMaskBits = 0xFFFF) const;
 
+        /// Ray cast method for a batch of rays that returns the closest hit of each ray
+        void raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                          unsigned short raycastWithCategoryMaskBits = 0xFFFF) const;
+
+        /// Sweep a convex collision shape along a translation and return the first collider hit
+        bool shapeCast(const CollisionShape* shape, const Transform& transform, const Vector3& translation,
+                       ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits = 0xFFFF,
+                       const CollisionBody* ignoredBody = nullptr) const;
+
         /// Return true if two bodies overlap (collide)
         bool testOverlap(CollisionBody* body1, CollisionBody* body2);
 
@@ -379,6 +423,33 @@ class PhysicsWorld {
         /// Set the number of iterations for the position constraint solver
         void setNbIterationsPositionSolver(uint nbIterations);
 
+        /// Get the number of worker threads used to solve the islands in parallel
+        uint getNbWorkerThreads() const;
+
+        /// Set the number of worker threads used to solve the islands in parallel
+        void setNbWorkerThreads(uint nbWorkerThreads);
+
+        /// Return true if the contacts are solved with the SIMD contact solver
+        bool isSimdContactSolverEnabled() const;
+
+        /// Enable/Disable the SIMD contact solver
+        void enableSimdContactSolver(bool isEnabled);
+
+        /// Return true if each step compares the impulses of the SIMD and scalar contact solvers
+        bool isContactSolverParityCheckEnabled() const;
+
+        /// Enable/Disable the comparison of the SIMD and scalar contact solvers at each step (slow)
+        void enableContactSolverParityCheck(bool isEnabled);
+
+        /// Return the largest impulse differences between the SIMD and scalar contact solvers
+        const ContactSolverParity& getContactSolverParity() const;
+
+        /// Get the minimum number of constraints of an island to solve it by colors in parallel
+        uint getIslandColoringThreshold() const;
+
+        /// Set the minimum number of constraints of an island to solve it by colors in parallel
+        void setIslandColoringThreshold(uint threshold);
+
         /// Set the position correction technique used for contacts
         void setContactsPositionCorrectionTechnique(ContactsPositionCorrectionTechnique technique);
 
@@ -517,6 +588,48 @@ inline void PhysicsWorld::raycast(const Ray& ray,
     mCollisionDetection.raycast(raycastCallback, ray, raycastWithCategoryMaskBits);
 }
 
+// Ray cast method for a batch of rays
+/// The closest hit of the ray rays[i] is written in outHits[i] (outHits must have room for
+/// nbRays hits). No callback is called. The rays are traversed together by packets of
+/// consecutive rays, therefore the batch is faster when close rays with similar directions
+/// (a shotgun spread for instance) are stored next to each other. This method can be called
+/// from several threads at the same time between two calls to update() (the base memory
+/// allocator has to be thread-safe, which is the case of the default one, and the profiler
+/// has to be disabled).
+/**
+ * @param rays Array of rays to use for raycasting
+ * @param nbRays Number of rays in the array
+ * @param[out] outHits Array where the closest hit of each ray is written
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                    bodies to be raycasted
+ */
+inline void PhysicsWorld::raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                                       unsigned short raycastWithCategoryMaskBits) const {
+    mCollisionDetection.raycastBatch(rays, nbRays, outHits, raycastWithCategoryMaskBits);
+}
+
+// Sweep a convex collision shape along a translation and return the first collider hit
+/// This can be used to move a fast projectile with a single query per step instead of
+/// simulating it with a smaller timestep: the projectile is swept along its motion of the
+/// step and it hits the returned collider at the fraction shapeCastInfo.hitFraction of the
+/// translation. The shape is only translated (its orientation does not change) and the
+/// other colliders do not move during the sweep.
+/**
+ * @param shape Convex collision shape (sphere, capsule, box or convex mesh) to sweep
+ * @param transform Transform of the shape (local-space to world-space) at the start of the sweep
+ * @param translation World-space translation of the shape during the sweep
+ * @param[out] shapeCastInfo Information about the first hit (valid only if the method returns true)
+ * @param castWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                 bodies that can be hit
+ * @param ignoredBody Body that cannot be hit (for instance the body of the projectile itself)
+ * @return True if the shape hits a collider during the sweep
+ */
+inline bool PhysicsWorld::shapeCast(const CollisionShape* shape, const Transform& transform, const Vector3& translation,
+                                    ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits,
+                                    const CollisionBody* ignoredBody) const {
+    return mCollisionDetection.shapeCast(shape, transform, translation, shapeCastInfo, castWithCategoryMaskBits, ignoredBody);
+}
+
 // Test collision and report contacts between two bodies.
 /// Use this method if you only want to get all the contacts between two bodies.
 /// All the contacts will be reported using the callback object in paramater.
@@ -620,6 +733,81 @@ inline uint PhysicsWorld::getNbIterationsPositionSolver() const {
     return mNbPositionSolverIterations;
 }
 
+// Get the number of worker threads used to solve the islands in parallel
+/**
+ * @return The number of worker threads (in addition to the thread calling update())
+ */
+inline uint PhysicsWorld::getNbWorkerThreads() const {
+    return mConfig.nbWorkerThreads;
+}
+
+// Return true if the contacts are solved with the SIMD contact solver
+/**
+ * @return True if the contacts are solved by batches with SIMD instructions
+ */
+inline bool PhysicsWorld::isSimdContactSolverEnabled() const {
+    return mContactSolverSystem.isSimdSolverEnabled();
+}
+
+// Enable/Disable the SIMD contact solver
+/**
+ * @param isEnabled True to solve the contacts by batches with SIMD instructions and false
+ *                  to use the scalar contact solver (both give the same result)
+ */
+inline void PhysicsWorld::enableSimdContactSolver(bool isEnabled) {
+    mConfig.isSimdContactSolverEnabled = isEnabled;
+    mContactSolverSystem.setIsSimdSolverEnabled(isEnabled);
+}
+
+// Return true if each step compares the impulses of the SIMD and scalar contact solvers
+/**
+ * @return True if the contacts of each step are solved with both contact solvers
+ */
+inline bool PhysicsWorld::isContactSolverParityCheckEnabled() const {
+    return mContactSolverSystem.isParityCheckEnabled();
+}
+
+// Enable/Disable the comparison of the SIMD and scalar contact solvers at each step
+/// When enabled, the contacts of each step are first solved with the contact solver that is
+/// not enabled and then again from the same state with the enabled one (the simulation is the
+/// same as without the comparison). This is meant for tests: the contacts are solved twice
+/// and on the world thread only. The steps of a world with enabled joints are not compared.
+/**
+ * @param isEnabled True to compare the contact solvers at each step (this resets the parity)
+ */
+inline void PhysicsWorld::enableContactSolverParityCheck(bool isEnabled) {
+    mContactSolverSystem.setIsParityCheckEnabled(isEnabled);
+}
+
+// Return the largest impulse differences between the SIMD and scalar contact solvers
+/**
+ * @return The largest differences between the accumulated impulses of both contact solvers
+ *         on the same contacts since the parity check has been enabled
+ */
+inline const ContactSolverParity& PhysicsWorld::getContactSolverParity() const {
+    return mContactSolverSystem.getParity();
+}
+
+// Get the minimum number of constraints of an island to solve it by colors in parallel
+/**
+ * @return The minimum number of contact manifolds of an island (or of enabled joints) to
+ *         color its constraints (zero if the constraints are never colored)
+ */
+inline uint PhysicsWorld::getIslandColoringThreshold() const {
+    return mConfig.islandColoringThreshold;
+}
+
+// Set the minimum number of constraints of an island to solve it by colors in parallel
+/**
+ * @param threshold Minimum number of contact manifolds of an island (or of enabled joints) to
+ *                  color its constraints (zero to never color them)
+ */
+inline void PhysicsWorld::setIslandColoringThreshold(uint threshold) {
+    mConfig.islandColoringThreshold = threshold;
+    mContactSolverSystem.setColoringThreshold(threshold);
+    mConstraintSolverSystem.setColoringThreshold(threshold);
+}
+
 // Set the position correction technique used for contacts
 /**
  * @param technique Technique used for the position correction (Baumgarte or Split Impulses)
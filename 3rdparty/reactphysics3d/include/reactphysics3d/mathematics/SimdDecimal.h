@@ -0,0 +1,385 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SIMD_DECIMAL_H
+#define REACTPHYSICS3D_SIMD_DECIMAL_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <algorithm>
+#include <cmath>
+
+// The instruction set is selected at compile time from the compiler flags (for instance
+// -mavx2 or /arch:AVX2 for 8 lanes). Without SSE2/AVX2 or in double precision, the lanes
+// are plain decimal values (scalar fallback).
+#if !defined(IS_RP3D_DOUBLE_PRECISION_ENABLED) && defined(__AVX2__)
+    #define RP3D_SIMD_AVX2
+    #include <immintrin.h>
+#elif !defined(IS_RP3D_DOUBLE_PRECISION_ENABLED) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define RP3D_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+#ifdef RP3D_SIMD_AVX2
+/// Number of lanes of a SimdDecimal
+const uint SIMD_WIDTH = 8;
+#else
+/// Number of lanes of a SimdDecimal
+const uint SIMD_WIDTH = 4;
+#endif
+
+// Class SimdDecimal
+/**
+ * This class represents SIMD_WIDTH decimal values (lanes) on which the operations are
+ * applied in lockstep. Each lane operation gives exactly the same result as the
+ * corresponding scalar operation (no approximate reciprocal) so that code written with this
+ * class matches its scalar version. This is not true anymore if the compiler is allowed to
+ * fuse multiply-adds (for instance -mfma without -ffp-contract=off). Values are loaded from
+ * and stored to arrays of SIMD_WIDTH decimals that do not need to be aligned.
+ */
+class SimdDecimal {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+#if defined(RP3D_SIMD_AVX2)
+        /// Values of the lanes
+        __m256 mValues;
+#elif defined(RP3D_SIMD_SSE2)
+        /// Values of the lanes
+        __m128 mValues;
+#else
+        /// Values of the lanes
+        decimal mValues[SIMD_WIDTH];
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Return a SimdDecimal with all its lanes set to a value
+        static SimdDecimal broadcast(decimal value);
+
+        /// Load the lanes from an array of SIMD_WIDTH decimals
+        static SimdDecimal load(const decimal* values);
+
+        /// Load the lanes from an array of SIMD_WIDTH unsigned 16-bits integers
+        static SimdDecimal loadUint16(const uint16* values);
+
+        /// Store the lanes into an array of SIMD_WIDTH decimals
+        void store(decimal* values) const;
+
+        /// Return the lane-wise std::min(a, b)
+        static SimdDecimal min(const SimdDecimal& a, const SimdDecimal& b);
+
+        /// Return the lane-wise std::max(a, b)
+        static SimdDecimal max(const SimdDecimal& a, const SimdDecimal& b);
+
+        /// Return the lane-wise square root
+        static SimdDecimal sqrt(const SimdDecimal& a);
+
+        /// Return the lane-wise (a < b ? ifTrue : ifFalse)
+        static SimdDecimal selectLess(const SimdDecimal& a, const SimdDecimal& b,
+                                      const SimdDecimal& ifTrue, const SimdDecimal& ifFalse);
+
+        /// Return a bit mask where the bit i is set if (a <= b) in the lane i
+        static uint maskLessOrEqual(const SimdDecimal& a, const SimdDecimal& b);
+
+        /// Overloaded operators
+        friend SimdDecimal operator+(const SimdDecimal& a, const SimdDecimal& b);
+        friend SimdDecimal operator-(const SimdDecimal& a, const SimdDecimal& b);
+        friend SimdDecimal operator*(const SimdDecimal& a, const SimdDecimal& b);
+        friend SimdDecimal operator/(const SimdDecimal& a, const SimdDecimal& b);
+        friend SimdDecimal operator-(const SimdDecimal& a);
+};
+
+#if defined(RP3D_SIMD_AVX2)
+
+inline SimdDecimal SimdDecimal::broadcast(decimal value) {
+    SimdDecimal result; result.mValues = _mm256_set1_ps(value); return result;
+}
+
+inline SimdDecimal SimdDecimal::load(const decimal* values) {
+    SimdDecimal result; result.mValues = _mm256_loadu_ps(values); return result;
+}
+
+inline SimdDecimal SimdDecimal::loadUint16(const uint16* values) {
+    SimdDecimal result;
+    result.mValues = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values))));
+    return result;
+}
+
+inline void SimdDecimal::store(decimal* values) const {
+    _mm256_storeu_ps(values, mValues);
+}
+
+// The operands are swapped because _mm256_min_ps(x, y) is (x < y ? x : y) while
+// std::min(a, b) is (b < a ? b : a). This matters for signed zeros.
+inline SimdDecimal SimdDecimal::min(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_min_ps(b.mValues, a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::max(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_max_ps(b.mValues, a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::sqrt(const SimdDecimal& a) {
+    SimdDecimal result; result.mValues = _mm256_sqrt_ps(a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::selectLess(const SimdDecimal& a, const SimdDecimal& b,
+                                           const SimdDecimal& ifTrue, const SimdDecimal& ifFalse) {
+    SimdDecimal result;
+    result.mValues = _mm256_blendv_ps(ifFalse.mValues, ifTrue.mValues, _mm256_cmp_ps(a.mValues, b.mValues, _CMP_LT_OQ));
+    return result;
+}
+
+inline uint SimdDecimal::maskLessOrEqual(const SimdDecimal& a, const SimdDecimal& b) {
+    return static_cast<uint>(_mm256_movemask_ps(_mm256_cmp_ps(a.mValues, b.mValues, _CMP_LE_OQ)));
+}
+
+inline SimdDecimal operator+(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_add_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_sub_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator*(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_mul_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator/(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm256_div_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a) {
+    SimdDecimal result; result.mValues = _mm256_xor_ps(a.mValues, _mm256_set1_ps(-0.0f)); return result;
+}
+
+#elif defined(RP3D_SIMD_SSE2)
+
+inline SimdDecimal SimdDecimal::broadcast(decimal value) {
+    SimdDecimal result; result.mValues = _mm_set1_ps(value); return result;
+}
+
+inline SimdDecimal SimdDecimal::load(const decimal* values) {
+    SimdDecimal result; result.mValues = _mm_loadu_ps(values); return result;
+}
+
+inline SimdDecimal SimdDecimal::loadUint16(const uint16* values) {
+    const __m128i integers = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values));
+    SimdDecimal result;
+    result.mValues = _mm_cvtepi32_ps(_mm_unpacklo_epi16(integers, _mm_setzero_si128()));
+    return result;
+}
+
+inline void SimdDecimal::store(decimal* values) const {
+    _mm_storeu_ps(values, mValues);
+}
+
+// The operands are swapped because _mm_min_ps(x, y) is (x < y ? x : y) while
+// std::min(a, b) is (b < a ? b : a). This matters for signed zeros.
+inline SimdDecimal SimdDecimal::min(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_min_ps(b.mValues, a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::max(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_max_ps(b.mValues, a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::sqrt(const SimdDecimal& a) {
+    SimdDecimal result; result.mValues = _mm_sqrt_ps(a.mValues); return result;
+}
+
+inline SimdDecimal SimdDecimal::selectLess(const SimdDecimal& a, const SimdDecimal& b,
+                                           const SimdDecimal& ifTrue, const SimdDecimal& ifFalse) {
+    const __m128 mask = _mm_cmplt_ps(a.mValues, b.mValues);
+    SimdDecimal result;
+    result.mValues = _mm_or_ps(_mm_and_ps(mask, ifTrue.mValues), _mm_andnot_ps(mask, ifFalse.mValues));
+    return result;
+}
+
+inline uint SimdDecimal::maskLessOrEqual(const SimdDecimal& a, const SimdDecimal& b) {
+    return static_cast<uint>(_mm_movemask_ps(_mm_cmple_ps(a.mValues, b.mValues)));
+}
+
+inline SimdDecimal operator+(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_add_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_sub_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator*(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_mul_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator/(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result; result.mValues = _mm_div_ps(a.mValues, b.mValues); return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a) {
+    SimdDecimal result; result.mValues = _mm_xor_ps(a.mValues, _mm_set1_ps(-0.0f)); return result;
+}
+
+#else
+
+inline SimdDecimal SimdDecimal::broadcast(decimal value) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = value;
+    return result;
+}
+
+inline SimdDecimal SimdDecimal::load(const decimal* values) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = values[i];
+    return result;
+}
+
+inline SimdDecimal SimdDecimal::loadUint16(const uint16* values) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = decimal(values[i]);
+    return result;
+}
+
+inline void SimdDecimal::store(decimal* values) const {
+    for (uint i=0; i < SIMD_WIDTH; i++) values[i] = mValues[i];
+}
+
+inline SimdDecimal SimdDecimal::min(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = std::min(a.mValues[i], b.mValues[i]);
+    return result;
+}
+
+inline SimdDecimal SimdDecimal::max(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = std::max(a.mValues[i], b.mValues[i]);
+    return result;
+}
+
+inline SimdDecimal SimdDecimal::sqrt(const SimdDecimal& a) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = std::sqrt(a.mValues[i]);
+    return result;
+}
+
+inline SimdDecimal SimdDecimal::selectLess(const SimdDecimal& a, const SimdDecimal& b,
+                                           const SimdDecimal& ifTrue, const SimdDecimal& ifFalse) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = a.mValues[i] < b.mValues[i] ? ifTrue.mValues[i] : ifFalse.mValues[i];
+    return result;
+}
+
+inline uint SimdDecimal::maskLessOrEqual(const SimdDecimal& a, const SimdDecimal& b) {
+    uint mask = 0;
+    for (uint i=0; i < SIMD_WIDTH; i++) mask |= (a.mValues[i] <= b.mValues[i] ? 1u : 0u) << i;
+    return mask;
+}
+
+inline SimdDecimal operator+(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = a.mValues[i] + b.mValues[i];
+    return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = a.mValues[i] - b.mValues[i];
+    return result;
+}
+
+inline SimdDecimal operator*(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = a.mValues[i] * b.mValues[i];
+    return result;
+}
+
+inline SimdDecimal operator/(const SimdDecimal& a, const SimdDecimal& b) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = a.mValues[i] / b.mValues[i];
+    return result;
+}
+
+inline SimdDecimal operator-(const SimdDecimal& a) {
+    SimdDecimal result;
+    for (uint i=0; i < SIMD_WIDTH; i++) result.mValues[i] = -a.mValues[i];
+    return result;
+}
+
+#endif
+
+// Structure SimdVector3
+/**
+ * SIMD_WIDTH 3D vectors stored as three SimdDecimal (one per coordinate). The vectors are
+ * loaded from and stored to arrays of three rows of SIMD_WIDTH decimals.
+ */
+struct SimdVector3 {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Coordinates of the vectors
+    SimdDecimal x, y, z;
+
+    // -------------------- Methods -------------------- //
+
+    /// Load the vectors from three rows (x, y and z) of SIMD_WIDTH decimals
+    static SimdVector3 load(const decimal values[3][SIMD_WIDTH]) {
+        SimdVector3 result;
+        result.x = SimdDecimal::load(values[0]);
+        result.y = SimdDecimal::load(values[1]);
+        result.z = SimdDecimal::load(values[2]);
+        return result;
+    }
+
+    /// Store the vectors into three rows (x, y and z) of SIMD_WIDTH decimals
+    void store(decimal values[3][SIMD_WIDTH]) const {
+        x.store(values[0]);
+        y.store(values[1]);
+        z.store(values[2]);
+    }
+};
+
+// Return the product of SIMD_WIDTH 3x3 matrices (stored row by row as nine rows of
+// SIMD_WIDTH decimals) with SIMD_WIDTH vectors. Same operations order as Matrix3x3 * Vector3.
+inline SimdVector3 multiply(const decimal matrix[9][SIMD_WIDTH], const SimdVector3& vector) {
+    SimdVector3 result;
+    result.x = SimdDecimal::load(matrix[0]) * vector.x + SimdDecimal::load(matrix[1]) * vector.y +
+               SimdDecimal::load(matrix[2]) * vector.z;
+    result.y = SimdDecimal::load(matrix[3]) * vector.x + SimdDecimal::load(matrix[4]) * vector.y +
+               SimdDecimal::load(matrix[5]) * vector.z;
+    result.z = SimdDecimal::load(matrix[6]) * vector.x + SimdDecimal::load(matrix[7]) * vector.y +
+               SimdDecimal::load(matrix[8]) * vector.z;
+    return result;
+}
+
+}
+
+#endif
@@ -31,6 +31,7 @@
 #include <reactphysics3d/memory/PoolAllocator.h>
 #include <reactphysics3d/memory/HeapAllocator.h>
 #include <reactphysics3d/memory/SingleFrameAllocator.h>
+#include <mutex>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -46,11 +47,41 @@ class MemoryAllocator;
  * The SingleFrameAllocator is used for memory that is allocated only during a frame and the PoolAllocator
  * is used to allocated objects of small size. Both SingleFrameAllocator and PoolAllocator will fall back to
  * HeapAllocator if an allocation request cannot be fulfilled.
+ * A thread that is bound to the memory manager (see bindCurrentThread()) gets its own cache of
+ * pool memory units and its own single frame arena so that it can allocate without locking.
  */
 class MemoryManager {
 
     private:
 
+       // Structure ThreadAllocators
+       /**
+        * Pool cache and single frame arena of a thread bound to the memory manager
+        */
+       struct ThreadAllocators {
+
+           /// Memory manager that owns the allocators
+           MemoryManager* memoryManager;
+
+           /// Cache of free memory units of the pool allocator
+           PoolAllocator::ThreadCache poolCache;
+
+           /// Arena of the single frame allocator
+           SingleFrameAllocator::Arena frameArena;
+
+           /// Allocators of the thread before it was bound to this memory manager
+           ThreadAllocators* previousThreadAllocators;
+
+           /// True if the allocators are used by a thread (protected by the mutex)
+           bool isBound;
+
+           /// Number of nested bindings of the thread that uses the allocators
+           uint nbBindings;
+
+           /// Next thread allocators of the memory manager
+           ThreadAllocators* next;
+       };
+
        /// Default malloc/free memory allocator
        DefaultAllocator mDefaultAllocator;
 
@@ -66,6 +97,15 @@ class MemoryManager {
        /// Single frame stack allocator
        SingleFrameAllocator mSingleFrameAllocator;
 
+       /// Mutex protecting the list of thread allocators
+       std::mutex mThreadAllocatorsMutex;
+
+       /// Linked-list of the allocators of the threads that have been bound to the memory manager
+       ThreadAllocators* mThreadAllocators;
+
+       /// Allocators of the calling thread (nullptr if the thread is not bound to a memory manager)
+       static thread_local ThreadAllocators* mCurrentThreadAllocators;
+
     public:
 
         /// Memory allocation types
@@ -80,7 +120,13 @@ class MemoryManager {
        MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory = 0);
 
        /// Destructor
-       ~MemoryManager() = default;
+       ~MemoryManager();
+
+       /// Deleted copy-constructor
+       MemoryManager(const MemoryManager& memoryManager) = delete;
+
+       /// Deleted assignment operator
+       MemoryManager& operator=(const MemoryManager& memoryManager) = delete;
 
         /// Allocate memory of a given type
         void* allocate(AllocationType allocationType, size_t size);
@@ -88,6 +134,9 @@ class MemoryManager {
         /// Release previously allocated memory.
         void release(AllocationType allocationType, void* pointer, size_t size);
 
+        /// Return the base allocator
+        MemoryAllocator& getBaseAllocator();
+
         /// Return the pool allocator
         PoolAllocator& getPoolAllocator();
 
@@ -99,6 +148,12 @@ class MemoryManager {
 
         /// Reset the single frame allocator
         void resetFrameAllocator();
+
+        /// Give the calling thread its own pool cache and single frame arena
+        void bindCurrentThread();
+
+        /// Undo the previous call to bindCurrentThread() from the calling thread
+        void unbindCurrentThread();
 };
 
 // Allocate memory of a given type
@@ -125,6 +180,11 @@ inline void MemoryManager::release(AllocationType allocationType, void* pointer,
     }
 }
 
+// Return the base allocator
+inline MemoryAllocator& MemoryManager::getBaseAllocator() {
+   return *mBaseAllocator;
+}
+
 // Return the pool allocator
 inline PoolAllocator& MemoryManager::getPoolAllocator() {
    return mPoolAllocator;
@@ -140,11 +200,6 @@ inline HeapAllocator& MemoryManager::getHeapAllocator() {
    return mHeapAllocator;
 }
 
-// Reset the single frame allocator
-inline void MemoryManager::resetFrameAllocator() {
-   mSingleFrameAllocator.reset();
-}
-
 }
 
 #endif
@@ -30,6 +30,7 @@
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/memory/MemoryAllocator.h>
 #include <mutex>
+#include <atomic>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -40,6 +41,9 @@ namespace reactphysics3d {
  * It allows us to allocate small blocks of memory (smaller or equal to 1024 bytes)
  * efficiently. This implementation is inspired by the small block allocator
  * described here : http://www.codeproject.com/useritems/Small_Block_Allocator.asp
+ * A thread can be given a cache of free memory units (see setCurrentThreadCache()).
+ * It then allocates and releases units without locking and only takes the mutex to
+ * exchange a whole magazine of units with the shared heaps when its cache is empty or full.
  */
 class PoolAllocator : public MemoryAllocator {
 
@@ -76,6 +80,8 @@ class PoolAllocator : public MemoryAllocator {
                 MemoryUnit* memoryUnits;
         };
 
+    public :
+
         // -------------------- Constants -------------------- //
 
         /// Number of heaps
@@ -90,6 +96,31 @@ class PoolAllocator : public MemoryAllocator {
         /// Size a memory chunk
         static const size_t BLOCK_SIZE = 16 * MAX_UNIT_SIZE;
 
+        /// Number of memory units exchanged at once between a thread cache and the shared heaps.
+        /// A thread cache holds at most twice this number of units per heap.
+        static const uint NB_UNITS_PER_MAGAZINE = 16;
+
+        // Structure ThreadCache
+        /**
+         * Free memory units owned by a single thread. It must be initialized with
+         * initThreadCache() and is only used by the allocator that initialized it.
+         */
+        struct ThreadCache {
+
+            public :
+
+                /// Allocator that owns the memory units of the cache
+                PoolAllocator* allocator;
+
+                /// Pointers to the first cached free memory unit for each heap
+                MemoryUnit* freeMemoryUnits[NB_HEAPS];
+
+                /// Number of cached free memory units for each heap
+                uint nbFreeMemoryUnits[NB_HEAPS];
+        };
+
+    private :
+
         // -------------------- Attributes -------------------- //
 
         /// Size of the memory units that each heap is responsible to allocate
@@ -102,6 +133,9 @@ class PoolAllocator : public MemoryAllocator {
         /// True if the mMapSizeToHeapIndex array has already been initialized
         static bool isMapSizeToHeadIndexInitialized;
 
+        /// Cache of the calling thread (nullptr if the thread has no cache)
+        static thread_local ThreadCache* mCurrentThreadCache;
+
         /// Mutex
         std::mutex mMutex;
 
@@ -125,9 +159,20 @@ class PoolAllocator : public MemoryAllocator {
         /// called and decreased by one when the release() method has been called.
         /// This variable is used in debug mode to check that the allocate() and release()
         /// methods are called the same number of times
-        int mNbTimesAllocateMethodCalled;
+        std::atomic<int> mNbTimesAllocateMethodCalled;
 #endif
 
+        // -------------------- Methods -------------------- //
+
+        /// Return a free memory unit of a given heap (the mutex must be locked)
+        MemoryUnit* allocateUnit(int indexHeap);
+
+        /// Move a magazine of free memory units from the shared heaps into a thread cache
+        void refillThreadCache(ThreadCache& cache, int indexHeap);
+
+        /// Move a number of free memory units of a heap from a thread cache back to the shared heaps
+        void flushThreadCache(ThreadCache& cache, int indexHeap, uint nbUnits);
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -147,8 +192,22 @@ class PoolAllocator : public MemoryAllocator {
 
         /// Release previously allocated memory.
         virtual void release(void* pointer, size_t size) override;
+
+        /// Initialize an empty cache of free memory units for this allocator
+        void initThreadCache(ThreadCache& cache);
+
+        /// Give all the memory units of a thread cache back to the shared heaps
+        void flushThreadCache(ThreadCache& cache);
+
+        /// Set the cache used by the calling thread (nullptr to use the shared heaps under the mutex)
+        static void setCurrentThreadCache(ThreadCache* cache);
 };
 
+// Set the cache used by the calling thread
+inline void PoolAllocator::setCurrentThreadCache(ThreadCache* cache) {
+    mCurrentThreadCache = cache;
+}
+
 }
 
 #endif
@@ -38,9 +38,70 @@ namespace reactphysics3d {
 /**
  * This class represent a memory allocator used to efficiently allocate
  * memory on the heap that is used during a single frame.
+ * The memory is taken linearly from an arena. A thread can be given its own arena
+ * (see setCurrentThreadArena()) that it uses without locking. The other threads share
+ * the arena of the allocator under a mutex. When an arena is full, the memory is taken
+ * from the base allocator and is kept until the next reset so that the memory can be
+ * released by any thread.
  */
 class SingleFrameAllocator : public MemoryAllocator {
 
+    public :
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Structure OverflowBlock
+        /**
+         * Header of a memory allocation that did not fit into an arena
+         */
+        struct OverflowBlock {
+
+            public :
+
+                /// Next overflow block of the arena
+                OverflowBlock* next;
+
+                /// Size (in bytes) of the block including this header
+                size_t sizeBytes;
+        };
+
+        // Structure Arena
+        /**
+         * Linear memory buffer of the allocator. It must be initialized with initArena()
+         * and is only used by the allocator that initialized it.
+         */
+        struct Arena {
+
+            public :
+
+                /// Allocator that owns the arena
+                SingleFrameAllocator* allocator;
+
+                /// Total size (in bytes) of memory of the arena
+                size_t totalSizeBytes;
+
+                /// Pointer to the beginning of the allocated memory block
+                char* memoryBufferStart;
+
+                /// Pointer to the next available memory location in the buffer
+                size_t currentOffset;
+
+                /// Allocations that did not fit into the buffer during the current frame
+                OverflowBlock* overflowBlocks;
+
+                /// Current number of frames since we detected too much memory
+                /// is allocated
+                size_t nbFramesTooMuchAllocated;
+
+                /// True if we need to allocate more memory in the next reset() call
+                bool needToAllocatedMore;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Initial size (in bytes) of the arena of a thread
+        static const size_t INIT_THREAD_ARENA_NB_BYTES = 65536; // 64Kb
+
     private :
 
         // -------------------- Constants -------------------- //
@@ -60,21 +121,16 @@ class SingleFrameAllocator : public MemoryAllocator {
         /// Reference to the base memory allocator
         MemoryAllocator& mBaseAllocator;
 
-        /// Total size (in bytes) of memory of the allocator
-        size_t mTotalSizeBytes;
-
-        /// Pointer to the beginning of the allocated memory block
-        char* mMemoryBufferStart;
+        /// Arena shared by the threads that do not have their own arena
+        Arena mArena;
 
-        /// Pointer to the next available memory location in the buffer
-        size_t mCurrentOffset;
+        /// Arena of the calling thread (nullptr if the thread has no arena)
+        static thread_local Arena* mCurrentThreadArena;
 
-        /// Current number of frames since we detected too much memory
-        /// is allocated
-        size_t mNbFramesTooMuchAllocated;
+        // -------------------- Methods -------------------- //
 
-        /// True if we need to allocate more memory in the next reset() call
-        bool mNeedToAllocatedMore;
+        /// Allocate memory of a given size (in bytes) from an arena
+        void* allocate(Arena& arena, size_t size);
 
     public :
 
@@ -97,8 +153,25 @@ class SingleFrameAllocator : public MemoryAllocator {
 
         /// Reset the marker of the current allocated memory
         virtual void reset();
+
+        /// Initialize an arena of a given initial size for this allocator
+        void initArena(Arena& arena, size_t initSizeBytes);
+
+        /// Reset the marker of an arena and release its overflow blocks
+        void resetArena(Arena& arena);
+
+        /// Release the memory of an arena
+        void destroyArena(Arena& arena);
+
+        /// Set the arena used by the calling thread (nullptr to use the shared arena under the mutex)
+        static void setCurrentThreadArena(Arena* arena);
 };
 
+// Set the arena used by the calling thread
+inline void SingleFrameAllocator::setCurrentThreadArena(Arena* arena) {
+    mCurrentThreadArena = arena;
+}
+
 }
 
 #endif
@@ -28,6 +28,8 @@
 
 // Libraries
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/broadphase/DynamicWideAABBTree.h>
+#include <reactphysics3d/collision/broadphase/SweepAndPrune.h>
 #include <reactphysics3d/containers/LinkedList.h>
 #include <reactphysics3d/containers/Set.h>
 #include <reactphysics3d/components/ColliderComponents.h>
@@ -45,6 +47,8 @@ class CollisionBody;
 class Collider;
 class MemoryManager;
 class Profiler;
+class ThreadPool;
+struct RaycastBatchHit;
 
 // class AABBOverlapCallback
 class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
@@ -66,26 +70,36 @@ class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
 
 // Class BroadPhaseRaycastCallback
 /**
- * Callback called when the AABB of a leaf node is hit by a ray the
- * broad-phase Dynamic AABB Tree.
+ * Callback called when the AABB of a leaf node is hit by a ray in the
+ * broad-phase tree.
  */
 class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
 
     private :
 
-        const DynamicAABBTree& mDynamicAABBTree;
+        const BroadPhaseSystem& mBroadPhaseSystem;
 
         unsigned short mRaycastWithCategoryMaskBits;
 
         RaycastTest& mRaycastTest;
 
+        /// True if the nodes are the ones of the static AABB tree
+        bool mIsStaticTree;
+
+        /// Smallest positive hit fraction returned by the raycast tests
+        decimal mSmallestHitFraction;
+
+        /// True if a raycast test has asked to stop the raycasting
+        bool mIsRaycastStopped;
+
     public:
 
         // Constructor
-        BroadPhaseRaycastCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
-                                  RaycastTest& raycastTest)
-            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
-              mRaycastTest(raycastTest) {
+        BroadPhaseRaycastCallback(const BroadPhaseSystem& broadPhaseSystem, unsigned short raycastWithCategoryMaskBits,
+                                  RaycastTest& raycastTest, bool isStaticTree)
+            : mBroadPhaseSystem(broadPhaseSystem), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+              mRaycastTest(raycastTest), mIsStaticTree(isStaticTree), mSmallestHitFraction(DECIMAL_LARGEST),
+              mIsRaycastStopped(false) {
 
         }
 
@@ -95,6 +109,93 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
         // Called for a broad-phase shape that has to be tested for raycast
         virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override;
 
+        // Return the smallest positive hit fraction returned by the raycast tests
+        decimal getSmallestHitFraction() const {
+            return mSmallestHitFraction;
+        }
+
+        // Return true if a raycast test has asked to stop the raycasting
+        bool isRaycastStopped() const {
+            return mIsRaycastStopped;
+        }
+
+};
+
+// Class BroadPhaseRaycastBatchCallback
+/**
+ * Callback called when the AABB of a leaf node is hit by a ray of a batch
+ * raycast in the broad-phase. It keeps the closest hit of each ray of the
+ * current packet of rays instead of calling a user callback.
+ */
+class BroadPhaseRaycastBatchCallback : public DynamicAABBTreeRaycastPacketCallback {
+
+    private :
+
+        const BroadPhaseSystem& mBroadPhaseSystem;
+
+        unsigned short mRaycastWithCategoryMaskBits;
+
+        /// Allocator for the temporary memory of the raycasts against the colliders
+        MemoryAllocator& mAllocator;
+
+        /// Closest hits of the rays of the current packet
+        RaycastBatchHit* mHits;
+
+        /// True if the nodes are the ones of the static AABB tree
+        bool mIsStaticTree;
+
+    public:
+
+        // Constructor
+        BroadPhaseRaycastBatchCallback(const BroadPhaseSystem& broadPhaseSystem, unsigned short raycastWithCategoryMaskBits,
+                                       MemoryAllocator& allocator)
+            : mBroadPhaseSystem(broadPhaseSystem), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+              mAllocator(allocator), mHits(nullptr), mIsStaticTree(false) {
+
+        }
+
+        // Destructor
+        virtual ~BroadPhaseRaycastBatchCallback() override = default;
+
+        // Set the closest hits of the current packet of rays and the tree that is raycast
+        void setPacket(RaycastBatchHit* hits, bool isStaticTree) {
+            mHits = hits;
+            mIsStaticTree = isStaticTree;
+        }
+
+        // Called for a broad-phase shape that has to be tested for raycast with a ray of the packet
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, uint rayIndex, const Ray& ray) override;
+};
+
+// Class BroadPhaseRaycastBatchRayCallback
+/**
+ * Callback used to raycast a single ray of a batch in the broad-phase data
+ * structures that do not traverse packets of rays.
+ */
+class BroadPhaseRaycastBatchRayCallback : public DynamicAABBTreeRaycastCallback {
+
+    private :
+
+        BroadPhaseRaycastBatchCallback& mBatchCallback;
+
+        /// Index of the ray in the current packet of rays
+        uint mRayIndex;
+
+    public:
+
+        // Constructor
+        BroadPhaseRaycastBatchRayCallback(BroadPhaseRaycastBatchCallback& batchCallback, uint rayIndex)
+            : mBatchCallback(batchCallback), mRayIndex(rayIndex) {
+
+        }
+
+        // Destructor
+        virtual ~BroadPhaseRaycastBatchRayCallback() override = default;
+
+        // Called for a broad-phase shape that has to be tested for raycast
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override {
+            return mBatchCallback.raycastBroadPhaseShape(nodeId, mRayIndex, ray);
+        }
 };
 
 // Class BroadPhaseSystem
@@ -103,17 +204,47 @@ class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
  * goal of the broad-phase collision detection is to compute the pairs of colliders
  * that have their AABBs overlapping. Only those pairs of bodies will be tested
  * later for collision during the narrow-phase collision detection. A dynamic AABB
- * tree data structure is used for fast broad-phase collision detection.
+ * tree data structure (binary or wide) or a sweep and prune is used for fast
+ * broad-phase collision detection (see BroadPhaseType). With the AABB trees, the
+ * colliders of the static bodies are stored in a separate AABB tree that is rebuilt
+ * with the surface area heuristic when it changes. This tree is only queried with the
+ * moved non-static colliders (there are no pairs of static colliders) and keeps the
+ * static colliders out of the tree that is updated every frame. The broad-phase ID of
+ * a collider is its ID in its data structure shifted by one bit, the lowest bit being
+ * one for the colliders of the static AABB tree.
  */
 class BroadPhaseSystem {
 
     protected :
 
+        // -------------------- Constants -------------------- //
+
+        /// Number of colliders whose AABB is recomputed by each parallel task
+        static const uint32 NB_COLLIDERS_PER_TASK;
+
+        /// Number of moved colliders tested for overlap by each parallel task
+        static const uint32 NB_SHAPES_PER_OVERLAP_TASK;
+
         // -------------------- Attributes -------------------- //
 
         /// Dynamic AABB tree
         DynamicAABBTree mDynamicAABBTree;
 
+        /// Dynamic wide AABB tree
+        DynamicWideAABBTree mDynamicWideAABBTree;
+
+        /// Sweep and prune
+        SweepAndPrune mSweepAndPrune;
+
+        /// Dynamic AABB tree with the colliders of the static bodies
+        DynamicAABBTree mStaticAABBTree;
+
+        /// True if the static AABB tree has changed since it has been rebuilt
+        bool mIsStaticTreeModified;
+
+        /// Data structure used to store the colliders
+        BroadPhaseType mBroadPhaseType;
+
         /// Reference to the colliders components
         ColliderComponents& mCollidersComponents;
 
@@ -146,6 +277,23 @@ class BroadPhaseSystem {
         /// Update the broad-phase state of some colliders components
         void updateCollidersComponents(uint32 startIndex, uint32 nbItems, decimal timeStep);
 
+        /// Compute the world-space AABB of the colliders components in [startIndex, endIndex) and
+        /// whether their broad-phase data structure has to be updated
+        void computeCollidersAABBs(uint32 startIndex, uint32 endIndex, decimal timeStep, AABB* aabbs, bool* isUpdateNeeded,
+                                   bool* isReInsertForced);
+
+        /// Enlarge the AABB of a collider of a body with continuous collision detection by the motion of the body during a step
+        void addContinuousMotion(Entity bodyEntity, decimal timeStep, AABB& aabb) const;
+
+        /// Report the pairs of colliders overlapping with the moved colliders in [startIndex, endIndex)
+        void reportOverlappingPairs(const List<int32>& shapesToTest, uint startIndex, uint endIndex,
+                                    List<Pair<int32, int32>>& outOverlappingNodes,
+                                    List<Pair<int32, int32>>& outStaticOverlappingNodes,
+                                    MemoryAllocator& allocator) const;
+
+        /// Return true if a collider has to be stored in the static AABB tree
+        bool isColliderInStaticTree(Collider* collider) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -169,11 +317,17 @@ class BroadPhaseSystem {
         /// Remove a collider from the broad-phase collision detection
         void removeCollider(Collider* collider);
 
+        /// Return the data structure used to store the colliders
+        BroadPhaseType getBroadPhaseType() const;
+
+        /// Set the data structure used to store the colliders (before any collider is added)
+        void setBroadPhaseType(BroadPhaseType broadPhaseType);
+
         /// Update the broad-phase state of a single collider
         void updateCollider(Entity colliderEntity, decimal timeStep);
 
         /// Update the broad-phase state of all the enabled colliders
-        void updateColliders(decimal timeStep);
+        void updateColliders(decimal timeStep, ThreadPool* threadPool = nullptr);
 
         /// Add a collider in the array of colliders that have moved in the last simulation step
         /// and that need to be tested again for broad-phase overlapping.
@@ -184,7 +338,11 @@ class BroadPhaseSystem {
         void removeMovedCollider(int broadPhaseID);
 
         /// Compute all the overlapping pairs of collision shapes
-        void computeOverlappingPairs(MemoryManager& memoryManager, List<Pair<int32, int32>>& overlappingNodes);
+        void computeOverlappingPairs(MemoryManager& memoryManager, List<Pair<int32, int32>>& overlappingNodes,
+                                     ThreadPool* threadPool = nullptr);
+
+        /// Report the broad-phase IDs of all the colliders with a fat AABB overlapping a given AABB
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int>& overlappingBroadPhaseIds) const;
 
         /// Return the collider corresponding to the broad-phase node id in parameter
         Collider* getColliderForBroadPhaseId(int broadPhaseId) const;
@@ -198,6 +356,19 @@ class BroadPhaseSystem {
         /// Ray casting method
         void raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Ray casting method for a batch of rays that returns the closest hit of each ray
+        void raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                          unsigned short raycastWithCategoryMaskBits, MemoryAllocator& allocator) const;
+
+        /// Return true if a broad-phase ID is the one of a collider of the static AABB tree
+        static bool isStaticBroadPhaseId(int broadPhaseId);
+
+        /// Return the ID of a collider in its broad-phase data structure
+        static int32 getNodeId(int broadPhaseId);
+
+        /// Return the broad-phase ID of a collider from its ID in its broad-phase data structure
+        static int computeBroadPhaseId(int32 nodeId, bool isInStaticTree);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -209,7 +380,36 @@ class BroadPhaseSystem {
 
 // Return the fat AABB of a given broad-phase shape
 inline const AABB& BroadPhaseSystem::getFatAABB(int broadPhaseId) const  {
-    return mDynamicAABBTree.getFatAABB(broadPhaseId);
+    const int32 nodeId = getNodeId(broadPhaseId);
+    if (isStaticBroadPhaseId(broadPhaseId)) return mStaticAABBTree.getFatAABB(nodeId);
+    switch (mBroadPhaseType) {
+        case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: return mDynamicWideAABBTree.getFatAABB(nodeId);
+        case BroadPhaseType::SWEEP_AND_PRUNE: return mSweepAndPrune.getFatAABB(nodeId);
+        default: return mDynamicAABBTree.getFatAABB(nodeId);
+    }
+}
+
+// Return true if a broad-phase ID is the one of a collider of the static AABB tree
+inline bool BroadPhaseSystem::isStaticBroadPhaseId(int broadPhaseId) {
+    assert(broadPhaseId >= 0);
+    return (broadPhaseId & 1) != 0;
+}
+
+// Return the ID of a collider in its broad-phase data structure
+inline int32 BroadPhaseSystem::getNodeId(int broadPhaseId) {
+    assert(broadPhaseId >= 0);
+    return broadPhaseId >> 1;
+}
+
+// Return the broad-phase ID of a collider from its ID in its broad-phase data structure
+inline int BroadPhaseSystem::computeBroadPhaseId(int32 nodeId, bool isInStaticTree) {
+    assert(nodeId >= 0);
+    return (nodeId << 1) | (isInStaticTree ? 1 : 0);
+}
+
+// Return the data structure used to store the colliders
+inline BroadPhaseType BroadPhaseSystem::getBroadPhaseType() const {
+    return mBroadPhaseType;
 }
 
 // Remove a collider from the array of colliders that have moved in the last simulation step
@@ -222,7 +422,13 @@ inline void BroadPhaseSystem::removeMovedCollider(int broadPhaseID) {
 
 // Return the collider corresponding to the broad-phase node id in parameter
 inline Collider* BroadPhaseSystem::getColliderForBroadPhaseId(int broadPhaseId) const {
-    return static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(broadPhaseId));
+    const int32 nodeId = getNodeId(broadPhaseId);
+    if (isStaticBroadPhaseId(broadPhaseId)) return static_cast<Collider*>(mStaticAABBTree.getNodeDataPointer(nodeId));
+    switch (mBroadPhaseType) {
+        case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: return static_cast<Collider*>(mDynamicWideAABBTree.getNodeDataPointer(nodeId));
+        case BroadPhaseType::SWEEP_AND_PRUNE: return static_cast<Collider*>(mSweepAndPrune.getNodeDataPointer(nodeId));
+        default: return static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
+    }
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -231,6 +437,9 @@ inline Collider* BroadPhaseSystem::getColliderForBroadPhaseId(int broadPhaseId)
 inline void BroadPhaseSystem::setProfiler(Profiler* profiler) {
 	mProfiler = profiler;
 	mDynamicAABBTree.setProfiler(profiler);
+	mDynamicWideAABBTree.setProfiler(profiler);
+	mSweepAndPrune.setProfiler(profiler);
+	mStaticAABBTree.setProfiler(profiler);
 }
 
 #endif
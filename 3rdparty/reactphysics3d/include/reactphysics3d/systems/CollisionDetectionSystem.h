@@ -52,10 +52,14 @@ class PhysicsWorld;
 class CollisionCallback;
 class OverlapCallback;
 class RaycastCallback;
+struct RaycastBatchHit;
+struct ShapeCastInfo;
+class ConvexShape;
 class ContactPoint;
 class MemoryManager;
 class EventListener;
 class CollisionDispatch;
+class ThreadPool;
 
 // Class CollisionDetectionSystem
 /**
@@ -75,6 +79,27 @@ class CollisionDetectionSystem {
         /// Maximum number of contact points in a reduced contact manifold
         static const int8 MAX_CONTACT_POINTS_IN_MANIFOLD = 4;
 
+        /// Maximum number of narrow-phase tests executed by a single task of the thread pool
+        static const uint NB_MAX_NARROW_PHASE_TESTS_PER_TASK = 32;
+
+        // -------------------- Structures -------------------- //
+
+        // Structure NarrowPhaseTask
+        /**
+         * Range of narrow-phase tests of a batch executed by a single task of the thread pool
+         */
+        struct NarrowPhaseTask {
+
+            /// Narrow-phase algorithm (and batch) of the tests
+            NarrowPhaseAlgorithmType algorithmType;
+
+            /// Index of the first test in the batch
+            uint batchStartIndex;
+
+            /// Number of tests
+            uint batchNbItems;
+        };
+
         // -------------------- Attributes -------------------- //
 
         /// Memory manager
@@ -163,8 +188,8 @@ class CollisionDetectionSystem {
         /// Pointer to the contact points of the current frame (either mContactPoints1 or mContactPoints2)
         List<ContactPoint>* mCurrentContactPoints;
 
-        /// Map a body entity to the list of contact pairs in which it is involved
-        Map<Entity, List<uint>> mMapBodyToContactPairs;
+        /// Pool of worker threads used to execute the broad-phase and the narrow-phase tests in parallel (null if disabled)
+        ThreadPool* mThreadPool;
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -186,7 +211,7 @@ class CollisionDetectionSystem {
                                                  bool reportContacts);
 
         /// Compute the narrow-phase collision detection
-        void computeNarrowPhase();
+        void computeNarrowPhase(decimal timeStep);
 
         /// Compute the narrow-phase collision detection for the testOverlap() methods.
         bool computeNarrowPhaseOverlapSnapshot(NarrowPhaseInput& narrowPhaseInput, OverlapCallback* callback);
@@ -211,7 +236,12 @@ class CollisionDetectionSystem {
         void addLostContactPair(uint64 overlappingPairIndex);
 
         /// Execute the narrow-phase collision detection algorithm on batches
-        bool testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator);
+        bool testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator,
+                                      ThreadPool* threadPool = nullptr);
+
+        /// Execute the narrow-phase collision detection algorithm on a range of tests of a batch
+        bool testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, NarrowPhaseAlgorithmType algorithmType, uint batchStartIndex,
+                                      uint batchNbItems, bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator);
 
         /// Compute the concave vs convex middle-phase algorithm for a given pair of bodies
         void computeConvexVsConcaveMiddlePhase(uint64 pairIndex, MemoryAllocator& allocator,
@@ -225,13 +255,17 @@ class CollisionDetectionSystem {
                                       bool updateLastFrameInfo, List<ContactPointInfo>& potentialContactPoints,
                                       Map<uint64, uint>* mapPairIdToContactPairIndex,
                                       List<ContactManifoldInfo>& potentialContactManifolds, List<ContactPair>* contactPairs,
-                                      Map<Entity, List<uint>>& mapBodyToContactPairs);
+                                      decimal speculativeTimeStep);
 
         /// Process the potential contacts after narrow-phase collision detection
         void processAllPotentialContacts(NarrowPhaseInput& narrowPhaseInput, bool updateLastFrameInfo, List<ContactPointInfo>& potentialContactPoints,
                                          Map<uint64, uint>* mapPairIdToContactPairIndex,
                                          List<ContactManifoldInfo>& potentialContactManifolds, List<ContactPair>* contactPairs,
-                                         Map<Entity, List<uint>>& mapBodyToContactPairs);
+                                         decimal speculativeTimeStep);
+
+        /// Add a speculative contact point to a pair of colliders that do not collide if a body with continuous
+        /// collision detection reaches the other collider during the step
+        bool computeSpeculativeContact(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint index, decimal timeStep) const;
 
         /// Reduce the potential contact manifolds and contact points of the overlapping pair contacts
         void reducePotentialContactManifolds(List<ContactPair>* contactPairs, List<ContactManifoldInfo>& potentialContactManifolds,
@@ -279,6 +313,26 @@ class CollisionDetectionSystem {
         /// Create the actual contact manifolds and contacts points (from potential contacts) for a given contact pair
         void createContacts();
 
+        /// Sweep a convex shape along a translation and report the first collider hit
+        bool castConvexShape(const ConvexShape* shape, const Transform& transform, const Vector3& translation,
+                             ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits,
+                             const CollisionBody* ignoredBody, const Collider* castCollider) const;
+
+        /// Compute the world transform from which a collider is swept during the current step and the translation of its body
+        void computeColliderStepSweep(Entity colliderEntity, Transform& outTransform, Vector3& outTranslation) const;
+
+        /// Return true if the hit of a collider at the start of its translation has to be ignored by the continuous collision detection
+        bool isContinuousStartHitIgnored(const Collider* castCollider, const Collider* collider,
+                                         const Vector3& translation, const Vector3& hitNormal) const;
+
+        /// Return true if a hit during the step has to be ignored by the continuous collision detection
+        bool isContinuousEndHitIgnored(const ConvexShape* shape, const Transform& transform, const Vector3& translation,
+                                       const CollisionShape* hitShape, const Transform& hitShapeTransform,
+                                       const Vector3& hitBodyTranslation, decimal hitFraction, const Vector3& hitNormal) const;
+
+        /// Return true if a body is an enabled dynamic body with continuous collision detection
+        bool isContinuousBody(Entity bodyEntity) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -328,12 +382,25 @@ class CollisionDetectionSystem {
         void reportContactsAndTriggers();
 
         /// Compute the collision detection
-        void computeCollisionDetection();
+        void computeCollisionDetection(decimal timeStep);
 
         /// Ray casting method
         void raycast(RaycastCallback* raycastCallback, const Ray& ray,
                      unsigned short raycastWithCategoryMaskBits) const;
 
+        /// Ray casting method for a batch of rays that returns the closest hit of each ray
+        void raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                          unsigned short raycastWithCategoryMaskBits) const;
+
+        /// Sweep a convex collision shape along a translation and report the first collider hit
+        bool shapeCast(const CollisionShape* shape, const Transform& transform, const Vector3& translation,
+                       ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits,
+                       const CollisionBody* ignoredBody) const;
+
+        /// Compute the time of impact of a collider moved by the current step (for continuous collision detection)
+        bool computeTimeOfImpact(Entity colliderEntity, decimal& outHitFraction, Vector3& outHitNormal,
+                                 Vector3& outHitBodyTranslation) const;
+
         /// Return true if two bodies (collide) overlap
         bool testOverlap(CollisionBody* body1, CollisionBody* body2);
 
@@ -361,6 +428,12 @@ class CollisionDetectionSystem {
         /// Return the world event listener
         EventListener* getWorldEventListener();
 
+        /// Set the pool of worker threads used to execute the broad-phase and the narrow-phase tests in parallel (null to disable)
+        void setThreadPool(ThreadPool* threadPool);
+
+        /// Set the data structure used by the broad-phase (before any collider is created)
+        void setBroadPhaseType(BroadPhaseType algorithm);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -428,6 +501,16 @@ inline MemoryManager& CollisionDetectionSystem::getMemoryManager() const {
     return mMemoryManager;
 }
 
+// Set the pool of worker threads used to execute the broad-phase and the narrow-phase tests in parallel (null to disable)
+inline void CollisionDetectionSystem::setThreadPool(ThreadPool* threadPool) {
+    mThreadPool = threadPool;
+}
+
+// Set the data structure used by the broad-phase (before any collider is created)
+inline void CollisionDetectionSystem::setBroadPhaseType(BroadPhaseType algorithm) {
+    mBroadPhaseSystem.setBroadPhaseType(algorithm);
+}
+
 // Update a collider (that has moved for instance)
 inline void CollisionDetectionSystem::updateCollider(Entity colliderEntity, decimal timeStep) {
 
@@ -437,7 +520,7 @@ inline void CollisionDetectionSystem::updateCollider(Entity colliderEntity, deci
 
 // Update all the enabled colliders
 inline void CollisionDetectionSystem::updateColliders(decimal timeStep) {
-    mBroadPhaseSystem.updateColliders(timeStep);
+    mBroadPhaseSystem.updateColliders(timeStep, mThreadPool);
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
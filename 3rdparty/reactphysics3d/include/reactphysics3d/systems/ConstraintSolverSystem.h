@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/mathematics/mathematics.h>
+#include <reactphysics3d/containers/List.h>
 #include <reactphysics3d/systems/SolveBallAndSocketJointSystem.h>
 #include <reactphysics3d/systems/SolveFixedJointSystem.h>
 #include <reactphysics3d/systems/SolveHingeJointSystem.h>
@@ -44,6 +45,9 @@ class Profiler;
 class RigidBodyComponents;
 class JointComponents;
 class DynamicsComponents;
+class MemoryManager;
+class ThreadPool;
+enum class JointType;
 
 // Structure ConstraintSolverData
 /**
@@ -147,6 +151,45 @@ class ConstraintSolverSystem {
 
     private :
 
+        // Structure ColoredJoint
+        /**
+         * Joint solved by the colors of joints
+         */
+        struct ColoredJoint {
+
+            /// Type of the joint
+            JointType type;
+
+            /// Index of the joint in the components of its type
+            uint32 componentIndex;
+        };
+
+        // Structure JointColor
+        /**
+         * Range of the joints of a color in the array of colored joints. The joints of a color
+         * do not share any body so that they can be solved in parallel.
+         */
+        struct JointColor {
+
+            /// Index of the first joint of the color in the array of colored joints
+            uint32 coloredJointsIndex;
+
+            /// Number of joints of the color
+            uint32 nbColoredJoints;
+
+            /// True if the joints of the color may share bodies (joints that did not
+            /// fit in any other color). Those joints are solved serially.
+            bool isOverflow;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of colors of joints without shared bodies
+        static const uint32 NB_MAX_COLORS;
+
+        /// Number of joints of a color solved by each parallel task
+        static const uint32 NB_JOINTS_PER_COLOR_TASK;
+
         // -------------------- Attributes -------------------- //
 
         /// Current time step
@@ -173,18 +216,50 @@ class ConstraintSolverSystem {
         /// Solver for the SliderJoint constraints
         SolveSliderJointSystem mSolveSliderJointSystem;
 
+        /// Reference to the ball-and-socket joint components
+        BallAndSocketJointComponents& mBallAndSocketJointComponents;
+
+        /// Reference to the fixed joint components
+        FixedJointComponents& mFixedJointComponents;
+
+        /// Reference to the hinge joint components
+        HingeJointComponents& mHingeJointComponents;
+
+        /// Reference to the slider joint components
+        SliderJointComponents& mSliderJointComponents;
+
+        /// Minimum number of enabled joints to color the joints (zero to never color them)
+        uint32 mColoringThreshold;
+
+        /// Joints sorted by color
+        List<ColoredJoint> mColoredJoints;
+
+        /// Colors of the joints (empty if the joints are not colored in this frame)
+        List<JointColor> mColors;
+
+        /// Colors already used by the joints of each body (bit field indexed by rigid body component)
+        List<uint32> mBodiesColors;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
 		Profiler* mProfiler;
 #endif
 
+        // -------------------- Methods -------------------- //
+
+        /// Color the enabled joints such that the joints of a color do not share any body
+        void colorJoints();
+
+        /// Solve the velocity constraint of a colored joint
+        void solveVelocityConstraint(const ColoredJoint& coloredJoint);
+
     public :
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ConstraintSolverSystem(PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
+        ConstraintSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
                                TransformComponents& transformComponents,
                                JointComponents& jointComponents,
                                BallAndSocketJointComponents& ballAndSocketJointComponents,
@@ -200,6 +275,9 @@ class ConstraintSolverSystem {
         /// Solve the constraints
         void solveVelocityConstraints();
 
+        /// Solve the constraints with the colors of joints solved in parallel
+        void solveVelocityConstraints(ThreadPool& threadPool);
+
         /// Solve the position constraints
         void solvePositionConstraints();
 
@@ -209,6 +287,15 @@ class ConstraintSolverSystem {
         /// Enable/Disable the Non-Linear-Gauss-Seidel position correction technique.
         void setIsNonLinearGaussSeidelPositionCorrectionActive(bool isActive);
 
+        /// Return the minimum number of enabled joints to color the joints (zero if disabled)
+        uint32 getColoringThreshold() const;
+
+        /// Set the minimum number of enabled joints to color the joints (zero to disable)
+        void setColoringThreshold(uint32 threshold);
+
+        /// Return the number of colors of the joints in this frame (zero if they are not colored)
+        uint32 getNbColors() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -221,6 +308,21 @@ class ConstraintSolverSystem {
         friend class HingeJoint;
 };
 
+// Return the minimum number of enabled joints to color the joints (zero if disabled)
+inline uint32 ConstraintSolverSystem::getColoringThreshold() const {
+    return mColoringThreshold;
+}
+
+// Set the minimum number of enabled joints to color the joints (zero to disable)
+inline void ConstraintSolverSystem::setColoringThreshold(uint32 threshold) {
+    mColoringThreshold = threshold;
+}
+
+// Return the number of colors of the joints in this frame (zero if they are not colored)
+inline uint32 ConstraintSolverSystem::getNbColors() const {
+    return mColors.size();
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -49,6 +49,46 @@ class CollisionBodyComponents;
 class DynamicsComponents;
 class RigidBodyComponents;
 class ColliderComponents;
+class ThreadPool;
+
+// Structure ContactSolverParity
+/**
+ * Largest differences between the accumulated impulses computed by the SIMD and the scalar
+ * contact solvers on the same contacts (see PhysicsWorld::enableContactSolverParityCheck()).
+ * The largest impulses are also stored so that the differences can be compared to them.
+ */
+struct ContactSolverParity {
+
+    /// Number of contact manifolds solved by both solvers
+    uint nbContactManifolds = 0;
+
+    /// Number of contact points solved by both solvers
+    uint nbContactPoints = 0;
+
+    /// Largest difference of accumulated penetration impulse of a contact point
+    decimal maxPenetrationImpulseError = decimal(0.0);
+
+    /// Largest difference of accumulated friction impulse (both directions) of a contact manifold
+    decimal maxFrictionImpulseError = decimal(0.0);
+
+    /// Largest difference of accumulated twist friction impulse of a contact manifold
+    decimal maxTwistImpulseError = decimal(0.0);
+
+    /// Largest difference of accumulated rolling resistance impulse (any component) of a contact manifold
+    decimal maxRollingResistanceImpulseError = decimal(0.0);
+
+    /// Largest accumulated penetration impulse
+    decimal maxPenetrationImpulse = decimal(0.0);
+
+    /// Largest accumulated friction impulse
+    decimal maxFrictionImpulse = decimal(0.0);
+
+    /// Largest accumulated twist friction impulse
+    decimal maxTwistImpulse = decimal(0.0);
+
+    /// Largest accumulated rolling resistance impulse
+    decimal maxRollingResistanceImpulse = decimal(0.0);
+};
 
 // Class ContactSolverSystem
 /**
@@ -118,6 +158,12 @@ class ColliderComponents;
  * constraints at the center of the contact manifold, we need two constraints for tangential
  * friction but also another twist friction constraint to prevent spin of the body around the
  * contact manifold center.
+ *
+ * When the SIMD solver is enabled, the contact manifolds are also packed into batches of
+ * SIMD_WIDTH manifolds (one per lane) that are solved in lockstep. A manifold is always put
+ * in a batch after all the batches containing a previous manifold with one of its non-static
+ * bodies. The constraints of each body are therefore still solved in the same order and the
+ * result is the same as with the scalar solver.
  */
 class ContactSolverSystem {
 
@@ -268,8 +314,106 @@ class ContactSolverSystem {
 
             /// Number of contact points
             int8 nbContacts;
+
+            /// True if body 1 is static. A static body can be shared between islands so
+            /// its velocities are never written by the solver.
+            bool isBody1Static;
+
+            /// True if body 2 is static
+            bool isBody2Static;
+        };
+
+        // Structure ContactSolverIsland
+        /**
+         * Range of the contact constraints of an island in the solver arrays
+         */
+        struct ContactSolverIsland {
+
+            /// Index of the first contact manifold of the island in the solver
+            uint contactManifoldsIndex;
+
+            /// Number of contact manifolds of the island
+            uint nbContactManifolds;
+
+            /// Index of the first contact point of the island in the solver
+            uint contactPointsIndex;
+
+            /// Index of the first color of the island (if its contacts have been colored)
+            uint colorsIndex;
+
+            /// Number of colors of the island (zero if its contacts have not been colored)
+            uint nbColors;
         };
 
+        // Structure ContactSolverColor
+        /**
+         * Range of the contact constraints of a color of a large island. The contact manifolds
+         * of a color do not share any non-static body so that they can be solved in parallel.
+         */
+        struct ContactSolverColor {
+
+            /// Index of the first contact manifold of the color in the solver
+            uint contactManifoldsIndex;
+
+            /// Number of contact manifolds of the color
+            uint nbContactManifolds;
+
+            /// Index of the first contact point of the color in the solver
+            uint contactPointsIndex;
+
+            /// Index of the first contact manifold batch of the color (SIMD solver)
+            uint contactManifoldBatchesIndex;
+
+            /// Number of contact manifold batches of the color (SIMD solver)
+            uint nbContactManifoldBatches;
+
+            /// Index of the first task of the color
+            uint tasksIndex;
+
+            /// Number of tasks of the color
+            uint nbTasks;
+
+            /// True if the contact manifolds of the color may share bodies (manifolds that
+            /// did not fit in any other color). This color is solved by a single task.
+            bool isOverflow;
+        };
+
+        // Structure ContactColorTask
+        /**
+         * Range of contact manifolds (or contact manifold batches with the SIMD solver) of a
+         * color solved by a single task
+         */
+        struct ContactColorTask {
+
+            /// Index of the first contact manifold (or batch) of the task
+            uint startIndex;
+
+            /// Index after the last contact manifold (or batch) of the task
+            uint endIndex;
+
+            /// Index of the first contact point of the task (scalar solver)
+            uint contactPointsIndex;
+        };
+
+        // Structure ContactBatchGroup
+        /**
+         * Range of the contact manifold batches built from consecutive islands. With the SIMD
+         * solver, the groups are solved in parallel instead of the islands.
+         */
+        struct ContactBatchGroup {
+
+            /// Index of the first contact manifold batch of the group
+            uint contactManifoldBatchesIndex;
+
+            /// Number of contact manifold batches of the group
+            uint nbContactManifoldBatches;
+        };
+
+        // Contact solver data of SIMD_WIDTH contact manifolds and contact points solved in
+        // lockstep (defined in the source file because they depend on the SIMD instruction set)
+        struct ContactManifoldBatchSolver;
+        struct ContactPointBatchSolver;
+
         // -------------------- Constants --------------------- //
 
         /// Beta value for the penetration depth position correction without split impulses
@@ -281,6 +425,16 @@ class ContactSolverSystem {
         /// Slop distance (allowed penetration distance between bodies)
         static const decimal SLOP;
 
+        /// Minimum number of contact manifolds of a group of batches (except the last one).
+        /// Larger groups fill the lanes better but leave less groups to solve in parallel.
+        static const uint NB_MIN_MANIFOLDS_PER_BATCH_GROUP;
+
+        /// Maximum number of colors of contact manifolds without shared bodies in an island
+        static const uint NB_MAX_COLORS;
+
+        /// Number of contact manifolds of a color solved by each task
+        static const uint NB_MANIFOLDS_PER_COLOR_TASK;
+
         // -------------------- Attributes -------------------- //
 
         /// Memory manager
@@ -307,6 +461,55 @@ class ContactSolverSystem {
         /// Number of contact constraints
         uint mNbContactManifolds;
 
+        /// Range of the contact constraints of each island with contacts
+        ContactSolverIsland* mSolverIslands;
+
+        /// Indices of the solver islands sorted by decreasing number of contact manifolds
+        /// (largest islands are scheduled first for a better load balancing between threads)
+        uint* mSolverIslandsOrder;
+
+        /// Number of islands with contacts
+        uint mNbSolverIslands;
+
+        /// Contact manifolds packed by batches for the SIMD solver
+        ContactManifoldBatchSolver* mContactManifoldBatches;
+
+        /// Contact points of the contact manifold batches
+        ContactPointBatchSolver* mContactPointBatches;
+
+        /// Number of contact manifold batches
+        uint mNbContactManifoldBatches;
+
+        /// Number of contact point batches
+        uint mNbContactPointBatches;
+
+        /// Groups of contact manifold batches
+        ContactBatchGroup* mBatchGroups;
+
+        /// Number of groups of contact manifold batches
+        uint mNbBatchGroups;
+
+        /// Minimum number of contact manifolds of an island to color its contacts (zero to never color them)
+        uint mColoringThreshold;
+
+        /// Colors of the colored islands
+        ContactSolverColor* mColors;
+
+        /// Number of colors of the colored islands
+        uint mNbColors;
+
+        /// Number of islands whose contacts have been colored
+        uint mNbColoredIslands;
+
+        /// Number of contact manifolds of the colored islands
+        uint mNbColoredContactManifolds;
+
+        /// Tasks of the colors of the colored islands
+        ContactColorTask* mColorTasks;
+
+        /// Number of tasks of the colors
+        uint mNbColorTasks;
+
         /// Reference to the islands
         Islands& mIslands;
 
@@ -328,6 +531,15 @@ class ContactSolverSystem {
         /// True if the split impulse position correction is active
         bool mIsSplitImpulseActive;
 
+        /// True if the contacts are solved by batches with SIMD instructions
+        bool mIsSimdSolverEnabled;
+
+        /// True if the contacts are also solved with the other solver to compare their impulses
+        bool mIsParityCheckEnabled;
+
+        /// Largest impulse differences found by the parity check since it has been enabled
+        ContactSolverParity mParity;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -356,6 +568,30 @@ class ContactSolverSystem {
         /// Warm start the solver.
         void warmStart();
 
+        /// Solve the contact manifolds in [startManifoldIndex, endManifoldIndex)
+        void solveContactManifolds(uint startManifoldIndex, uint endManifoldIndex, uint startContactPointIndex);
+
+        /// Pack the contact manifolds into batches for the SIMD solver
+        void initializeBatches();
+
+        /// Color the contact manifolds of an island such that the manifolds of a color do not share any body
+        void colorIsland(ContactSolverIsland& island, uint32* bodiesColors);
+
+        /// Split the colors of the colored islands into tasks
+        void initializeColorTasks();
+
+        /// Solve the colored islands with the tasks of each color solved in parallel
+        void solveColoredIslands(ThreadPool& threadPool, uint nbIterations);
+
+        /// Solve the contact manifold batches in [startBatchIndex, endBatchIndex)
+        void solveContactBatches(uint startBatchIndex, uint endBatchIndex);
+
+        /// Copy the impulses of the contact manifold batches back to the contact manifolds
+        void storeBatchImpulses();
+
+        /// Compare the impulses stored in the contact manifolds and points with the ones of the other solver
+        void compareImpulses(const List<ContactManifold>& otherManifolds, const List<ContactPoint>& otherPoints);
+
    public:
 
         // -------------------- Methods -------------------- //
@@ -380,6 +616,28 @@ class ContactSolverSystem {
         /// Solve the contacts
         void solve();
 
+        /// Solve all the iterations of the velocity solver for the contacts of the islands in parallel
+        void solveIslands(ThreadPool& threadPool, uint nbIterations);
+
+        /// Solve the contacts with both the SIMD and the scalar solvers and compare their impulses
+        void solveWithParityCheck(List<ContactManifold>* contactManifolds, List<ContactPoint>* contactPoints,
+                                  decimal timeStep, uint nbIterations);
+
+        /// Return the number of islands with contacts
+        uint getNbSolverIslands() const;
+
+        /// Return the number of tasks that solveIslands() can run in parallel
+        uint getNbParallelTasks() const;
+
+        /// Return the number of islands whose contacts are solved by colors
+        uint getNbColoredIslands() const;
+
+        /// Return the minimum number of contact manifolds of an island to color its contacts
+        uint getColoringThreshold() const;
+
+        /// Set the minimum number of contact manifolds of an island to color its contacts (zero to disable)
+        void setColoringThreshold(uint threshold);
+
         /// Release allocated memory
         void reset();
 
@@ -389,6 +647,21 @@ class ContactSolverSystem {
         /// Activate or Deactivate the split impulses for contacts
         void setIsSplitImpulseActive(bool isActive);
 
+        /// Return true if the contacts are solved by batches with SIMD instructions
+        bool isSimdSolverEnabled() const;
+
+        /// Enable/Disable the SIMD solver (the scalar solver is used otherwise)
+        void setIsSimdSolverEnabled(bool isEnabled);
+
+        /// Return true if the contacts are solved with both solvers to compare their impulses
+        bool isParityCheckEnabled() const;
+
+        /// Enable/Disable the comparison of the impulses of both solvers (this resets the parity)
+        void setIsParityCheckEnabled(bool isEnabled);
+
+        /// Return the largest impulse differences found by the parity check
+        const ContactSolverParity& getParity() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -397,6 +670,31 @@ class ContactSolverSystem {
 #endif
 };
 
+// Return the number of islands with contacts
+inline uint ContactSolverSystem::getNbSolverIslands() const {
+    return mNbSolverIslands;
+}
+
+// Return the number of tasks that solveIslands() can run in parallel
+inline uint ContactSolverSystem::getNbParallelTasks() const {
+    return mContactManifoldBatches != nullptr ? mNbBatchGroups : mNbSolverIslands;
+}
+
+// Return the number of islands whose contacts are solved by colors
+inline uint ContactSolverSystem::getNbColoredIslands() const {
+    return mNbColoredIslands;
+}
+
+// Return the minimum number of contact manifolds of an island to color its contacts
+inline uint ContactSolverSystem::getColoringThreshold() const {
+    return mColoringThreshold;
+}
+
+// Set the minimum number of contact manifolds of an island to color its contacts (zero to disable)
+inline void ContactSolverSystem::setColoringThreshold(uint threshold) {
+    mColoringThreshold = threshold;
+}
+
 // Return true if the split impulses position correction technique is used for contacts
 inline bool ContactSolverSystem::isSplitImpulseActive() const {
     return mIsSplitImpulseActive;
@@ -407,6 +705,32 @@ inline void ContactSolverSystem::setIsSplitImpulseActive(bool isActive) {
     mIsSplitImpulseActive = isActive;
 }
 
+// Return true if the contacts are solved by batches with SIMD instructions
+inline bool ContactSolverSystem::isSimdSolverEnabled() const {
+    return mIsSimdSolverEnabled;
+}
+
+// Enable/Disable the SIMD solver (the scalar solver is used otherwise)
+inline void ContactSolverSystem::setIsSimdSolverEnabled(bool isEnabled) {
+    mIsSimdSolverEnabled = isEnabled;
+}
+
+// Return true if the contacts are solved with both solvers to compare their impulses
+inline bool ContactSolverSystem::isParityCheckEnabled() const {
+    return mIsParityCheckEnabled;
+}
+
+// Enable/Disable the comparison of the impulses of both solvers (this resets the parity)
+inline void ContactSolverSystem::setIsParityCheckEnabled(bool isEnabled) {
+    mIsParityCheckEnabled = isEnabled;
+    mParity = ContactSolverParity();
+}
+
+// Return the largest impulse differences found by the parity check
+inline const ContactSolverParity& ContactSolverSystem::getParity() const {
+    return mParity;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
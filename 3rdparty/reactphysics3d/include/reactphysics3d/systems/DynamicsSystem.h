@@ -36,6 +36,15 @@
 namespace reactphysics3d {
 
 class PhysicsWorld;
+class CollisionDetectionSystem;
+class ThreadPool;
+
+// Constants
+
+/// Distance a body with continuous collision detection is moved into the body it hits (along the hit normal)
+/// from its time of impact, so that the contact is created by the discrete collision detection at next step.
+/// It must be larger than the time of impact tolerance, the shapes can be that far apart at the time of impact.
+constexpr decimal CCD_PENETRATION_DEPTH = decimal(0.01);
 
 // Class DynamicsSystem
 /**
@@ -46,6 +55,11 @@ class DynamicsSystem {
 
     private :
 
+        // -------------------- Constants -------------------- //
+
+        /// Number of bodies (or colliders) updated by each task of the parallel passes
+        static const uint32 NB_COMPONENTS_PER_TASK;
+
         // -------------------- Attributes -------------------- //
 
         /// Physics world
@@ -69,12 +83,33 @@ class DynamicsSystem {
         /// Reference to the world gravity vector
         Vector3& mGravity;
 
+        /// Pool of worker threads used to update the bodies in parallel (null if disabled)
+        ThreadPool* mThreadPool;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Pointer to the profiler
         Profiler* mProfiler;
 #endif
 
+        // -------------------- Methods -------------------- //
+
+        /// Call functor(startIndex, endIndex) for ranges of [0, nbComponents) executed in parallel
+        template<typename Functor>
+        void runInParallel(uint32 nbComponents, const Functor& functor);
+
+        /// Integrate the positions and orientations of the rigid bodies in [startIndex, endIndex)
+        void integrateRigidBodiesPositions(uint32 startIndex, uint32 endIndex, decimal timeStep, bool isSplitImpulseActive);
+
+        /// Integrate the velocities of the rigid bodies in [startIndex, endIndex)
+        void integrateRigidBodiesVelocities(uint32 startIndex, uint32 endIndex, decimal timeStep);
+
+        /// Update the postion/orientation of the bodies in [startIndex, endIndex)
+        void updateBodiesState(uint32 startIndex, uint32 endIndex);
+
+        /// Update the local-to-world transform of the colliders in [startIndex, endIndex)
+        void updateCollidersState(uint32 startIndex, uint32 endIndex);
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -94,23 +129,31 @@ class DynamicsSystem {
 
 #endif
 
+        /// Set the pool of worker threads used to update the bodies in parallel (null to disable)
+        void setThreadPool(ThreadPool* threadPool);
+
         /// Integrate the positions and orientations of rigid bodies.
         void integrateRigidBodiesPositions(decimal timeStep, bool isSplitImpulseActive);
 
         /// Integrate the velocities of rigid bodies.
         void integrateRigidBodiesVelocities(decimal timeStep);
 
+        /// Stop the bodies with continuous collision detection at their time of impact
+        void solveContinuousCollisions(const CollisionDetectionSystem& collisionDetection);
+
         /// Update the postion/orientation of the bodies
         void updateBodiesState();
 
         /// Reset the external force and torque applied to the bodies
         void resetBodiesForceAndTorque();
 
-        /// Reset the split velocities of the bodies
-        void resetSplitVelocities();
-
 };
 
+// Set the pool of worker threads used to update the bodies in parallel (null to disable)
+inline void DynamicsSystem::setThreadPool(ThreadPool* threadPool) {
+    mThreadPool = threadPool;
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
@@ -102,6 +102,9 @@ class SolveBallAndSocketJointSystem {
         /// Solve the velocity constraint
         void solveVelocityConstraint();
 
+        /// Solve the velocity constraint of the joint with a given component index
+        void solveVelocityConstraint(uint32 i);
+
         /// Solve the position constraint (for position error correction)
         void solvePositionConstraint();
 
@@ -81,6 +81,15 @@ class SolveSliderJointSystem {
 
         // -------------------- Methods -------------------- //
 
+        /// Solve the velocity of the translation constraints of the joint with a given component index
+        void solveTranslationVelocityConstraint(uint32 i);
+
+        /// Solve the velocity of the rotation constraints of the joint with a given component index
+        void solveRotationVelocityConstraint(uint32 i);
+
+        /// Solve the velocity of the limits and motor constraints of the joint with a given component index
+        void solveLimitsAndMotorVelocityConstraint(uint32 i);
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -103,6 +112,9 @@ class SolveSliderJointSystem {
         /// Solve the velocity constraint
         void solveVelocityConstraint();
 
+        /// Solve the velocity constraint of the joint with a given component index
+        void solveVelocityConstraint(uint32 i);
+
         /// Solve the position constraint (for position error correction)
         void solvePositionConstraint();
 
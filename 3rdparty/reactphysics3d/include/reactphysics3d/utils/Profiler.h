@@ -513,6 +513,14 @@ inline void Profiler::destroy() {
 
 }
 
+// If profiling is disabled but the blocks are forwarded to external trace hooks
+#elif defined(IS_RP3D_TRACING_ENABLED)
+
+#include <reactphysics3d/utils/TraceHooks.h>
+
+// Use this macro to trace a block of code (the profiler is not used)
+#define RP3D_PROFILE(name, profiler) TraceZone traceZone(name)
+
 // If profiling is disabled
 #else
 
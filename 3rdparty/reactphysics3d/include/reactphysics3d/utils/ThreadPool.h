@@ -0,0 +1,150 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_THREAD_POOL_H
+#define REACTPHYSICS3D_THREAD_POOL_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class MemoryManager;
+
+// Class ThreadPool
+/**
+ * This class is a pool of worker threads used to execute a list of independent
+ * tasks in parallel. The thread that calls run() also executes tasks. Tasks are
+ * claimed one at a time from a shared atomic counter so that a worker that finishes
+ * early takes the remaining tasks of the slower ones. The pool does not decide
+ * anything about the order of the results: each task must only write its own data.
+ */
+class ThreadPool {
+
+    public:
+
+        /// Function executed for each task index
+        typedef void (*TaskFunction)(void* data, uint taskIndex);
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory manager
+        MemoryManager& mMemoryManager;
+
+        /// Worker threads
+        std::thread* mThreads;
+
+        /// Number of worker threads (the calling thread is not included)
+        uint mNbWorkers;
+
+        /// Mutex protecting the current job
+        std::mutex mMutex;
+
+        /// Signaled when a new job is available or when the pool is stopping
+        std::condition_variable mJobCondition;
+
+        /// Signaled when a worker finishes its part of the current job
+        std::condition_variable mDoneCondition;
+
+        /// Incremented for each new job so that sleeping workers know there is work
+        uint64 mJobGeneration;
+
+        /// Function of the current job
+        TaskFunction mTaskFunction;
+
+        /// User data of the current job
+        void* mTaskData;
+
+        /// Number of tasks of the current job
+        uint mNbTasks;
+
+        /// Index of the next task to be claimed
+        std::atomic<uint> mNextTaskIndex;
+
+        /// Number of workers currently executing tasks of a job
+        uint mNbActiveWorkers;
+
+        /// True when the pool is destroyed
+        bool mIsStopping;
+
+        // -------------------- Methods -------------------- //
+
+        /// Main loop of a worker thread
+        void workerLoop();
+
+        /// Claim and execute tasks until there is no task left
+        void executeTasks(TaskFunction taskFunction, void* data, uint nbTasks);
+
+        /// Call a functor for a given task index
+        template<typename Functor>
+        static void callFunctor(void* data, uint taskIndex) {
+            (*static_cast<const Functor*>(data))(taskIndex);
+        }
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ThreadPool(MemoryManager& memoryManager, uint nbWorkers);
+
+        /// Destructor
+        ~ThreadPool();
+
+        /// Deleted copy-constructor
+        ThreadPool(const ThreadPool& threadPool) = delete;
+
+        /// Deleted assignment operator
+        ThreadPool& operator=(const ThreadPool& threadPool) = delete;
+
+        /// Return the number of worker threads
+        uint getNbWorkers() const;
+
+        /// Execute the tasks [0, nbTasks) and return when all of them are done
+        void run(uint nbTasks, TaskFunction taskFunction, void* data);
+
+        /// Call functor(taskIndex) for each task in [0, nbTasks) and return when all of them are done
+        template<typename Functor>
+        void parallelFor(uint nbTasks, const Functor& functor) {
+            run(nbTasks, &ThreadPool::callFunctor<Functor>, const_cast<void*>(static_cast<const void*>(&functor)));
+        }
+};
+
+// Return the number of worker threads
+inline uint ThreadPool::getNbWorkers() const {
+    return mNbWorkers;
+}
+
+}
+
+#endif
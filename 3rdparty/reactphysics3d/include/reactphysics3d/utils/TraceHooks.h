@@ -0,0 +1,79 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TRACE_HOOKS_H
+#define REACTPHYSICS3D_TRACE_HOOKS_H
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+/// Function called when a traced block of code starts (name is a string literal)
+typedef void (*TraceBeginFunction)(const char* name);
+
+/// Function called when the most recently started traced block of code ends
+typedef void (*TraceEndFunction)();
+
+/// Hooks called by the RP3D_PROFILE blocks when the library is compiled with
+/// IS_RP3D_TRACING_ENABLED (instead of the built-in profiler). This lets an external
+/// tracer record the library blocks together with its own zones. The hooks are called
+/// from every thread that runs library code and must be thread-safe.
+extern TraceBeginFunction gTraceBeginFunction;
+extern TraceEndFunction gTraceEndFunction;
+
+/// Install the trace hooks (nullptr disables tracing). This must not be called while a
+/// physics world is being updated.
+void setTraceHooks(TraceBeginFunction beginFunction, TraceEndFunction endFunction);
+
+// Class TraceZone
+/**
+ * This class calls the trace hooks at the beginning and at the end of its scope
+ */
+class TraceZone {
+
+    private:
+
+        /// True if the begin hook has been called (hooks may change during the scope)
+        bool mIsTraced;
+
+    public:
+
+        /// Constructor
+        TraceZone(const char* name) : mIsTraced(gTraceBeginFunction != nullptr) {
+            if (mIsTraced) {
+                gTraceBeginFunction(name);
+            }
+        }
+
+        /// Destructor
+        ~TraceZone() {
+            if (mIsTraced && gTraceEndFunction != nullptr) {
+                gTraceEndFunction();
+            }
+        }
+};
+
+}
+
+#endif
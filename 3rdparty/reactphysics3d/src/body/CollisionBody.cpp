@@ -179,6 +179,9 @@ void CollisionBody::removeCollider(Collider* collider) {
 
     mWorld.mCollisionBodyComponents.removeColliderFromBody(mEntity, collider->getEntity());
 
+    // The contacts of the collider do not connect the island of the body anymore
+    mWorld.mIslandUnionFind.markSplitNeeded(mEntity);
+
     // Unassign the collider from the collision shape
     collider->getCollisionShape()->removeCollider(collider);
 
@@ -66,7 +66,8 @@ BodyType RigidBody::getType() const {
  */
 void RigidBody::setType(BodyType type) {
 
-    if (mWorld.mRigidBodyComponents.getBodyType(mEntity) == type) return;
+    const BodyType previousType = mWorld.mRigidBodyComponents.getBodyType(mEntity);
+    if (previousType == type) return;
 
     mWorld.mRigidBodyComponents.setBodyType(mEntity, type);
 
@@ -107,6 +108,34 @@ void RigidBody::setType(BodyType type) {
     // Awake the body
     setIsSleeping(false);
 
+    // If the body becomes static or is not static anymore, its colliders have to be moved between
+    // the static and the non-static broad-phase data structures
+    if ((type == BodyType::STATIC) != (previousType == BodyType::STATIC) &&
+        mWorld.mCollisionBodyComponents.getIsActive(mEntity)) {
+
+        // Only the non-static bodies are in the sets of bodies for the islands
+        if (type == BodyType::STATIC) {
+            mWorld.mIslandUnionFind.removeBody(mEntity);
+        }
+        else {
+            mWorld.mIslandUnionFind.addBody(mEntity);
+        }
+
+        const Transform& transform = mWorld.mTransformComponents.getTransform(mEntity);
+        const List<Entity>& colliderEntities = mWorld.mCollisionBodyComponents.getColliders(mEntity);
+        for (uint i=0; i < colliderEntities.size(); i++) {
+
+            Collider* collider = mWorld.mCollidersComponents.getCollider(colliderEntities[i]);
+            if (collider->getBroadPhaseId() == -1) continue;
+
+            AABB aabb;
+            collider->getCollisionShape()->computeAABB(aabb, transform * mWorld.mCollidersComponents.getLocalToBodyTransform(collider->getEntity()));
+
+            mWorld.mCollisionDetection.removeCollider(collider);
+            mWorld.mCollisionDetection.addCollider(collider, aabb);
+        }
+    }
+
     // Update the active status of currently overlapping pairs
     updateOverlappingPairs();
 
@@ -909,6 +938,34 @@ bool RigidBody::isSleeping() const {
     return mWorld.mRigidBodyComponents.getIsSleeping(mEntity);
 }
 
+// Return true if the continuous collision detection is enabled for the body
+/**
+ * @return True if the continuous collision detection is enabled for the body and false otherwise
+ */
+bool RigidBody::isCCDEnabled() const {
+    return mWorld.mRigidBodyComponents.getIsCCDEnabled(mEntity);
+}
+
+// Enable or disable the continuous collision detection for the body
+/// When it is enabled, the colliders of a dynamic body that moves more than half of the size of
+/// one of them during a step are swept along the motion of the body. If one of them would go
+/// through another collider during the step, a speculative contact is created between them in
+/// the step where they meet, which lets the body move only until they touch. A body that still
+/// goes through a collider after the contacts have been solved is stopped at the time of impact.
+/// Only the linear motion of the body is swept. This is meant for fast and small bodies
+/// (bullets, debris) that would otherwise go through thin bodies.
+/**
+ * @param isCCDEnabled True to enable the continuous collision detection for the body
+ */
+void RigidBody::setIsCCDEnabled(bool isCCDEnabled) {
+
+    mWorld.mRigidBodyComponents.setIsCCDEnabled(mEntity, isCCDEnabled);
+
+    RP3D_LOG(mWorld.mConfig.worldName, Logger::Level::Information, Logger::Category::Body,
+             "Body " + std::to_string(mEntity.id) + ": Set isCCDEnabled=" +
+             (isCCDEnabled ? "true" : "false"),  __FILE__, __LINE__);
+}
+
 // Set whether or not the body is active
 /**
  * @param isActive True if you want to activate the body
@@ -921,6 +978,14 @@ void RigidBody::setIsActive(bool isActive) {
     setIsSleeping(!isActive);
 
     CollisionBody::setIsActive(isActive);
+
+    // Only the active non-static bodies are in the sets of bodies for the islands
+    if (!isActive) {
+        mWorld.mIslandUnionFind.removeBody(mEntity);
+    }
+    else if (mWorld.mRigidBodyComponents.getBodyType(mEntity) != BodyType::STATIC) {
+        mWorld.mIslandUnionFind.addBody(mEntity);
+    }
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
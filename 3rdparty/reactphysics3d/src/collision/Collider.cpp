@@ -174,6 +174,13 @@ const Transform& Collider::getLocalToBodyTransform() const {
  * @return True if the ray hits the collision shape
  */
 bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
+    return raycast(ray, raycastInfo, mMemoryManager.getPoolAllocator());
+}
+
+// Raycast method with the allocator to use for the temporary memory of the raycast. This method
+// does not modify the collider and can be called from several threads at the same time with a
+// thread-safe allocator.
+bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator) {
 
     // If the corresponding body is not active, it cannot be hit by rays
     if (!mBody->isActive()) return false;
@@ -186,7 +193,7 @@ bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
                  ray.maxFraction);
 
     const CollisionShape* collisionShape = mBody->mWorld.mCollidersComponents.getCollisionShape(mEntity);
-    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, mMemoryManager.getPoolAllocator());
+    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, allocator);
 
     // Convert the raycast info into world-space
     raycastInfo.worldPoint = localToWorldTransform * raycastInfo.worldPoint;
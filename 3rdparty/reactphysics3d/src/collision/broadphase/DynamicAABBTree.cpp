@@ -27,6 +27,7 @@
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
 #include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
 #include <reactphysics3d/utils/Profiler.h>
 
 using namespace reactphysics3d;
@@ -34,6 +35,18 @@ using namespace reactphysics3d;
 // Initialization of static variables
 const int32 TreeNode::NULL_TREE_NODE = -1;
 
+// Number of bins used to evaluate the surface area heuristic when the tree is rebuilt
+static const uint NB_REBUILD_SAH_BINS = 16;
+
+// Tolerance on the hit fractions of the SIMD ray vs AABB slab tests to counteract arithmetic errors
+static const decimal RAY_HIT_FRACTION_TOLERANCE = decimal(0.0001);
+
+// Return half the surface area of an AABB
+static decimal computeHalfSurfaceArea(const AABB& aabb) {
+    const Vector3 extent = aabb.getExtent();
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
 // Constructor
 DynamicAABBTree::DynamicAABBTree(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
                 : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage) {
@@ -573,6 +586,191 @@ int32 DynamicAABBTree::balanceSubTreeAtNode(int32 nodeID) {
     return nodeID;
 }
 
+// Rebuild the tree top-down with the surface area heuristic (SAH).
+/// The tree built by successive insertions is well balanced but the choice of the sibling of
+/// each new leaf only depends on the leaves already in the tree. This method builds the tree
+/// again from all its leaves. At each node, the leaves are split in two groups along the axis
+/// and at the position (among NB_REBUILD_SAH_BINS bins of the centers) that minimize the sum of
+/// the surface areas of the two groups weighted by their number of leaves. The leaf nodes are
+/// kept and therefore the IDs of the objects do not change. This is meant for a tree that is
+/// rarely modified (for instance with static objects only) because the whole tree is rebuilt.
+void DynamicAABBTree::rebuild() {
+
+    RP3D_PROFILE("DynamicAABBTree::rebuild()", mProfiler);
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE) return;
+
+    // Collect the leaf nodes and release the internal nodes
+    List<int32> leaves(mAllocator, static_cast<uint>(mNbNodes / 2 + 1));
+    Stack<int32> stack(mAllocator, 64);
+    stack.push(mRootNodeID);
+    while (stack.size() > 0) {
+
+        const int32 nodeID = stack.pop();
+        if (mNodes[nodeID].isLeaf()) {
+            leaves.add(nodeID);
+        }
+        else {
+            stack.push(mNodes[nodeID].children[0]);
+            stack.push(mNodes[nodeID].children[1]);
+            releaseNode(nodeID);
+        }
+    }
+    mRootNodeID = TreeNode::NULL_TREE_NODE;
+
+    // Range of leaves to build a sub-tree from and the node where to attach this sub-tree
+    struct BuildRange {
+        uint start;
+        uint end;
+        int32 parentID;
+        int childIndex;
+    };
+
+    // Internal nodes in creation order (a parent is always created before its children)
+    List<int32> internalNodes(mAllocator, leaves.size());
+
+    Stack<BuildRange> ranges(mAllocator, 64);
+    BuildRange rootRange = {0, static_cast<uint>(leaves.size()), TreeNode::NULL_TREE_NODE, 0};
+    ranges.push(rootRange);
+
+    while (ranges.size() > 0) {
+
+        const BuildRange range = ranges.pop();
+        const uint nbLeaves = range.end - range.start;
+
+        // Create the root node of the sub-tree (the leaf itself if there is a single leaf)
+        int32 nodeID;
+        if (nbLeaves == 1) {
+            nodeID = leaves[range.start];
+        }
+        else {
+
+            // The internal nodes have been released above and therefore the array of nodes is
+            // not reallocated here
+            nodeID = allocateNode();
+            mNodes[nodeID].height = 1;
+            internalNodes.add(nodeID);
+        }
+
+        mNodes[nodeID].parentID = range.parentID;
+        if (range.parentID == TreeNode::NULL_TREE_NODE) {
+            mRootNodeID = nodeID;
+        }
+        else {
+            mNodes[range.parentID].children[range.childIndex] = nodeID;
+        }
+
+        if (nbLeaves == 1) continue;
+
+        // Compute the AABB of the node and the bounds of the centers of the leaves
+        AABB& nodeAABB = mNodes[nodeID].aabb;
+        nodeAABB = mNodes[leaves[range.start]].aabb;
+        Vector3 minCenter = nodeAABB.getCenter();
+        Vector3 maxCenter = minCenter;
+        for (uint i=range.start + 1; i < range.end; i++) {
+            const AABB& leafAABB = mNodes[leaves[i]].aabb;
+            nodeAABB.mergeWithAABB(leafAABB);
+            const Vector3 center = leafAABB.getCenter();
+            minCenter = Vector3::min(minCenter, center);
+            maxCenter = Vector3::max(maxCenter, center);
+        }
+
+        // Find the axis and the bin where to split the leaves with the smallest SAH cost
+        int splitAxis = -1;
+        uint splitBin = 0;
+        decimal smallestCost = DECIMAL_LARGEST;
+        for (int axis=0; axis < 3; axis++) {
+
+            const decimal extent = maxCenter[axis] - minCenter[axis];
+            if (extent <= decimal(0.0)) continue;
+            const decimal binScale = decimal(NB_REBUILD_SAH_BINS) / extent;
+
+            // Put the leaves into the bins
+            uint binNbLeaves[NB_REBUILD_SAH_BINS] = {};
+            AABB binAABBs[NB_REBUILD_SAH_BINS];
+            for (uint i=range.start; i < range.end; i++) {
+                const AABB& leafAABB = mNodes[leaves[i]].aabb;
+                const uint bin = std::min(NB_REBUILD_SAH_BINS - 1, static_cast<uint>((leafAABB.getCenter()[axis] - minCenter[axis]) * binScale));
+                if (binNbLeaves[bin] == 0) {
+                    binAABBs[bin] = leafAABB;
+                }
+                else {
+                    binAABBs[bin].mergeWithAABB(leafAABB);
+                }
+                binNbLeaves[bin]++;
+            }
+
+            // Compute the cost of the left side of each split position
+            decimal leftCosts[NB_REBUILD_SAH_BINS];
+            AABB leftAABB;
+            uint nbLeftLeaves = 0;
+            for (uint bin=0; bin < NB_REBUILD_SAH_BINS - 1; bin++) {
+                if (binNbLeaves[bin] > 0) {
+                    if (nbLeftLeaves == 0) leftAABB = binAABBs[bin];
+                    else leftAABB.mergeWithAABB(binAABBs[bin]);
+                    nbLeftLeaves += binNbLeaves[bin];
+                }
+                leftCosts[bin + 1] = nbLeftLeaves == 0 ? DECIMAL_LARGEST : nbLeftLeaves * computeHalfSurfaceArea(leftAABB);
+            }
+
+            // Add the cost of the right side and keep the best split position
+            AABB rightAABB;
+            uint nbRightLeaves = 0;
+            for (uint bin=NB_REBUILD_SAH_BINS - 1; bin > 0; bin--) {
+                if (binNbLeaves[bin] > 0) {
+                    if (nbRightLeaves == 0) rightAABB = binAABBs[bin];
+                    else rightAABB.mergeWithAABB(binAABBs[bin]);
+                    nbRightLeaves += binNbLeaves[bin];
+                }
+                if (nbRightLeaves == 0 || nbRightLeaves == nbLeaves) continue;
+                const decimal cost = leftCosts[bin] + nbRightLeaves * computeHalfSurfaceArea(rightAABB);
+                if (cost < smallestCost) {
+                    smallestCost = cost;
+                    splitAxis = axis;
+                    splitBin = bin;
+                }
+            }
+        }
+
+        // Partition the leaves (bins smaller than the split bin on the left side). If all the
+        // centers are at the same position, the leaves are split in two halves.
+        uint middle = range.start + nbLeaves / 2;
+        if (splitAxis != -1) {
+
+            const decimal binScale = decimal(NB_REBUILD_SAH_BINS) / (maxCenter[splitAxis] - minCenter[splitAxis]);
+            uint left = range.start;
+            uint right = range.end;
+            while (left < right) {
+                const decimal center = mNodes[leaves[left]].aabb.getCenter()[splitAxis];
+                const uint bin = std::min(NB_REBUILD_SAH_BINS - 1, static_cast<uint>((center - minCenter[splitAxis]) * binScale));
+                if (bin < splitBin) {
+                    left++;
+                }
+                else {
+                    right--;
+                    const int32 leaf = leaves[left];
+                    leaves[left] = leaves[right];
+                    leaves[right] = leaf;
+                }
+            }
+            middle = left;
+        }
+
+        assert(middle > range.start && middle < range.end);
+
+        BuildRange leftRange = {range.start, middle, nodeID, 0};
+        BuildRange rightRange = {middle, range.end, nodeID, 1};
+        ranges.push(rightRange);
+        ranges.push(leftRange);
+    }
+
+    // Compute the heights of the internal nodes (children before their parent)
+    for (int i=static_cast<int>(internalNodes.size()) - 1; i >= 0; i--) {
+        TreeNode& node = mNodes[internalNodes[i]];
+        node.height = static_cast<int16>(1 + std::max(mNodes[node.children[0]].height, mNodes[node.children[1]].height));
+    }
+}
+
 /// Take a list of shapes to be tested for broad-phase overlap and return a list of pair of overlapping shapes
 void DynamicAABBTree::reportAllShapesOverlappingWithShapes(const List<int32>& nodesToTest, size_t startIndex,
                                                            size_t endIndex, List<Pair<int32, int32>>& outOverlappingNodes) const {
@@ -667,12 +865,19 @@ void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, List<
 
 // Ray casting method
 void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+    raycast(ray, callback, mAllocator);
+}
+
+// Ray casting method with the allocator to use for the traversal stack. Using an allocator
+// that is not shared with the tree allows to raycast the tree from several threads at the same time.
+void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback,
+                              MemoryAllocator& stackAllocator) const {
 
     RP3D_PROFILE("DynamicAABBTree::raycast()", mProfiler);
 
     decimal maxFraction = ray.maxFraction;
 
-    Stack<int32> stack(mAllocator, 128);
+    Stack<int32> stack(stackAllocator, 128);
     stack.push(mRootNodeID);
 
     // Walk through the tree from the root looking for colliders
@@ -727,6 +932,111 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& ca
     }
 }
 
+// Ray casting method for a packet of at most SIMD_WIDTH rays. The maximum fraction of the
+// ray i is maxFractions[i] (instead of rays[i].maxFraction). The tree is traversed once for the
+// whole packet and each node AABB is tested against all the rays at once with SIMD slab tests.
+// The callback is called for each ray that hits the AABB of a leaf node. The traversal is
+// efficient when the rays of the packet are coherent (close origins and directions).
+void DynamicAABBTree::raycastPacket(const Ray* rays, const decimal* maxFractions, uint nbRays,
+                                    DynamicAABBTreeRaycastPacketCallback& callback,
+                                    MemoryAllocator& stackAllocator) const {
+
+    assert(nbRays <= SIMD_WIDTH);
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || nbRays == 0) return;
+
+    // Compute the origins and the inverse of the directions (clamped to finite values) of
+    // the rays. The unused lanes have a negative maximum fraction and never hit a node.
+    decimal origins[3][SIMD_WIDTH];
+    decimal inverseDirections[3][SIMD_WIDTH];
+    decimal rayMaxFractions[SIMD_WIDTH];
+    for (uint i=0; i < SIMD_WIDTH; i++) {
+
+        const bool isRayUsed = i < nbRays;
+        const Vector3 direction = isRayUsed ? rays[i].point2 - rays[i].point1 : Vector3::zero();
+
+        for (int axis=0; axis < 3; axis++) {
+            origins[axis][i] = isRayUsed ? rays[i].point1[axis] : decimal(0.0);
+            inverseDirections[axis][i] = direction[axis] == decimal(0.0) ? DECIMAL_LARGEST :
+                                         clamp(decimal(1.0) / direction[axis], DECIMAL_SMALLEST, DECIMAL_LARGEST);
+        }
+
+        rayMaxFractions[i] = isRayUsed ? maxFractions[i] : decimal(-1.0);
+    }
+
+    SimdDecimal origin[3];
+    SimdDecimal inverseDirection[3];
+    for (int axis=0; axis < 3; axis++) {
+        origin[axis] = SimdDecimal::load(origins[axis]);
+        inverseDirection[axis] = SimdDecimal::load(inverseDirections[axis]);
+    }
+
+    const SimdDecimal tolerance = SimdDecimal::broadcast(RAY_HIT_FRACTION_TOLERANCE);
+
+    // Bit mask of the rays that have not been stopped by the callback
+    uint activeRays = (1u << nbRays) - 1u;
+
+    Stack<int32> stack(stackAllocator, 128);
+    stack.push(mRootNodeID);
+
+    // Walk through the tree from the root looking for colliders
+    // that overlap with the rays
+    while (stack.size() > 0) {
+
+        // Get the next node in the stack
+        const int32 nodeID = stack.pop();
+        const TreeNode* node = mNodes + nodeID;
+
+        // Test all the rays against the node AABB at once
+        SimdDecimal tMin = SimdDecimal::broadcast(decimal(0.0));
+        SimdDecimal tMax = SimdDecimal::load(rayMaxFractions);
+        for (int axis=0; axis < 3; axis++) {
+
+            const SimdDecimal t1 = (SimdDecimal::broadcast(node->aabb.getMin()[axis]) - origin[axis]) * inverseDirection[axis];
+            const SimdDecimal t2 = (SimdDecimal::broadcast(node->aabb.getMax()[axis]) - origin[axis]) * inverseDirection[axis];
+
+            tMin = SimdDecimal::max(tMin, SimdDecimal::min(t1, t2));
+            tMax = SimdDecimal::min(tMax, SimdDecimal::max(t1, t2));
+        }
+
+        const uint hitRays = SimdDecimal::maskLessOrEqual(tMin - tolerance, tMax) & activeRays;
+        if (hitRays == 0) continue;
+
+        // If the node is a leaf of the tree
+        if (node->isLeaf()) {
+
+            for (uint i=0; i < nbRays; i++) {
+
+                if ((hitRays & (1u << i)) == 0) continue;
+
+                // Call the callback that will raycast again the broad-phase shape
+                Ray rayTemp(rays[i].point1, rays[i].point2, rayMaxFractions[i]);
+                const decimal hitFraction = callback.raycastBroadPhaseShape(nodeID, i, rayTemp);
+
+                // If the user returned a hitFraction of zero, it means that
+                // the raycasting of this ray should stop here
+                if (hitFraction == decimal(0.0)) {
+                    rayMaxFractions[i] = decimal(-1.0);
+                    activeRays &= ~(1u << i);
+                }
+                else if (hitFraction > decimal(0.0) && hitFraction < rayMaxFractions[i]) {
+
+                    // Clip the ray with the new maximum fraction
+                    rayMaxFractions[i] = hitFraction;
+                }
+            }
+
+            if (activeRays == 0) return;
+        }
+        else {  // If the node has children
+
+            // Push its children in the stack of nodes to explore
+            stack.push(node->children[0]);
+            stack.push(node->children[1]);
+        }
+    }
+}
+
 #ifndef NDEBUG
 
 // Check if the tree structure is valid (for debugging purpose)
@@ -0,0 +1,891 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/DynamicWideAABBTree.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Largest quantized coordinate
+static const decimal MAX_QUANTIZED_COORDINATE = decimal(65535.0);
+
+// Tolerance on the ray fraction used to make the SIMD ray test of the children conservative
+static const decimal RAY_HIT_FRACTION_TOLERANCE = decimal(0.0001);
+
+// Return half the surface area of an AABB (cost used to choose where to insert an object)
+static decimal computeHalfSurfaceArea(const AABB& aabb) {
+    const Vector3 extent = aabb.getExtent();
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+// Constructor
+DynamicWideAABBTree::DynamicWideAABBTree(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
+                    : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage) {
+
+    init();
+}
+
+// Destructor
+DynamicWideAABBTree::~DynamicWideAABBTree() {
+
+    // Free the allocated memory for the nodes and the objects
+    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(WideTreeNode));
+    mAllocator.release(mObjects, static_cast<size_t>(mNbAllocatedObjects) * sizeof(WideTreeObject));
+}
+
+// Initialize the tree
+void DynamicWideAABBTree::init() {
+
+    mRootNodeID = -1;
+    mNbNodes = 0;
+    mNbAllocatedNodes = 8;
+    mNbObjects = 0;
+    mNbAllocatedObjects = 16;
+
+    // Allocate memory for the nodes of the tree
+    mNodes = static_cast<WideTreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(WideTreeNode)));
+    assert(mNodes);
+    std::memset(mNodes, 0, static_cast<size_t>(mNbAllocatedNodes) * sizeof(WideTreeNode));
+
+    // Initialize the allocated nodes
+    for (int32 i=0; i<mNbAllocatedNodes - 1; i++) {
+        mNodes[i].nextNodeID = i + 1;
+    }
+    mNodes[mNbAllocatedNodes - 1].nextNodeID = -1;
+    mFreeNodeID = 0;
+
+    // Allocate memory for the objects
+    mObjects = static_cast<WideTreeObject*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedObjects) * sizeof(WideTreeObject)));
+    assert(mObjects);
+    std::memset(mObjects, 0, static_cast<size_t>(mNbAllocatedObjects) * sizeof(WideTreeObject));
+
+    // Initialize the allocated objects
+    for (int32 i=0; i<mNbAllocatedObjects; i++) {
+        mObjects[i].nextObjectID = i + 1 < mNbAllocatedObjects ? i + 1 : -1;
+        mObjects[i].indexInNode = -1;
+    }
+    mFreeObjectID = 0;
+}
+
+// Clear all the nodes and reset the tree
+void DynamicWideAABBTree::reset() {
+
+    // Free the allocated memory for the nodes and the objects
+    mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(WideTreeNode));
+    mAllocator.release(mObjects, static_cast<size_t>(mNbAllocatedObjects) * sizeof(WideTreeObject));
+
+    // Initialize the tree
+    init();
+}
+
+// Allocate and return a new node in the tree
+int32 DynamicWideAABBTree::allocateNode() {
+
+    // If there is no more allocated node to use
+    if (mFreeNodeID == -1) {
+
+        assert(mNbNodes == mNbAllocatedNodes);
+
+        // Allocate more nodes in the tree
+        int32 oldNbAllocatedNodes = mNbAllocatedNodes;
+        mNbAllocatedNodes *= 2;
+        WideTreeNode* oldNodes = mNodes;
+        mNodes = static_cast<WideTreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(WideTreeNode)));
+        assert(mNodes);
+        std::memcpy(mNodes, oldNodes, static_cast<size_t>(mNbNodes) * sizeof(WideTreeNode));
+        mAllocator.release(oldNodes, static_cast<size_t>(oldNbAllocatedNodes) * sizeof(WideTreeNode));
+
+        // Initialize the allocated nodes
+        for (int32 i=mNbNodes; i<mNbAllocatedNodes - 1; i++) {
+            mNodes[i].nextNodeID = i + 1;
+            mNodes[i].nbChildren = 0;
+        }
+        mNodes[mNbAllocatedNodes - 1].nextNodeID = -1;
+        mNodes[mNbAllocatedNodes - 1].nbChildren = 0;
+        mFreeNodeID = mNbNodes;
+    }
+
+    // Get the next free node
+    int32 freeNodeID = mFreeNodeID;
+    mFreeNodeID = mNodes[freeNodeID].nextNodeID;
+    mNodes[freeNodeID].parentID = -1;
+    mNodes[freeNodeID].indexInParent = 0;
+    mNodes[freeNodeID].nbChildren = 0;
+    mNodes[freeNodeID].height = 0;
+    mNbNodes++;
+
+    return freeNodeID;
+}
+
+// Release a node
+void DynamicWideAABBTree::releaseNode(int32 nodeID) {
+
+    assert(mNbNodes > 0);
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    mNodes[nodeID].nextNodeID = mFreeNodeID;
+    mNodes[nodeID].nbChildren = 0;
+    mFreeNodeID = nodeID;
+    mNbNodes--;
+}
+
+// Allocate and return a new object ID
+int32 DynamicWideAABBTree::allocateObject() {
+
+    // If there is no more allocated object to use
+    if (mFreeObjectID == -1) {
+
+        assert(mNbObjects == mNbAllocatedObjects);
+
+        // Allocate more objects
+        int32 oldNbAllocatedObjects = mNbAllocatedObjects;
+        mNbAllocatedObjects *= 2;
+        WideTreeObject* oldObjects = mObjects;
+        mObjects = static_cast<WideTreeObject*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedObjects) * sizeof(WideTreeObject)));
+        assert(mObjects);
+        std::memcpy(mObjects, oldObjects, static_cast<size_t>(mNbObjects) * sizeof(WideTreeObject));
+        mAllocator.release(oldObjects, static_cast<size_t>(oldNbAllocatedObjects) * sizeof(WideTreeObject));
+
+        // Initialize the allocated objects
+        for (int32 i=mNbObjects; i<mNbAllocatedObjects; i++) {
+            mObjects[i].nextObjectID = i + 1 < mNbAllocatedObjects ? i + 1 : -1;
+            mObjects[i].indexInNode = -1;
+        }
+        mFreeObjectID = mNbObjects;
+    }
+
+    // Get the next free object
+    int32 freeObjectID = mFreeObjectID;
+    mFreeObjectID = mObjects[freeObjectID].nextObjectID;
+    mObjects[freeObjectID].nodeID = -1;
+    mNbObjects++;
+
+    return freeObjectID;
+}
+
+// Release an object ID
+void DynamicWideAABBTree::releaseObject(int32 objectID) {
+
+    assert(mNbObjects > 0);
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    mObjects[objectID].nextObjectID = mFreeObjectID;
+    mObjects[objectID].indexInNode = -1;
+    mFreeObjectID = objectID;
+    mNbObjects--;
+}
+
+// Remove an object from the tree
+void DynamicWideAABBTree::removeObject(int32 objectID) {
+
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].indexInNode >= 0);
+
+    // Remove the object from the tree
+    removeObjectFromNode(objectID);
+    releaseObject(objectID);
+}
+
+// Update the dynamic tree after an object has moved.
+/// If the new AABB of the object that has moved is still inside its fat AABB, then
+/// nothing is done. Otherwise, the fat AABB of the object is recomputed. If the new fat AABB
+/// is still inside the AABB of the node containing the object, the node and its ancestors are
+/// only refitted. Otherwise, the object is removed and reinserted into the tree.
+/// The method returns true if the fat AABB of the object has changed.
+/// If the "forceReInsert" parameter is true, we force the existing AABB to take the size
+/// of the "newAABB" parameter even if it is larger than "newAABB". This can be used to shrink the
+/// AABB in the tree for instance if the corresponding collision shape has been shrunk.
+bool DynamicWideAABBTree::updateObject(int32 objectID, const AABB& newAABB, bool forceReinsert) {
+
+    RP3D_PROFILE("DynamicWideAABBTree::updateObject()", mProfiler);
+
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].indexInNode >= 0);
+
+    // If the new AABB is still inside the fat AABB of the object
+    if (!forceReinsert && mObjects[objectID].aabb.contains(newAABB)) {
+        return false;
+    }
+
+    // Compute the fat AABB by inflating the AABB with by a constant percentage of the size of the AABB
+    const Vector3 gap(newAABB.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+    const AABB fatAABB(newAABB.getMin() - gap, newAABB.getMax() + gap);
+
+    assert(fatAABB.contains(newAABB));
+
+    const int32 nodeID = mObjects[objectID].nodeID;
+
+    // If the new fat AABB is still inside the AABB of the node containing the object
+    if (!forceReinsert && mNodes[nodeID].aabb.contains(fatAABB)) {
+
+        // We only need to refit the node and its ancestors
+        mObjects[objectID].aabb = fatAABB;
+        refitNodeAndAncestors(nodeID, mObjects[objectID].indexInNode);
+    }
+    else {
+
+        // Remove the object and reinsert it into the tree
+        removeObjectFromNode(objectID);
+        mObjects[objectID].aabb = fatAABB;
+        insertObject(objectID);
+    }
+
+    return true;
+}
+
+// Set the location (node and index) of a child in the tree
+void DynamicWideAABBTree::setChildLocation(int32 child, int32 nodeID, uint index) {
+
+    if (isObject(child)) {
+        WideTreeObject& object = mObjects[decodeObject(child)];
+        object.nodeID = nodeID;
+        object.indexInNode = static_cast<int32>(index);
+    }
+    else {
+        mNodes[child].parentID = nodeID;
+        mNodes[child].indexInParent = static_cast<uint8>(index);
+    }
+}
+
+// Add a child at the end of the children of a node
+void DynamicWideAABBTree::addChild(int32 nodeID, int32 child) {
+
+    WideTreeNode& node = mNodes[nodeID];
+    assert(node.nbChildren < WIDE_TREE_NB_MAX_CHILDREN);
+
+    const uint index = node.nbChildren;
+    node.children[index] = child;
+    node.nbChildren++;
+    setChildLocation(child, nodeID, index);
+}
+
+// Insert an object in the tree
+void DynamicWideAABBTree::insertObject(int32 objectID) {
+    insertChild(encodeObject(objectID), 0);
+}
+
+// Insert a child (an object or the root node of a sub-tree) into a node of a given height.
+// As in an R-tree, we go down the tree into the child whose surface area grows the least
+// until we reach a node of this height. All the objects are therefore at the same depth.
+void DynamicWideAABBTree::insertChild(int32 child, int height) {
+
+    // If the tree is empty
+    if (mRootNodeID == -1) {
+
+        if (isObject(child)) {
+            mRootNodeID = allocateNode();
+            addChild(mRootNodeID, child);
+            refitNode(mRootNodeID);
+        }
+        else {
+            mRootNodeID = child;
+            mNodes[child].parentID = -1;
+            mNodes[child].indexInParent = 0;
+        }
+
+        return;
+    }
+
+    assert(mNodes[mRootNodeID].height >= height);
+
+    const AABB childAABB = getChildAABB(child);
+
+    int32 nodeID = mRootNodeID;
+    while (mNodes[nodeID].height > height) {
+
+        const WideTreeNode& node = mNodes[nodeID];
+
+        // Find the child node whose surface area grows the least (the smallest one in case of a tie)
+        uint bestIndex = 0;
+        decimal bestEnlargement = DECIMAL_LARGEST;
+        decimal bestArea = DECIMAL_LARGEST;
+        for (uint i=0; i < node.nbChildren; i++) {
+
+            const AABB& aabb = mNodes[node.children[i]].aabb;
+            AABB mergedAABB;
+            mergedAABB.mergeTwoAABBs(aabb, childAABB);
+
+            const decimal area = computeHalfSurfaceArea(aabb);
+            const decimal enlargement = computeHalfSurfaceArea(mergedAABB) - area;
+            if (enlargement < bestEnlargement || (enlargement == bestEnlargement && area < bestArea)) {
+                bestEnlargement = enlargement;
+                bestArea = area;
+                bestIndex = i;
+            }
+        }
+
+        nodeID = node.children[bestIndex];
+    }
+
+    addChildOrSplitNode(nodeID, child);
+}
+
+// Add a child to a node. If the node is full, it is split in two nodes.
+void DynamicWideAABBTree::addChildOrSplitNode(int32 nodeID, int32 child) {
+
+    if (mNodes[nodeID].nbChildren < WIDE_TREE_NB_MAX_CHILDREN) {
+        addChild(nodeID, child);
+        refitNodeAndAncestors(nodeID);
+    }
+    else {
+        splitNode(nodeID, child);
+    }
+}
+
+// Split a full node in two nodes to add a new child. The children are sorted along each axis
+// and we keep the split that minimizes the sum of the surface areas of the two nodes. The
+// new node is then added to the parent node (that can also be split).
+void DynamicWideAABBTree::splitNode(int32 nodeID, int32 child) {
+
+    const uint nbEntries = WIDE_TREE_NB_MAX_CHILDREN + 1;
+
+    // Each node receives at least 40% of the children
+    const uint minNbEntriesPerNode = std::max(2u, nbEntries * 2u / 5u);
+
+    // Get the children of the node and the new child
+    int32 entries[nbEntries];
+    AABB entriesAABB[nbEntries];
+    for (uint i=0; i < WIDE_TREE_NB_MAX_CHILDREN; i++) {
+        entries[i] = mNodes[nodeID].children[i];
+    }
+    entries[WIDE_TREE_NB_MAX_CHILDREN] = child;
+    for (uint i=0; i < nbEntries; i++) {
+        entriesAABB[i] = getChildAABB(entries[i]);
+    }
+
+    uint bestOrder[nbEntries];
+    uint bestSplit = 0;
+    decimal bestCost = DECIMAL_LARGEST;
+
+    for (int axis=0; axis < 3; axis++) {
+
+        // Sort the children by the center of their AABB along the axis
+        uint order[nbEntries];
+        for (uint i=0; i < nbEntries; i++) {
+            order[i] = i;
+            const decimal center = entriesAABB[i].getMin()[axis] + entriesAABB[i].getMax()[axis];
+            uint j = i;
+            while (j > 0 && entriesAABB[order[j - 1]].getMin()[axis] + entriesAABB[order[j - 1]].getMax()[axis] > center) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = i;
+        }
+
+        // Compute the surface areas of the first k children and of the last children
+        decimal firstAreas[nbEntries];
+        decimal lastAreas[nbEntries];
+        AABB firstAABB = entriesAABB[order[0]];
+        AABB lastAABB = entriesAABB[order[nbEntries - 1]];
+        for (uint k=1; k < nbEntries; k++) {
+            firstAreas[k] = computeHalfSurfaceArea(firstAABB);
+            firstAABB.mergeWithAABB(entriesAABB[order[k]]);
+            lastAreas[nbEntries - k] = computeHalfSurfaceArea(lastAABB);
+            lastAABB.mergeWithAABB(entriesAABB[order[nbEntries - k - 1]]);
+        }
+
+        for (uint k=minNbEntriesPerNode; k <= nbEntries - minNbEntriesPerNode; k++) {
+            const decimal cost = firstAreas[k] + lastAreas[k];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = k;
+                std::memcpy(bestOrder, order, sizeof(order));
+            }
+        }
+    }
+
+    assert(bestSplit > 0);
+
+    // Create the new node (note that the allocation of the node can move the nodes in memory)
+    const int32 newNodeID = allocateNode();
+    mNodes[newNodeID].height = mNodes[nodeID].height;
+
+    // Distribute the children between the two nodes
+    mNodes[nodeID].nbChildren = 0;
+    for (uint k=0; k < nbEntries; k++) {
+        addChild(k < bestSplit ? nodeID : newNodeID, entries[bestOrder[k]]);
+    }
+    refitNode(nodeID);
+    refitNode(newNodeID);
+
+    // If the root has been split, we create a new root
+    if (nodeID == mRootNodeID) {
+
+        const int32 newRootID = allocateNode();
+        mNodes[newRootID].height = mNodes[nodeID].height + 1;
+        addChild(newRootID, nodeID);
+        addChild(newRootID, newNodeID);
+        refitNode(newRootID);
+        mRootNodeID = newRootID;
+    }
+    else {
+        addChildOrSplitNode(mNodes[nodeID].parentID, newNodeID);
+    }
+}
+
+// Remove the child at a given index of a node (the last child takes its place)
+void DynamicWideAABBTree::removeChild(int32 nodeID, uint index) {
+
+    WideTreeNode& node = mNodes[nodeID];
+    assert(index < node.nbChildren);
+
+    const uint lastIndex = node.nbChildren - 1u;
+    if (index != lastIndex) {
+        node.children[index] = node.children[lastIndex];
+        setChildLocation(node.children[index], nodeID, index);
+    }
+    node.nbChildren--;
+}
+
+// Remove an object from the tree. As in an R-tree, the nodes (except the root) that are left
+// with less than two children are removed and their remaining child is inserted again.
+void DynamicWideAABBTree::removeObjectFromNode(int32 objectID) {
+
+    int32 nodeID = mObjects[objectID].nodeID;
+    removeChild(nodeID, static_cast<uint>(mObjects[objectID].indexInNode));
+    mObjects[objectID].nodeID = -1;
+
+    // Remove the nodes with less than two children and keep their remaining child
+    int32 orphans[64];
+    uint nbOrphans = 0;
+    while (nodeID != mRootNodeID && mNodes[nodeID].nbChildren < 2) {
+
+        const WideTreeNode& node = mNodes[nodeID];
+        if (node.nbChildren == 1) {
+            assert(nbOrphans < 64);
+            orphans[nbOrphans] = node.children[0];
+            nbOrphans++;
+        }
+
+        const int32 parentID = node.parentID;
+        const uint indexInParent = node.indexInParent;
+        releaseNode(nodeID);
+        removeChild(parentID, indexInParent);
+        nodeID = parentID;
+    }
+
+    // Refit the remaining ancestors or remove the root if it is empty
+    if (mNodes[nodeID].nbChildren > 0) {
+        refitNodeAndAncestors(nodeID);
+    }
+    else {
+        assert(nodeID == mRootNodeID);
+        releaseNode(mRootNodeID);
+        mRootNodeID = -1;
+    }
+
+    // Insert the orphans again (the highest one first in case the tree is now empty)
+    for (uint i=nbOrphans; i > 0; i--) {
+        const int32 orphan = orphans[i - 1];
+        insertChild(orphan, isObject(orphan) ? 0 : mNodes[orphan].height + 1);
+    }
+
+    // Remove the root while it has a single child node
+    while (mRootNodeID != -1 && mNodes[mRootNodeID].height > 0 && mNodes[mRootNodeID].nbChildren == 1) {
+        const int32 newRootID = mNodes[mRootNodeID].children[0];
+        releaseNode(mRootNodeID);
+        mRootNodeID = newRootID;
+        mNodes[mRootNodeID].parentID = -1;
+        mNodes[mRootNodeID].indexInParent = 0;
+    }
+}
+
+// Recompute the AABB of a node from the AABBs of its children and quantize the AABBs of
+// its children. If the AABB of the node does not change and the index of the only child
+// that has changed is given, only this child is quantized again. The method returns true
+// if the AABB of the node has changed.
+bool DynamicWideAABBTree::refitNode(int32 nodeID, int changedChildIndex) {
+
+    WideTreeNode& node = mNodes[nodeID];
+    assert(node.nbChildren > 0);
+
+    // Compute the union of the AABBs of the children
+    AABB aabb = getChildAABB(node.children[0]);
+    for (uint i=1; i < node.nbChildren; i++) {
+        aabb.mergeWithAABB(getChildAABB(node.children[i]));
+    }
+
+    const bool hasChanged = !(aabb.getMin() == node.aabb.getMin() && aabb.getMax() == node.aabb.getMax());
+    node.aabb = aabb;
+
+    // Compute the quantization step along each axis. The step is large enough for the
+    // quantized coordinates to cover the node with one step of margin and is never smaller
+    // than the rounding error of the dequantized coordinates.
+    const Vector3& min = aabb.getMin();
+    const Vector3& max = aabb.getMax();
+    Vector3 inverseStep;
+    for (int axis=0; axis < 3; axis++) {
+        const decimal magnitude = std::max(std::abs(min[axis]), std::abs(max[axis]));
+        decimal step = std::max((max[axis] - min[axis]) / (MAX_QUANTIZED_COORDINATE - decimal(2.0)),
+                                magnitude * MACHINE_EPSILON * decimal(16.0));
+        if (step == decimal(0.0)) step = decimal(1.0);
+        node.quantizationStep[axis] = step;
+        inverseStep[axis] = decimal(1.0) / step;
+    }
+
+    // Quantize the AABBs of the children
+    if (!hasChanged && changedChildIndex >= 0) {
+        quantizeChildAABB(node, static_cast<uint>(changedChildIndex), getChildAABB(node.children[changedChildIndex]), inverseStep);
+    }
+    else {
+        for (uint i=0; i < node.nbChildren; i++) {
+            quantizeChildAABB(node, i, getChildAABB(node.children[i]), inverseStep);
+        }
+    }
+
+    return hasChanged;
+}
+
+// Recompute the AABB and the quantized children AABBs of a node and of its ancestors. We
+// stop going up as soon as the AABB of a node does not change.
+void DynamicWideAABBTree::refitNodeAndAncestors(int32 nodeID, int changedChildIndex) {
+
+    while (nodeID != -1) {
+
+        if (!refitNode(nodeID, changedChildIndex)) return;
+
+        changedChildIndex = mNodes[nodeID].indexInParent;
+        nodeID = mNodes[nodeID].parentID;
+    }
+}
+
+// Quantize the AABB of a child of a node. The quantized AABB is rounded outward by one more
+// step so that it always contains the child AABB once dequantized. The coordinates are
+// rounded by truncation (they are clamped to positive values first).
+void DynamicWideAABBTree::quantizeChildAABB(WideTreeNode& node, uint index, const AABB& childAABB,
+                                            const Vector3& inverseStep) const {
+
+    for (int axis=0; axis < 3; axis++) {
+
+        const decimal origin = node.aabb.getMin()[axis];
+
+        const decimal quantizedMin = (childAABB.getMin()[axis] - origin) * inverseStep[axis] - decimal(1.0);
+        const decimal quantizedMax = (childAABB.getMax()[axis] - origin) * inverseStep[axis] + decimal(2.0);
+
+        node.childrenMin[axis][index] = static_cast<uint16>(clamp(quantizedMin, decimal(0.0), MAX_QUANTIZED_COORDINATE));
+        node.childrenMax[axis][index] = static_cast<uint16>(clamp(quantizedMax, decimal(0.0), MAX_QUANTIZED_COORDINATE));
+    }
+}
+
+// Return the bit mask of the children of a node whose quantized AABB overlaps an AABB
+uint DynamicWideAABBTree::computeOverlappingChildren(const WideTreeNode& node, const AABB& aabb) const {
+
+    uint mask = (1u << node.nbChildren) - 1u;
+
+    for (int axis=0; axis < 3; axis++) {
+
+        const SimdDecimal origin = SimdDecimal::broadcast(node.aabb.getMin()[axis]);
+        const SimdDecimal step = SimdDecimal::broadcast(node.quantizationStep[axis]);
+        const SimdDecimal childrenMin = origin + SimdDecimal::loadUint16(node.childrenMin[axis]) * step;
+        const SimdDecimal childrenMax = origin + SimdDecimal::loadUint16(node.childrenMax[axis]) * step;
+
+        mask &= SimdDecimal::maskLessOrEqual(childrenMin, SimdDecimal::broadcast(aabb.getMax()[axis]));
+        mask &= SimdDecimal::maskLessOrEqual(SimdDecimal::broadcast(aabb.getMin()[axis]), childrenMax);
+    }
+
+    return mask;
+}
+
+// Return the bit mask of the children of a node whose quantized AABB is hit by a ray
+// (slab test). The inverse direction of the ray is never infinite so that no NaN appears.
+uint DynamicWideAABBTree::computeRayHitChildren(const WideTreeNode& node, const Vector3& rayOrigin,
+                                                const Vector3& rayInverseDirection, decimal maxFraction) const {
+
+    SimdDecimal tMin = SimdDecimal::broadcast(decimal(0.0));
+    SimdDecimal tMax = SimdDecimal::broadcast(maxFraction);
+
+    for (int axis=0; axis < 3; axis++) {
+
+        const SimdDecimal origin = SimdDecimal::broadcast(node.aabb.getMin()[axis] - rayOrigin[axis]);
+        const SimdDecimal step = SimdDecimal::broadcast(node.quantizationStep[axis]);
+        const SimdDecimal inverseDirection = SimdDecimal::broadcast(rayInverseDirection[axis]);
+        const SimdDecimal t1 = (origin + SimdDecimal::loadUint16(node.childrenMin[axis]) * step) * inverseDirection;
+        const SimdDecimal t2 = (origin + SimdDecimal::loadUint16(node.childrenMax[axis]) * step) * inverseDirection;
+
+        tMin = SimdDecimal::max(tMin, SimdDecimal::min(t1, t2));
+        tMax = SimdDecimal::min(tMax, SimdDecimal::max(t1, t2));
+    }
+
+    return SimdDecimal::maskLessOrEqual(tMin - SimdDecimal::broadcast(RAY_HIT_FRACTION_TOLERANCE), tMax) &
+           ((1u << node.nbChildren) - 1u);
+}
+
+/// Take a list of shapes to be tested for broad-phase overlap and return a list of pair of overlapping shapes
+void DynamicWideAABBTree::reportAllShapesOverlappingWithShapes(const List<int32>& nodesToTest, size_t startIndex,
+                                                               size_t endIndex, List<Pair<int32, int32>>& outOverlappingNodes) const {
+
+    RP3D_PROFILE("DynamicWideAABBTree::reportAllShapesOverlappingWithShapes()", mProfiler);
+
+    if (mRootNodeID == -1) return;
+
+    // Create a stack with the nodes to visit
+    Stack<int32> stack(mAllocator, 64);
+
+    // For each shape to be tested for overlap
+    for (size_t i=startIndex; i < endIndex; i++) {
+
+        assert(nodesToTest[i] != -1);
+
+        stack.push(mRootNodeID);
+
+        const AABB& shapeAABB = getFatAABB(nodesToTest[i]);
+
+        // While there are still nodes to visit
+        while(stack.size() > 0) {
+
+            const WideTreeNode& node = mNodes[stack.pop()];
+
+            // Test the AABB in parameter against all the children of the node at once
+            const uint overlappingChildren = computeOverlappingChildren(node, shapeAABB);
+
+            for (uint c=0; c < node.nbChildren; c++) {
+
+                if ((overlappingChildren & (1u << c)) == 0) continue;
+
+                const int32 child = node.children[c];
+
+                // If the child is an object, we test its exact fat AABB
+                if (isObject(child)) {
+
+                    const int32 objectID = decodeObject(child);
+                    if (shapeAABB.testCollision(mObjects[objectID].aabb)) {
+
+                        // Add the object in the list of overlapping nodes
+                        outOverlappingNodes.add(Pair<int32, int32>(nodesToTest[i], objectID));
+                    }
+                }
+                else {
+
+                    // We need to visit the child node
+                    stack.push(child);
+                }
+            }
+        }
+    }
+}
+
+// Report all shapes overlapping with the AABB given in parameter.
+void DynamicWideAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int32>& overlappingNodes) const {
+
+    RP3D_PROFILE("DynamicWideAABBTree::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    if (mRootNodeID == -1) return;
+
+    // Create a stack with the nodes to visit
+    Stack<int32> stack(mAllocator, 64);
+    stack.push(mRootNodeID);
+
+    // While there are still nodes to visit
+    while(stack.size() > 0) {
+
+        const WideTreeNode& node = mNodes[stack.pop()];
+
+        // Test the AABB in parameter against all the children of the node at once
+        const uint overlappingChildren = computeOverlappingChildren(node, aabb);
+
+        for (uint c=0; c < node.nbChildren; c++) {
+
+            if ((overlappingChildren & (1u << c)) == 0) continue;
+
+            const int32 child = node.children[c];
+
+            // If the child is an object, we test its exact fat AABB
+            if (isObject(child)) {
+
+                const int32 objectID = decodeObject(child);
+                if (aabb.testCollision(mObjects[objectID].aabb)) {
+                    overlappingNodes.add(objectID);
+                }
+            }
+            else {
+
+                // We need to visit the child node
+                stack.push(child);
+            }
+        }
+    }
+}
+
+// Ray casting method
+void DynamicWideAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+    raycast(ray, callback, mAllocator);
+}
+
+// Ray casting method with the allocator to use for the traversal stack. Using an allocator
+// that is not shared with the tree allows to raycast the tree from several threads at the same time.
+void DynamicWideAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback,
+                                  MemoryAllocator& stackAllocator) const {
+
+    RP3D_PROFILE("DynamicWideAABBTree::raycast()", mProfiler);
+
+    if (mRootNodeID == -1) return;
+
+    decimal maxFraction = ray.maxFraction;
+
+    // Compute the inverse of the ray direction (clamped to finite values)
+    const Vector3 direction = ray.point2 - ray.point1;
+    Vector3 inverseDirection;
+    for (int axis=0; axis < 3; axis++) {
+        inverseDirection[axis] = direction[axis] == decimal(0.0) ? DECIMAL_LARGEST :
+                                 clamp(decimal(1.0) / direction[axis], DECIMAL_SMALLEST, DECIMAL_LARGEST);
+    }
+
+    Stack<int32> stack(stackAllocator, 128);
+    stack.push(mRootNodeID);
+
+    // Walk through the tree from the root looking for colliders
+    // that overlap with the ray AABB
+    while (stack.size() > 0) {
+
+        const WideTreeNode& node = mNodes[stack.pop()];
+
+        // Test the ray against all the children of the node at once
+        const uint hitChildren = computeRayHitChildren(node, ray.point1, inverseDirection, maxFraction);
+
+        for (uint c=0; c < node.nbChildren; c++) {
+
+            if ((hitChildren & (1u << c)) == 0) continue;
+
+            const int32 child = node.children[c];
+
+            // If the child is a node, we need to visit it
+            if (!isObject(child)) {
+                stack.push(child);
+                continue;
+            }
+
+            const int32 objectID = decodeObject(child);
+
+            Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
+            // Test if the ray intersects with the fat AABB of the object
+            if (!mObjects[objectID].aabb.testRayIntersect(rayTemp)) continue;
+
+            // Call the callback that will raycast again the broad-phase shape
+            decimal hitFraction = callback.raycastBroadPhaseShape(objectID, rayTemp);
+
+            // If the user returned a hitFraction of zero, it means that
+            // the raycasting should stop here
+            if (hitFraction == decimal(0.0)) {
+                return;
+            }
+
+            // If the user returned a positive fraction
+            if (hitFraction > decimal(0.0)) {
+
+                // We update the maxFraction value using the new maximum fraction
+                if (hitFraction < maxFraction) {
+                    maxFraction = hitFraction;
+                }
+            }
+
+            // If the user returned a negative fraction, we continue
+            // the raycasting as if the collider did not exist
+        }
+    }
+}
+
+// Compute the height of the tree
+int DynamicWideAABBTree::computeHeight() const {
+    return mRootNodeID == -1 ? 0 : mNodes[mRootNodeID].height + 1;
+}
+
+#ifndef NDEBUG
+
+// Check if the tree structure is valid (for debugging purpose)
+void DynamicWideAABBTree::check() const {
+
+    if (mRootNodeID == -1) {
+        assert(mNbNodes == 0);
+        assert(mNbObjects == 0);
+        return;
+    }
+
+    assert(mNodes[mRootNodeID].parentID == -1);
+
+    // Recursively check each node
+    checkNode(mRootNodeID);
+
+    // Check the free lists
+    int nbFreeNodes = 0;
+    for (int32 freeNodeID = mFreeNodeID; freeNodeID != -1; freeNodeID = mNodes[freeNodeID].nextNodeID) {
+        assert(mNodes[freeNodeID].nbChildren == 0);
+        nbFreeNodes++;
+    }
+    assert(mNbNodes + nbFreeNodes == mNbAllocatedNodes);
+
+    int nbFreeObjects = 0;
+    for (int32 freeObjectID = mFreeObjectID; freeObjectID != -1; freeObjectID = mObjects[freeObjectID].nextObjectID) {
+        assert(mObjects[freeObjectID].indexInNode == -1);
+        nbFreeObjects++;
+    }
+    assert(mNbObjects + nbFreeObjects == mNbAllocatedObjects);
+}
+
+// Check if the node structure is valid (for debugging purpose)
+void DynamicWideAABBTree::checkNode(int32 nodeID) const {
+
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+
+    const WideTreeNode& node = mNodes[nodeID];
+
+    // Only the root can have a single child
+    assert(node.nbChildren >= (nodeID == mRootNodeID ? 1u : 2u));
+    assert(node.nbChildren <= WIDE_TREE_NB_MAX_CHILDREN);
+
+    for (uint i=0; i < node.nbChildren; i++) {
+
+        const int32 child = node.children[i];
+        const AABB& childAABB = getChildAABB(child);
+
+        // Check the location and the height of the child (all the objects are at the same depth)
+        if (isObject(child)) {
+            assert(node.height == 0);
+            assert(mObjects[decodeObject(child)].nodeID == nodeID);
+            assert(mObjects[decodeObject(child)].indexInNode == static_cast<int32>(i));
+        }
+        else {
+            assert(mNodes[child].height + 1 == node.height);
+            assert(mNodes[child].parentID == nodeID);
+            assert(mNodes[child].indexInParent == i);
+        }
+
+        // Check that the AABB of the node and the quantized AABB of the child contain the child AABB
+        assert(node.aabb.contains(childAABB));
+        for (int axis=0; axis < 3; axis++) {
+            assert(node.aabb.getMin()[axis] + decimal(node.childrenMin[axis][i]) * node.quantizationStep[axis] <= childAABB.getMin()[axis]);
+            assert(node.aabb.getMin()[axis] + decimal(node.childrenMax[axis][i]) * node.quantizationStep[axis] >= childAABB.getMax()[axis]);
+        }
+
+        if (!isObject(child)) {
+            checkNode(child);
+        }
+    }
+}
+
+#endif
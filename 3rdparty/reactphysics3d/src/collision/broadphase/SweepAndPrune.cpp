@@ -0,0 +1,488 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/SweepAndPrune.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Constructor
+SweepAndPrune::SweepAndPrune(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
+              : mAllocator(allocator), mNewOverlappingPairs(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage) {
+
+    init();
+}
+
+// Destructor
+SweepAndPrune::~SweepAndPrune() {
+
+    // Free the allocated memory for the objects and the endpoints
+    mAllocator.release(mObjects, static_cast<size_t>(mNbAllocatedObjects) * sizeof(SweepAndPruneObject));
+    for (int axis=0; axis < 3; axis++) {
+        mAllocator.release(mEndPoints[axis], static_cast<size_t>(2 * mNbAllocatedObjects) * sizeof(SweepAndPruneEndPoint));
+    }
+}
+
+// Initialize the sweep and prune
+void SweepAndPrune::init() {
+
+    mNbObjects = 0;
+    mNbAllocatedObjects = 16;
+
+    // Allocate memory for the objects
+    mObjects = static_cast<SweepAndPruneObject*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedObjects) * sizeof(SweepAndPruneObject)));
+    assert(mObjects);
+    std::memset(mObjects, 0, static_cast<size_t>(mNbAllocatedObjects) * sizeof(SweepAndPruneObject));
+
+    // Initialize the allocated objects
+    for (int32 i=0; i<mNbAllocatedObjects; i++) {
+        mObjects[i].nextObjectID = i + 1 < mNbAllocatedObjects ? i + 1 : -1;
+        mObjects[i].minEndPoints[0] = -1;
+    }
+    mFreeObjectID = 0;
+
+    // Allocate memory for the endpoints (two endpoints per object on each axis)
+    for (int axis=0; axis < 3; axis++) {
+        mEndPoints[axis] = static_cast<SweepAndPruneEndPoint*>(mAllocator.allocate(static_cast<size_t>(2 * mNbAllocatedObjects) * sizeof(SweepAndPruneEndPoint)));
+        assert(mEndPoints[axis]);
+    }
+
+    mNewOverlappingPairs.clear();
+}
+
+// Clear all the objects and reset the sweep and prune
+void SweepAndPrune::reset() {
+
+    // Free the allocated memory for the objects and the endpoints
+    mAllocator.release(mObjects, static_cast<size_t>(mNbAllocatedObjects) * sizeof(SweepAndPruneObject));
+    for (int axis=0; axis < 3; axis++) {
+        mAllocator.release(mEndPoints[axis], static_cast<size_t>(2 * mNbAllocatedObjects) * sizeof(SweepAndPruneEndPoint));
+    }
+
+    // Initialize the sweep and prune
+    init();
+}
+
+// Allocate and return a new object ID
+int32 SweepAndPrune::allocateObject() {
+
+    // If there is no more allocated object to use
+    if (mFreeObjectID == -1) {
+
+        assert(mNbObjects == mNbAllocatedObjects);
+
+        // Allocate more objects
+        int32 oldNbAllocatedObjects = mNbAllocatedObjects;
+        mNbAllocatedObjects *= 2;
+        SweepAndPruneObject* oldObjects = mObjects;
+        mObjects = static_cast<SweepAndPruneObject*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedObjects) * sizeof(SweepAndPruneObject)));
+        assert(mObjects);
+        std::memcpy(mObjects, oldObjects, static_cast<size_t>(mNbObjects) * sizeof(SweepAndPruneObject));
+        mAllocator.release(oldObjects, static_cast<size_t>(oldNbAllocatedObjects) * sizeof(SweepAndPruneObject));
+
+        // Initialize the allocated objects
+        for (int32 i=mNbObjects; i<mNbAllocatedObjects; i++) {
+            mObjects[i].nextObjectID = i + 1 < mNbAllocatedObjects ? i + 1 : -1;
+            mObjects[i].minEndPoints[0] = -1;
+        }
+        mFreeObjectID = mNbObjects;
+
+        // Allocate more endpoints
+        for (int axis=0; axis < 3; axis++) {
+            SweepAndPruneEndPoint* oldEndPoints = mEndPoints[axis];
+            mEndPoints[axis] = static_cast<SweepAndPruneEndPoint*>(mAllocator.allocate(static_cast<size_t>(2 * mNbAllocatedObjects) * sizeof(SweepAndPruneEndPoint)));
+            assert(mEndPoints[axis]);
+            std::memcpy(mEndPoints[axis], oldEndPoints, static_cast<size_t>(2 * mNbObjects) * sizeof(SweepAndPruneEndPoint));
+            mAllocator.release(oldEndPoints, static_cast<size_t>(2 * oldNbAllocatedObjects) * sizeof(SweepAndPruneEndPoint));
+        }
+    }
+
+    // Get the next free object
+    int32 freeObjectID = mFreeObjectID;
+    mFreeObjectID = mObjects[freeObjectID].nextObjectID;
+    mNbObjects++;
+
+    return freeObjectID;
+}
+
+// Release an object ID
+void SweepAndPrune::releaseObject(int32 objectID) {
+
+    assert(mNbObjects > 0);
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    mObjects[objectID].nextObjectID = mFreeObjectID;
+    mObjects[objectID].minEndPoints[0] = -1;
+    mFreeObjectID = objectID;
+    mNbObjects--;
+}
+
+// Add an object. This method inserts the endpoints of the fat AABB of a new object in
+// the sorted arrays and returns the ID of the object. The overlapping pairs with the new
+// object are not added into the pair cache. They have to be found with
+// reportAllShapesOverlappingWithShapes().
+int32 SweepAndPrune::addObject(const AABB& aabb, void* data) {
+
+    RP3D_PROFILE("SweepAndPrune::addObject()", mProfiler);
+
+    int32 objectID = allocateObject();
+    SweepAndPruneObject& object = mObjects[objectID];
+
+    // Create the fat aabb (inflate the aabb by a constant percentage of its size)
+    const Vector3 gap(aabb.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+    object.aabb = AABB(aabb.getMin() - gap, aabb.getMax() + gap);
+    object.dataPointer = data;
+
+    // Index of the first free endpoint in the arrays
+    const int32 endPointIndex = 2 * (mNbObjects - 1);
+
+    for (int axis=0; axis < 3; axis++) {
+
+        // Add the two endpoints at the end of the array and move them to their sorted position
+        mEndPoints[axis][endPointIndex].value = object.aabb.getMin()[axis];
+        mEndPoints[axis][endPointIndex].data = static_cast<uint32>(objectID) << 1;
+        mEndPoints[axis][endPointIndex + 1].value = object.aabb.getMax()[axis];
+        mEndPoints[axis][endPointIndex + 1].data = (static_cast<uint32>(objectID) << 1) | 1;
+        object.minEndPoints[axis] = endPointIndex;
+        object.maxEndPoints[axis] = endPointIndex + 1;
+
+        sortEndPoint(axis, object.minEndPoints[axis], false);
+        sortEndPoint(axis, object.maxEndPoints[axis], false);
+    }
+
+    return objectID;
+}
+
+// Remove an object
+void SweepAndPrune::removeObject(int32 objectID) {
+
+    RP3D_PROFILE("SweepAndPrune::removeObject()", mProfiler);
+
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].minEndPoints[0] >= 0);
+
+    const int32 nbEndPoints = 2 * mNbObjects;
+
+    // Remove the two endpoints of the object from the array of each axis
+    for (int axis=0; axis < 3; axis++) {
+
+        SweepAndPruneEndPoint* endPoints = mEndPoints[axis];
+        int32 writeIndex = mObjects[objectID].minEndPoints[axis];
+        for (int32 readIndex = writeIndex + 1; readIndex < nbEndPoints; readIndex++) {
+
+            if (endPoints[readIndex].getObjectID() == objectID) continue;
+
+            endPoints[writeIndex] = endPoints[readIndex];
+            setEndPointIndex(axis, writeIndex);
+            writeIndex++;
+        }
+
+        assert(writeIndex == nbEndPoints - 2);
+    }
+
+    releaseObject(objectID);
+}
+
+// Update the sweep and prune after an object has moved.
+/// If the new AABB of the object that has moved is still inside its fat AABB, then
+/// nothing is done. Otherwise, the fat AABB of the object is recomputed and its endpoints are
+/// moved to their new sorted positions. The pairs of objects that start to overlap during this
+/// sort are added into the pair cache. The method returns true if the fat AABB of the object
+/// has changed.
+/// If the "forceReInsert" parameter is true, we force the existing AABB to take the size
+/// of the "newAABB" parameter even if it is larger than "newAABB". This can be used to shrink the
+/// AABB in the sweep and prune for instance if the corresponding collision shape has been shrunk.
+bool SweepAndPrune::updateObject(int32 objectID, const AABB& newAABB, bool forceReinsert) {
+
+    RP3D_PROFILE("SweepAndPrune::updateObject()", mProfiler);
+
+    assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+    assert(mObjects[objectID].minEndPoints[0] >= 0);
+
+    SweepAndPruneObject& object = mObjects[objectID];
+
+    // If the new AABB is still inside the fat AABB of the object
+    if (!forceReinsert && object.aabb.contains(newAABB)) {
+        return false;
+    }
+
+    // Compute the fat AABB by inflating the AABB with by a constant percentage of the size of the AABB
+    const Vector3 gap(newAABB.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+    object.aabb = AABB(newAABB.getMin() - gap, newAABB.getMax() + gap);
+
+    assert(object.aabb.contains(newAABB));
+
+    // Move the endpoints of the object on each axis. The new fat AABB is set before sorting so
+    // that the overlap test of a new pair uses the final AABB on all the axes.
+    for (int axis=0; axis < 3; axis++) {
+
+        SweepAndPruneEndPoint& minEndPoint = mEndPoints[axis][object.minEndPoints[axis]];
+        SweepAndPruneEndPoint& maxEndPoint = mEndPoints[axis][object.maxEndPoints[axis]];
+        const bool isMaxMovingUp = object.aabb.getMax()[axis] > maxEndPoint.value;
+        minEndPoint.value = object.aabb.getMin()[axis];
+        maxEndPoint.value = object.aabb.getMax()[axis];
+
+        // The minimum endpoint cannot pass the maximum endpoint of its object. Therefore, the
+        // maximum endpoint has to be sorted first when it moves up.
+        if (isMaxMovingUp) {
+            sortEndPoint(axis, object.maxEndPoints[axis], true);
+            sortEndPoint(axis, object.minEndPoints[axis], true);
+        }
+        else {
+            sortEndPoint(axis, object.minEndPoints[axis], true);
+            sortEndPoint(axis, object.maxEndPoints[axis], true);
+        }
+    }
+
+    return true;
+}
+
+// Move an endpoint to its sorted position in the array of an axis (insertion sort). A pair
+// can only start to overlap when a minimum endpoint moves down past the maximum endpoint of
+// another object or when a maximum endpoint moves up past the minimum endpoint of another
+// object. In this case, the pair is added into the pair cache if the fat AABBs overlap.
+// The endpoints of an object never pass each other because a minimum endpoint is sorted
+// before a maximum endpoint with the same value.
+void SweepAndPrune::sortEndPoint(int axis, int32 index, bool addNewOverlappingPairs) {
+
+    SweepAndPruneEndPoint* endPoints = mEndPoints[axis];
+    const SweepAndPruneEndPoint endPoint = endPoints[index];
+    const int32 objectID = endPoint.getObjectID();
+    const int32 nbEndPoints = 2 * mNbObjects;
+
+    // Move the endpoint down
+    while (index > 0 && isEndPointLess(endPoint, endPoints[index - 1])) {
+
+        const SweepAndPruneEndPoint& previous = endPoints[index - 1];
+        if (addNewOverlappingPairs && !endPoint.isMax() && previous.isMax()) {
+            addNewOverlappingPair(objectID, previous.getObjectID());
+        }
+
+        endPoints[index] = previous;
+        setEndPointIndex(axis, index);
+        index--;
+    }
+
+    // Move the endpoint up
+    while (index + 1 < nbEndPoints && isEndPointLess(endPoints[index + 1], endPoint)) {
+
+        const SweepAndPruneEndPoint& next = endPoints[index + 1];
+        if (addNewOverlappingPairs && endPoint.isMax() && !next.isMax()) {
+            addNewOverlappingPair(objectID, next.getObjectID());
+        }
+
+        endPoints[index] = next;
+        setEndPointIndex(axis, index);
+        index++;
+    }
+
+    endPoints[index] = endPoint;
+    setEndPointIndex(axis, index);
+}
+
+// Add a pair of objects whose endpoints have started to overlap on an axis into the pair
+// cache if their fat AABBs overlap on all the axes
+void SweepAndPrune::addNewOverlappingPair(int32 objectID1, int32 objectID2) {
+
+    assert(objectID1 != objectID2);
+
+    if (mObjects[objectID1].aabb.testCollision(mObjects[objectID2].aabb)) {
+        mNewOverlappingPairs.add(Pair<int32, int32>(objectID1, objectID2));
+    }
+}
+
+// Report the pairs of objects that have started to overlap since the last call and clear
+// the pair cache. A pair is only reported if both objects are still in the sweep and prune
+// and if their fat AABBs still overlap. A pair can be reported more than once.
+void SweepAndPrune::reportNewOverlappingPairs(List<Pair<int32, int32>>& outOverlappingNodes) {
+
+    RP3D_PROFILE("SweepAndPrune::reportNewOverlappingPairs()", mProfiler);
+
+    for (uint i=0; i < mNewOverlappingPairs.size(); i++) {
+
+        const Pair<int32, int32>& pair = mNewOverlappingPairs[i];
+        const SweepAndPruneObject& object1 = mObjects[pair.first];
+        const SweepAndPruneObject& object2 = mObjects[pair.second];
+
+        if (object1.minEndPoints[0] >= 0 && object2.minEndPoints[0] >= 0 &&
+            object1.aabb.testCollision(object2.aabb)) {
+
+            outOverlappingNodes.add(pair);
+        }
+    }
+
+    mNewOverlappingPairs.clear();
+}
+
+// Report all shapes overlapping with all the shapes in the map in parameter. The endpoints
+// of the first axis are swept from the side of the array that is the closest to the shape.
+void SweepAndPrune::reportAllShapesOverlappingWithShapes(const List<int32>& nodesToTest, size_t startIndex,
+                                                         size_t endIndex, List<Pair<int32, int32>>& outOverlappingNodes) const {
+
+    RP3D_PROFILE("SweepAndPrune::reportAllShapesOverlappingWithShapes()", mProfiler);
+
+    const SweepAndPruneEndPoint* endPoints = mEndPoints[0];
+    const int32 nbEndPoints = 2 * mNbObjects;
+
+    // For each shape to be tested for overlap
+    for (size_t i=startIndex; i < endIndex; i++) {
+
+        const int32 objectID = nodesToTest[i];
+        assert(objectID >= 0 && objectID < mNbAllocatedObjects);
+
+        const SweepAndPruneObject& object = mObjects[objectID];
+        const AABB& shapeAABB = object.aabb;
+
+        // If there are fewer endpoints before the maximum of the shape than after its minimum
+        if (object.maxEndPoints[0] < nbEndPoints - object.minEndPoints[0]) {
+
+            // Test the objects whose minimum is smaller than the maximum of the shape
+            for (int32 e=0; e < nbEndPoints && endPoints[e].value <= shapeAABB.getMax().x; e++) {
+
+                const int32 otherObjectID = endPoints[e].getObjectID();
+                if (!endPoints[e].isMax() && otherObjectID != objectID &&
+                    shapeAABB.testCollision(mObjects[otherObjectID].aabb)) {
+
+                    outOverlappingNodes.add(Pair<int32, int32>(objectID, otherObjectID));
+                }
+            }
+        }
+        else {
+
+            // Test the objects whose maximum is larger than the minimum of the shape
+            for (int32 e=nbEndPoints - 1; e >= 0 && endPoints[e].value >= shapeAABB.getMin().x; e--) {
+
+                const int32 otherObjectID = endPoints[e].getObjectID();
+                if (endPoints[e].isMax() && otherObjectID != objectID &&
+                    shapeAABB.testCollision(mObjects[otherObjectID].aabb)) {
+
+                    outOverlappingNodes.add(Pair<int32, int32>(objectID, otherObjectID));
+                }
+            }
+        }
+    }
+}
+
+// Report all the objects overlapping with the AABB given in parameter. The endpoints of the x
+// axis are swept from the start until the maximum of the AABB.
+void SweepAndPrune::reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int>& overlappingNodes) const {
+
+    RP3D_PROFILE("SweepAndPrune::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    const SweepAndPruneEndPoint* endPoints = mEndPoints[0];
+    const int32 nbEndPoints = 2 * mNbObjects;
+
+    // Test the objects whose minimum is smaller than the maximum of the AABB
+    for (int32 e=0; e < nbEndPoints && endPoints[e].value <= aabb.getMax().x; e++) {
+
+        const int32 objectID = endPoints[e].getObjectID();
+        if (!endPoints[e].isMax() && aabb.testCollision(mObjects[objectID].aabb)) {
+            overlappingNodes.add(objectID);
+        }
+    }
+}
+
+// Ray casting method. The sweep and prune does not accelerate raycasts: the fat AABBs of
+// all the objects are tested against the ray.
+void SweepAndPrune::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+
+    RP3D_PROFILE("SweepAndPrune::raycast()", mProfiler);
+
+    decimal maxFraction = ray.maxFraction;
+
+    for (int32 objectID=0; objectID < mNbAllocatedObjects; objectID++) {
+
+        // Skip the free objects
+        if (mObjects[objectID].minEndPoints[0] < 0) continue;
+
+        Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
+        // Test if the ray intersects with the fat AABB of the object
+        if (!mObjects[objectID].aabb.testRayIntersect(rayTemp)) continue;
+
+        // Call the callback that will raycast again the broad-phase shape
+        decimal hitFraction = callback.raycastBroadPhaseShape(objectID, rayTemp);
+
+        // If the user returned a hitFraction of zero, it means that
+        // the raycasting should stop here
+        if (hitFraction == decimal(0.0)) {
+            return;
+        }
+
+        // If the user returned a positive fraction
+        if (hitFraction > decimal(0.0)) {
+
+            // We update the maxFraction value using the new maximum fraction
+            if (hitFraction < maxFraction) {
+                maxFraction = hitFraction;
+            }
+        }
+
+        // If the user returned a negative fraction, we continue
+        // the raycasting as if the collider did not exist
+    }
+}
+
+#ifndef NDEBUG
+
+// Check if the endpoints arrays are valid (for debugging purpose)
+void SweepAndPrune::check() const {
+
+    const int32 nbEndPoints = 2 * mNbObjects;
+
+    for (int axis=0; axis < 3; axis++) {
+
+        for (int32 e=0; e < nbEndPoints; e++) {
+
+            const SweepAndPruneEndPoint& endPoint = mEndPoints[axis][e];
+            const SweepAndPruneObject& object = mObjects[endPoint.getObjectID()];
+
+            // Check that the endpoints are sorted
+            assert(e == 0 || !isEndPointLess(endPoint, mEndPoints[axis][e - 1]));
+
+            // Check the index and the value of the endpoint in its object
+            if (endPoint.isMax()) {
+                assert(object.maxEndPoints[axis] == e);
+                assert(endPoint.value == object.aabb.getMax()[axis]);
+            }
+            else {
+                assert(object.minEndPoints[axis] == e);
+                assert(endPoint.value == object.aabb.getMin()[axis]);
+            }
+        }
+    }
+
+    // Check the free objects list
+    int32 nbFreeObjects = 0;
+    for (int32 objectID = mFreeObjectID; objectID != -1; objectID = mObjects[objectID].nextObjectID) {
+        assert(mObjects[objectID].minEndPoints[0] == -1);
+        nbFreeObjects++;
+    }
+    assert(nbFreeObjects + mNbObjects == mNbAllocatedObjects);
+}
+
+#endif
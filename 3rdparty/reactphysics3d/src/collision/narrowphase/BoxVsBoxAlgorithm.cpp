@@ -0,0 +1,486 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/BoxVsBoxNarrowPhaseInfoBatch.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+#include <reactphysics3d/mathematics/mathematics_functions.h>
+#include <reactphysics3d/utils/Profiler.h>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Static variables initialization
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_RELATIVE_TOLERANCE = decimal(1.002);
+const decimal BoxVsBoxAlgorithm::SEPARATING_AXIS_ABSOLUTE_TOLERANCE = decimal(0.0005);
+const decimal BoxVsBoxAlgorithm::MIN_EDGES_CROSS_PRODUCT_SQUARE_LENGTH = decimal(0.000001);
+
+// Compute the narrow-phase collision detection between two boxes
+/// The 15 potential separating axes are numbered as follows: 0 to 2 are the face normals of box 1,
+/// 3 to 5 are the face normals of box 2 and 6 + 3 * i + j is the cross product of the i-th edge
+/// direction of box 1 with the j-th edge direction of box 2. All the computations are done in the
+/// local-space of box 1.
+bool BoxVsBoxAlgorithm::testCollision(BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint batchStartIndex, uint batchNbItems,
+                                      bool clipWithPreviousAxisIfStillColliding) {
+
+    RP3D_PROFILE("BoxVsBoxAlgorithm::testCollision()", mProfiler);
+
+    bool isCollisionFound = false;
+
+    for (uint batchIndex = batchStartIndex; batchIndex < batchStartIndex + batchNbItems; batchIndex++) {
+
+        assert(narrowPhaseInfoBatch.contactPoints[batchIndex].size() == 0);
+        assert(!narrowPhaseInfoBatch.isColliding[batchIndex]);
+
+        const Vector3& halfExtents1 = narrowPhaseInfoBatch.box1HalfExtents[batchIndex];
+        const Vector3& halfExtents2 = narrowPhaseInfoBatch.box2HalfExtents[batchIndex];
+
+        // Transform of box 2 in the local-space of box 1. The columns of the rotation
+        // matrix are the axes of box 2 expressed in the local-space of box 1
+        const Transform box2ToBox1 = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex].getInverse() *
+                                     narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex];
+        const Matrix3x3 rotation = box2ToBox1.getOrientation().getMatrix();
+        const Matrix3x3 absRotation = rotation.getAbsoluteMatrix();
+        const Vector3& translation = box2ToBox1.getPosition();
+
+        LastFrameCollisionInfo* lastFrameCollisionInfo = narrowPhaseInfoBatch.lastFrameCollisionInfos[batchIndex];
+        const bool isPreviousAxisValid = lastFrameCollisionInfo->isValid && lastFrameCollisionInfo->wasUsingSAT;
+
+        lastFrameCollisionInfo->wasUsingSAT = true;
+        lastFrameCollisionInfo->wasUsingGJK = false;
+
+        Vector3 normal;
+
+        // If the last frame collision info is valid, we perform temporal coherence and test
+        // the previous separating axis (or axis of minimum penetration) first
+        if (isPreviousAxisValid) {
+
+            const uint previousAxis = getPreviousSeparatingAxis(lastFrameCollisionInfo);
+            const decimal penetrationDepth = testSeparatingAxis(previousAxis, halfExtents1, halfExtents2, rotation, absRotation,
+                                                                translation, normal);
+
+            // If the previous axis was a separating axis and is still a separating axis in this frame
+            if (!lastFrameCollisionInfo->wasColliding && penetrationDepth <= decimal(0.0)) {
+
+                // Return no collision without testing the other axes
+                continue;
+            }
+
+            // If the boxes were colliding along a face normal and still seem to overlap along this axis, we
+            // clip with the same reference face again to keep the contact manifold stable between frames
+            if (lastFrameCollisionInfo->wasColliding && clipWithPreviousAxisIfStillColliding && previousAxis < 6 &&
+                penetrationDepth > decimal(0.0)) {
+
+                if (computeFaceContactPoints(previousAxis, normal, box2ToBox1, narrowPhaseInfoBatch, batchIndex)) {
+
+                    narrowPhaseInfoBatch.isColliding[batchIndex] = true;
+                    isCollisionFound = true;
+                    continue;
+                }
+
+                // The contact manifold is empty. Therefore, we have to test all the axes again
+            }
+        }
+
+        bool isSeparatingAxisFound = false;
+
+        // Find the face normal of each box with minimum penetration depth
+        decimal minPenetrationDepths[2] = {DECIMAL_LARGEST, DECIMAL_LARGEST};
+        uint minFaceAxes[2] = {0, 3};
+        Vector3 minFaceNormals[2];
+        for (uint axis=0; axis < 6; axis++) {
+
+            const decimal penetrationDepth = testSeparatingAxis(axis, halfExtents1, halfExtents2, rotation, absRotation,
+                                                                translation, normal);
+
+            // If we have found a separating axis
+            if (penetrationDepth <= decimal(0.0)) {
+
+                setPreviousSeparatingAxis(lastFrameCollisionInfo, axis);
+                isSeparatingAxisFound = true;
+                break;
+            }
+
+            const uint box = axis / 3;
+            if (penetrationDepth < minPenetrationDepths[box]) {
+                minPenetrationDepths[box] = penetrationDepth;
+                minFaceAxes[box] = axis;
+                minFaceNormals[box] = normal;
+            }
+        }
+
+        if (isSeparatingAxisFound) {
+            continue;
+        }
+
+        // If the two penetration depths are almost the same, we always prefer the face of box 1 for
+        // consistency between frames (same bias as in the SAT algorithm)
+        const uint minFaceBox = minPenetrationDepths[0] < minPenetrationDepths[1] * SEPARATING_AXIS_RELATIVE_TOLERANCE +
+                                                          SEPARATING_AXIS_ABSOLUTE_TOLERANCE ? 0 : 1;
+        const decimal minFacePenetrationDepth = std::min(minPenetrationDepths[0], minPenetrationDepths[1]);
+
+        // Test the cross products of the edge directions
+        decimal minEdgePenetrationDepth = DECIMAL_LARGEST;
+        uint minEdgeAxis = 0;
+        Vector3 minEdgeNormal;
+        for (uint axis=6; axis < 15; axis++) {
+
+            const decimal penetrationDepth = testSeparatingAxis(axis, halfExtents1, halfExtents2, rotation, absRotation,
+                                                                translation, normal);
+
+            // If we have found a separating axis
+            if (penetrationDepth <= decimal(0.0)) {
+
+                setPreviousSeparatingAxis(lastFrameCollisionInfo, axis);
+                isSeparatingAxisFound = true;
+                break;
+            }
+
+            if (penetrationDepth < minEdgePenetrationDepth) {
+                minEdgePenetrationDepth = penetrationDepth;
+                minEdgeAxis = axis;
+                minEdgeNormal = normal;
+            }
+        }
+
+        if (isSeparatingAxisFound) {
+            continue;
+        }
+
+        // Here we know the boxes are overlapping. We favor the face normal axis because face contacts have more
+        // contact points and are therefore more stable than the single contact point of an edge vs edge contact.
+        // We only use an edge vs edge axis if its penetration depth is really smaller.
+        if (minEdgePenetrationDepth * SEPARATING_AXIS_RELATIVE_TOLERANCE + SEPARATING_AXIS_ABSOLUTE_TOLERANCE < minFacePenetrationDepth) {
+
+            // If we need to report contacts
+            if (narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+                computeEdgeContactPoint(minEdgeAxis, minEdgeNormal, minEdgePenetrationDepth, box2ToBox1, narrowPhaseInfoBatch, batchIndex);
+            }
+
+            setPreviousSeparatingAxis(lastFrameCollisionInfo, minEdgeAxis);
+        }
+        else {
+
+            const uint minFaceAxis = minFaceAxes[minFaceBox];
+
+            setPreviousSeparatingAxis(lastFrameCollisionInfo, minFaceAxis);
+
+            // Compute the contact points between the reference and incident faces. There should be clipping points
+            // here. If it is not the case, it might be because of a numerical issue and we report no collision.
+            if (!computeFaceContactPoints(minFaceAxis, minFaceNormals[minFaceBox], box2ToBox1, narrowPhaseInfoBatch, batchIndex)) {
+                continue;
+            }
+        }
+
+        narrowPhaseInfoBatch.isColliding[batchIndex] = true;
+        isCollisionFound = true;
+    }
+
+    return isCollisionFound;
+}
+
+// Compute the penetration depth of the boxes along one of the 15 potential separating axes
+/// The method also computes the unit axis (in the local-space of box 1) oriented from box 1 toward
+/// box 2. A penetration depth smaller or equal to zero means that this is a separating axis. For
+/// two almost parallel edges, the method returns DECIMAL_LARGEST because the axis is undefined.
+decimal BoxVsBoxAlgorithm::testSeparatingAxis(uint axis, const Vector3& halfExtents1, const Vector3& halfExtents2,
+                                              const Matrix3x3& rotation, const Matrix3x3& absRotation,
+                                              const Vector3& translation, Vector3& normalBox1Space) const {
+
+    assert(axis < 15);
+
+    // Face normal of box 1
+    if (axis < 3) {
+
+        const int i = static_cast<int>(axis);
+        const decimal radius2 = halfExtents2.x * absRotation[i][0] + halfExtents2.y * absRotation[i][1] +
+                                halfExtents2.z * absRotation[i][2];
+
+        normalBox1Space.setToZero();
+        normalBox1Space[i] = translation[i] < decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+
+        return halfExtents1[i] + radius2 - std::abs(translation[i]);
+    }
+
+    // Face normal of box 2
+    if (axis < 6) {
+
+        const int j = static_cast<int>(axis) - 3;
+        const decimal distance = translation.x * rotation[0][j] + translation.y * rotation[1][j] + translation.z * rotation[2][j];
+        const decimal radius1 = halfExtents1.x * absRotation[0][j] + halfExtents1.y * absRotation[1][j] +
+                                halfExtents1.z * absRotation[2][j];
+
+        normalBox1Space = distance < decimal(0.0) ? -rotation.getColumn(j) : rotation.getColumn(j);
+
+        return radius1 + halfExtents2[j] - std::abs(distance);
+    }
+
+    // Cross product of the i-th edge direction of box 1 with the j-th edge direction of box 2
+    const int i = static_cast<int>(axis - 6) / 3;
+    const int j = static_cast<int>(axis - 6) % 3;
+    const int i1 = (i + 1) % 3;
+    const int i2 = (i + 2) % 3;
+    const int j1 = (j + 1) % 3;
+    const int j2 = (j + 2) % 3;
+
+    // Components of the (non normalized) axis, the i-th component is zero
+    const decimal axisI1 = -rotation[i2][j];
+    const decimal axisI2 = rotation[i1][j];
+    const decimal axisLengthSquare = axisI1 * axisI1 + axisI2 * axisI2;
+
+    // If the edges are almost parallel, this axis is not a valid separating axis
+    if (axisLengthSquare < MIN_EDGES_CROSS_PRODUCT_SQUARE_LENGTH) {
+        return DECIMAL_LARGEST;
+    }
+
+    const decimal radius1 = halfExtents1[i1] * absRotation[i2][j] + halfExtents1[i2] * absRotation[i1][j];
+    const decimal radius2 = halfExtents2[j1] * absRotation[i][j2] + halfExtents2[j2] * absRotation[i][j1];
+    const decimal distance = translation[i1] * axisI1 + translation[i2] * axisI2;
+    const decimal axisLength = std::sqrt(axisLengthSquare);
+    const decimal axisSign = distance < decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+
+    normalBox1Space.setToZero();
+    normalBox1Space[i1] = axisSign * axisI1 / axisLength;
+    normalBox1Space[i2] = axisSign * axisI2 / axisLength;
+
+    return (radius1 + radius2 - std::abs(distance)) / axisLength;
+}
+
+// Return the separating axis (or axis of minimum penetration) of the previous frame
+uint BoxVsBoxAlgorithm::getPreviousSeparatingAxis(const LastFrameCollisionInfo* lastFrameCollisionInfo) const {
+
+    if (lastFrameCollisionInfo->satIsAxisFacePolyhedron1) {
+        assert(lastFrameCollisionInfo->satMinAxisFaceIndex < 3);
+        return lastFrameCollisionInfo->satMinAxisFaceIndex;
+    }
+    if (lastFrameCollisionInfo->satIsAxisFacePolyhedron2) {
+        assert(lastFrameCollisionInfo->satMinAxisFaceIndex < 3);
+        return 3 + lastFrameCollisionInfo->satMinAxisFaceIndex;
+    }
+
+    assert(lastFrameCollisionInfo->satMinEdge1Index < 3 && lastFrameCollisionInfo->satMinEdge2Index < 3);
+    return 6 + 3 * lastFrameCollisionInfo->satMinEdge1Index + lastFrameCollisionInfo->satMinEdge2Index;
+}
+
+// Store the separating axis (or axis of minimum penetration) for the next frame
+/// We use the same fields as the SAT algorithm: the face index is the box axis of the face normal
+/// and the edge indices are the box axes of the two edge directions.
+void BoxVsBoxAlgorithm::setPreviousSeparatingAxis(LastFrameCollisionInfo* lastFrameCollisionInfo, uint axis) const {
+
+    lastFrameCollisionInfo->satIsAxisFacePolyhedron1 = axis < 3;
+    lastFrameCollisionInfo->satIsAxisFacePolyhedron2 = axis >= 3 && axis < 6;
+
+    if (axis < 6) {
+        lastFrameCollisionInfo->satMinAxisFaceIndex = axis % 3;
+    }
+    else {
+        lastFrameCollisionInfo->satMinEdge1Index = (axis - 6) / 3;
+        lastFrameCollisionInfo->satMinEdge2Index = (axis - 6) % 3;
+    }
+}
+
+// Clip a polygon with an axis-aligned plane and return the number of vertices of the clipped polygon
+/// The vertices "v" with planeSide * v[planeAxis] <= planeOffset are kept. Clipping a polygon
+/// with one plane adds at most one vertex.
+uint BoxVsBoxAlgorithm::clipPolygonWithAxisPlane(const Vector3* polygonVertices, uint nbVertices, uint planeAxis, decimal planeSide,
+                                                 decimal planeOffset, Vector3* clippedVertices) const {
+
+    const int axis = static_cast<int>(planeAxis);
+    uint nbClippedVertices = 0;
+
+    for (uint v=0; v < nbVertices; v++) {
+
+        const Vector3& vertexA = polygonVertices[v];
+        const Vector3& vertexB = polygonVertices[(v + 1) % nbVertices];
+
+        const decimal distanceA = planeSide * vertexA[axis] - planeOffset;
+        const decimal distanceB = planeSide * vertexB[axis] - planeOffset;
+
+        // If the first vertex is inside the plane
+        if (distanceA <= decimal(0.0)) {
+            clippedVertices[nbClippedVertices] = vertexA;
+            nbClippedVertices++;
+        }
+
+        // If the edge crosses the plane, add the intersection point
+        if ((distanceA < decimal(0.0) && distanceB > decimal(0.0)) || (distanceA > decimal(0.0) && distanceB < decimal(0.0))) {
+            const decimal t = distanceA / (distanceA - distanceB);
+            clippedVertices[nbClippedVertices] = vertexA + t * (vertexB - vertexA);
+            nbClippedVertices++;
+        }
+    }
+
+    return nbClippedVertices;
+}
+
+// Compute the contact points between a reference face and an incident face of the boxes
+/// The reference face is the face of the separating axis. The incident face is the face of the other
+/// box the most anti-parallel to the reference face normal. The incident face is clipped with the
+/// four side planes of the reference face and the clipped points below the reference face are the
+/// contact points. The method returns true if contact points have been found.
+bool BoxVsBoxAlgorithm::computeFaceContactPoints(uint axis, const Vector3& normalBox1Space, const Transform& box2ToBox1,
+                                                 BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint batchIndex) const {
+
+    assert(axis < 6);
+
+    const bool isReferenceBox1 = axis < 3;
+    const int referenceAxis = static_cast<int>(axis % 3);
+    const int referenceAxis1 = (referenceAxis + 1) % 3;
+    const int referenceAxis2 = (referenceAxis + 2) % 3;
+
+    const Transform incidentToReference = isReferenceBox1 ? box2ToBox1 : box2ToBox1.getInverse();
+    const Vector3& referenceHalfExtents = isReferenceBox1 ? narrowPhaseInfoBatch.box1HalfExtents[batchIndex] :
+                                                            narrowPhaseInfoBatch.box2HalfExtents[batchIndex];
+    const Vector3& incidentHalfExtents = isReferenceBox1 ? narrowPhaseInfoBatch.box2HalfExtents[batchIndex] :
+                                                           narrowPhaseInfoBatch.box1HalfExtents[batchIndex];
+
+    // Side of the reference face (its normal in the reference space points toward the incident box)
+    const decimal referenceNormalComponent = isReferenceBox1 ? normalBox1Space[referenceAxis] :
+                                             -(incidentToReference.getOrientation() * normalBox1Space)[referenceAxis];
+    const decimal referenceSide = referenceNormalComponent < decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+
+    // Find the incident face (the face normal the most anti-parallel to the reference face normal)
+    const Matrix3x3 incidentRotation = incidentToReference.getOrientation().getMatrix();
+    int incidentAxis = 0;
+    for (int k=1; k < 3; k++) {
+        if (std::abs(incidentRotation[referenceAxis][k]) > std::abs(incidentRotation[referenceAxis][incidentAxis])) {
+            incidentAxis = k;
+        }
+    }
+    const decimal incidentSide = referenceSide * incidentRotation[referenceAxis][incidentAxis] > decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+
+    // Compute the vertices of the incident face in the reference space
+    const Vector3 incidentFaceCenter = incidentToReference.getPosition() + incidentSide * incidentHalfExtents[incidentAxis] *
+                                       incidentRotation.getColumn(incidentAxis);
+    const Vector3 incidentFaceEdge1 = incidentHalfExtents[(incidentAxis + 1) % 3] * incidentRotation.getColumn((incidentAxis + 1) % 3);
+    const Vector3 incidentFaceEdge2 = incidentHalfExtents[(incidentAxis + 2) % 3] * incidentRotation.getColumn((incidentAxis + 2) % 3);
+
+    // Vertices of the incident face polygon (at most 8 vertices after clipping with 4 planes)
+    Vector3 polygonVertices[8];
+    Vector3 clippedVertices[8];
+    polygonVertices[0] = incidentFaceCenter + incidentFaceEdge1 + incidentFaceEdge2;
+    polygonVertices[1] = incidentFaceCenter - incidentFaceEdge1 + incidentFaceEdge2;
+    polygonVertices[2] = incidentFaceCenter - incidentFaceEdge1 - incidentFaceEdge2;
+    polygonVertices[3] = incidentFaceCenter + incidentFaceEdge1 - incidentFaceEdge2;
+
+    // Clip the incident face with the side planes of the reference face
+    uint nbVertices = clipPolygonWithAxisPlane(polygonVertices, 4, referenceAxis1, decimal(1.0), referenceHalfExtents[referenceAxis1], clippedVertices);
+    nbVertices = clipPolygonWithAxisPlane(clippedVertices, nbVertices, referenceAxis1, decimal(-1.0), referenceHalfExtents[referenceAxis1], polygonVertices);
+    nbVertices = clipPolygonWithAxisPlane(polygonVertices, nbVertices, referenceAxis2, decimal(1.0), referenceHalfExtents[referenceAxis2], clippedVertices);
+    nbVertices = clipPolygonWithAxisPlane(clippedVertices, nbVertices, referenceAxis2, decimal(-1.0), referenceHalfExtents[referenceAxis2], polygonVertices);
+
+    // Compute the world normal (from box 1 toward box 2)
+    Vector3 referenceNormal(0, 0, 0);
+    referenceNormal[referenceAxis] = referenceSide;
+    const Vector3 normalWorld = isReferenceBox1 ?
+                                narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex].getOrientation() * referenceNormal :
+                                -(narrowPhaseInfoBatch.shape2ToWorldTransforms[batchIndex].getOrientation() * referenceNormal);
+
+    const Transform referenceToIncident = incidentToReference.getInverse();
+
+    // We only keep the clipped points that are below the reference face
+    bool contactPointsFound = false;
+    for (uint v=0; v < nbVertices; v++) {
+
+        const decimal penetrationDepth = referenceHalfExtents[referenceAxis] - referenceSide * polygonVertices[v][referenceAxis];
+
+        // If the clip point is below the reference face
+        if (penetrationDepth > decimal(0.0)) {
+
+            contactPointsFound = true;
+
+            // If we do not need to report contacts, one point is enough
+            if (!narrowPhaseInfoBatch.reportContacts[batchIndex]) {
+                break;
+            }
+
+            // Project the contact point onto the reference face
+            Vector3 contactPointReference = polygonVertices[v];
+            contactPointReference[referenceAxis] = referenceSide * referenceHalfExtents[referenceAxis];
+
+            // Convert the clipped incident face vertex into the incident box local-space
+            const Vector3 contactPointIncident = referenceToIncident * polygonVertices[v];
+
+            // Create a new contact point
+            narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth,
+                                                 isReferenceBox1 ? contactPointReference : contactPointIncident,
+                                                 isReferenceBox1 ? contactPointIncident : contactPointReference);
+        }
+    }
+
+    return contactPointsFound;
+}
+
+// Compute the contact point between an edge of each box
+/// The edge of each box is the edge parallel to the edge direction of the separating axis with
+/// the largest projection onto the axis (toward the other box). The contact point is the pair
+/// of closest points between the two edges.
+void BoxVsBoxAlgorithm::computeEdgeContactPoint(uint axis, const Vector3& normalBox1Space, decimal penetrationDepth,
+                                                const Transform& box2ToBox1, BoxVsBoxNarrowPhaseInfoBatch& narrowPhaseInfoBatch,
+                                                uint batchIndex) const {
+
+    assert(axis >= 6 && axis < 15);
+
+    const int i = static_cast<int>(axis - 6) / 3;
+    const int j = static_cast<int>(axis - 6) % 3;
+
+    const Vector3& halfExtents1 = narrowPhaseInfoBatch.box1HalfExtents[batchIndex];
+    const Vector3& halfExtents2 = narrowPhaseInfoBatch.box2HalfExtents[batchIndex];
+    const Matrix3x3 rotation = box2ToBox1.getOrientation().getMatrix();
+
+    // Compute the edge of box 1 in the direction of the normal
+    Vector3 edge1Center(0, 0, 0);
+    Vector3 edge1Direction(0, 0, 0);
+    for (int k=0; k < 3; k++) {
+        if (k != i) {
+            edge1Center[k] = normalBox1Space[k] < decimal(0.0) ? -halfExtents1[k] : halfExtents1[k];
+        }
+    }
+    edge1Direction[i] = halfExtents1[i];
+
+    // Compute the edge of box 2 in the opposite direction of the normal (in the local-space of box 1)
+    Vector3 edge2Center = box2ToBox1.getPosition();
+    for (int k=0; k < 3; k++) {
+        if (k != j) {
+            const Vector3 box2Axis = rotation.getColumn(k);
+            edge2Center += (normalBox1Space.dot(box2Axis) > decimal(0.0) ? -halfExtents2[k] : halfExtents2[k]) * box2Axis;
+        }
+    }
+    const Vector3 edge2Direction = halfExtents2[j] * rotation.getColumn(j);
+
+    // Compute the closest points between the two edges (in the local-space of box 1)
+    Vector3 closestPointEdge1, closestPointEdge2;
+    computeClosestPointBetweenTwoSegments(edge1Center - edge1Direction, edge1Center + edge1Direction,
+                                          edge2Center - edge2Direction, edge2Center + edge2Direction,
+                                          closestPointEdge1, closestPointEdge2);
+
+    // Compute the world normal
+    const Vector3 normalWorld = narrowPhaseInfoBatch.shape1ToWorldTransforms[batchIndex].getOrientation() * normalBox1Space;
+
+    // Create the contact point
+    narrowPhaseInfoBatch.addContactPoint(batchIndex, normalWorld, penetrationDepth, closestPointEdge1,
+                                         box2ToBox1.getInverse() * closestPointEdge2);
+}
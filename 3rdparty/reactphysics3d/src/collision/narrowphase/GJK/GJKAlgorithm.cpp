@@ -235,3 +235,156 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         gjkResults.add(GJKResult::INTERPENETRATE);
     }
 }
+
+// Compute the distance and the closest points between two convex shapes (with their margins).
+/// The GJK algorithm is run in world-space on the shapes without margins and the closest points
+/// are then projected on the margins. The distance is negative if the shapes overlap only in their
+/// margins. The normal is the unit vector from the closest point of shape 2 toward the closest
+/// point of shape 1. This method returns false if the shapes without margins intersect (the
+/// distance and the closest points are not computed in this case).
+bool GJKAlgorithm::computeDistance(const ConvexShape* shape1, const Transform& transform1,
+                                   const ConvexShape* shape2, const Transform& transform2,
+                                   decimal& outDistance, Vector3& outPoint1, Vector3& outPoint2, Vector3& outNormal) const {
+
+    const Quaternion worldToShape1 = transform1.getOrientation().getInverse();
+    const Quaternion worldToShape2 = transform2.getOrientation().getInverse();
+
+    // Create a simplex set
+    VoronoiSimplex simplex;
+
+    // Start with the direction between the origins of the two shapes
+    Vector3 v = transform1.getPosition() - transform2.getPosition();
+    if (v.lengthSquare() < MACHINE_EPSILON) {
+        v.setAllValues(0, 1, 0);
+    }
+
+    // Initialize the upper bound for the square distance
+    decimal distSquare = DECIMAL_LARGEST;
+
+    bool closestPointFound = false;
+
+    // Unlike in the intersection test, the loop does not stop when the distance becomes negligible relative to the
+    // size of the shapes. A small shape a few millimeters in front of a large one would otherwise be reported as
+    // intersecting it, or with the closest point of a simplex that has not converged.
+    do {
+
+        // Compute the support points for original objects (without margins) A and B
+        const Vector3 suppA = transform1 * shape1->getLocalSupportPointWithoutMargin(worldToShape1 * (-v));
+        const Vector3 suppB = transform2 * shape2->getLocalSupportPointWithoutMargin(worldToShape2 * v);
+
+        // Compute the support point for the Minkowski difference A-B
+        const Vector3 w = suppA - suppB;
+
+        // If the closest point cannot be improved anymore
+        if (simplex.isPointInSimplex(w) || distSquare - v.dot(w) <= distSquare * REL_ERROR_SQUARE) {
+            closestPointFound = true;
+            break;
+        }
+
+        // Add the new support point to the simplex
+        simplex.addPoint(w, suppA, suppB);
+
+        if (simplex.isAffinelyDependent()) {
+            closestPointFound = true;
+            break;
+        }
+
+        // Compute the point of the simplex closest to the origin
+        if (!simplex.computeClosestPoint(v)) {
+            closestPointFound = true;
+            break;
+        }
+
+        // Store and update the squared distance of the closest point
+        const decimal prevDistSquare = distSquare;
+        distSquare = v.lengthSquare();
+
+        // If the distance to the closest point doesn't improve a lot
+        if (prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare) {
+            simplex.backupClosestPointInSimplex(v);
+            distSquare = v.lengthSquare();
+            closestPointFound = true;
+            break;
+        }
+
+    } while(!simplex.isFull() && distSquare > MACHINE_EPSILON);
+
+    // If the simplex contains the origin, the shapes without margins intersect
+    if (!closestPointFound || distSquare <= MACHINE_EPSILON) {
+        return false;
+    }
+
+    // Compute the closest points of both objects (without the margins)
+    Vector3 pA, pB;
+    simplex.computeClosestPointsOfAandB(pA, pB);
+
+    // Project those two points on the margins
+    const decimal dist = std::sqrt(distSquare);
+    outNormal = v / dist;
+    outPoint1 = pA - shape1->getMargin() * outNormal;
+    outPoint2 = pB + shape2->getMargin() * outNormal;
+    outDistance = dist - shape1->getMargin() - shape2->getMargin();
+
+    return true;
+}
+
+// Compute the time of impact of a convex shape translated toward another (not moving) one.
+/// This method uses the conservative advancement: the shape 1 is moved along the translation by
+/// the distance between the shapes divided by the speed at which they approach each other along the
+/// normal. Because the distance is a convex function of the fraction of the translation, the shapes
+/// never interpenetrate during this advancement. A hit is reported when the distance is below
+/// CONSERVATIVE_ADVANCEMENT_TOLERANCE before the fraction maxFraction of the translation. The hit
+/// fraction is then the fraction of the translation where the shapes are about to touch, the hit point
+/// is on shape 2 and the hit normal points from shape 2 toward shape 1. If the shapes already overlap
+/// at the start of the translation, the hit fraction is zero.
+bool GJKAlgorithm::computeTimeOfImpact(const ConvexShape* shape1, const Transform& transform1, const Vector3& translation1,
+                                       const ConvexShape* shape2, const Transform& transform2, decimal maxFraction,
+                                       decimal& outHitFraction, Vector3& outHitPoint, Vector3& outHitNormal) const {
+
+    Transform movedTransform1 = transform1;
+    decimal fraction = decimal(0.0);
+
+    for (int i=0; i < MAX_ITERATIONS_CONSERVATIVE_ADVANCEMENT; i++) {
+
+        movedTransform1.setPosition(transform1.getPosition() + fraction * translation1);
+
+        decimal distance;
+        Vector3 point1, point2, normal;
+        if (!computeDistance(shape1, movedTransform1, shape2, transform2, distance, point1, point2, normal)) {
+
+            // The shapes intersect at the start of the translation (the advancement does not make them intersect)
+            outHitFraction = fraction;
+            outHitPoint = movedTransform1.getPosition();
+            outHitNormal = translation1.lengthSquare() > MACHINE_EPSILON ? -translation1.getUnit() : Vector3(0, 1, 0);
+            return true;
+        }
+
+        // If the shapes are close enough, we have found the time of impact
+        if (distance <= CONSERVATIVE_ADVANCEMENT_TOLERANCE) {
+            outHitFraction = fraction;
+            outHitPoint = point2;
+            outHitNormal = normal;
+            return true;
+        }
+
+        // If the shape 1 does not move toward the shape 2, they will never touch
+        const decimal approachSpeed = -translation1.dot(normal);
+        if (approachSpeed <= MACHINE_EPSILON) {
+            return false;
+        }
+
+        // Advance the shape 1 until the shapes are at half the tolerance distance along the normal
+        fraction += (distance - decimal(0.5) * CONSERVATIVE_ADVANCEMENT_TOLERANCE) / approachSpeed;
+        if (fraction > maxFraction) {
+            return false;
+        }
+    }
+
+    // The advancement has not converged, report the hit at the current fraction so that the
+    // shape 1 does not go through the shape 2
+    outHitFraction = fraction;
+    outHitPoint = transform1.getPosition() + fraction * translation1;
+    outHitNormal = -translation1.getUnit();
+
+    return true;
+}
@@ -34,7 +34,7 @@ NarrowPhaseInput::NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs&
     :mSphereVsSphereBatch(allocator, overlappingPairs), mSphereVsCapsuleBatch(allocator, overlappingPairs),
      mCapsuleVsCapsuleBatch(allocator, overlappingPairs), mSphereVsConvexPolyhedronBatch(allocator, overlappingPairs),
      mCapsuleVsConvexPolyhedronBatch(allocator, overlappingPairs),
-     mConvexPolyhedronVsConvexPolyhedronBatch(allocator, overlappingPairs) {
+     mConvexPolyhedronVsConvexPolyhedronBatch(allocator, overlappingPairs), mBoxVsBoxBatch(allocator, overlappingPairs) {
 
 }
 
@@ -62,6 +62,9 @@ void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, uint64 pairIndex, Entit
         case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
             mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, pairIndex, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, shapeAllocator);
             break;
+        case NarrowPhaseAlgorithmType::BoxVsBox:
+            mBoxVsBoxBatch.addNarrowPhaseInfo(pairId, pairIndex, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, shapeAllocator);
+            break;
         case NarrowPhaseAlgorithmType::None:
             // Must never happen
             assert(false);
@@ -78,6 +81,7 @@ void NarrowPhaseInput::reserveMemory() {
     mSphereVsConvexPolyhedronBatch.reserveMemory();
     mCapsuleVsConvexPolyhedronBatch.reserveMemory();
     mConvexPolyhedronVsConvexPolyhedronBatch.reserveMemory();
+    mBoxVsBoxBatch.reserveMemory();
 }
 
 // Clear
@@ -89,4 +93,5 @@ void NarrowPhaseInput::clear() {
     mSphereVsConvexPolyhedronBatch.clear();
     mCapsuleVsConvexPolyhedronBatch.clear();
     mConvexPolyhedronVsConvexPolyhedronBatch.clear();
+    mBoxVsBoxBatch.clear();
 }
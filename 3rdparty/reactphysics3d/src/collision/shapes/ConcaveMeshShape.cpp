@@ -193,7 +193,7 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
     // Ask the Dynamic AABB Tree to report all AABB nodes that are hit by the ray.
     // The raycastCallback object will then compute ray casting against the triangles
     // in the hit AABBs.
-    mDynamicAABBTree.raycast(scaledRay, raycastCallback);
+    mDynamicAABBTree.raycast(scaledRay, raycastCallback, allocator);
 
     raycastCallback.raycastTriangles();
 
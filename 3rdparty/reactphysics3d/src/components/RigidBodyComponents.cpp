@@ -43,7 +43,7 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Quaternion) + sizeof(Vector3) + sizeof(Vector3) +
-                                sizeof(bool) + sizeof(bool) + sizeof(List<Entity>)) {
+                                sizeof(bool) + sizeof(bool) + sizeof(bool) + sizeof(List<Entity>)) {
 
     // Allocate memory for the components data
     allocate(INIT_NB_ALLOCATED_COMPONENTS);
@@ -88,7 +88,8 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     Vector3* newCentersOfMassWorld = reinterpret_cast<Vector3*>(newCentersOfMassLocal + nbComponentsToAllocate);
     bool* newIsGravityEnabled = reinterpret_cast<bool*>(newCentersOfMassWorld + nbComponentsToAllocate);
     bool* newIsAlreadyInIsland = reinterpret_cast<bool*>(newIsGravityEnabled + nbComponentsToAllocate);
-    List<Entity>* newJoints = reinterpret_cast<List<Entity>*>(newIsAlreadyInIsland + nbComponentsToAllocate);
+    bool* newIsCCDEnabled = reinterpret_cast<bool*>(newIsAlreadyInIsland + nbComponentsToAllocate);
+    List<Entity>* newJoints = reinterpret_cast<List<Entity>*>(newIsCCDEnabled + nbComponentsToAllocate);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -120,6 +121,7 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newCentersOfMassWorld, mCentersOfMassWorld, mNbComponents * sizeof(Vector3));
         memcpy(newIsGravityEnabled, mIsGravityEnabled, mNbComponents * sizeof(bool));
         memcpy(newIsAlreadyInIsland, mIsAlreadyInIsland, mNbComponents * sizeof(bool));
+        memcpy(newIsCCDEnabled, mIsCCDEnabled, mNbComponents * sizeof(bool));
         memcpy(newJoints, mJoints, mNbComponents * sizeof(List<Entity>));
 
         // Deallocate previous memory
@@ -154,6 +156,7 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mCentersOfMassWorld = newCentersOfMassWorld;
     mIsGravityEnabled = newIsGravityEnabled;
     mIsAlreadyInIsland = newIsAlreadyInIsland;
+    mIsCCDEnabled = newIsCCDEnabled;
     mJoints = newJoints;
 }
 
@@ -190,6 +193,7 @@ void RigidBodyComponents::addComponent(Entity bodyEntity, bool isSleeping, const
     new (mCentersOfMassWorld + index) Vector3(component.worldPosition);
     mIsGravityEnabled[index] = true;
     mIsAlreadyInIsland[index] = false;
+    mIsCCDEnabled[index] = false;
     new (mJoints + index) List<Entity>(mMemoryAllocator);
 
     // Map the entity with the new component lookup index
@@ -234,6 +238,7 @@ void RigidBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     new (mCentersOfMassWorld + destIndex) Vector3(mCentersOfMassWorld[srcIndex]);
     mIsGravityEnabled[destIndex] = mIsGravityEnabled[srcIndex];
     mIsAlreadyInIsland[destIndex] = mIsAlreadyInIsland[srcIndex];
+    mIsCCDEnabled[destIndex] = mIsCCDEnabled[srcIndex];
     new (mJoints + destIndex) List<Entity>(mJoints[srcIndex]);
 
     // Destroy the source component
@@ -277,6 +282,7 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     Vector3 centerOfMassWorld1 = mCentersOfMassWorld[index1];
     bool isGravityEnabled1 = mIsGravityEnabled[index1];
     bool isAlreadyInIsland1 = mIsAlreadyInIsland[index1];
+    bool isCCDEnabled1 = mIsCCDEnabled[index1];
     List<Entity> joints1 = mJoints[index1];
 
     // Destroy component 1
@@ -311,6 +317,7 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     mCentersOfMassWorld[index2] = centerOfMassWorld1;
     mIsGravityEnabled[index2] = isGravityEnabled1;
     mIsAlreadyInIsland[index2] = isAlreadyInIsland1;
+    mIsCCDEnabled[index2] = isCCDEnabled1;
     new (mJoints + index2) List<Entity>(joints1);
 
     // Update the entity to component index mapping
@@ -39,7 +39,6 @@ ContactPoint::ContactPoint(const ContactPointInfo* contactInfo, decimal persiste
                mIsRestingContact(false), mIsObsolete(false), mNext(nullptr), mPrevious(nullptr),
                mPersistentContactDistanceThreshold(persistentContactDistanceThreshold) {
 
-    assert(mPenetrationDepth > decimal(0.0));
     assert(mNormal.lengthSquare() > decimal(0.8));
 
     mIsObsolete = false;
@@ -54,7 +53,6 @@ ContactPoint::ContactPoint(const ContactPointInfo& contactInfo, decimal persiste
                mIsRestingContact(false), mPenetrationImpulse(0), mIsObsolete(false),
                mPersistentContactDistanceThreshold(persistentContactDistanceThreshold) {
 
-    assert(mPenetrationDepth > decimal(0.0));
     assert(mNormal.lengthSquare() > decimal(0.8));
 
     mIsObsolete = false;
@@ -65,7 +63,6 @@ ContactPoint::ContactPoint(const ContactPointInfo& contactInfo, decimal persiste
 void ContactPoint::update(const ContactPointInfo* contactInfo) {
 
     assert(isSimilarWithContactPoint(contactInfo));
-    assert(contactInfo->penetrationDepth > decimal(0.0));
 
     mNormal = contactInfo->normal;
     mPenetrationDepth = contactInfo->penetrationDepth;
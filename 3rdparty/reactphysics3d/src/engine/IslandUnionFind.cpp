@@ -0,0 +1,189 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/engine/IslandUnionFind.h>
+#include <utility>
+
+using namespace reactphysics3d;
+
+// Static members initialization
+const uint32 IslandUnionFind::NULL_NODE = 0xFFFFFFFF;
+
+// Constructor
+IslandUnionFind::IslandUnionFind(MemoryAllocator& allocator)
+                :mBodyEntities(allocator), mRoots(allocator), mNextNodes(allocator), mSizes(allocator),
+                 mIsSplitNeeded(allocator), mIslandIndices(allocator), mRootsToSplit(allocator) {
+
+}
+
+// Add a body in its own set
+void IslandUnionFind::addBody(Entity bodyEntity) {
+
+    const uint32 node = bodyEntity.getIndex();
+
+    // Create the missing nodes
+    while (mRoots.size() <= node) {
+        mBodyEntities.add(bodyEntity);
+        mRoots.add(NULL_NODE);
+        mNextNodes.add(NULL_NODE);
+        mSizes.add(0);
+        mIsSplitNeeded.add(false);
+        mIslandIndices.add(NULL_NODE);
+    }
+
+    assert(mRoots[node] == NULL_NODE);
+
+    mBodyEntities[node] = bodyEntity;
+    mRoots[node] = node;
+    mNextNodes[node] = NULL_NODE;
+    mSizes[node] = 1;
+    mIsSplitNeeded[node] = false;
+    mIslandIndices[node] = NULL_NODE;
+}
+
+// Remove a body from its set
+/// The remaining bodies of the set may not be connected anymore, so the set is marked to be split.
+void IslandUnionFind::removeBody(Entity bodyEntity) {
+
+    const uint32 node = getNode(bodyEntity);
+    if (node == NULL_NODE) return;
+
+    const uint32 rootNode = mRoots[node];
+    assert(mIslandIndices[rootNode] == NULL_NODE);
+
+    // If the body is the root node, the next node of the set becomes the root
+    if (node == rootNode) {
+
+        const uint32 newRootNode = mNextNodes[node];
+        if (newRootNode != NULL_NODE) {
+
+            for (uint32 n = newRootNode; n != NULL_NODE; n = mNextNodes[n]) {
+                mRoots[n] = newRootNode;
+            }
+            mSizes[newRootNode] = mSizes[rootNode] - 1;
+            markSplitNeeded(newRootNode);
+        }
+    }
+    else {
+
+        // Unlink the node from the set
+        uint32 previousNode = rootNode;
+        while (mNextNodes[previousNode] != node) {
+            previousNode = mNextNodes[previousNode];
+        }
+        mNextNodes[previousNode] = mNextNodes[node];
+
+        mSizes[rootNode]--;
+        markSplitNeeded(rootNode);
+    }
+
+    mRoots[node] = NULL_NODE;
+    mNextNodes[node] = NULL_NODE;
+    mIsSplitNeeded[node] = false;
+}
+
+// Merge the sets of two bodies (nothing happens if one of the bodies is not in a set)
+void IslandUnionFind::merge(Entity body1Entity, Entity body2Entity) {
+
+    const uint32 node1 = getNode(body1Entity);
+    const uint32 node2 = getNode(body2Entity);
+    if (node1 == NULL_NODE || node2 == NULL_NODE) return;
+
+    uint32 rootNode = mRoots[node1];
+    uint32 mergedRootNode = mRoots[node2];
+    if (rootNode == mergedRootNode) return;
+
+    // The nodes of the smallest set take the root of the largest one
+    if (mSizes[rootNode] < mSizes[mergedRootNode]) {
+        std::swap(rootNode, mergedRootNode);
+    }
+
+    uint32 lastMergedNode = mergedRootNode;
+    mRoots[mergedRootNode] = rootNode;
+    while (mNextNodes[lastMergedNode] != NULL_NODE) {
+        lastMergedNode = mNextNodes[lastMergedNode];
+        mRoots[lastMergedNode] = rootNode;
+    }
+
+    // Insert the merged nodes after the root node
+    mNextNodes[lastMergedNode] = mNextNodes[rootNode];
+    mNextNodes[rootNode] = mergedRootNode;
+    mSizes[rootNode] += mSizes[mergedRootNode];
+
+    if (mIsSplitNeeded[mergedRootNode]) {
+        mIsSplitNeeded[mergedRootNode] = false;
+        markSplitNeeded(rootNode);
+    }
+}
+
+// Mark the set of a body to be split (nothing happens if the body is not in a set)
+void IslandUnionFind::markSplitNeeded(Entity bodyEntity) {
+
+    const uint32 node = getNode(bodyEntity);
+    if (node == NULL_NODE) return;
+
+    markSplitNeeded(mRoots[node]);
+}
+
+// Mark the set of a root node to be split
+void IslandUnionFind::markSplitNeeded(uint32 rootNode) {
+
+    assert(mRoots[rootNode] == rootNode);
+
+    if (!mIsSplitNeeded[rootNode]) {
+        mIsSplitNeeded[rootNode] = true;
+        mRootsToSplit.add(rootNode);
+    }
+}
+
+// Put each body of the sets to split into its own set and add the bodies to a list
+void IslandUnionFind::resetSetsToSplit(List<Entity>& outBodyEntities) {
+
+    for (uint32 i=0; i < mRootsToSplit.size(); i++) {
+
+        const uint32 rootNode = mRootsToSplit[i];
+
+        // The set may have been merged into another one or the root may have been removed
+        if (mRoots[rootNode] != rootNode || !mIsSplitNeeded[rootNode]) continue;
+
+        uint32 node = rootNode;
+        while (node != NULL_NODE) {
+
+            const uint32 nextNode = mNextNodes[node];
+
+            outBodyEntities.add(mBodyEntities[node]);
+
+            mRoots[node] = node;
+            mNextNodes[node] = NULL_NODE;
+            mSizes[node] = 1;
+            mIsSplitNeeded[node] = false;
+
+            node = nextNode;
+        }
+    }
+
+    mRootsToSplit.clear();
+}
@@ -285,7 +285,7 @@ uint64 OverlappingPairs::addPair(Collider* shape1, Collider* shape2) {
     NarrowPhaseAlgorithmType algorithmType;
     if (isConvexVsConvex) {
 
-        algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1->getType(), collisionShape2->getType());
+        algorithmType = mCollisionDispatch.selectNarrowPhaseAlgorithm(collisionShape1, collisionShape2);
     }
     else {
 
@@ -35,6 +35,7 @@
 #include <reactphysics3d/engine/Island.h>
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <reactphysics3d/containers/Stack.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 
 // Namespaces
 using namespace reactphysics3d;
@@ -59,10 +60,10 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, const WorldSettings& wo
                 mSliderJointsComponents(mMemoryManager.getHeapAllocator()), mCollisionDetection(this, mCollidersComponents, mTransformComponents, mCollisionBodyComponents, mRigidBodyComponents,
                                         mMemoryManager),
                 mCollisionBodies(mMemoryManager.getHeapAllocator()), mEventListener(nullptr),
-                mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
+                mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()), mIslandUnionFind(mMemoryManager.getPoolAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
                 mContactSolverSystem(mMemoryManager, *this, mIslands, mCollisionBodyComponents, mRigidBodyComponents,
                                mCollidersComponents, mConfig.restitutionVelocityThreshold),
-                mConstraintSolverSystem(*this, mIslands, mRigidBodyComponents, mTransformComponents, mJointsComponents,
+                mConstraintSolverSystem(mMemoryManager, *this, mIslands, mRigidBodyComponents, mTransformComponents, mJointsComponents,
                                         mBallAndSocketJointsComponents, mFixedJointsComponents, mHingeJointsComponents,
                                         mSliderJointsComponents),
                 mDynamicsSystem(*this, mCollisionBodyComponents, mRigidBodyComponents, mTransformComponents, mCollidersComponents, mIsGravityEnabled, mConfig.gravity),
@@ -70,7 +71,8 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, const WorldSettings& wo
                 mNbPositionSolverIterations(mConfig.defaultPositionSolverNbIterations), 
                 mIsSleepingEnabled(mConfig.isSleepingEnabled), mRigidBodies(mMemoryManager.getPoolAllocator()),
                 mIsGravityEnabled(true), mSleepLinearVelocity(mConfig.defaultSleepLinearVelocity),
-                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep), mCurrentJointId(0) {
+                mSleepAngularVelocity(mConfig.defaultSleepAngularVelocity), mTimeBeforeSleep(mConfig.defaultTimeBeforeSleep), mCurrentJointId(0),
+                mThreadPool(nullptr) {
 
     // Automatically generate a name for the world
     if (mName == "") {
@@ -101,6 +103,11 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, const WorldSettings& wo
 
     mNbWorlds++;
 
+    setNbWorkerThreads(mConfig.nbWorkerThreads);
+    mContactSolverSystem.setIsSimdSolverEnabled(mConfig.isSimdContactSolverEnabled);
+    setIslandColoringThreshold(mConfig.islandColoringThreshold);
+    mCollisionDetection.setBroadPhaseType(mConfig.broadPhaseType);
+
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
              "Physics World: Physics world " + mName + " has been created",  __FILE__, __LINE__);
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
@@ -147,6 +154,8 @@ PhysicsWorld::~PhysicsWorld() {
     assert(mTransformComponents.getNbComponents() == 0);
     assert(mCollidersComponents.getNbComponents() == 0);
 
+    setNbWorkerThreads(0);
+
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
              "Physics World: Physics world " + mName + " has been destroyed",  __FILE__, __LINE__);
 }
@@ -331,13 +340,16 @@ void PhysicsWorld::update(decimal timeStep) {
 
     RP3D_PROFILE("PhysicsWorld::update()", mProfiler);
 
+    // Allocate from the pool cache and single frame arena of this thread during the step
+    mMemoryManager.bindCurrentThread();
+
     // Reset the debug renderer
     if (mIsDebugRenderingEnabled) {
         mDebugRenderer.reset();
     }
 
     // Compute the collision detection
-    mCollisionDetection.computeCollisionDetection();
+    mCollisionDetection.computeCollisionDetection(timeStep);
 
     // Create the islands
     createIslands();
@@ -363,6 +375,9 @@ void PhysicsWorld::update(decimal timeStep) {
     // Solve the position correction for constraints
     solvePositionCorrection();
 
+    // Stop the fast bodies with continuous collision detection before they go through other bodies
+    mDynamicsSystem.solveContinuousCollisions(mCollisionDetection);
+
     // Update the state (positions and velocities) of the bodies
     mDynamicsSystem.updateBodiesState();
 
@@ -386,6 +401,8 @@ void PhysicsWorld::update(decimal timeStep) {
 
     // Reset the single frame memory allocator
     mMemoryManager.resetFrameAllocator();
+
+    mMemoryManager.unbindCurrentThread();
 }
 
 
@@ -396,18 +413,52 @@ void PhysicsWorld::solveContactsAndConstraints(decimal timeStep) {
 
     // ---------- Solve velocity constraints for joints and contacts ---------- //
 
+    // Solve the contacts with both contact solvers to compare them (only without joints)
+    if (mContactSolverSystem.isParityCheckEnabled() && mJointsComponents.getNbEnabledComponents() == 0) {
+
+        mConstraintSolverSystem.initialize(timeStep);
+
+        mContactSolverSystem.solveWithParityCheck(mCollisionDetection.mCurrentContactManifolds, mCollisionDetection.mCurrentContactPoints,
+                                                  timeStep, mNbVelocitySolverIterations);
+
+        return;
+    }
+
     // Initialize the contact solver
     mContactSolverSystem.init(mCollisionDetection.mCurrentContactManifolds, mCollisionDetection.mCurrentContactPoints, timeStep);
 
     // Initialize the constraint solver
     mConstraintSolverSystem.initialize(timeStep);
 
-    // For each iteration of the velocity solver
-    for (uint i=0; i<mNbVelocitySolverIterations; i++) {
+    // If the islands (or the colors of constraints of large islands) can be solved in parallel
+    if (mThreadPool != nullptr && (mContactSolverSystem.getNbParallelTasks() > 1 ||
+                                   mContactSolverSystem.getNbColoredIslands() > 0 ||
+                                   mConstraintSolverSystem.getNbColors() > 0)) {
+
+        // Without joints, each island runs all its iterations as a single task. Otherwise, the
+        // joints are solved (by colors if they have been colored) before the contacts at each
+        // iteration as in the serial case.
+        if (mJointsComponents.getNbEnabledComponents() == 0) {
+            mContactSolverSystem.solveIslands(*mThreadPool, mNbVelocitySolverIterations);
+        }
+        else {
+            for (uint i=0; i<mNbVelocitySolverIterations; i++) {
+
+                mConstraintSolverSystem.solveVelocityConstraints(*mThreadPool);
+
+                mContactSolverSystem.solveIslands(*mThreadPool, 1);
+            }
+        }
+    }
+    else {
+
+        // For each iteration of the velocity solver
+        for (uint i=0; i<mNbVelocitySolverIterations; i++) {
 
-        mConstraintSolverSystem.solveVelocityConstraints();
+            mConstraintSolverSystem.solveVelocityConstraints();
 
-        mContactSolverSystem.solve();
+            mContactSolverSystem.solve();
+        }
     }
 
     mContactSolverSystem.storeImpulses();
@@ -479,6 +530,9 @@ RigidBody* PhysicsWorld::createRigidBody(const Transform& transform) {
     RigidBodyComponents::RigidBodyComponent rigidBodyComponent(rigidBody, BodyType::DYNAMIC, transform.getPosition());
     mRigidBodyComponents.addComponent(entity, false, rigidBodyComponent);
 
+    // Add the body in its own set of bodies for the islands
+    mIslandUnionFind.addBody(entity);
+
     // Compute the inverse mass
     mRigidBodyComponents.setMassInverse(entity, decimal(1.0) / mRigidBodyComponents.getMass(entity));
 
@@ -515,6 +569,9 @@ void PhysicsWorld::destroyRigidBody(RigidBody* rigidBody) {
         destroyJoint(mJointsComponents.getJoint(joints[i]));
     }
 
+    // Remove the body from the sets of bodies for the islands
+    mIslandUnionFind.removeBody(rigidBody->getEntity());
+
     // Destroy the corresponding entity and its components
     mCollisionBodyComponents.removeComponent(rigidBody->getEntity());
     mRigidBodyComponents.removeComponent(rigidBody->getEntity());
@@ -651,6 +708,9 @@ Joint* PhysicsWorld::createJoint(const JointInfo& jointInfo) {
     // Add the joint into the joint list of the bodies involved in the joint
     addJointToBodies(jointInfo.body1->getEntity(), jointInfo.body2->getEntity(), entity);
 
+    // The two bodies of the joint are now in the same island
+    mIslandUnionFind.merge(jointInfo.body1->getEntity(), jointInfo.body2->getEntity());
+
     // Return the pointer to the created joint
     return newJoint;
 }
@@ -684,6 +744,10 @@ void PhysicsWorld::destroyJoint(Joint* joint) {
     mRigidBodyComponents.removeJointFromBody(body1->getEntity(), joint->getEntity());
     mRigidBodyComponents.removeJointFromBody(body2->getEntity(), joint->getEntity());
 
+    // The island of the two bodies may have been disconnected
+    mIslandUnionFind.markSplitNeeded(body1->getEntity());
+    mIslandUnionFind.markSplitNeeded(body2->getEntity());
+
     size_t nbBytes = joint->getSizeInBytes();
 
     Entity jointEntity = joint->getEntity();
@@ -743,144 +807,182 @@ void PhysicsWorld::addJointToBodies(Entity body1, Entity body2, Entity joint) {
 /// the contact manifolds and contact points of the same island
 /// to be packed together into linear arrays of manifolds and contacts for better caching.
 /// An island is an isolated group of rigid bodies that have constraints (joints or contacts)
-/// between each other. This method computes the islands at each time step as follows: For each
-/// awake rigid body, we run a Depth First Search (DFS) through the constraint graph of that body
-/// (graph where nodes are the bodies and where the edges are the constraints between the bodies) to
-/// find all the bodies that are connected with it (the bodies that share joints or contacts with
-/// it). Then, we create an island with this group of connected bodies.
+/// between each other. The non-static bodies are kept in the sets of mIslandUnionFind from one
+/// frame to the next instead of running a search through the whole constraint graph at each frame.
+/// The sets that may have been disconnected by lost contacts are split first. Then, the contacts of
+/// the current frame merge the sets they connect (only a new contact can connect two different sets)
+/// and each set with an awake body becomes an island. Static bodies are not in the sets so that they
+/// do not connect the islands. The bodies of the islands are gathered again at each frame from the
+/// enabled rigid bodies, which are the awake (and static) ones since sleeping bodies are disabled.
+/// This is linear in the number of awake bodies with a constant time root lookup, as are the
+/// integration and the sleep test of those same bodies afterwards.
 void PhysicsWorld::createIslands() {
 
     RP3D_PROFILE("PhysicsWorld::createIslands()", mProfiler);
 
     assert(mProcessContactPairsOrderIslands.size() == 0);
 
-    // Reset all the isAlreadyInIsland variables of bodies and joints
-    for (uint b=0; b < mRigidBodyComponents.getNbComponents(); b++) {
+    List<ContactPair>& contactPairs = *(mCollisionDetection.mCurrentContactPairs);
 
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = false;
-    }
-    for (uint32 i=0; i < mJointsComponents.getNbComponents(); i++) {
-        mJointsComponents.mIsAlreadyInIsland[i] = false;
+    // The sets of the bodies of the lost contacts may have been disconnected
+    for (uint32 i=0; i < mCollisionDetection.mLostContactPairs.size(); i++) {
+
+        const ContactPair& lostContactPair = mCollisionDetection.mLostContactPairs[i];
+        if (!lostContactPair.isTrigger) {
+            mIslandUnionFind.markSplitNeeded(lostContactPair.body1Entity);
+            mIslandUnionFind.markSplitNeeded(lostContactPair.body2Entity);
+        }
     }
 
-    // Create a stack for the bodies to visit during the Depth First Search
-    Stack<Entity> bodyEntityIndicesToVisit(mMemoryManager.getSingleFrameAllocator());
+    splitIslandSets();
 
-    uint nbTotalManifolds = 0;
+    // Merge the sets connected by the contacts
+    for (uint32 p=0; p < contactPairs.size(); p++) {
 
-    // For each rigid body component
-    for (uint b=0; b < mRigidBodyComponents.getNbEnabledComponents(); b++) {
+        if (!contactPairs[p].isTrigger) {
+            mIslandUnionFind.merge(contactPairs[p].body1Entity, contactPairs[p].body2Entity);
+        }
+    }
 
-        // If the body has already been added to an island, we go to the next body
-        if (mRigidBodyComponents.mIsAlreadyInIsland[b]) continue;
+    // Create an island for each set with an awake body (sleeping bodies are not in the enabled components)
+    List<uint32> islandRootNodes(mMemoryManager.getSingleFrameAllocator());
+    for (uint32 b=0; b < mRigidBodyComponents.getNbEnabledComponents(); b++) {
 
-        // If the body is static, we go to the next body
-        if (mRigidBodyComponents.mBodyTypes[b] == BodyType::STATIC) continue;
+        const Entity bodyEntity = mRigidBodyComponents.mBodiesEntities[b];
 
-        // Reset the stack of bodies to visit
-        bodyEntityIndicesToVisit.clear();
+        // If the body is static (or inactive), it is not in a set and we go to the next body
+        if (!mIslandUnionFind.hasBody(bodyEntity)) continue;
+        const uint32 rootNode = mIslandUnionFind.findRoot(bodyEntity);
 
-        // Add the body into the stack of bodies to visit
-        mRigidBodyComponents.mIsAlreadyInIsland[b] = true;
-        bodyEntityIndicesToVisit.push(mRigidBodyComponents.mBodiesEntities[b]);
+        uint32 islandIndex = mIslandUnionFind.getIslandIndex(rootNode);
+        if (!IslandUnionFind::isValid(islandIndex)) {
 
-        // Create the new island
-        uint32 islandIndex = mIslands.addIsland(nbTotalManifolds);
+            islandIndex = mIslands.addIsland(0);
+            mIslandUnionFind.setIslandIndex(rootNode, islandIndex);
+            islandRootNodes.add(rootNode);
+        }
 
-        // While there are still some bodies to visit in the stack
-        while (bodyEntityIndicesToVisit.size() > 0) {
+        // Add the body into the island
+        mIslands.bodyEntities[islandIndex].add(bodyEntity);
+    }
 
-            // Get the next body to visit from the stack
-            const Entity bodyToVisitEntity = bodyEntityIndicesToVisit.pop();
+    // Awake the sleeping bodies of the sets that have an awake body
+    for (uint32 i=0; i < islandRootNodes.size(); i++) {
 
-            // Add the body into the island
-            mIslands.bodyEntities[islandIndex].add(bodyToVisitEntity);
+        if (mIslands.bodyEntities[i].size() == mIslandUnionFind.getSetSize(islandRootNodes[i])) continue;
 
-            RigidBody* rigidBodyToVisit = static_cast<RigidBody*>(mCollisionBodyComponents.getBody(bodyToVisitEntity));
+        for (uint32 node = islandRootNodes[i]; IslandUnionFind::isValid(node); node = mIslandUnionFind.getNextNode(node)) {
 
-            // Awake the body if it is sleeping
-            rigidBodyToVisit->setIsSleeping(false);
+            const Entity bodyEntity = mIslandUnionFind.getBodyEntity(node);
+            if (mRigidBodyComponents.getIsSleeping(bodyEntity)) {
 
-            // If the current body is static, we do not want to perform the DFS search across that body
-            if (rigidBodyToVisit->getType() == BodyType::STATIC) continue;
+                mRigidBodyComponents.getRigidBody(bodyEntity)->setIsSleeping(false);
+                mIslands.bodyEntities[i].add(bodyEntity);
+            }
+        }
+    }
 
-            // If the body is involved in contacts with other bodies
-            auto itBodyContactPairs = mCollisionDetection.mMapBodyToContactPairs.find(bodyToVisitEntity);
-            if (itBodyContactPairs != mCollisionDetection.mMapBodyToContactPairs.end()) {
+    // Find the island of each contact pair and count the contact pairs and manifolds of each island
+    List<uint32> contactPairsIslandIndices(mMemoryManager.getSingleFrameAllocator(), contactPairs.size());
+    List<uint32> islandsContactPairsIndices(mMemoryManager.getSingleFrameAllocator(), islandRootNodes.size() + 1);
+    for (uint32 i=0; i <= islandRootNodes.size(); i++) {
+        islandsContactPairsIndices.add(0);
+    }
+    for (uint32 p=0; p < contactPairs.size(); p++) {
 
-                // For each contact pair in which the current body is involded
-                List<uint>& contactPairs = itBodyContactPairs->second;
-                for (uint p=0; p < contactPairs.size(); p++) {
+        ContactPair& pair = contactPairs[p];
 
-                    ContactPair& pair = (*mCollisionDetection.mCurrentContactPairs)[contactPairs[p]];
+        // The pairs with a trigger or a CollisionBody (and not a RigidBody) are not part of the islands
+        uint32 islandIndex = islandRootNodes.size();
+        if (!pair.isTrigger) {
 
-                    // Check if the current contact pair has already been added into an island
-                    if (pair.isAlreadyInIsland) continue;
+            // The bodies that are not in a set are static rigid bodies or CollisionBodies
+            const bool isBody1InSet = mIslandUnionFind.hasBody(pair.body1Entity);
+            const bool isBody2InSet = mIslandUnionFind.hasBody(pair.body2Entity);
+            const bool isRigidBody1 = isBody1InSet || mRigidBodyComponents.hasComponent(pair.body1Entity);
+            const bool isRigidBody2 = isBody2InSet || mRigidBodyComponents.hasComponent(pair.body2Entity);
 
-                    // If the colliding body is a RigidBody (and not a CollisionBody) and is not a trigger
-                    if (mRigidBodyComponents.hasComponent(pair.body1Entity) && mRigidBodyComponents.hasComponent(pair.body2Entity)
-                        && !mCollidersComponents.getIsTrigger(pair.collider1Entity) && !mCollidersComponents.getIsTrigger(pair.collider2Entity)) {
+            if ((isBody1InSet || isBody2InSet) && isRigidBody1 && isRigidBody2) {
 
-                        mProcessContactPairsOrderIslands.add(contactPairs[p]);
+                islandIndex = mIslandUnionFind.getIslandIndex(mIslandUnionFind.findRoot(isBody1InSet ? pair.body1Entity : pair.body2Entity));
+                assert(IslandUnionFind::isValid(islandIndex));
 
-                        assert(pair.potentialContactManifoldsIndices.size() > 0);
-                        nbTotalManifolds += pair.potentialContactManifoldsIndices.size();
+                assert(pair.potentialContactManifoldsIndices.size() > 0);
+                mIslands.nbContactManifolds[islandIndex] += pair.potentialContactManifoldsIndices.size();
+            }
+        }
 
-                        // Add the contact manifold into the island
-                        mIslands.nbContactManifolds[islandIndex] += pair.potentialContactManifoldsIndices.size();
-                        pair.isAlreadyInIsland = true;
+        contactPairsIslandIndices.add(islandIndex);
+        islandsContactPairsIndices[islandIndex]++;
+    }
 
-                        const Entity otherBodyEntity = pair.body1Entity == bodyToVisitEntity ? pair.body2Entity : pair.body1Entity;
+    // Compute the index of the first contact pair and first contact manifold of each island
+    uint32 nbTotalContactPairs = 0;
+    uint32 nbTotalManifolds = 0;
+    for (uint32 i=0; i <= islandRootNodes.size(); i++) {
 
-                        // Check if the other body has already been added to the island
-                        if (mRigidBodyComponents.getIsAlreadyInIsland(otherBodyEntity)) continue;
+        const uint32 nbIslandContactPairs = islandsContactPairsIndices[i];
+        islandsContactPairsIndices[i] = nbTotalContactPairs;
+        nbTotalContactPairs += nbIslandContactPairs;
 
-                        // Insert the other body into the stack of bodies to visit
-                        bodyEntityIndicesToVisit.push(otherBodyEntity);
-                        mRigidBodyComponents.setIsAlreadyInIsland(otherBodyEntity, true);
-                    }
-                    else {
+        if (i < islandRootNodes.size()) {
+            mIslands.contactManifoldsIndices[i] = nbTotalManifolds;
+            nbTotalManifolds += mIslands.nbContactManifolds[i];
+        }
+    }
 
-                        // Add the contact pair index in the list of contact pairs that won't be part of islands
-                        pair.isAlreadyInIsland = true;
-                    }
-                }
-            }
+    // Order the contact pairs by island. The pairs that are not part of the islands are at the end.
+    mProcessContactPairsOrderIslands.addWithoutInit(contactPairs.size());
+    for (uint32 p=0; p < contactPairs.size(); p++) {
+        mProcessContactPairsOrderIslands[islandsContactPairsIndices[contactPairsIslandIndices[p]]++] = p;
+    }
 
-            // For each joint in which the current body is involved
-            const List<Entity>& joints = mRigidBodyComponents.getJoints(rigidBodyToVisit->getEntity());
-            for (uint32 i=0; i < joints.size(); i++) {
+    for (uint32 i=0; i < islandRootNodes.size(); i++) {
+        mIslandUnionFind.resetIslandIndex(islandRootNodes[i]);
+    }
+}
 
-                // Check if the current joint has already been added into an island
-                if (mJointsComponents.getIsAlreadyInIsland(joints[i])) continue;
+// Split the sets of bodies that may have been disconnected since the last frame
+/// The bodies of those sets are put into their own set and are merged again through their joints and
+/// the contacts of their colliders. The contacts are taken from the overlapping pairs so that a pair of
+/// sleeping bodies, which is not tested anymore, still connects its bodies.
+void PhysicsWorld::splitIslandSets() {
 
-                // Add the joint into the island
-                mJointsComponents.setIsAlreadyInIsland(joints[i], true);
+    List<Entity> bodyEntities(mMemoryManager.getSingleFrameAllocator());
+    mIslandUnionFind.resetSetsToSplit(bodyEntities);
 
-                const Entity body1Entity = mJointsComponents.getBody1Entity(joints[i]);
-                const Entity body2Entity = mJointsComponents.getBody2Entity(joints[i]);
-                const Entity otherBodyEntity = body1Entity == bodyToVisitEntity ? body2Entity : body1Entity;
+    const OverlappingPairs& overlappingPairs = mCollisionDetection.mOverlappingPairs;
 
-                // Check if the other body has already been added to the island
-                if (mRigidBodyComponents.getIsAlreadyInIsland(otherBodyEntity)) continue;
+    for (uint32 b=0; b < bodyEntities.size(); b++) {
 
-                // Insert the other body into the stack of bodies to visit
-                bodyEntityIndicesToVisit.push(otherBodyEntity);
-                mRigidBodyComponents.setIsAlreadyInIsland(otherBodyEntity, true);
-            }
+        const Entity bodyEntity = bodyEntities[b];
+
+        // For each joint in which the body is involved
+        const List<Entity>& joints = mRigidBodyComponents.getJoints(bodyEntity);
+        for (uint32 i=0; i < joints.size(); i++) {
+            mIslandUnionFind.merge(mJointsComponents.getBody1Entity(joints[i]), mJointsComponents.getBody2Entity(joints[i]));
         }
 
-        // Reset the isAlreadyIsland variable of the static bodies so that they
-        // can also be included in the other islands
-        for (uint j=0; j < mRigidBodyComponents.getNbEnabledComponents(); j++) {
+        // For each colliding pair of a collider of the body
+        const List<Entity>& colliderEntities = mCollisionBodyComponents.getColliders(bodyEntity);
+        for (uint32 c=0; c < colliderEntities.size(); c++) {
+
+            if (mCollidersComponents.getIsTrigger(colliderEntities[c])) continue;
+
+            const List<uint64>& pairIds = mCollidersComponents.getOverlappingPairs(colliderEntities[c]);
+            for (uint32 i=0; i < pairIds.size(); i++) {
+
+                const uint64 pairIndex = overlappingPairs.mMapPairIdToPairIndex[pairIds[i]];
+                if (!overlappingPairs.mCollidingInCurrentFrame[pairIndex]) continue;
 
-            if (mRigidBodyComponents.mBodyTypes[j] == BodyType::STATIC) {
-                mRigidBodyComponents.mIsAlreadyInIsland[j] = false;
+                const Entity otherColliderEntity = overlappingPairs.mColliders1[pairIndex] == colliderEntities[c] ?
+                                                   overlappingPairs.mColliders2[pairIndex] : overlappingPairs.mColliders1[pairIndex];
+                if (mCollidersComponents.getIsTrigger(otherColliderEntity)) continue;
+
+                mIslandUnionFind.merge(bodyEntity, mCollidersComponents.getBody(otherColliderEntity));
             }
         }
     }
-
-    mCollisionDetection.mMapBodyToContactPairs.clear(true);
 }
 
 // Put bodies to sleep if needed.
@@ -980,6 +1082,41 @@ void PhysicsWorld::setNbIterationsPositionSolver(uint nbIterations) {
              "Physics World: Set nb iterations position solver to " + std::to_string(nbIterations),  __FILE__, __LINE__);
 }
 
+// Set the number of worker threads used to solve the islands in parallel
+/// The contacts of the different islands are independent and are solved in the same order
+/// as on a single thread, so the simulation gives the same result for any number of threads.
+/// The position correction is only used by the joints and is still solved on the calling thread.
+/// The narrow-phase tests of the collision detection and the integration of the bodies
+/// (by ranges of bodies) are also executed by the pool.
+/**
+ * @param nbWorkerThreads Number of worker threads in addition to the thread calling update() (zero to disable)
+ */
+void PhysicsWorld::setNbWorkerThreads(uint nbWorkerThreads) {
+
+    if (mThreadPool != nullptr) {
+
+        if (mThreadPool->getNbWorkers() == nbWorkerThreads) return;
+
+        mThreadPool->~ThreadPool();
+        mMemoryManager.release(MemoryManager::AllocationType::Base, mThreadPool, sizeof(ThreadPool));
+        mThreadPool = nullptr;
+    }
+
+    // Allocated with the base allocator because the mutex and condition variables of the pool need their natural alignment
+    if (nbWorkerThreads > 0) {
+        mThreadPool = new (mMemoryManager.allocate(MemoryManager::AllocationType::Base, sizeof(ThreadPool)))
+                                ThreadPool(mMemoryManager, nbWorkerThreads);
+    }
+
+    mCollisionDetection.setThreadPool(mThreadPool);
+    mDynamicsSystem.setThreadPool(mThreadPool);
+
+    mConfig.nbWorkerThreads = nbWorkerThreads;
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: Set nb worker threads to " + std::to_string(nbWorkerThreads),  __FILE__, __LINE__);
+}
+
 // Set the gravity vector of the world
 /**
  * @param gravity The gravity vector (in meter per seconds squared)
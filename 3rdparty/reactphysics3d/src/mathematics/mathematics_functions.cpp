@@ -410,6 +410,6 @@ bool reactphysics3d::isPrimeNumber(int number) {
 /// http://szudzik.com/ElegantPairing.pdf
 uint64 reactphysics3d::pairNumbers(uint32 number1, uint32 number2) {
     assert(number1 == std::max(number1, number2));
-    return number1 * number1 + number1 + number2;
+    return static_cast<uint64>(number1) * number1 + number1 + number2;
 }
 
@@ -25,14 +25,120 @@
 
 // Libraries
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <new>
+#include <cassert>
 
 using namespace reactphysics3d;
 
+// Initialization of static variables
+thread_local MemoryManager::ThreadAllocators* MemoryManager::mCurrentThreadAllocators = nullptr;
+
 // Constructor
 MemoryManager::MemoryManager(MemoryAllocator* baseAllocator, size_t initAllocatedMemory) :
                mBaseAllocator(baseAllocator == nullptr ? &mDefaultAllocator : baseAllocator),
                mHeapAllocator(*mBaseAllocator, initAllocatedMemory),
                mPoolAllocator(mHeapAllocator),
-               mSingleFrameAllocator(mHeapAllocator) {
+               mSingleFrameAllocator(mHeapAllocator), mThreadAllocators(nullptr) {
+
+}
+
+// Destructor
+MemoryManager::~MemoryManager() {
+
+    // Release the allocators of the threads
+    while (mThreadAllocators != nullptr) {
+
+        ThreadAllocators* threadAllocators = mThreadAllocators;
+        assert(!threadAllocators->isBound);
+        mThreadAllocators = threadAllocators->next;
+
+        mPoolAllocator.flushThreadCache(threadAllocators->poolCache);
+        mSingleFrameAllocator.destroyArena(threadAllocators->frameArena);
+        threadAllocators->~ThreadAllocators();
+        mBaseAllocator->release(threadAllocators, sizeof(ThreadAllocators));
+    }
+}
+
+// Reset the single frame allocator
+/// The arenas of the bound threads are reset together with the shared one. This must
+/// not happen while another thread is using the single frame allocator.
+void MemoryManager::resetFrameAllocator() {
+
+    mSingleFrameAllocator.reset();
+
+    std::lock_guard<std::mutex> lock(mThreadAllocatorsMutex);
+
+    for (ThreadAllocators* threadAllocators = mThreadAllocators; threadAllocators != nullptr;
+         threadAllocators = threadAllocators->next) {
+        mSingleFrameAllocator.resetArena(threadAllocators->frameArena);
+    }
+}
+
+// Give the calling thread its own pool cache and single frame arena
+/// Until unbindCurrentThread() is called, the pool and single frame allocations of the thread
+/// do not take any lock. The allocators are reused by the next thread that is bound once the
+/// thread is unbound. Calls can be nested.
+void MemoryManager::bindCurrentThread() {
+
+    ThreadAllocators* currentThreadAllocators = mCurrentThreadAllocators;
+
+    // If the thread is already bound to this memory manager
+    if (currentThreadAllocators != nullptr && currentThreadAllocators->memoryManager == this) {
+        currentThreadAllocators->nbBindings++;
+        return;
+    }
+
+    ThreadAllocators* threadAllocators = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mThreadAllocatorsMutex);
+
+        // Look for free allocators
+        for (ThreadAllocators* freeAllocators = mThreadAllocators; freeAllocators != nullptr;
+             freeAllocators = freeAllocators->next) {
+            if (!freeAllocators->isBound) {
+                threadAllocators = freeAllocators;
+                break;
+            }
+        }
+
+        // Create new allocators if necessary
+        if (threadAllocators == nullptr) {
+
+            threadAllocators = new (mBaseAllocator->allocate(sizeof(ThreadAllocators))) ThreadAllocators();
+            threadAllocators->memoryManager = this;
+            mPoolAllocator.initThreadCache(threadAllocators->poolCache);
+            mSingleFrameAllocator.initArena(threadAllocators->frameArena, SingleFrameAllocator::INIT_THREAD_ARENA_NB_BYTES);
+            threadAllocators->next = mThreadAllocators;
+            mThreadAllocators = threadAllocators;
+        }
+
+        threadAllocators->isBound = true;
+    }
+
+    threadAllocators->nbBindings = 1;
+    threadAllocators->previousThreadAllocators = currentThreadAllocators;
+
+    mCurrentThreadAllocators = threadAllocators;
+    PoolAllocator::setCurrentThreadCache(&threadAllocators->poolCache);
+    SingleFrameAllocator::setCurrentThreadArena(&threadAllocators->frameArena);
+}
+
+// Undo the previous call to bindCurrentThread() from the calling thread
+void MemoryManager::unbindCurrentThread() {
+
+    ThreadAllocators* threadAllocators = mCurrentThreadAllocators;
+    assert(threadAllocators != nullptr && threadAllocators->memoryManager == this);
+
+    threadAllocators->nbBindings--;
+    if (threadAllocators->nbBindings > 0) return;
+
+    // Give the thread back the allocators it had before
+    ThreadAllocators* previousThreadAllocators = threadAllocators->previousThreadAllocators;
+    mCurrentThreadAllocators = previousThreadAllocators;
+    PoolAllocator::setCurrentThreadCache(previousThreadAllocators != nullptr ? &previousThreadAllocators->poolCache : nullptr);
+    SingleFrameAllocator::setCurrentThreadArena(previousThreadAllocators != nullptr ? &previousThreadAllocators->frameArena : nullptr);
 
+    std::lock_guard<std::mutex> lock(mThreadAllocatorsMutex);
+    threadAllocators->isBound = false;
 }
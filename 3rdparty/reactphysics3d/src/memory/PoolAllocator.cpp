@@ -35,6 +35,7 @@ using namespace reactphysics3d;
 bool PoolAllocator::isMapSizeToHeadIndexInitialized = false;
 size_t PoolAllocator::mUnitSizes[NB_HEAPS];
 int PoolAllocator::mMapSizeToHeapIndex[MAX_UNIT_SIZE + 1];
+thread_local PoolAllocator::ThreadCache* PoolAllocator::mCurrentThreadCache = nullptr;
 
 // Constructor
 PoolAllocator::PoolAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator) {
@@ -100,9 +101,6 @@ PoolAllocator::~PoolAllocator() {
 // allocated memory.
 void* PoolAllocator::allocate(size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
     assert(size > 0);
 
     // We cannot allocate zero bytes
@@ -123,6 +121,30 @@ void* PoolAllocator::allocate(size_t size) {
     int indexHeap = mMapSizeToHeapIndex[size];
     assert(indexHeap >= 0 && indexHeap < NB_HEAPS);
 
+    // If the calling thread has its own cache of memory units for this allocator
+    ThreadCache* cache = mCurrentThreadCache;
+    if (cache != nullptr && cache->allocator == this) {
+
+        if (cache->freeMemoryUnits[indexHeap] == nullptr) {
+            refillThreadCache(*cache, indexHeap);
+        }
+
+        // Return a pointer to the cached memory unit
+        MemoryUnit* unit = cache->freeMemoryUnits[indexHeap];
+        cache->freeMemoryUnits[indexHeap] = unit->nextUnit;
+        cache->nbFreeMemoryUnits[indexHeap]--;
+        return unit;
+    }
+
+    // Lock the shared heaps with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    return allocateUnit(indexHeap);
+}
+
+// Return a free memory unit of a given heap (the mutex must be locked)
+PoolAllocator::MemoryUnit* PoolAllocator::allocateUnit(int indexHeap) {
+
     // If there still are free memory units in the corresponding heap
     if (mFreeMemoryUnits[indexHeap] != nullptr) {
 
@@ -178,9 +200,6 @@ void* PoolAllocator::allocate(size_t size) {
 // Release previously allocated memory.
 void PoolAllocator::release(void* pointer, size_t size) {
 
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
     assert(size > 0);
 
     // Cannot release a 0-byte allocated memory
@@ -202,9 +221,83 @@ void PoolAllocator::release(void* pointer, size_t size) {
     int indexHeap = mMapSizeToHeapIndex[size];
     assert(indexHeap >= 0 && indexHeap < NB_HEAPS);
 
+    MemoryUnit* releasedUnit = static_cast<MemoryUnit*>(pointer);
+
+    // If the calling thread has its own cache of memory units for this allocator
+    ThreadCache* cache = mCurrentThreadCache;
+    if (cache != nullptr && cache->allocator == this) {
+
+        // Insert the released memory unit into the cache
+        releasedUnit->nextUnit = cache->freeMemoryUnits[indexHeap];
+        cache->freeMemoryUnits[indexHeap] = releasedUnit;
+        cache->nbFreeMemoryUnits[indexHeap]++;
+
+        // If the cache is full, give a magazine back to the shared heaps
+        if (cache->nbFreeMemoryUnits[indexHeap] >= 2 * NB_UNITS_PER_MAGAZINE) {
+            flushThreadCache(*cache, indexHeap, NB_UNITS_PER_MAGAZINE);
+        }
+
+        return;
+    }
+
+    // Lock the shared heaps with a mutex
+    std::lock_guard<std::mutex> lock(mMutex);
+
     // Insert the released memory unit into the list of free memory units of the
     // corresponding heap
-    MemoryUnit* releasedUnit = static_cast<MemoryUnit*>(pointer);
     releasedUnit->nextUnit = mFreeMemoryUnits[indexHeap];
     mFreeMemoryUnits[indexHeap] = releasedUnit;
 }
+
+// Move a magazine of free memory units from the shared heaps into a thread cache
+void PoolAllocator::refillThreadCache(ThreadCache& cache, int indexHeap) {
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    for (uint i=0; i < NB_UNITS_PER_MAGAZINE; i++) {
+        MemoryUnit* unit = allocateUnit(indexHeap);
+        unit->nextUnit = cache.freeMemoryUnits[indexHeap];
+        cache.freeMemoryUnits[indexHeap] = unit;
+    }
+    cache.nbFreeMemoryUnits[indexHeap] += NB_UNITS_PER_MAGAZINE;
+}
+
+// Move a number of free memory units of a heap from a thread cache back to the shared heaps
+void PoolAllocator::flushThreadCache(ThreadCache& cache, int indexHeap, uint nbUnits) {
+
+    assert(nbUnits <= cache.nbFreeMemoryUnits[indexHeap]);
+
+    if (nbUnits == 0) return;
+
+    // Find the last unit of the sequence to move
+    MemoryUnit* firstUnit = cache.freeMemoryUnits[indexHeap];
+    MemoryUnit* lastUnit = firstUnit;
+    for (uint i=1; i < nbUnits; i++) {
+        lastUnit = lastUnit->nextUnit;
+    }
+    cache.freeMemoryUnits[indexHeap] = lastUnit->nextUnit;
+    cache.nbFreeMemoryUnits[indexHeap] -= nbUnits;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    lastUnit->nextUnit = mFreeMemoryUnits[indexHeap];
+    mFreeMemoryUnits[indexHeap] = firstUnit;
+}
+
+// Initialize an empty cache of free memory units for this allocator
+void PoolAllocator::initThreadCache(ThreadCache& cache) {
+
+    cache.allocator = this;
+    memset(cache.freeMemoryUnits, 0, sizeof(cache.freeMemoryUnits));
+    memset(cache.nbFreeMemoryUnits, 0, sizeof(cache.nbFreeMemoryUnits));
+}
+
+// Give all the memory units of a thread cache back to the shared heaps
+void PoolAllocator::flushThreadCache(ThreadCache& cache) {
+
+    assert(cache.allocator == this);
+
+    for (int i=0; i < NB_HEAPS; i++) {
+        flushThreadCache(cache, i, cache.nbFreeMemoryUnits[i]);
+    }
+}
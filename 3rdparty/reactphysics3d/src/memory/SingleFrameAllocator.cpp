@@ -31,64 +31,71 @@
 
 using namespace reactphysics3d;
 
+// Initialization of static variables
+thread_local SingleFrameAllocator::Arena* SingleFrameAllocator::mCurrentThreadArena = nullptr;
+
 // Constructor
-SingleFrameAllocator::SingleFrameAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator),
-                                           mTotalSizeBytes(INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES),
-                                           mCurrentOffset(0), mNbFramesTooMuchAllocated(0), mNeedToAllocatedMore(false) {
+SingleFrameAllocator::SingleFrameAllocator(MemoryAllocator& baseAllocator) : mBaseAllocator(baseAllocator) {
 
-    // Allocate a whole block of memory at the beginning
-    mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-    assert(mMemoryBufferStart != nullptr);
+    initArena(mArena, INIT_SINGLE_FRAME_ALLOCATOR_NB_BYTES);
 }
 
 // Destructor
 SingleFrameAllocator::~SingleFrameAllocator() {
 
-    // Release the memory allocated at the beginning
-    mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+    destroyArena(mArena);
 }
 
-
 // Allocate memory of a given size (in bytes) and return a pointer to the
 // allocated memory.
 void* SingleFrameAllocator::allocate(size_t size) {
 
-    // Lock the method with a mutex
+    // If the calling thread has its own arena for this allocator
+    Arena* arena = mCurrentThreadArena;
+    if (arena != nullptr && arena->allocator == this) {
+        return allocate(*arena, size);
+    }
+
+    // Lock the shared arena with a mutex
     std::lock_guard<std::mutex> lock(mMutex);
 
+    return allocate(mArena, size);
+}
+
+// Allocate memory of a given size (in bytes) from an arena
+void* SingleFrameAllocator::allocate(Arena& arena, size_t size) {
+
     // Check that there is enough remaining memory in the buffer
-    if (mCurrentOffset + size > mTotalSizeBytes) {
+    if (arena.currentOffset + size > arena.totalSizeBytes) {
 
         // We need to allocate more memory next time reset() is called
-        mNeedToAllocatedMore = true;
+        arena.needToAllocatedMore = true;
+
+        // Use default memory allocation and keep the block until the next reset
+        const size_t blockSizeBytes = sizeof(OverflowBlock) + size;
+        OverflowBlock* block = static_cast<OverflowBlock*>(mBaseAllocator.allocate(blockSizeBytes));
+        assert(block != nullptr);
+        block->next = arena.overflowBlocks;
+        block->sizeBytes = blockSizeBytes;
+        arena.overflowBlocks = block;
 
-        // Return default memory allocation
-        return mBaseAllocator.allocate(size);
+        return static_cast<void*>(block + 1);
     }
 
     // Next available memory location
-    void* nextAvailableMemory = mMemoryBufferStart + mCurrentOffset;
+    void* nextAvailableMemory = arena.memoryBufferStart + arena.currentOffset;
 
     // Increment the offset
-    mCurrentOffset += size;
+    arena.currentOffset += size;
 
     // Return the next available memory location
     return nextAvailableMemory;
 }
 
 // Release previously allocated memory.
-void SingleFrameAllocator::release(void* pointer, size_t size) {
-
-    // Lock the method with a mutex
-    std::lock_guard<std::mutex> lock(mMutex);
-
-    // If allocated memory is not within the single frame allocation range
-    char* p = static_cast<char*>(pointer);
-    if (p < mMemoryBufferStart || p > mMemoryBufferStart + mTotalSizeBytes) {
+/// The memory of a frame is only reclaimed when the arena it comes from is reset
+void SingleFrameAllocator::release(void* /*pointer*/, size_t /*size*/) {
 
-        // Use default deallocation
-        mBaseAllocator.release(pointer, size);
-    }
 }
 
 // Reset the marker of the current allocated memory
@@ -97,48 +104,95 @@ void SingleFrameAllocator::reset() {
     // Lock the method with a mutex
     std::lock_guard<std::mutex> lock(mMutex);
 
+    resetArena(mArena);
+}
+
+// Initialize an arena of a given initial size for this allocator
+void SingleFrameAllocator::initArena(Arena& arena, size_t initSizeBytes) {
+
+    arena.allocator = this;
+    arena.totalSizeBytes = initSizeBytes;
+    arena.currentOffset = 0;
+    arena.overflowBlocks = nullptr;
+    arena.nbFramesTooMuchAllocated = 0;
+    arena.needToAllocatedMore = false;
+
+    // Allocate a whole block of memory at the beginning
+    arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+    assert(arena.memoryBufferStart != nullptr);
+}
+
+// Reset the marker of an arena and release its overflow blocks
+void SingleFrameAllocator::resetArena(Arena& arena) {
+
+    assert(arena.allocator == this);
+
+    // Release the allocations that did not fit into the buffer
+    while (arena.overflowBlocks != nullptr) {
+        OverflowBlock* block = arena.overflowBlocks;
+        arena.overflowBlocks = block->next;
+        mBaseAllocator.release(block, block->sizeBytes);
+    }
+
     // If too much memory is allocated
-    if (mCurrentOffset < mTotalSizeBytes / 2) {
+    if (arena.currentOffset < arena.totalSizeBytes / 2) {
 
-        mNbFramesTooMuchAllocated++;
+        arena.nbFramesTooMuchAllocated++;
 
-        if (mNbFramesTooMuchAllocated > NB_FRAMES_UNTIL_SHRINK) {
+        if (arena.nbFramesTooMuchAllocated > NB_FRAMES_UNTIL_SHRINK) {
 
             // Release the memory allocated at the beginning
-            mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+            mBaseAllocator.release(arena.memoryBufferStart, arena.totalSizeBytes);
 
             // Divide the total memory to allocate by two
-            mTotalSizeBytes /= 2;
-            if (mTotalSizeBytes == 0) mTotalSizeBytes = 1;
+            arena.totalSizeBytes /= 2;
+            if (arena.totalSizeBytes == 0) arena.totalSizeBytes = 1;
 
             // Allocate a whole block of memory at the beginning
-            mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-            assert(mMemoryBufferStart != nullptr);
+            arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+            assert(arena.memoryBufferStart != nullptr);
 
-            mNbFramesTooMuchAllocated = 0;
+            arena.nbFramesTooMuchAllocated = 0;
         }
     }
     else {
-        mNbFramesTooMuchAllocated = 0;
+        arena.nbFramesTooMuchAllocated = 0;
     }
 
     // If we need to allocate more memory
-    if (mNeedToAllocatedMore) {
+    if (arena.needToAllocatedMore) {
 
         // Release the memory allocated at the beginning
-        mBaseAllocator.release(mMemoryBufferStart, mTotalSizeBytes);
+        mBaseAllocator.release(arena.memoryBufferStart, arena.totalSizeBytes);
 
         // Multiply the total memory to allocate by two
-        mTotalSizeBytes *= 2;
+        arena.totalSizeBytes *= 2;
 
         // Allocate a whole block of memory at the beginning
-        mMemoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(mTotalSizeBytes));
-        assert(mMemoryBufferStart != nullptr);
+        arena.memoryBufferStart = static_cast<char*>(mBaseAllocator.allocate(arena.totalSizeBytes));
+        assert(arena.memoryBufferStart != nullptr);
 
-        mNeedToAllocatedMore = false;
-        mNbFramesTooMuchAllocated = 0;
+        arena.needToAllocatedMore = false;
+        arena.nbFramesTooMuchAllocated = 0;
     }
 
     // Reset the current offset at the beginning of the block
-    mCurrentOffset = 0;
+    arena.currentOffset = 0;
+}
+
+// Release the memory of an arena
+void SingleFrameAllocator::destroyArena(Arena& arena) {
+
+    assert(arena.allocator == this);
+
+    // Release the allocations that did not fit into the buffer
+    while (arena.overflowBlocks != nullptr) {
+        OverflowBlock* block = arena.overflowBlocks;
+        arena.overflowBlocks = block->next;
+        mBaseAllocator.release(block, block->sizeBytes);
+    }
+
+    // Release the memory allocated at the beginning
+    mBaseAllocator.release(arena.memoryBufferStart, arena.totalSizeBytes);
+    arena.memoryBufferStart = nullptr;
 }
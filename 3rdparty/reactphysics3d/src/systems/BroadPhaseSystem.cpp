@@ -30,14 +30,25 @@
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/body/CollisionBody.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
+// Static variables definition
+const uint32 BroadPhaseSystem::NB_COLLIDERS_PER_TASK = 512;
+const uint32 BroadPhaseSystem::NB_SHAPES_PER_OVERLAP_TASK = 64;
+
 // Constructor
 BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection, ColliderComponents& collidersComponents,
                                    TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents)
                     :mDynamicAABBTree(collisionDetection.getMemoryManager().getPoolAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mDynamicWideAABBTree(collisionDetection.getMemoryManager().getPoolAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mSweepAndPrune(collisionDetection.getMemoryManager().getPoolAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mStaticAABBTree(collisionDetection.getMemoryManager().getPoolAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mIsStaticTreeModified(false),
+                     mBroadPhaseType(BroadPhaseType::DYNAMIC_AABB_TREE),
                      mCollidersComponents(collidersComponents), mTransformsComponents(transformComponents),
                      mRigidBodyComponents(rigidBodyComponents), mMovedShapes(collisionDetection.getMemoryManager().getPoolAllocator()),
                      mCollisionDetection(collisionDetection) {
@@ -59,8 +70,8 @@ bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 sha
     assert(shape1BroadPhaseId != -1 && shape2BroadPhaseId != -1);
 
     // Get the two AABBs of the collision shapes
-    const AABB& aabb1 = mDynamicAABBTree.getFatAABB(shape1BroadPhaseId);
-    const AABB& aabb2 = mDynamicAABBTree.getFatAABB(shape2BroadPhaseId);
+    const AABB& aabb1 = getFatAABB(shape1BroadPhaseId);
+    const AABB& aabb2 = getFatAABB(shape2BroadPhaseId);
 
     // Check if the two AABBs are overlapping
     return aabb1.testCollision(aabb2);
@@ -72,9 +83,120 @@ void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest,
 
     RP3D_PROFILE("BroadPhaseSystem::raycast()", mProfiler);
 
-    BroadPhaseRaycastCallback broadPhaseRaycastCallback(mDynamicAABBTree, raycastWithCategoryMaskBits, raycastTest);
+    BroadPhaseRaycastCallback broadPhaseRaycastCallback(*this, raycastWithCategoryMaskBits, raycastTest, false);
+
+    switch (mBroadPhaseType) {
+        case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: mDynamicWideAABBTree.raycast(ray, broadPhaseRaycastCallback); break;
+        case BroadPhaseType::SWEEP_AND_PRUNE: mSweepAndPrune.raycast(ray, broadPhaseRaycastCallback); break;
+        default: mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback); break;
+    }
+
+    // Raycast the static AABB tree with the part of the ray that has not been clipped by a hit
+    if (!broadPhaseRaycastCallback.isRaycastStopped()) {
+
+        const Ray staticRay(ray.point1, ray.point2, std::min(ray.maxFraction, broadPhaseRaycastCallback.getSmallestHitFraction()));
+        BroadPhaseRaycastCallback staticRaycastCallback(*this, raycastWithCategoryMaskBits, raycastTest, true);
+        mStaticAABBTree.raycast(staticRay, staticRaycastCallback);
+    }
+}
+
+// Report the broad-phase IDs of all the colliders with a fat AABB overlapping a given AABB
+void BroadPhaseSystem::reportAllShapesOverlappingWithAABB(const AABB& aabb, List<int>& overlappingBroadPhaseIds) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    const size_t startIndex = overlappingBroadPhaseIds.size();
+
+    switch (mBroadPhaseType) {
+        case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: mDynamicWideAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingBroadPhaseIds); break;
+        case BroadPhaseType::SWEEP_AND_PRUNE: mSweepAndPrune.reportAllShapesOverlappingWithAABB(aabb, overlappingBroadPhaseIds); break;
+        default: mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingBroadPhaseIds); break;
+    }
+
+    // Convert the IDs in the data structure into broad-phase IDs
+    const size_t staticStartIndex = overlappingBroadPhaseIds.size();
+    for (size_t i=startIndex; i < staticStartIndex; i++) {
+        overlappingBroadPhaseIds[i] = computeBroadPhaseId(overlappingBroadPhaseIds[i], false);
+    }
+
+    mStaticAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingBroadPhaseIds);
+    for (size_t i=staticStartIndex; i < overlappingBroadPhaseIds.size(); i++) {
+        overlappingBroadPhaseIds[i] = computeBroadPhaseId(overlappingBroadPhaseIds[i], true);
+    }
+}
+
+// Ray casting method for a batch of rays that writes the closest hit of each ray in the output
+// array. The rays are traversed by packets of SIMD_WIDTH consecutive rays in the AABB trees (the
+// wide tree and the sweep and prune are raycast one ray at a time). This method does not modify
+// the broad-phase and does not use the profiler. Therefore, it can be called from several threads
+// at the same time as long as the allocator is thread-safe.
+void BroadPhaseSystem::raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                                    unsigned short raycastWithCategoryMaskBits, MemoryAllocator& allocator) const {
+
+    BroadPhaseRaycastBatchCallback batchCallback(*this, raycastWithCategoryMaskBits, allocator);
+
+    decimal maxFractions[SIMD_WIDTH];
+
+    // For each packet of rays
+    for (uint firstRay=0; firstRay < nbRays; firstRay += SIMD_WIDTH) {
+
+        const uint nbPacketRays = std::min(SIMD_WIDTH, nbRays - firstRay);
+        const Ray* packetRays = rays + firstRay;
+        RaycastBatchHit* packetHits = outHits + firstRay;
+
+        for (uint i=0; i < nbPacketRays; i++) {
+            packetHits[i] = RaycastBatchHit();
+            maxFractions[i] = packetRays[i].maxFraction;
+        }
+
+        batchCallback.setPacket(packetHits, false);
+
+        switch (mBroadPhaseType) {
+            case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE:
+                for (uint i=0; i < nbPacketRays; i++) {
+                    BroadPhaseRaycastBatchRayCallback rayCallback(batchCallback, i);
+                    mDynamicWideAABBTree.raycast(packetRays[i], rayCallback, allocator);
+                }
+                break;
+            case BroadPhaseType::SWEEP_AND_PRUNE:
+                for (uint i=0; i < nbPacketRays; i++) {
+                    BroadPhaseRaycastBatchRayCallback rayCallback(batchCallback, i);
+                    mSweepAndPrune.raycast(packetRays[i], rayCallback);
+                }
+                break;
+            default:
+                mDynamicAABBTree.raycastPacket(packetRays, maxFractions, nbPacketRays, batchCallback, allocator);
+                break;
+        }
+
+        // Raycast the static AABB tree with the rays clipped by their closest hit
+        for (uint i=0; i < nbPacketRays; i++) {
+            if (packetHits[i].isHit()) {
+                maxFractions[i] = std::min(maxFractions[i], packetHits[i].hitFraction);
+            }
+        }
+        batchCallback.setPacket(packetHits, true);
+        mStaticAABBTree.raycastPacket(packetRays, maxFractions, nbPacketRays, batchCallback, allocator);
+    }
+}
+
+// Set the data structure used to store the colliders. This has to be done before any
+// collider is added because the broad-phase IDs of the colliders are given by the data structure.
+void BroadPhaseSystem::setBroadPhaseType(BroadPhaseType broadPhaseType) {
+
+    assert(mCollidersComponents.getNbComponents() == 0);
+
+    mBroadPhaseType = broadPhaseType;
+}
+
+// Return true if a collider has to be stored in the static AABB tree. The sweep and prune
+// keeps the colliders of the static bodies because their endpoints never move.
+bool BroadPhaseSystem::isColliderInStaticTree(Collider* collider) const {
+
+    if (mBroadPhaseType == BroadPhaseType::SWEEP_AND_PRUNE) return false;
 
-    mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback);
+    const Entity bodyEntity = collider->getBody()->getEntity();
+    return mRigidBodyComponents.hasComponent(bodyEntity) && mRigidBodyComponents.getBodyType(bodyEntity) == BodyType::STATIC;
 }
 
 // Add a collider into the broad-phase collision detection
@@ -82,11 +204,24 @@ void BroadPhaseSystem::addCollider(Collider* collider, const AABB& aabb) {
 
     assert(collider->getBroadPhaseId() == -1);
 
-    // Add the collision shape into the dynamic AABB tree and get its broad-phase ID
-    int nodeId = mDynamicAABBTree.addObject(aabb, collider);
+    const bool isInStaticTree = isColliderInStaticTree(collider);
+
+    // Add the collision shape into the broad-phase data structure and get its ID in this structure
+    int32 nodeId;
+    if (isInStaticTree) {
+        nodeId = mStaticAABBTree.addObject(aabb, collider);
+        mIsStaticTreeModified = true;
+    }
+    else {
+        switch (mBroadPhaseType) {
+            case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: nodeId = mDynamicWideAABBTree.addObject(aabb, collider); break;
+            case BroadPhaseType::SWEEP_AND_PRUNE: nodeId = mSweepAndPrune.addObject(aabb, collider); break;
+            default: nodeId = mDynamicAABBTree.addObject(aabb, collider); break;
+        }
+    }
 
     // Set the broad-phase ID of the collider
-    mCollidersComponents.setBroadPhaseId(collider->getEntity(), nodeId);
+    mCollidersComponents.setBroadPhaseId(collider->getEntity(), computeBroadPhaseId(nodeId, isInStaticTree));
 
     // Add the collision shape into the array of bodies that have moved (or have been created)
     // during the last simulation step
@@ -102,8 +237,19 @@ void BroadPhaseSystem::removeCollider(Collider* collider) {
 
     mCollidersComponents.setBroadPhaseId(collider->getEntity(), -1);
 
-    // Remove the collision shape from the dynamic AABB tree
-    mDynamicAABBTree.removeObject(broadPhaseID);
+    // Remove the collision shape from the broad-phase data structure
+    const int32 nodeId = getNodeId(broadPhaseID);
+    if (isStaticBroadPhaseId(broadPhaseID)) {
+        mStaticAABBTree.removeObject(nodeId);
+        mIsStaticTreeModified = true;
+    }
+    else {
+        switch (mBroadPhaseType) {
+            case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: mDynamicWideAABBTree.removeObject(nodeId); break;
+            case BroadPhaseType::SWEEP_AND_PRUNE: mSweepAndPrune.removeObject(nodeId); break;
+            default: mDynamicAABBTree.removeObject(nodeId); break;
+        }
+    }
 
     // Remove the collision shape into the array of shapes that have moved (or have been created)
     // during the last simulation step
@@ -123,13 +269,75 @@ void BroadPhaseSystem::updateCollider(Entity colliderEntity, decimal timeStep) {
 }
 
 // Update the broad-phase state of all the enabled colliders
-void BroadPhaseSystem::updateColliders(decimal timeStep) {
+/// With a thread pool, the AABBs of the colliders are computed by ranges in parallel together
+/// with the test against their fat AABB (that only changes when the collider itself is updated).
+/// The colliders that have moved out of their fat AABB are then updated in the broad-phase data
+/// structure in a single pass, in the same order as on a single thread.
+void BroadPhaseSystem::updateColliders(decimal timeStep, ThreadPool* threadPool) {
 
     RP3D_PROFILE("BroadPhaseSystem::updateColliders()", mProfiler);
 
-    // Update all the enabled collider components
-    if (mCollidersComponents.getNbEnabledComponents() > 0) {
-        updateCollidersComponents(0, mCollidersComponents.getNbEnabledComponents(), timeStep);
+    const uint32 nbColliders = mCollidersComponents.getNbEnabledComponents();
+
+    if (nbColliders == 0) return;
+
+    // Update all the enabled collider components on this thread
+    if (threadPool == nullptr || nbColliders <= NB_COLLIDERS_PER_TASK) {
+        updateCollidersComponents(0, nbColliders, timeStep);
+        return;
+    }
+
+    MemoryManager& memoryManager = mCollisionDetection.getMemoryManager();
+    AABB* aabbs = static_cast<AABB*>(memoryManager.allocate(MemoryManager::AllocationType::Frame, sizeof(AABB) * nbColliders));
+    bool* isUpdateNeeded = static_cast<bool*>(memoryManager.allocate(MemoryManager::AllocationType::Frame, sizeof(bool) * nbColliders));
+    bool* isReInsertForced = static_cast<bool*>(memoryManager.allocate(MemoryManager::AllocationType::Frame, sizeof(bool) * nbColliders));
+
+    // Compute the AABBs of the colliders in parallel
+    const uint32 nbTasks = (nbColliders + NB_COLLIDERS_PER_TASK - 1) / NB_COLLIDERS_PER_TASK;
+    threadPool->parallelFor(nbTasks, [this, nbColliders, timeStep, aabbs, isUpdateNeeded, isReInsertForced](uint taskIndex) {
+        const uint32 startIndex = taskIndex * NB_COLLIDERS_PER_TASK;
+        computeCollidersAABBs(startIndex, std::min(startIndex + NB_COLLIDERS_PER_TASK, nbColliders), timeStep, aabbs,
+                              isUpdateNeeded, isReInsertForced);
+    });
+
+    // Update the broad-phase data structures with the colliders that have moved out of their fat AABB
+    for (uint32 i=0; i < nbColliders; i++) {
+        if (isUpdateNeeded[i]) {
+            updateColliderInternal(mCollidersComponents.mBroadPhaseIds[i], mCollidersComponents.mColliders[i], aabbs[i],
+                                   isReInsertForced[i]);
+        }
+    }
+
+    memoryManager.release(MemoryManager::AllocationType::Frame, isReInsertForced, sizeof(bool) * nbColliders);
+    memoryManager.release(MemoryManager::AllocationType::Frame, isUpdateNeeded, sizeof(bool) * nbColliders);
+    memoryManager.release(MemoryManager::AllocationType::Frame, aabbs, sizeof(AABB) * nbColliders);
+}
+
+// Compute the world-space AABB of the colliders components in [startIndex, endIndex).
+/// The data structure of a collider only has to be updated if its size has been changed by
+/// the user or if its new AABB is not inside its fat AABB anymore.
+void BroadPhaseSystem::computeCollidersAABBs(uint32 startIndex, uint32 endIndex, decimal timeStep, AABB* aabbs, bool* isUpdateNeeded,
+                                             bool* isReInsertForced) {
+
+    for (uint32 i = startIndex; i < endIndex; i++) {
+
+        const int32 broadPhaseId = mCollidersComponents.mBroadPhaseIds[i];
+        isUpdateNeeded[i] = false;
+
+        if (broadPhaseId != -1) {
+
+            const Entity& bodyEntity = mCollidersComponents.mBodiesEntities[i];
+            const Transform& transform = mTransformsComponents.getTransform(bodyEntity);
+
+            // Recompute the world-space AABB of the collision shape
+            mCollidersComponents.mCollisionShapes[i]->computeAABB(aabbs[i], transform * mCollidersComponents.mLocalToBodyTransforms[i]);
+            addContinuousMotion(bodyEntity, timeStep, aabbs[i]);
+
+            isReInsertForced[i] = mCollidersComponents.mHasCollisionShapeChangedSize[i];
+            isUpdateNeeded[i] = isReInsertForced[i] || !getFatAABB(broadPhaseId).contains(aabbs[i]);
+
+            mCollidersComponents.mHasCollisionShapeChangedSize[i] = false;
+        }
     }
 }
 
@@ -139,8 +347,31 @@ void BroadPhaseSystem::updateColliderInternal(int32 broadPhaseId, Collider* coll
 
     assert(broadPhaseId >= 0);
 
+    const int32 nodeId = getNodeId(broadPhaseId);
+
+    // If the collider of a static body has been moved, the static AABB tree will be rebuilt
+    if (isStaticBroadPhaseId(broadPhaseId)) {
+        if (mStaticAABBTree.updateObject(nodeId, aabb, forceReInsert)) {
+            mIsStaticTreeModified = true;
+            addMovedCollider(broadPhaseId, collider);
+        }
+        return;
+    }
+
+    // With the sweep and prune, the pairs that start to overlap while the endpoints of the
+    // collider are sorted are stored in its pair cache. We only need to test again the
+    // existing overlapping pairs of the collider if its fat AABB has changed.
+    if (mBroadPhaseType == BroadPhaseType::SWEEP_AND_PRUNE) {
+        if (mSweepAndPrune.updateObject(nodeId, aabb, forceReInsert)) {
+            mCollisionDetection.notifyOverlappingPairsToTestOverlap(collider);
+        }
+        return;
+    }
+
     // Update the dynamic AABB tree according to the movement of the collision shape
-    bool hasBeenReInserted = mDynamicAABBTree.updateObject(broadPhaseId, aabb, forceReInsert);
+    bool hasBeenReInserted = mBroadPhaseType == BroadPhaseType::DYNAMIC_WIDE_AABB_TREE ?
+                                 mDynamicWideAABBTree.updateObject(nodeId, aabb, forceReInsert) :
+                                 mDynamicAABBTree.updateObject(nodeId, aabb, forceReInsert);
 
     // If the collision shape has moved out of its fat AABB (and therefore has been reinserted
     // into the tree).
@@ -178,6 +409,7 @@ void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbIte
             // Recompute the world-space AABB of the collision shape
             AABB aabb;
             mCollidersComponents.mCollisionShapes[i]->computeAABB(aabb, transform * mCollidersComponents.mLocalToBodyTransforms[i]);
+            addContinuousMotion(bodyEntity, timeStep, aabb);
 
             // If the size of the collision shape has been changed by the user,
             // we need to reset the broad-phase AABB to its new size
@@ -192,6 +424,21 @@ void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbIte
 }
 
 
+// Enlarge the AABB of a collider of a body with continuous collision detection by the motion of the body during a step
+/// The AABB also covers the collider moved by the current linear velocity of the body during the step. This
+/// way, the collider already overlaps in the broad-phase with the colliders that it reaches during the next
+/// step and the narrow-phase can create speculative contacts with them.
+void BroadPhaseSystem::addContinuousMotion(Entity bodyEntity, decimal timeStep, AABB& aabb) const {
+
+    if (timeStep <= decimal(0.0) || !mRigidBodyComponents.hasComponent(bodyEntity) ||
+        !mRigidBodyComponents.getIsCCDEnabled(bodyEntity) || mRigidBodyComponents.getBodyType(bodyEntity) != BodyType::DYNAMIC) {
+        return;
+    }
+
+    const Vector3 translation = mRigidBodyComponents.getLinearVelocity(bodyEntity) * timeStep;
+    aabb.mergeWithAABB(AABB(aabb.getMin() + translation, aabb.getMax() + translation));
+}
+
 // Add a collider in the array of colliders that have moved in the last simulation step
 // and that need to be tested again for broad-phase overlapping.
 void BroadPhaseSystem::addMovedCollider(int broadPhaseID, Collider* collider) {
@@ -206,21 +453,156 @@ void BroadPhaseSystem::addMovedCollider(int broadPhaseID, Collider* collider) {
 }
 
 // Compute all the overlapping pairs of collision shapes
-void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, List<Pair<int32, int32>>& overlappingNodes) {
+/// With a thread pool, the moved colliders are tested for overlap by ranges in parallel.
+void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, List<Pair<int32, int32>>& overlappingNodes,
+                                               ThreadPool* threadPool) {
 
     RP3D_PROFILE("BroadPhaseSystem::computeOverlappingPairs()", mProfiler);
 
-    // Get the list of the colliders that have moved or have been created in the last frame
-    List<int> shapesToTest = mMovedShapes.toList(memoryManager.getPoolAllocator());
+    MemoryAllocator& allocator = memoryManager.getPoolAllocator();
+
+    // Rebuild the static AABB tree if colliders of static bodies have been added, removed or moved
+    if (mIsStaticTreeModified) {
+        mStaticAABBTree.rebuild();
+        mIsStaticTreeModified = false;
+    }
+
+    // Get the IDs (in their data structure) of the colliders that have moved or have been
+    // created in the last frame
+    List<int32> shapesToTest(allocator, mMovedShapes.size());
+    List<int32> staticShapesToTest(allocator);
+    for (auto it = mMovedShapes.begin(); it != mMovedShapes.end(); ++it) {
+        if (isStaticBroadPhaseId(*it)) {
+            staticShapesToTest.add(getNodeId(*it));
+        }
+        else {
+            shapesToTest.add(getNodeId(*it));
+        }
+    }
+
+    if (mBroadPhaseType == BroadPhaseType::SWEEP_AND_PRUNE) {
+
+        // The shapes to test are the new colliders and the colliders for which a new
+        // broad-phase test has been asked. The pairs of colliders that have started to
+        // overlap because they have moved are in the pair cache of the sweep and prune.
+        const uint startIndex = overlappingNodes.size();
+        mSweepAndPrune.reportNewOverlappingPairs(overlappingNodes);
+        for (uint i=startIndex; i < overlappingNodes.size(); i++) {
+            overlappingNodes[i].first = computeBroadPhaseId(overlappingNodes[i].first, false);
+            overlappingNodes[i].second = computeBroadPhaseId(overlappingNodes[i].second, false);
+        }
+    }
+
+    // Report the pairs with the moved colliders on this thread
+    const uint nbTasks = (shapesToTest.size() + NB_SHAPES_PER_OVERLAP_TASK - 1) / NB_SHAPES_PER_OVERLAP_TASK;
+    if (threadPool == nullptr || nbTasks < 2) {
+
+        List<Pair<int32, int32>> staticOverlappingNodes(allocator);
+        reportOverlappingPairs(shapesToTest, 0, shapesToTest.size(), overlappingNodes, staticOverlappingNodes, allocator);
+        overlappingNodes.addRange(staticOverlappingNodes);
+    }
+    else {
+
+        // Each task reports the pairs of a range of moved colliders in its own lists. The lists are
+        // then merged in the order of the tasks so that the pairs are in the same order as on a single thread.
+        List<Pair<int32, int32>>* tasksOverlappingNodes = static_cast<List<Pair<int32, int32>>*>(
+                    memoryManager.allocate(MemoryManager::AllocationType::Frame, sizeof(List<Pair<int32, int32>>) * 2 * nbTasks));
+        for (uint t=0; t < 2 * nbTasks; t++) {
+            new (tasksOverlappingNodes + t) List<Pair<int32, int32>>(allocator);
+        }
+
+        threadPool->parallelFor(nbTasks, [this, &shapesToTest, tasksOverlappingNodes, nbTasks, &allocator](uint taskIndex) {
+            const uint startIndex = taskIndex * NB_SHAPES_PER_OVERLAP_TASK;
+            const uint endIndex = std::min(startIndex + NB_SHAPES_PER_OVERLAP_TASK, static_cast<uint>(shapesToTest.size()));
+            reportOverlappingPairs(shapesToTest, startIndex, endIndex, tasksOverlappingNodes[taskIndex],
+                                   tasksOverlappingNodes[nbTasks + taskIndex], allocator);
+        });
+
+        for (uint t=0; t < 2 * nbTasks; t++) {
+            overlappingNodes.addRange(tasksOverlappingNodes[t]);
+            tasksOverlappingNodes[t].~List<Pair<int32, int32>>();
+        }
+
+        memoryManager.release(MemoryManager::AllocationType::Frame, tasksOverlappingNodes,
+                              sizeof(List<Pair<int32, int32>>) * 2 * nbTasks);
+    }
+
+    if (mBroadPhaseType != BroadPhaseType::SWEEP_AND_PRUNE) {
+
+        List<int32> overlappingShapes(allocator);
 
-    // Ask the dynamic AABB tree to report all collision shapes that overlap with the shapes to test
-    mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, 0, shapesToTest.size(), overlappingNodes);
+        // Report the non-static colliders overlapping with the moved static colliders (the
+        // pairs of static colliders are never reported)
+        for (uint i=0; i < staticShapesToTest.size(); i++) {
+
+            overlappingShapes.clear();
+            const AABB& staticShapeAABB = mStaticAABBTree.getFatAABB(staticShapesToTest[i]);
+            if (mBroadPhaseType == BroadPhaseType::DYNAMIC_WIDE_AABB_TREE) {
+                mDynamicWideAABBTree.reportAllShapesOverlappingWithAABB(staticShapeAABB, overlappingShapes);
+            }
+            else {
+                mDynamicAABBTree.reportAllShapesOverlappingWithAABB(staticShapeAABB, overlappingShapes);
+            }
+
+            for (uint j=0; j < overlappingShapes.size(); j++) {
+                overlappingNodes.add(Pair<int32, int32>(computeBroadPhaseId(staticShapesToTest[i], true), computeBroadPhaseId(overlappingShapes[j], false)));
+            }
+        }
+    }
 
     // Reset the array of collision shapes that have move (or have been created) during the
     // last simulation step
     mMovedShapes.clear();
 }
 
+// Report the pairs of colliders overlapping with the moved colliders in [startIndex, endIndex).
+/// The pairs with the colliders of the broad-phase data structure are added into outOverlappingNodes
+/// and the ones with the colliders of the static AABB tree into outStaticOverlappingNodes.
+void BroadPhaseSystem::reportOverlappingPairs(const List<int32>& shapesToTest, uint startIndex, uint endIndex,
+                                              List<Pair<int32, int32>>& outOverlappingNodes,
+                                              List<Pair<int32, int32>>& outStaticOverlappingNodes,
+                                              MemoryAllocator& allocator) const {
+
+    const uint outStartIndex = outOverlappingNodes.size();
+
+    // Ask the broad-phase data structure to report all collision shapes that overlap with the shapes to test
+    switch (mBroadPhaseType) {
+
+        case BroadPhaseType::DYNAMIC_WIDE_AABB_TREE:
+            mDynamicWideAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, startIndex, endIndex, outOverlappingNodes);
+            break;
+
+        case BroadPhaseType::SWEEP_AND_PRUNE:
+            mSweepAndPrune.reportAllShapesOverlappingWithShapes(shapesToTest, startIndex, endIndex, outOverlappingNodes);
+            break;
+
+        default:
+            mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, startIndex, endIndex, outOverlappingNodes);
+            break;
+    }
+
+    // Convert the IDs of the data structure into broad-phase IDs
+    for (uint i=outStartIndex; i < outOverlappingNodes.size(); i++) {
+        outOverlappingNodes[i].first = computeBroadPhaseId(outOverlappingNodes[i].first, false);
+        outOverlappingNodes[i].second = computeBroadPhaseId(outOverlappingNodes[i].second, false);
+    }
+
+    if (mBroadPhaseType == BroadPhaseType::SWEEP_AND_PRUNE) return;
+
+    List<int32> overlappingShapes(allocator);
+
+    // Report the colliders of the static AABB tree overlapping with the moved colliders
+    for (uint i=startIndex; i < endIndex; i++) {
+
+        overlappingShapes.clear();
+        mStaticAABBTree.reportAllShapesOverlappingWithAABB(getFatAABB(computeBroadPhaseId(shapesToTest[i], false)), overlappingShapes);
+
+        for (uint j=0; j < overlappingShapes.size(); j++) {
+            outStaticOverlappingNodes.add(Pair<int32, int32>(computeBroadPhaseId(shapesToTest[i], false), computeBroadPhaseId(overlappingShapes[j], true)));
+        }
+    }
+}
+
 // Called when a overlapping node has been found during the call to
 // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
 void AABBOverlapCallback::notifyOverlappingNode(int nodeId) {
@@ -233,7 +615,7 @@ decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ra
     decimal hitFraction = decimal(-1.0);
 
     // Get the collider from the node
-    Collider* collider = static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
+    Collider* collider = mBroadPhaseSystem.getColliderForBroadPhaseId(BroadPhaseSystem::computeBroadPhaseId(nodeId, mIsStaticTree));
 
     // Check if the raycast filtering mask allows raycast against this shape
     if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) != 0) {
@@ -242,7 +624,43 @@ decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ra
         // the collider of this node because the ray is overlapping
         // with the shape in the broad-phase
         hitFraction = mRaycastTest.raycastAgainstShape(collider, ray);
+
+        if (hitFraction == decimal(0.0)) {
+            mIsRaycastStopped = true;
+        }
+        else if (hitFraction > decimal(0.0) && hitFraction < mSmallestHitFraction) {
+            mSmallestHitFraction = hitFraction;
+        }
     }
 
     return hitFraction;
 }
+
+// Called for a broad-phase shape that has to be tested for raycast with a ray of the packet
+decimal BroadPhaseRaycastBatchCallback::raycastBroadPhaseShape(int32 nodeId, uint rayIndex, const Ray& ray) {
+
+    // Get the collider from the node
+    Collider* collider = mBroadPhaseSystem.getColliderForBroadPhaseId(BroadPhaseSystem::computeBroadPhaseId(nodeId, mIsStaticTree));
+
+    // Check if the raycast filtering mask allows raycast against this shape
+    if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) == 0) return decimal(-1.0);
+
+    // Ray casting test against the collision shape
+    RaycastInfo raycastInfo;
+    if (!collider->raycast(ray, raycastInfo, mAllocator)) return decimal(-1.0);
+
+    // Keep the hit if it is the closest one of the ray
+    RaycastBatchHit& hit = mHits[rayIndex];
+    if (!hit.isHit() || raycastInfo.hitFraction < hit.hitFraction) {
+        hit.worldPoint = raycastInfo.worldPoint;
+        hit.worldNormal = raycastInfo.worldNormal;
+        hit.hitFraction = raycastInfo.hitFraction;
+        hit.meshSubpart = raycastInfo.meshSubpart;
+        hit.triangleIndex = raycastInfo.triangleIndex;
+        hit.body = raycastInfo.body;
+        hit.collider = raycastInfo.collider;
+    }
+
+    // Clip the ray with the hit fraction for the next tests
+    return raycastInfo.hitFraction;
+}
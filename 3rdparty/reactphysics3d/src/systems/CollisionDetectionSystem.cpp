@@ -40,7 +40,11 @@
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/collision/ShapeCastInfo.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
 #include <reactphysics3d/containers/Pair.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 #include <cassert>
 #include <iostream>
 
@@ -48,6 +52,9 @@
 using namespace reactphysics3d;
 using namespace std;
 
+// Initialization of static variables
+const uint CollisionDetectionSystem::NB_MAX_NARROW_PHASE_TESTS_PER_TASK;
+
 // Constructor
 CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, ColliderComponents& collidersComponents, TransformComponents& transformComponents,
                                        CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents, MemoryManager& memoryManager)
@@ -67,7 +74,8 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
                      mContactManifolds2(mMemoryManager.getPoolAllocator()), mPreviousContactManifolds(&mContactManifolds1), mCurrentContactManifolds(&mContactManifolds2),
                      mContactPoints1(mMemoryManager.getPoolAllocator()),
                      mContactPoints2(mMemoryManager.getPoolAllocator()), mPreviousContactPoints(&mContactPoints1),
-                     mCurrentContactPoints(&mContactPoints2), mMapBodyToContactPairs(mMemoryManager.getSingleFrameAllocator()) {
+                     mCurrentContactPoints(&mContactPoints2),
+                     mThreadPool(nullptr) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -81,7 +89,7 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
 }
 
 // Compute the collision detection
-void CollisionDetectionSystem::computeCollisionDetection() {
+void CollisionDetectionSystem::computeCollisionDetection(decimal timeStep) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeCollisionDetection()", mProfiler);
 	    
@@ -92,7 +100,7 @@ void CollisionDetectionSystem::computeCollisionDetection() {
     computeMiddlePhase(mNarrowPhaseInput, true);
     
     // Compute the narrow-phase collision detection
-    computeNarrowPhase();
+    computeNarrowPhase(timeStep);
 }
 
 // Compute the broad-phase collision detection
@@ -104,7 +112,7 @@ void CollisionDetectionSystem::computeBroadPhase() {
     // have moved or have been added in the last frame. This call can only add new
     // overlapping pairs in the collision detection.
     List<Pair<int32, int32>> overlappingNodes(mMemoryManager.getPoolAllocator(), 32);
-    mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, overlappingNodes);
+    mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, overlappingNodes, mThreadPool);
 
     // Create new overlapping pairs if necessary
     updateOverlappingPairs(overlappingNodes);
@@ -432,57 +440,124 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(uint64 pairInde
 }
 
 // Execute the narrow-phase collision detection algorithm on batches
-bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput,
-                                                        bool clipWithPreviousAxisIfStillColliding, MemoryAllocator& allocator) {
+/// With a thread pool, the batches are split into ranges of tests executed in parallel. Each test
+/// only writes its own contact points and last frame collision info in the batch, so the result
+/// is the same as on a single thread.
+bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, bool clipWithPreviousAxisIfStillColliding,
+                                                        MemoryAllocator& allocator, ThreadPool* threadPool) {
+
+    const NarrowPhaseAlgorithmType algorithmTypes[] = {NarrowPhaseAlgorithmType::SphereVsSphere, NarrowPhaseAlgorithmType::SphereVsCapsule,
+                                                       NarrowPhaseAlgorithmType::CapsuleVsCapsule, NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron,
+                                                       NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron,
+                                                       NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron,
+                                                       NarrowPhaseAlgorithmType::BoxVsBox};
+    const uint nbBatchItems[] = {narrowPhaseInput.getSphereVsSphereBatch().getNbObjects(), narrowPhaseInput.getSphereVsCapsuleBatch().getNbObjects(),
+                                 narrowPhaseInput.getCapsuleVsCapsuleBatch().getNbObjects(), narrowPhaseInput.getSphereVsConvexPolyhedronBatch().getNbObjects(),
+                                 narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch().getNbObjects(),
+                                 narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch().getNbObjects(),
+                                 narrowPhaseInput.getBoxVsBoxBatch().getNbObjects()};
+    const uint nbBatches = sizeof(algorithmTypes) / sizeof(algorithmTypes[0]);
+
+    // Number of tasks if the batches are split
+    uint nbTasks = 0;
+    for (uint b=0; b < nbBatches; b++) {
+        nbTasks += (nbBatchItems[b] + NB_MAX_NARROW_PHASE_TESTS_PER_TASK - 1) / NB_MAX_NARROW_PHASE_TESTS_PER_TASK;
+    }
 
     bool contactFound = false;
 
-    // Get the narrow-phase collision detection algorithms for each kind of collision shapes
-    SphereVsSphereAlgorithm* sphereVsSphereAlgo = mCollisionDispatch.getSphereVsSphereAlgorithm();
-    SphereVsCapsuleAlgorithm* sphereVsCapsuleAlgo = mCollisionDispatch.getSphereVsCapsuleAlgorithm();
-    CapsuleVsCapsuleAlgorithm* capsuleVsCapsuleAlgo = mCollisionDispatch.getCapsuleVsCapsuleAlgorithm();
-    SphereVsConvexPolyhedronAlgorithm* sphereVsConvexPolyAlgo = mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm();
-    CapsuleVsConvexPolyhedronAlgorithm* capsuleVsConvexPolyAlgo = mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm();
-    ConvexPolyhedronVsConvexPolyhedronAlgorithm* convexPolyVsConvexPolyAlgo = mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm();
-
-    // get the narrow-phase batches to test for collision for contacts
-    SphereVsSphereNarrowPhaseInfoBatch& sphereVsSphereBatchContacts = narrowPhaseInput.getSphereVsSphereBatch();
-    SphereVsCapsuleNarrowPhaseInfoBatch& sphereVsCapsuleBatchContacts = narrowPhaseInput.getSphereVsCapsuleBatch();
-    CapsuleVsCapsuleNarrowPhaseInfoBatch& capsuleVsCapsuleBatchContacts = narrowPhaseInput.getCapsuleVsCapsuleBatch();
-    NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatchContacts = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
-    NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatchContacts = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
-    NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatchContacts = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
-
-    // Compute the narrow-phase collision detection for each kind of collision shapes (for contacts)
-    if (sphereVsSphereBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsSphereAlgo->testCollision(sphereVsSphereBatchContacts, 0, sphereVsSphereBatchContacts.getNbObjects(), allocator);
-    }
-    if (sphereVsCapsuleBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsCapsuleAlgo->testCollision(sphereVsCapsuleBatchContacts, 0, sphereVsCapsuleBatchContacts.getNbObjects(), allocator);
-    }
-    if (capsuleVsCapsuleBatchContacts.getNbObjects() > 0) {
-        contactFound |= capsuleVsCapsuleAlgo->testCollision(capsuleVsCapsuleBatchContacts, 0, capsuleVsCapsuleBatchContacts.getNbObjects(), allocator);
-    }
-    if (sphereVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= sphereVsConvexPolyAlgo->testCollision(sphereVsConvexPolyhedronBatchContacts, 0, sphereVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+    // Compute the narrow-phase collision detection for each kind of collision shapes on this thread
+    if (threadPool == nullptr || nbTasks < 2) {
+
+        for (uint b=0; b < nbBatches; b++) {
+            if (nbBatchItems[b] > 0) {
+                contactFound |= testNarrowPhaseCollision(narrowPhaseInput, algorithmTypes[b], 0, nbBatchItems[b],
+                                                         clipWithPreviousAxisIfStillColliding, allocator);
+            }
+        }
+
+        return contactFound;
     }
-    if (capsuleVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= capsuleVsConvexPolyAlgo->testCollision(capsuleVsConvexPolyhedronBatchContacts, 0, capsuleVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+
+    RP3D_PROFILE("CollisionDetectionSystem::testNarrowPhaseCollision()", mProfiler);
+
+    NarrowPhaseTask* tasks = static_cast<NarrowPhaseTask*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                                   sizeof(NarrowPhaseTask) * nbTasks));
+    bool* isContactFound = static_cast<bool*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame, sizeof(bool) * nbTasks));
+
+    // Split the batches into ranges of tests
+    uint taskIndex = 0;
+    for (uint b=0; b < nbBatches; b++) {
+        for (uint start=0; start < nbBatchItems[b]; start += NB_MAX_NARROW_PHASE_TESTS_PER_TASK) {
+            tasks[taskIndex].algorithmType = algorithmTypes[b];
+            tasks[taskIndex].batchStartIndex = start;
+            tasks[taskIndex].batchNbItems = std::min(NB_MAX_NARROW_PHASE_TESTS_PER_TASK, nbBatchItems[b] - start);
+            taskIndex++;
+        }
     }
-    if (convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects() > 0) {
-        contactFound |= convexPolyVsConvexPolyAlgo->testCollision(convexPolyhedronVsConvexPolyhedronBatchContacts, 0, convexPolyhedronVsConvexPolyhedronBatchContacts.getNbObjects(), clipWithPreviousAxisIfStillColliding, allocator);
+    assert(taskIndex == nbTasks);
+
+    threadPool->parallelFor(nbTasks, [this, &narrowPhaseInput, tasks, isContactFound, clipWithPreviousAxisIfStillColliding, &allocator](uint i) {
+        isContactFound[i] = testNarrowPhaseCollision(narrowPhaseInput, tasks[i].algorithmType, tasks[i].batchStartIndex,
+                                                     tasks[i].batchNbItems, clipWithPreviousAxisIfStillColliding, allocator);
+    });
+
+    for (uint i=0; i < nbTasks; i++) {
+        contactFound |= isContactFound[i];
     }
 
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, isContactFound, sizeof(bool) * nbTasks);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, tasks, sizeof(NarrowPhaseTask) * nbTasks);
+
     return contactFound;
 }
 
+// Execute the narrow-phase collision detection algorithm on a range of tests of a batch
+bool CollisionDetectionSystem::testNarrowPhaseCollision(NarrowPhaseInput& narrowPhaseInput, NarrowPhaseAlgorithmType algorithmType,
+                                                        uint batchStartIndex, uint batchNbItems, bool clipWithPreviousAxisIfStillColliding,
+                                                        MemoryAllocator& allocator) {
+
+    switch (algorithmType) {
+
+        case NarrowPhaseAlgorithmType::SphereVsSphere:
+            return mCollisionDispatch.getSphereVsSphereAlgorithm()->testCollision(narrowPhaseInput.getSphereVsSphereBatch(), batchStartIndex,
+                                                                                  batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::SphereVsCapsule:
+            return mCollisionDispatch.getSphereVsCapsuleAlgorithm()->testCollision(narrowPhaseInput.getSphereVsCapsuleBatch(), batchStartIndex,
+                                                                                   batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::CapsuleVsCapsule:
+            return mCollisionDispatch.getCapsuleVsCapsuleAlgorithm()->testCollision(narrowPhaseInput.getCapsuleVsCapsuleBatch(), batchStartIndex,
+                                                                                    batchNbItems, allocator);
+        case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
+            return mCollisionDispatch.getSphereVsConvexPolyhedronAlgorithm()->testCollision(narrowPhaseInput.getSphereVsConvexPolyhedronBatch(),
+                                                                                            batchStartIndex, batchNbItems,
+                                                                                            clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
+            return mCollisionDispatch.getCapsuleVsConvexPolyhedronAlgorithm()->testCollision(narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch(),
+                                                                                             batchStartIndex, batchNbItems,
+                                                                                             clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
+            return mCollisionDispatch.getConvexPolyhedronVsConvexPolyhedronAlgorithm()->testCollision(
+                        narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch(), batchStartIndex, batchNbItems,
+                        clipWithPreviousAxisIfStillColliding, allocator);
+        case NarrowPhaseAlgorithmType::BoxVsBox:
+            return mCollisionDispatch.getBoxVsBoxAlgorithm()->testCollision(narrowPhaseInput.getBoxVsBoxBatch(), batchStartIndex, batchNbItems,
+                                                                            clipWithPreviousAxisIfStillColliding);
+        case NarrowPhaseAlgorithmType::None:
+            break;
+    }
+
+    assert(false);
+    return false;
+}
+
 // Process the potential contacts after narrow-phase collision detection
+/// Speculative contacts are only created with a positive time step (see processPotentialContacts()).
 void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& narrowPhaseInput, bool updateLastFrameInfo,
                                                      List<ContactPointInfo>& potentialContactPoints,
                                                      Map<uint64, uint>* mapPairIdToContactPairIndex,
                                                      List<ContactManifoldInfo>& potentialContactManifolds,
-                                                     List<ContactPair>* contactPairs,
-                                                     Map<Entity, List<uint>>& mapBodyToContactPairs) {
+                                                     List<ContactPair>* contactPairs, decimal speculativeTimeStep) {
 
     assert(contactPairs->size() == 0);
     assert(mapPairIdToContactPairIndex->size() == 0);
@@ -494,24 +569,27 @@ void CollisionDetectionSystem::processAllPotentialContacts(NarrowPhaseInput& nar
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
 
     // Process the potential contacts
     processPotentialContacts(sphereVsSphereBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                             potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
     processPotentialContacts(sphereVsCapsuleBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                             potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
     processPotentialContacts(capsuleVsCapsuleBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                             potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
     processPotentialContacts(sphereVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                            potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                            potentialContactManifolds, contactPairs, speculativeTimeStep);
     processPotentialContacts(capsuleVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                             potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
     processPotentialContacts(convexPolyhedronVsConvexPolyhedronBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
-                             potentialContactManifolds, contactPairs, mapBodyToContactPairs);
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
+    processPotentialContacts(boxVsBoxBatch, updateLastFrameInfo, potentialContactPoints, mapPairIdToContactPairIndex,
+                             potentialContactManifolds, contactPairs, speculativeTimeStep);
 }
 
 // Compute the narrow-phase collision detection
-void CollisionDetectionSystem::computeNarrowPhase() {
+void CollisionDetectionSystem::computeNarrowPhase(decimal timeStep) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeNarrowPhase()", mProfiler);
 
@@ -521,15 +599,19 @@ void CollisionDetectionSystem::computeNarrowPhase() {
     swapPreviousAndCurrentContacts();
 
     // Test the narrow-phase collision detection on the batches to be tested
-    testNarrowPhaseCollision(mNarrowPhaseInput, true, allocator);
+    testNarrowPhaseCollision(mNarrowPhaseInput, true, allocator, mThreadPool);
 
     // Process all the potential contacts after narrow-phase collision
     processAllPotentialContacts(mNarrowPhaseInput, true, mPotentialContactPoints, mCurrentMapPairIdToContactPairIndex,
-                                mPotentialContactManifolds, mCurrentContactPairs, mMapBodyToContactPairs);
+                                mPotentialContactManifolds, mCurrentContactPairs, timeStep);
 
     // Reduce the number of contact points in the manifolds
     reducePotentialContactManifolds(mCurrentContactPairs, mPotentialContactManifolds, mPotentialContactPoints);
 
+    // Compute the lost contacts (contact pairs that were colliding in previous frame but not in this one).
+    // This is done here because the lost contacts are needed to create the islands.
+    computeLostContactPairs();
+
     assert(mCurrentContactManifolds->size() == 0);
     assert(mCurrentContactPoints->size() == 0);
 }
@@ -571,6 +653,7 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     NarrowPhaseInfoBatch& sphereVsConvexPolyhedronBatch = narrowPhaseInput.getSphereVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& capsuleVsConvexPolyhedronBatch = narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch();
     NarrowPhaseInfoBatch& convexPolyhedronVsConvexPolyhedronBatch = narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch();
+    NarrowPhaseInfoBatch& boxVsBoxBatch = narrowPhaseInput.getBoxVsBoxBatch();
 
     // Process the potential contacts
     computeOverlapSnapshotContactPairs(sphereVsSphereBatch, contactPairs, setOverlapContactPairId);
@@ -579,6 +662,7 @@ void CollisionDetectionSystem::computeOverlapSnapshotContactPairs(NarrowPhaseInp
     computeOverlapSnapshotContactPairs(sphereVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(capsuleVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
     computeOverlapSnapshotContactPairs(convexPolyhedronVsConvexPolyhedronBatch, contactPairs, setOverlapContactPairId);
+    computeOverlapSnapshotContactPairs(boxVsBoxBatch, contactPairs, setOverlapContactPairId);
 }
 
 // Notify that the overlapping pairs where a given collider is involved need to be tested for overlap
@@ -654,11 +738,10 @@ bool CollisionDetectionSystem::computeNarrowPhaseCollisionSnapshot(NarrowPhaseIn
         List<ContactPair> lostContactPairs(allocator);                  // Not used during collision snapshots
         List<ContactManifold> contactManifolds(allocator);
         List<ContactPoint> contactPoints(allocator);
-        Map<Entity, List<uint>> mapBodyToContactPairs(allocator);
 
-        // Process all the potential contacts after narrow-phase collision
+        // Process all the potential contacts after narrow-phase collision (no speculative contacts, the bodies do not move)
         processAllPotentialContacts(narrowPhaseInput, true, potentialContactPoints, &mapPairIdToContactPairIndex, potentialContactManifolds,
-                                    &contactPairs, mapBodyToContactPairs);
+                                    &contactPairs, decimal(0.0));
 
         // Reduce the number of contact points in the manifolds
         reducePotentialContactManifolds(&contactPairs, potentialContactManifolds, potentialContactPoints);
@@ -711,19 +794,8 @@ void CollisionDetectionSystem::createContacts() {
     mCurrentContactManifolds->reserve(mCurrentContactPairs->size());
     mCurrentContactPoints->reserve(mCurrentContactManifolds->size());
 
-    // We go through all the contact pairs and add the pairs with a least a CollisionBody at the end of the
-    // mProcessContactPairsOrderIslands array because those pairs have not been added during the islands
-    // creation (only the pairs with two RigidBodies are added during island creation)
-    Set<uint32> processedContactPairsIndices(mMemoryManager.getSingleFrameAllocator(), mCurrentContactPairs->size());
-    for (uint32 i=0; i < mWorld->mProcessContactPairsOrderIslands.size(); i++) {
-        processedContactPairsIndices.add(mWorld->mProcessContactPairsOrderIslands[i]);
-    }
-    for (uint32 i=0; i < mCurrentContactPairs->size(); i++) {
-        if (!processedContactPairsIndices.contains(i)) {
-            mWorld->mProcessContactPairsOrderIslands.add(i);
-        }
-    }
-
+    // The islands creation has ordered all the contact pairs (the pairs with a least a CollisionBody
+    // or a trigger are at the end of the mProcessContactPairsOrderIslands array)
     assert(mWorld->mProcessContactPairsOrderIslands.size() == (*mCurrentContactPairs).size());
 
     // Process the contact pairs in the order defined by the islands such that the contact manifolds and
@@ -774,9 +846,6 @@ void CollisionDetectionSystem::createContacts() {
     // Initialize the current contacts with the contacts from the previous frame (for warmstarting)
     initContactsWithPreviousOnes();
 
-    // Compute the lost contacts (contact pairs that were colliding in previous frame but not in this one)
-    computeLostContactPairs();
-
     mPreviousContactPoints->clear();
     mPreviousContactManifolds->clear();
     mPreviousContactPairs->clear();
@@ -992,13 +1061,297 @@ void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback,
     mBroadPhaseSystem.raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
 }
 
+// Ray casting method for a batch of rays. The closest hit of each ray is written in the output
+// array. This method does not use the profiler and its temporary memory comes from the base
+// allocator so that it can be called from several threads at the same time.
+void CollisionDetectionSystem::raycastBatch(const Ray* rays, uint nbRays, RaycastBatchHit* outHits,
+                                            unsigned short raycastWithCategoryMaskBits) const {
+
+    mBroadPhaseSystem.raycastBatch(rays, nbRays, outHits, raycastWithCategoryMaskBits, mMemoryManager.getBaseAllocator());
+}
+
+// Sweep a convex collision shape along a translation and report the first collider hit. The
+// broad-phase reports the colliders overlapping with the AABB swept by the shape. The time of impact
+// with each of them (or with each of their triangles overlapping the swept AABB for concave shapes) is
+// computed with the conservative advancement on the GJK distance. The other colliders do not move
+// during the sweep. Returns true if a collider has been hit.
+bool CollisionDetectionSystem::shapeCast(const CollisionShape* shape, const Transform& transform, const Vector3& translation,
+                                         ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits,
+                                         const CollisionBody* ignoredBody) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::shapeCast()", mProfiler);
+
+    assert(shape->isConvex());
+
+    return castConvexShape(static_cast<const ConvexShape*>(shape), transform, translation, shapeCastInfo,
+                           castWithCategoryMaskBits, ignoredBody, nullptr);
+}
+
+// Compute the time of impact of a collider moved by the current step (for continuous collision detection)
+/// This method must be called after the integration of the positions of the bodies. The colliders
+/// are swept as described in computeColliderStepSweep(). Colliders that the collider cannot collide
+/// with (collision filtering, triggers, bodies of a joint) are ignored, as well as colliders that it
+/// already touches without moving toward them or that it is already in contact with, because the discrete collision
+/// detection takes care of them. The hit normal (pointing from the collider that is hit toward the moved one) and the
+/// translation during the step of the body that is hit are also returned.
+bool CollisionDetectionSystem::computeTimeOfImpact(Entity colliderEntity, decimal& outHitFraction, Vector3& outHitNormal,
+                                                   Vector3& outHitBodyTranslation) const {
+
+    const uint32 colliderIndex = mCollidersComponents.getEntityIndex(colliderEntity);
+    const Collider* collider = mCollidersComponents.mColliders[colliderIndex];
+    const CollisionShape* shape = mCollidersComponents.mCollisionShapes[colliderIndex];
+
+    if (!shape->isConvex() || mCollidersComponents.mIsTrigger[colliderIndex]) return false;
+
+    Transform transform;
+    Vector3 translation;
+    computeColliderStepSweep(colliderEntity, transform, translation);
+
+    ShapeCastInfo shapeCastInfo;
+    if (!castConvexShape(static_cast<const ConvexShape*>(shape), transform, translation, shapeCastInfo,
+                         mCollidersComponents.mCollideWithMaskBits[colliderIndex], collider->getBody(), collider)) {
+        return false;
+    }
+
+    Transform hitColliderTransform;
+    computeColliderStepSweep(shapeCastInfo.collider->getEntity(), hitColliderTransform, outHitBodyTranslation);
+
+    if (isContinuousEndHitIgnored(static_cast<const ConvexShape*>(shape), transform, translation, shapeCastInfo.collider->getCollisionShape(),
+                                  hitColliderTransform, outHitBodyTranslation, shapeCastInfo.hitFraction, shapeCastInfo.worldNormal)) {
+        return false;
+    }
+
+    outHitFraction = shapeCastInfo.hitFraction;
+    outHitNormal = shapeCastInfo.worldNormal;
+
+    return true;
+}
+
+// Return true if a hit during the step has to be ignored by the continuous collision detection
+/// This is the case if the discrete collision detection of the next step resolves the contact as it would without
+/// continuous collision detection: the two colliders still overlap at the end of the step and the cast collider has
+/// not moved deeper (along the hit normal) than half of the thickness of the other one since they have touched. The
+/// contact solver then pushes it back out of the side it came from and the body keeps all its motion. Thin colliders
+/// (triangles of concave shapes for instance) or colliders that are passed through are hit.
+bool CollisionDetectionSystem::isContinuousEndHitIgnored(const ConvexShape* shape, const Transform& transform, const Vector3& translation,
+                                                         const CollisionShape* hitShape, const Transform& hitShapeTransform,
+                                                         const Vector3& hitBodyTranslation, decimal hitFraction, const Vector3& hitNormal) const {
+
+    if (!hitShape->isConvex()) return false;
+    const ConvexShape* hitConvexShape = static_cast<const ConvexShape*>(hitShape);
+
+    // Depth reached along the normal by the cast collider after the time of impact
+    const Vector3 relativeTranslation = translation - hitBodyTranslation;
+    const decimal depth = -(decimal(1.0) - hitFraction) * relativeTranslation.dot(hitNormal);
+
+    const Vector3 localNormal = hitShapeTransform.getOrientation().getInverse() * hitNormal;
+    const decimal thickness = (hitConvexShape->getLocalSupportPointWithMargin(localNormal) -
+                               hitConvexShape->getLocalSupportPointWithMargin(-localNormal)).dot(localNormal);
+    if (depth > decimal(0.5) * thickness) return false;
+
+    // Check that the colliders still overlap at the end of the step
+    const Transform endTransform(transform.getPosition() + translation, transform.getOrientation());
+    const Transform hitEndTransform(hitShapeTransform.getPosition() + hitBodyTranslation, hitShapeTransform.getOrientation());
+    GJKAlgorithm gjkAlgorithm;
+    decimal distance;
+    Vector3 point1, point2, normal;
+
+    return !gjkAlgorithm.computeDistance(shape, endTransform, hitConvexShape, hitEndTransform, distance, point1, point2, normal) ||
+           distance < decimal(0.0);
+}
+
+// Compute the world transform from which a collider is swept during the current step and the translation of its body.
+/// Only the linear motion of the bodies is swept. A collider is swept from the position of its body at the beginning of
+/// the step but already with the orientation of the body at the end of the step. This way, when a body is stopped at
+/// the time of impact, the configuration of the two bodies is the one that the next step starts with.
+void CollisionDetectionSystem::computeColliderStepSweep(Entity colliderEntity, Transform& outTransform, Vector3& outTranslation) const {
+
+    const Entity bodyEntity = mCollidersComponents.getBody(colliderEntity);
+    RigidBodyComponents& rigidBodyComponents = mWorld->mRigidBodyComponents;
+
+    // Only the enabled rigid bodies (not sleeping) are moved by the step
+    if (!rigidBodyComponents.hasComponent(bodyEntity) || rigidBodyComponents.getIsEntityDisabled(bodyEntity)) {
+        outTransform = mCollidersComponents.getLocalToWorldTransform(colliderEntity);
+        outTranslation.setToZero();
+        return;
+    }
+
+    const Vector3& centerOfMassWorld = rigidBodyComponents.getCenterOfMassWorld(bodyEntity);
+    const Quaternion orientation = rigidBodyComponents.getConstrainedOrientation(bodyEntity).getUnit();
+    const Transform bodyTransform(centerOfMassWorld - orientation * rigidBodyComponents.getCenterOfMassLocal(bodyEntity), orientation);
+
+    outTransform = bodyTransform * mCollidersComponents.getLocalToBodyTransform(colliderEntity);
+    outTranslation = rigidBodyComponents.getConstrainedPosition(bodyEntity) - centerOfMassWorld;
+}
+
+// Return true if a body is an enabled dynamic body with continuous collision detection
+bool CollisionDetectionSystem::isContinuousBody(Entity bodyEntity) const {
+
+    RigidBodyComponents& rigidBodyComponents = mWorld->mRigidBodyComponents;
+
+    return rigidBodyComponents.hasComponent(bodyEntity) && !rigidBodyComponents.getIsEntityDisabled(bodyEntity) &&
+           rigidBodyComponents.getBodyType(bodyEntity) == BodyType::DYNAMIC && rigidBodyComponents.getIsCCDEnabled(bodyEntity);
+}
+
+// Return true if the hit of a collider at the start of its translation has to be ignored by the continuous collision detection
+/// This is the case if the shape does not move toward the other one by more than the time of impact tolerance or if the
+/// discrete collision detection has found a contact between the two colliders at the beginning of the step (the contact
+/// solver takes care of it). Shapes that touch without contact (closer than the precision of the GJK algorithm but not
+/// overlapping) are not ignored, otherwise the shape would go through the other one.
+bool CollisionDetectionSystem::isContinuousStartHitIgnored(const Collider* castCollider, const Collider* collider,
+                                                           const Vector3& translation, const Vector3& hitNormal) const {
+
+    if (-translation.dot(hitNormal) <= CONSERVATIVE_ADVANCEMENT_TOLERANCE) return true;
+
+    const int32 broadPhaseId1 = castCollider->getBroadPhaseId();
+    const int32 broadPhaseId2 = collider->getBroadPhaseId();
+    const uint64 pairId = pairNumbers(std::max(broadPhaseId1, broadPhaseId2), std::min(broadPhaseId1, broadPhaseId2));
+    auto it = mOverlappingPairs.mMapPairIdToPairIndex.find(pairId);
+
+    return it != mOverlappingPairs.mMapPairIdToPairIndex.end() && mOverlappingPairs.mCollidingInCurrentFrame[it->second];
+}
+
+// Sweep a convex shape along a translation and report the first collider hit
+/// If the cast collider is not null, the shape is the one of a collider moved by the continuous
+/// collision detection. The hits are then filtered as the contacts of this collider would be.
+bool CollisionDetectionSystem::castConvexShape(const ConvexShape* shape, const Transform& transform, const Vector3& translation,
+                                               ShapeCastInfo& shapeCastInfo, unsigned short castWithCategoryMaskBits,
+                                               const CollisionBody* ignoredBody, const Collider* castCollider) const {
+
+    MemoryAllocator& allocator = mMemoryManager.getPoolAllocator();
+
+    // Compute the AABB swept by the shape (enlarged by the hit tolerance distance)
+    const Transform endTransform(transform.getPosition() + translation, transform.getOrientation());
+    AABB sweptAABB;
+    AABB endAABB;
+    shape->computeAABB(sweptAABB, transform);
+    shape->computeAABB(endAABB, endTransform);
+    sweptAABB.mergeWithAABB(endAABB);
+    sweptAABB.inflate(CONSERVATIVE_ADVANCEMENT_TOLERANCE, CONSERVATIVE_ADVANCEMENT_TOLERANCE, CONSERVATIVE_ADVANCEMENT_TOLERANCE);
+
+    // Ask the broad-phase for the colliders that can be hit
+    List<int> overlappingBroadPhaseIds(allocator);
+    mBroadPhaseSystem.reportAllShapesOverlappingWithAABB(sweptAABB, overlappingBroadPhaseIds);
+
+    GJKAlgorithm gjkAlgorithm;
+    bool isHit = false;
+    shapeCastInfo.hitFraction = decimal(1.0);
+
+    List<Vector3> triangleVertices(allocator);
+    List<Vector3> triangleVerticesNormals(allocator);
+    List<uint> triangleShapeIds(allocator);
+
+    // For each collider that can be hit
+    for (uint i=0; i < overlappingBroadPhaseIds.size(); i++) {
+
+        Collider* collider = mBroadPhaseSystem.getColliderForBroadPhaseId(overlappingBroadPhaseIds[i]);
+        CollisionBody* body = collider->getBody();
+
+        // Check if the filtering mask allows the cast against this collider
+        if ((castWithCategoryMaskBits & collider->getCollisionCategoryBits()) == 0) continue;
+        if (body == ignoredBody || !body->isActive()) continue;
+
+        const CollisionShape* colliderShape = collider->getCollisionShape();
+        Transform colliderTransform = collider->getLocalToWorldTransform();
+        Vector3 relativeTranslation = translation;
+
+        // Check if the cast collider would collide with this collider
+        if (castCollider != nullptr) {
+            if ((collider->getCollideWithMaskBits() & castCollider->getCollisionCategoryBits()) == 0) continue;
+            if (collider->getIsTrigger()) continue;
+            if (mNoCollisionPairs.contains(OverlappingPairs::computeBodiesIndexPair(body->getEntity(), ignoredBody->getEntity()))) continue;
+
+            // Two moving bodies with continuous collision detection are not swept against each other, the other
+            // body can itself be stopped at its time of impact during the step (the discrete collision detection
+            // handles their contacts)
+            if (isContinuousBody(body->getEntity())) continue;
+
+            // If the other body also moves during the step, the shape is swept along the relative translation
+            // (otherwise, two bodies moving together would stop each other)
+            Vector3 colliderTranslation;
+            computeColliderStepSweep(collider->getEntity(), colliderTransform, colliderTranslation);
+            relativeTranslation -= colliderTranslation;
+        }
+
+        decimal hitFraction;
+        Vector3 hitPoint;
+        Vector3 hitNormal;
+
+        if (colliderShape->isConvex()) {
+
+            const ConvexShape* convexColliderShape = static_cast<const ConvexShape*>(colliderShape);
+
+            // Compute the time of impact with the convex collider
+            if (gjkAlgorithm.computeTimeOfImpact(shape, transform, relativeTranslation, convexColliderShape,
+                                                 colliderTransform, shapeCastInfo.hitFraction, hitFraction, hitPoint, hitNormal) &&
+                (!isHit || hitFraction < shapeCastInfo.hitFraction) &&
+                (castCollider == nullptr || hitFraction > decimal(0.0) ||
+                 !isContinuousStartHitIgnored(castCollider, collider, relativeTranslation, hitNormal))) {
+
+                shapeCastInfo.hitFraction = hitFraction;
+                shapeCastInfo.worldPoint = hitPoint;
+                shapeCastInfo.worldNormal = hitNormal;
+                shapeCastInfo.body = body;
+                shapeCastInfo.collider = collider;
+                isHit = true;
+            }
+        }
+        else {
+
+            // Compute the AABB swept by the shape in the local-space of the concave collider
+            const Transform worldToCollider = colliderTransform.getInverse();
+            const Transform relativeEndTransform(transform.getPosition() + relativeTranslation, transform.getOrientation());
+            AABB localSweptAABB;
+            AABB localEndAABB;
+            shape->computeAABB(localSweptAABB, worldToCollider * transform);
+            shape->computeAABB(localEndAABB, worldToCollider * relativeEndTransform);
+            localSweptAABB.mergeWithAABB(localEndAABB);
+            localSweptAABB.inflate(CONSERVATIVE_ADVANCEMENT_TOLERANCE, CONSERVATIVE_ADVANCEMENT_TOLERANCE, CONSERVATIVE_ADVANCEMENT_TOLERANCE);
+
+            // Compute the triangles of the concave shape that can be hit
+            triangleVertices.clear();
+            triangleVerticesNormals.clear();
+            triangleShapeIds.clear();
+            const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(colliderShape);
+            concaveShape->computeOverlappingTriangles(localSweptAABB, triangleVertices, triangleVerticesNormals,
+                                                      triangleShapeIds, allocator);
+
+            // Compute the time of impact with each triangle
+            for (uint t=0; t < triangleShapeIds.size(); t++) {
+
+                TriangleShape triangleShape(&(triangleVertices[t * 3]), &(triangleVerticesNormals[t * 3]),
+                                            triangleShapeIds[t], allocator);
+
+                if (gjkAlgorithm.computeTimeOfImpact(shape, transform, relativeTranslation, &triangleShape, colliderTransform,
+                                                     shapeCastInfo.hitFraction, hitFraction, hitPoint, hitNormal) &&
+                    (!isHit || hitFraction < shapeCastInfo.hitFraction) &&
+                    (castCollider == nullptr || hitFraction > decimal(0.0) ||
+                     !isContinuousStartHitIgnored(castCollider, collider, relativeTranslation, hitNormal))) {
+
+                    shapeCastInfo.hitFraction = hitFraction;
+                    shapeCastInfo.worldPoint = hitPoint;
+                    shapeCastInfo.worldNormal = hitNormal;
+                    shapeCastInfo.body = body;
+                    shapeCastInfo.collider = collider;
+                    isHit = true;
+                }
+            }
+        }
+    }
+
+    return isHit;
+}
+
 // Convert the potential contact into actual contacts
+/// With a positive time step, a speculative contact is created for the pairs of colliders that do not collide
+/// but where a body with continuous collision detection reaches the other collider during the step (see
+/// computeSpeculativeContact()). The pair is then in contact, but the last frame collision info keeps the
+/// result of the narrow-phase test.
 void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, bool updateLastFrameInfo,
                                                         List<ContactPointInfo>& potentialContactPoints,
                                                         Map<uint64, uint>* mapPairIdToContactPairIndex,
                                                         List<ContactManifoldInfo>& potentialContactManifolds,
-                                                        List<ContactPair>* contactPairs,
-                                                        Map<Entity, List<uint>>& mapBodyToContactPairs) {
+                                                        List<ContactPair>* contactPairs, decimal speculativeTimeStep) {
 
     RP3D_PROFILE("CollisionDetectionSystem::processPotentialContacts()", mProfiler);
 
@@ -1015,8 +1368,9 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
         const uint64 pairId = narrowPhaseInfoBatch.overlappingPairIds[i];
         const uint64 pairIndex = mOverlappingPairs.mMapPairIdToPairIndex[pairId];
 
-        // If the two colliders are colliding
-        if (narrowPhaseInfoBatch.isColliding[i]) {
+        // If the two colliders are colliding (or will collide during the step)
+        if (narrowPhaseInfoBatch.isColliding[i] ||
+            (speculativeTimeStep > decimal(0.0) && computeSpeculativeContact(narrowPhaseInfoBatch, i, speculativeTimeStep))) {
 
             mOverlappingPairs.mCollidingInCurrentFrame[pairIndex] = true;
 
@@ -1047,25 +1401,6 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
                 contactPairs->add(overlappingPairContact);
                 pairContact = &((*contactPairs)[newContactPairIndex]);
                 mapPairIdToContactPairIndex->add(Pair<uint64, uint>(pairId, newContactPairIndex));
-
-                auto itbodyContactPairs = mapBodyToContactPairs.find(body1Entity);
-                if (itbodyContactPairs != mapBodyToContactPairs.end()) {
-                    itbodyContactPairs->second.add(newContactPairIndex);
-                }
-                else {
-                    List<uint> contactPairs(mMemoryManager.getPoolAllocator(), 1);
-                    contactPairs.add(newContactPairIndex);
-                    mapBodyToContactPairs.add(Pair<Entity, List<uint>>(body1Entity, contactPairs));
-                }
-                itbodyContactPairs = mapBodyToContactPairs.find(body2Entity);
-                if (itbodyContactPairs != mapBodyToContactPairs.end()) {
-                    itbodyContactPairs->second.add(newContactPairIndex);
-                }
-                else {
-                    List<uint> contactPairs(mMemoryManager.getPoolAllocator(), 1);
-                    contactPairs.add(newContactPairIndex);
-                    mapBodyToContactPairs.add(Pair<Entity, List<uint>>(body2Entity, contactPairs));
-                }
             }
             else { // If a ContactPair already exists for this overlapping pair, we use this one
 
@@ -1140,6 +1475,88 @@ void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& na
     }
 }
 
+// Add a speculative contact point to a pair of colliders that do not collide if a body with continuous
+// collision detection reaches the other collider during the step
+/// The shape of the body with continuous collision detection is swept toward the other shape along the relative
+/// linear motion of the bodies with their current velocities. If it moves more than half of its smallest extent
+/// and hits the other shape, a contact point is added at the time of impact with the distance that separates the
+/// shapes as a negative penetration depth. The contact solver lets the bodies close this distance during the step
+/// but no more, so that the contact is solved and reported in the step where they meet and not after the body has
+/// passed through the other one. As for the time of impact, the hits that the discrete collision detection of the
+/// next step resolves are ignored (see isContinuousEndHitIgnored()). Two bodies with continuous collision detection
+/// are not swept against each other. Return true if a contact point has been added.
+bool CollisionDetectionSystem::computeSpeculativeContact(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint index, decimal timeStep) const {
+
+    if (!narrowPhaseInfoBatch.reportContacts[index]) return false;
+
+    const Entity body1Entity = mCollidersComponents.getBody(narrowPhaseInfoBatch.colliderEntities1[index]);
+    const Entity body2Entity = mCollidersComponents.getBody(narrowPhaseInfoBatch.colliderEntities2[index]);
+    const bool isContinuousBody1 = isContinuousBody(body1Entity);
+    if (isContinuousBody1 == isContinuousBody(body2Entity)) return false;
+
+    assert(narrowPhaseInfoBatch.collisionShapes1[index]->isConvex() && narrowPhaseInfoBatch.collisionShapes2[index]->isConvex());
+
+    // Shape that is swept (of the body with continuous collision detection) and shape that is hit
+    const ConvexShape* shape = static_cast<const ConvexShape*>(isContinuousBody1 ? narrowPhaseInfoBatch.collisionShapes1[index] :
+                                                                                   narrowPhaseInfoBatch.collisionShapes2[index]);
+    const ConvexShape* hitShape = static_cast<const ConvexShape*>(isContinuousBody1 ? narrowPhaseInfoBatch.collisionShapes2[index] :
+                                                                                      narrowPhaseInfoBatch.collisionShapes1[index]);
+    const Transform& transform = isContinuousBody1 ? narrowPhaseInfoBatch.shape1ToWorldTransforms[index] :
+                                                     narrowPhaseInfoBatch.shape2ToWorldTransforms[index];
+    const Transform& hitShapeTransform = isContinuousBody1 ? narrowPhaseInfoBatch.shape2ToWorldTransforms[index] :
+                                                             narrowPhaseInfoBatch.shape1ToWorldTransforms[index];
+    const Entity bodyEntity = isContinuousBody1 ? body1Entity : body2Entity;
+    const Entity hitBodyEntity = isContinuousBody1 ? body2Entity : body1Entity;
+
+    // Linear motion of the bodies during the step
+    RigidBodyComponents& rigidBodyComponents = mWorld->mRigidBodyComponents;
+    const Vector3 translation = rigidBodyComponents.getLinearVelocity(bodyEntity) * timeStep;
+    Vector3 hitBodyTranslation(0, 0, 0);
+    if (rigidBodyComponents.hasComponent(hitBodyEntity) && !rigidBodyComponents.getIsEntityDisabled(hitBodyEntity)) {
+        hitBodyTranslation = rigidBodyComponents.getLinearVelocity(hitBodyEntity) * timeStep;
+    }
+    const Vector3 relativeTranslation = translation - hitBodyTranslation;
+
+    // If the shape does not move more than half of its size, the discrete collision detection cannot miss the contact
+    Vector3 minBounds, maxBounds;
+    shape->getLocalBounds(minBounds, maxBounds);
+    const decimal motionThreshold = decimal(0.5) * (maxBounds - minBounds).getMinValue();
+    if (relativeTranslation.lengthSquare() <= motionThreshold * motionThreshold) return false;
+
+    GJKAlgorithm gjkAlgorithm;
+    decimal hitFraction;
+    Vector3 hitPoint;
+    Vector3 hitNormal;
+    if (!gjkAlgorithm.computeTimeOfImpact(shape, transform, relativeTranslation, hitShape, hitShapeTransform, decimal(1.0),
+                                          hitFraction, hitPoint, hitNormal)) {
+        return false;
+    }
+
+    if (-relativeTranslation.dot(hitNormal) <= CONSERVATIVE_ADVANCEMENT_TOLERANCE ||
+        isContinuousEndHitIgnored(shape, transform, translation, hitShape, hitShapeTransform, hitBodyTranslation, hitFraction, hitNormal)) {
+        return false;
+    }
+
+    // Distance along the normal that the bodies can close during the step. The shapes are at most the time of
+    // impact tolerance apart at the time of impact, they then touch at the end of the step (and the discrete
+    // collision detection of the next step finds their contact) without overlapping more than the tolerance.
+    const decimal separation = -hitFraction * relativeTranslation.dot(hitNormal) + CONSERVATIVE_ADVANCEMENT_TOLERANCE;
+
+    // The hit point is on the hit shape, the swept shape touches it at the time of impact
+    const Vector3 localPoint = transform.getInverse() * (hitPoint - hitFraction * relativeTranslation);
+    const Vector3 hitLocalPoint = hitShapeTransform.getInverse() * hitPoint;
+
+    // The hit normal points from the hit shape toward the swept one and the contact normal from shape 1 toward shape 2
+    if (isContinuousBody1) {
+        narrowPhaseInfoBatch.addContactPoint(index, -hitNormal, -separation, localPoint, hitLocalPoint);
+    }
+    else {
+        narrowPhaseInfoBatch.addContactPoint(index, hitNormal, -separation, hitLocalPoint, localPoint);
+    }
+
+    return true;
+}
+
 // Clear the obsolete manifolds and contact points and reduce the number of contacts points of the remaining manifolds
 void CollisionDetectionSystem::reducePotentialContactManifolds(List<ContactPair>* contactPairs,
                                                          List<ContactManifoldInfo>& potentialContactManifolds,
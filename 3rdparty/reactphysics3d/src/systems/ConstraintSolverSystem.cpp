@@ -27,13 +27,24 @@
 #include <reactphysics3d/systems/ConstraintSolverSystem.h>
 #include <reactphysics3d/components/JointComponents.h>
 #include <reactphysics3d/components/BallAndSocketJointComponents.h>
+#include <reactphysics3d/components/FixedJointComponents.h>
+#include <reactphysics3d/components/HingeJointComponents.h>
+#include <reactphysics3d/components/SliderJointComponents.h>
+#include <reactphysics3d/constraint/Joint.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 #include <reactphysics3d/engine/Island.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <algorithm>
 
 using namespace reactphysics3d;
 
+// Static variables definition
+const uint32 ConstraintSolverSystem::NB_MAX_COLORS = 32;
+const uint32 ConstraintSolverSystem::NB_JOINTS_PER_COLOR_TASK = 16;
+
 // Constructor
-ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
+ConstraintSolverSystem::ConstraintSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, Islands& islands, RigidBodyComponents& rigidBodyComponents,
                                                TransformComponents& transformComponents,
                                                JointComponents& jointComponents,
                                                BallAndSocketJointComponents& ballAndSocketJointComponents,
@@ -45,7 +56,11 @@ ConstraintSolverSystem::ConstraintSolverSystem(PhysicsWorld& world, Islands& isl
                    mSolveBallAndSocketJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, ballAndSocketJointComponents),
                    mSolveFixedJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, fixedJointComponents),
                    mSolveHingeJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, hingeJointComponents),
-                   mSolveSliderJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, sliderJointComponents) {
+                   mSolveSliderJointSystem(world, rigidBodyComponents, transformComponents, jointComponents, sliderJointComponents),
+                   mBallAndSocketJointComponents(ballAndSocketJointComponents), mFixedJointComponents(fixedJointComponents),
+                   mHingeJointComponents(hingeJointComponents), mSliderJointComponents(sliderJointComponents),
+                   mColoringThreshold(0), mColoredJoints(memoryManager.getPoolAllocator()),
+                   mColors(memoryManager.getPoolAllocator()), mBodiesColors(memoryManager.getPoolAllocator()) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -88,6 +103,128 @@ void ConstraintSolverSystem::initialize(decimal dt) {
         mSolveHingeJointSystem.warmstart();
         mSolveSliderJointSystem.warmstart();
     }
+
+    mColoredJoints.clear();
+    mColors.clear();
+
+    // If there are enough joints, color them so that they can be solved in parallel
+    if (mColoringThreshold > 0 && mConstraintSolverData.jointComponents.getNbEnabledComponents() >= mColoringThreshold) {
+        colorJoints();
+    }
+}
+
+// Color the enabled joints such that the joints of a color do not share any body.
+/// We use a greedy first-fit coloring where each joint gets the first color that is not already
+/// used by one of its two bodies. Static bodies are also taken into account because the joint
+/// solvers write the velocities of both bodies. The joints that do not fit in any of the
+/// NB_MAX_COLORS colors are put in an overflow color that is solved serially. The joints
+/// are then sorted by color (keeping their relative order inside a color).
+void ConstraintSolverSystem::colorJoints() {
+
+    RP3D_PROFILE("ConstraintSolverSystem::colorJoints()", mProfiler);
+
+    JointComponents& jointComponents = mConstraintSolverData.jointComponents;
+    RigidBodyComponents& rigidBodyComponents = mConstraintSolverData.rigidBodyComponents;
+
+    const uint32 nbJoints = jointComponents.getNbEnabledComponents();
+    const uint32 nbBodies = rigidBodyComponents.getNbComponents();
+
+    mBodiesColors.clear();
+    mBodiesColors.reserve(nbBodies);
+    for (uint32 i=0; i < nbBodies; i++) {
+        mBodiesColors.add(0);
+    }
+
+    // Compute the color of each joint (the overflow color is NB_MAX_COLORS)
+    uint32 nbJointsPerColor[NB_MAX_COLORS + 1] = {};
+    mColoredJoints.reserve(nbJoints);
+    for (uint32 j=0; j < nbJoints; j++) {
+
+        const uint32 body1Index = rigidBodyComponents.getEntityIndex(jointComponents.mBody1Entities[j]);
+        const uint32 body2Index = rigidBodyComponents.getEntityIndex(jointComponents.mBody2Entities[j]);
+
+        const uint32 usedColors = mBodiesColors[body1Index] | mBodiesColors[body2Index];
+        uint32 color = 0;
+        while (color < NB_MAX_COLORS && (usedColors & (uint32(1) << color)) != 0) {
+            color++;
+        }
+
+        if (color < NB_MAX_COLORS) {
+            mBodiesColors[body1Index] |= uint32(1) << color;
+            mBodiesColors[body2Index] |= uint32(1) << color;
+        }
+
+        nbJointsPerColor[color]++;
+
+        // Temporarily store the color in the component index
+        ColoredJoint coloredJoint;
+        coloredJoint.type = jointComponents.mTypes[j];
+        coloredJoint.componentIndex = color;
+        mColoredJoints.add(coloredJoint);
+    }
+
+    // Compute the first index of each color in the sorted array and create the colors
+    uint32 colorsStartIndex[NB_MAX_COLORS + 1];
+    uint32 startIndex = 0;
+    for (uint32 c=0; c <= NB_MAX_COLORS; c++) {
+
+        colorsStartIndex[c] = startIndex;
+
+        if (nbJointsPerColor[c] > 0) {
+            JointColor jointColor;
+            jointColor.coloredJointsIndex = startIndex;
+            jointColor.nbColoredJoints = nbJointsPerColor[c];
+            jointColor.isOverflow = c == NB_MAX_COLORS;
+            mColors.add(jointColor);
+        }
+
+        startIndex += nbJointsPerColor[c];
+    }
+
+    // Sort the joints by color
+    List<ColoredJoint> unsortedJoints(mColoredJoints);
+    for (uint32 j=0; j < nbJoints; j++) {
+
+        const Entity jointEntity = jointComponents.mJointEntities[j];
+        const uint32 color = unsortedJoints[j].componentIndex;
+
+        ColoredJoint& coloredJoint = mColoredJoints[colorsStartIndex[color]++];
+        coloredJoint.type = unsortedJoints[j].type;
+
+        switch (coloredJoint.type) {
+            case JointType::BALLSOCKETJOINT:
+                coloredJoint.componentIndex = mBallAndSocketJointComponents.getEntityIndex(jointEntity);
+                break;
+            case JointType::FIXEDJOINT:
+                coloredJoint.componentIndex = mFixedJointComponents.getEntityIndex(jointEntity);
+                break;
+            case JointType::HINGEJOINT:
+                coloredJoint.componentIndex = mHingeJointComponents.getEntityIndex(jointEntity);
+                break;
+            case JointType::SLIDERJOINT:
+                coloredJoint.componentIndex = mSliderJointComponents.getEntityIndex(jointEntity);
+                break;
+        }
+    }
+}
+
+// Solve the velocity constraint of a colored joint
+void ConstraintSolverSystem::solveVelocityConstraint(const ColoredJoint& coloredJoint) {
+
+    switch (coloredJoint.type) {
+        case JointType::BALLSOCKETJOINT:
+            mSolveBallAndSocketJointSystem.solveVelocityConstraint(coloredJoint.componentIndex);
+            break;
+        case JointType::FIXEDJOINT:
+            mSolveFixedJointSystem.solveVelocityConstraint(coloredJoint.componentIndex);
+            break;
+        case JointType::HINGEJOINT:
+            mSolveHingeJointSystem.solveVelocityConstraint(coloredJoint.componentIndex);
+            break;
+        case JointType::SLIDERJOINT:
+            mSolveSliderJointSystem.solveVelocityConstraint(coloredJoint.componentIndex);
+            break;
+    }
 }
 
 // Solve the velocity constraints
@@ -95,12 +232,56 @@ void ConstraintSolverSystem::solveVelocityConstraints() {
 
     RP3D_PROFILE("ConstraintSolverSystem::solveVelocityConstraints()", mProfiler);
 
+    // If the joints have been colored, solve them in the order of the colors so that
+    // the result is the same as with the parallel solver
+    if (mColors.size() > 0) {
+
+        for (uint32 i=0; i < mColoredJoints.size(); i++) {
+            solveVelocityConstraint(mColoredJoints[i]);
+        }
+
+        return;
+    }
+
     mSolveBallAndSocketJointSystem.solveVelocityConstraint();
     mSolveFixedJointSystem.solveVelocityConstraint();
     mSolveHingeJointSystem.solveVelocityConstraint();
     mSolveSliderJointSystem.solveVelocityConstraint();
 }
 
+// Solve the velocity constraints with the colors of joints solved in parallel.
+/// The joints of a color do not share any body and are solved by parallel tasks. There is
+/// a barrier between two colors. If the joints are not colored, they are solved serially.
+void ConstraintSolverSystem::solveVelocityConstraints(ThreadPool& threadPool) {
+
+    if (mColors.size() == 0) {
+        solveVelocityConstraints();
+        return;
+    }
+
+    RP3D_PROFILE("ConstraintSolverSystem::solveVelocityConstraints()", mProfiler);
+
+    for (uint32 c=0; c < mColors.size(); c++) {
+
+        const JointColor& color = mColors[c];
+        const uint32 endIndex = color.coloredJointsIndex + color.nbColoredJoints;
+
+        // The joints of the overflow color can share bodies and are solved by a single task
+        const uint32 nbJointsPerTask = color.isOverflow ? color.nbColoredJoints : NB_JOINTS_PER_COLOR_TASK;
+        const uint32 nbTasks = (color.nbColoredJoints + nbJointsPerTask - 1) / nbJointsPerTask;
+
+        threadPool.parallelFor(nbTasks, [this, &color, endIndex, nbJointsPerTask](uint taskIndex) {
+
+            const uint32 startIndex = color.coloredJointsIndex + taskIndex * nbJointsPerTask;
+            const uint32 taskEndIndex = std::min(startIndex + nbJointsPerTask, endIndex);
+
+            for (uint32 i=startIndex; i < taskEndIndex; i++) {
+                solveVelocityConstraint(mColoredJoints[i]);
+            }
+        });
+    }
+}
+
 // Solve the position constraints
 void ConstraintSolverSystem::solvePositionConstraints() {
 
@@ -30,10 +30,13 @@
 #include <reactphysics3d/constraint/ContactPoint.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/engine/Island.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/components/CollisionBodyComponents.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/collision/ContactManifold.h>
+#include <reactphysics3d/mathematics/SimdDecimal.h>
+#include <algorithm>
 
 using namespace reactphysics3d;
 using namespace std;
@@ -42,6 +45,197 @@ using namespace std;
 const decimal ContactSolverSystem::BETA = decimal(0.2);
 const decimal ContactSolverSystem::BETA_SPLIT_IMPULSE = decimal(0.2);
 const decimal ContactSolverSystem::SLOP = decimal(0.01);
+const uint ContactSolverSystem::NB_MIN_MANIFOLDS_PER_BATCH_GROUP = 128;
+const uint ContactSolverSystem::NB_MAX_COLORS = 32;
+const uint ContactSolverSystem::NB_MANIFOLDS_PER_COLOR_TASK = 32;
+
+// Structure ContactPointBatchSolver
+/**
+ * Contact solver data of the i-th contact point of each contact manifold of a batch. The lanes
+ * of the manifolds with less than i+1 contact points are zero and have no effect.
+ */
+struct ContactSolverSystem::ContactPointBatchSolver {
+
+    /// Normal vector of the contacts
+    decimal normal[3][SIMD_WIDTH];
+
+    /// Vectors from the body 1 center to the contact points
+    decimal r1[3][SIMD_WIDTH];
+
+    /// Vectors from the body 2 center to the contact points
+    decimal r2[3][SIMD_WIDTH];
+
+    /// Inverse inertia tensor of body 1 times the cross product of r1 with the contact normal
+    decimal i1TimesR1CrossN[3][SIMD_WIDTH];
+
+    /// Inverse inertia tensor of body 2 times the cross product of r2 with the contact normal
+    decimal i2TimesR2CrossN[3][SIMD_WIDTH];
+
+    /// Velocity bias for the penetration depth correction
+    decimal biasPenetrationDepth[SIMD_WIDTH];
+
+    /// Velocity restitution bias
+    decimal restitutionBias[SIMD_WIDTH];
+
+    /// Inverse of the matrix K for the penenetration
+    decimal inversePenetrationMass[SIMD_WIDTH];
+
+    /// Accumulated normal impulse
+    decimal penetrationImpulse[SIMD_WIDTH];
+
+    /// Accumulated split impulse for penetration correction
+    decimal penetrationSplitImpulse[SIMD_WIDTH];
+};
+
+// Structure ContactManifoldBatchSolver
+/**
+ * Contact solver data of up to SIMD_WIDTH contact manifolds (one per lane) that do not share
+ * any non-static body. The unused lanes are zero and their velocities are never written.
+ */
+struct ContactSolverSystem::ContactManifoldBatchSolver {
+
+    /// Index of the contact manifold of each lane in the solver
+    uint contactManifoldIndices[SIMD_WIDTH];
+
+    /// Index of the first contact point of each lane in the solver
+    uint contactPointIndices[SIMD_WIDTH];
+
+    /// Index of body 1 of each lane in the dynamics components arrays
+    uint32 rigidBodyComponentIndexBody1[SIMD_WIDTH];
+
+    /// Index of body 2 of each lane in the dynamics components arrays
+    uint32 rigidBodyComponentIndexBody2[SIMD_WIDTH];
+
+    /// True if the velocities of body 1 of the lane are written (false for static bodies and unused lanes)
+    bool isBody1Written[SIMD_WIDTH];
+
+    /// True if the velocities of body 2 of the lane are written
+    bool isBody2Written[SIMD_WIDTH];
+
+    /// Number of used lanes
+    uint nbLanes;
+
+    /// Index of the first contact point batch
+    uint contactPointBatchesIndex;
+
+    /// Number of contact point batches (largest number of contact points of the lanes)
+    uint nbContactPointBatches;
+
+    /// True if at least one lane has a rolling resistance
+    bool hasRollingResistance;
+
+    /// Inverse of the mass of body 1
+    decimal massInverseBody1[SIMD_WIDTH];
+
+    /// Inverse of the mass of body 2
+    decimal massInverseBody2[SIMD_WIDTH];
+
+    /// Inverse inertia tensor of body 1 (row by row)
+    decimal inverseInertiaTensorBody1[9][SIMD_WIDTH];
+
+    /// Inverse inertia tensor of body 2 (row by row)
+    decimal inverseInertiaTensorBody2[9][SIMD_WIDTH];
+
+    /// Mix friction coefficient for the two bodies
+    decimal frictionCoefficient[SIMD_WIDTH];
+
+    /// Rolling resistance factor between the two bodies
+    decimal rollingResistanceFactor[SIMD_WIDTH];
+
+    /// Average normal vector of the contact manifold
+    decimal normal[3][SIMD_WIDTH];
+
+    /// R1 vector for the friction constraints
+    decimal r1Friction[3][SIMD_WIDTH];
+
+    /// R2 vector for the friction constraints
+    decimal r2Friction[3][SIMD_WIDTH];
+
+    /// Cross product of r1 with 1st friction vector
+    decimal r1CrossT1[3][SIMD_WIDTH];
+
+    /// Cross product of r1 with 2nd friction vector
+    decimal r1CrossT2[3][SIMD_WIDTH];
+
+    /// Cross product of r2 with 1st friction vector
+    decimal r2CrossT1[3][SIMD_WIDTH];
+
+    /// Cross product of r2 with 2nd friction vector
+    decimal r2CrossT2[3][SIMD_WIDTH];
+
+    /// First friction direction at contact manifold center
+    decimal frictionVector1[3][SIMD_WIDTH];
+
+    /// Second friction direction at contact manifold center
+    decimal frictionVector2[3][SIMD_WIDTH];
+
+    /// Matrix K for the first friction constraint
+    decimal inverseFriction1Mass[SIMD_WIDTH];
+
+    /// Matrix K for the second friction constraint
+    decimal inverseFriction2Mass[SIMD_WIDTH];
+
+    /// Matrix K for the twist friction constraint
+    decimal inverseTwistFrictionMass[SIMD_WIDTH];
+
+    /// Matrix K for the rolling resistance constraint (row by row)
+    decimal inverseRollingResistance[9][SIMD_WIDTH];
+
+    /// First friction direction impulse at manifold center
+    decimal friction1Impulse[SIMD_WIDTH];
+
+    /// Second friction direction impulse at manifold center
+    decimal friction2Impulse[SIMD_WIDTH];
+
+    /// Twist friction impulse at contact manifold center
+    decimal frictionTwistImpulse[SIMD_WIDTH];
+
+    /// Rolling resistance impulse
+    decimal rollingResistanceImpulse[3][SIMD_WIDTH];
+};
+
+// Load the vectors of the lanes of a batch from a components array
+static inline SimdVector3 gatherVectors(const Vector3* vectors, const uint32* componentIndices) {
+
+    decimal values[3][SIMD_WIDTH];
+    for (uint i=0; i < SIMD_WIDTH; i++) {
+        const Vector3& vector = vectors[componentIndices[i]];
+        values[0][i] = vector.x;
+        values[1][i] = vector.y;
+        values[2][i] = vector.z;
+    }
+
+    return SimdVector3::load(values);
+}
+
+// Write the vectors of the lanes of a batch into a components array
+static inline void scatterVectors(const SimdVector3& simdVectors, Vector3* vectors, const uint32* componentIndices,
+                                  const bool* isWritten) {
+
+    decimal values[3][SIMD_WIDTH];
+    simdVectors.store(values);
+    for (uint i=0; i < SIMD_WIDTH; i++) {
+        if (isWritten[i]) {
+            vectors[componentIndices[i]].setAllValues(values[0][i], values[1][i], values[2][i]);
+        }
+    }
+}
+
+// Set the lane of a vector stored as three rows of SIMD_WIDTH decimals
+static inline void setLane(decimal values[3][SIMD_WIDTH], uint lane, const Vector3& vector) {
+    values[0][lane] = vector.x;
+    values[1][lane] = vector.y;
+    values[2][lane] = vector.z;
+}
+
+// Set the lane of a matrix stored row by row as nine rows of SIMD_WIDTH decimals
+static inline void setLane(decimal values[9][SIMD_WIDTH], uint lane, const Matrix3x3& matrix) {
+    for (int i=0; i < 3; i++) {
+        for (int j=0; j < 3; j++) {
+            values[i * 3 + j][lane] = matrix[i][j];
+        }
+    }
+}
 
 // Constructor
 ContactSolverSystem::ContactSolverSystem(MemoryManager& memoryManager, PhysicsWorld& world, Islands& islands,
@@ -49,9 +243,14 @@ ContactSolverSystem::ContactSolverSystem(MemoryManager& memoryManager, PhysicsWo
                                          ColliderComponents& colliderComponents, decimal& restitutionVelocityThreshold)
               :mMemoryManager(memoryManager), mWorld(world), mRestitutionVelocityThreshold(restitutionVelocityThreshold),
                mContactConstraints(nullptr), mContactPoints(nullptr),
-               mIslands(islands), mAllContactManifolds(nullptr), mAllContactPoints(nullptr),
+               mSolverIslands(nullptr), mSolverIslandsOrder(nullptr), mNbSolverIslands(0),
+               mContactManifoldBatches(nullptr), mContactPointBatches(nullptr), mNbContactManifoldBatches(0),
+               mNbContactPointBatches(0), mBatchGroups(nullptr), mNbBatchGroups(0), mColoringThreshold(0),
+               mColors(nullptr), mNbColors(0), mNbColoredIslands(0), mNbColoredContactManifolds(0), mColorTasks(nullptr),
+               mNbColorTasks(0), mIslands(islands), mAllContactManifolds(nullptr), mAllContactPoints(nullptr),
                mBodyComponents(bodyComponents), mRigidBodyComponents(rigidBodyComponents),
-               mColliderComponents(colliderComponents), mIsSplitImpulseActive(true) {
+               mColliderComponents(colliderComponents), mIsSplitImpulseActive(true), mIsSimdSolverEnabled(true),
+               mIsParityCheckEnabled(false) {
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -79,6 +278,24 @@ void ContactSolverSystem::init(List<ContactManifold>* contactManifolds, List<Con
     mContactConstraints = nullptr;
     mContactPoints = nullptr;
 
+    mSolverIslands = nullptr;
+    mSolverIslandsOrder = nullptr;
+    mNbSolverIslands = 0;
+
+    mContactManifoldBatches = nullptr;
+    mContactPointBatches = nullptr;
+    mNbContactManifoldBatches = 0;
+    mNbContactPointBatches = 0;
+    mBatchGroups = nullptr;
+    mNbBatchGroups = 0;
+
+    mColors = nullptr;
+    mNbColors = 0;
+    mNbColoredIslands = 0;
+    mNbColoredContactManifolds = 0;
+    mColorTasks = nullptr;
+    mNbColorTasks = 0;
+
     if (nbContactManifolds == 0 || nbContactPoints == 0) return;
 
     mContactPoints = static_cast<ContactPointSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
@@ -89,16 +306,82 @@ void ContactSolverSystem::init(List<ContactManifold>* contactManifolds, List<Con
                                                                                       sizeof(ContactManifoldSolver) * nbContactManifolds));
     assert(mContactConstraints != nullptr);
 
+    mSolverIslands = static_cast<ContactSolverIsland*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                               sizeof(ContactSolverIsland) * mIslands.getNbIslands()));
+    mSolverIslandsOrder = static_cast<uint*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                     sizeof(uint) * mIslands.getNbIslands()));
+
+    // Count the islands that are large enough to color their contacts
+    if (mColoringThreshold > 0) {
+        for (uint i = 0; i < mIslands.getNbIslands(); i++) {
+            if (mIslands.nbContactManifolds[i] >= mColoringThreshold) {
+                mNbColoredIslands++;
+                mNbColoredContactManifolds += mIslands.nbContactManifolds[i];
+            }
+        }
+    }
+
+    // Colors already used by the contact manifolds of each body of the island being colored
+    const uint32 nbRigidBodies = mRigidBodyComponents.getNbComponents();
+    uint32* bodiesColors = nullptr;
+    if (mNbColoredIslands > 0) {
+
+        mColors = static_cast<ContactSolverColor*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                           sizeof(ContactSolverColor) * mNbColoredIslands * (NB_MAX_COLORS + 1)));
+        mColorTasks = static_cast<ContactColorTask*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                             sizeof(ContactColorTask) * mNbColoredContactManifolds));
+
+        bodiesColors = static_cast<uint32*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                    sizeof(uint32) * nbRigidBodies));
+        std::fill(bodiesColors, bodiesColors + nbRigidBodies, 0);
+    }
+
     // For each island of the world
     for (uint i = 0; i < mIslands.getNbIslands(); i++) {
 
         if (mIslands.nbContactManifolds[i] > 0) {
+
+            ContactSolverIsland& solverIsland = mSolverIslands[mNbSolverIslands];
+            solverIsland.contactManifoldsIndex = mNbContactManifolds;
+            solverIsland.contactPointsIndex = mNbContactPoints;
+            solverIsland.colorsIndex = 0;
+            solverIsland.nbColors = 0;
+
             initializeForIsland(i);
+
+            solverIsland.nbContactManifolds = mNbContactManifolds - solverIsland.contactManifoldsIndex;
+            mSolverIslandsOrder[mNbSolverIslands] = mNbSolverIslands;
+            mNbSolverIslands++;
+
+            if (mNbColoredIslands > 0 && solverIsland.nbContactManifolds >= mColoringThreshold) {
+                colorIsland(solverIsland, bodiesColors);
+            }
         }
     }
 
+    if (bodiesColors != nullptr) {
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, bodiesColors, sizeof(uint32) * nbRigidBodies);
+    }
+
+    // Sort the islands by decreasing number of contact manifolds. This only changes the order in
+    // which the islands are scheduled, not the result (ties are broken by index so it is stable).
+    const ContactSolverIsland* solverIslands = mSolverIslands;
+    std::sort(mSolverIslandsOrder, mSolverIslandsOrder + mNbSolverIslands, [solverIslands](uint a, uint b) {
+        return solverIslands[a].nbContactManifolds > solverIslands[b].nbContactManifolds ||
+               (solverIslands[a].nbContactManifolds == solverIslands[b].nbContactManifolds && a < b);
+    });
+
     // Warmstarting
     warmStart();
+
+    // Pack the contact manifolds (with their warm started impulses) for the SIMD solver
+    if (mIsSimdSolverEnabled) {
+        initializeBatches();
+    }
+
+    if (mNbColoredIslands > 0) {
+        initializeColorTasks();
+    }
 }
 
 // Release allocated memory
@@ -106,6 +389,191 @@ void ContactSolverSystem::reset() {
 
     if (mAllContactPoints->size() > 0) mMemoryManager.release(MemoryManager::AllocationType::Frame, mContactPoints, sizeof(ContactPointSolver) * mAllContactPoints->size());
     if (mAllContactManifolds->size() > 0) mMemoryManager.release(MemoryManager::AllocationType::Frame, mContactConstraints, sizeof(ContactManifoldSolver) * mAllContactManifolds->size());
+    if (mSolverIslands != nullptr) {
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mSolverIslands, sizeof(ContactSolverIsland) * mIslands.getNbIslands());
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mSolverIslandsOrder, sizeof(uint) * mIslands.getNbIslands());
+    }
+    if (mContactManifoldBatches != nullptr) {
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mContactManifoldBatches,
+                               sizeof(ContactManifoldBatchSolver) * mNbContactManifoldBatches);
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mContactPointBatches,
+                               sizeof(ContactPointBatchSolver) * mNbContactPointBatches);
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mBatchGroups, sizeof(ContactBatchGroup) * mNbSolverIslands);
+    }
+    if (mColors != nullptr) {
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mColors,
+                               sizeof(ContactSolverColor) * mNbColoredIslands * (NB_MAX_COLORS + 1));
+        mMemoryManager.release(MemoryManager::AllocationType::Frame, mColorTasks,
+                               sizeof(ContactColorTask) * mNbColoredContactManifolds);
+    }
+}
+
+// Color the contact manifolds of an island such that the manifolds of a color do not share any body.
+/// We use a greedy first-fit coloring where each contact manifold gets the first color that is not
+/// already used by one of its non-static bodies (static bodies are never written by the solver).
+/// The manifolds that do not fit in any of the NB_MAX_COLORS colors are put in an overflow color
+/// solved by a single task. The contact manifolds and contact points of the island are then sorted
+/// by color (keeping their relative order inside a color) so that solve() uses the same order as
+/// the parallel solver.
+void ContactSolverSystem::colorIsland(ContactSolverIsland& island, uint32* bodiesColors) {
+
+    RP3D_PROFILE("ContactSolver::colorIsland()", mProfiler);
+
+    const uint startManifoldIndex = island.contactManifoldsIndex;
+    const uint endManifoldIndex = island.contactManifoldsIndex + island.nbContactManifolds;
+    const uint nbContactPoints = mNbContactPoints - island.contactPointsIndex;
+
+    uint8* manifoldsColors = static_cast<uint8*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                         sizeof(uint8) * island.nbContactManifolds));
+
+    // Compute the color of each contact manifold (the overflow color is NB_MAX_COLORS)
+    uint nbManifoldsPerColor[NB_MAX_COLORS + 1] = {};
+    uint nbContactPointsPerColor[NB_MAX_COLORS + 1] = {};
+    for (uint m=startManifoldIndex; m < endManifoldIndex; m++) {
+
+        const ContactManifoldSolver& manifold = mContactConstraints[m];
+
+        uint32 usedColors = 0;
+        if (!manifold.isBody1Static) usedColors |= bodiesColors[manifold.rigidBodyComponentIndexBody1];
+        if (!manifold.isBody2Static) usedColors |= bodiesColors[manifold.rigidBodyComponentIndexBody2];
+
+        uint color = 0;
+        while (color < NB_MAX_COLORS && (usedColors & (uint32(1) << color)) != 0) {
+            color++;
+        }
+
+        if (color < NB_MAX_COLORS) {
+            if (!manifold.isBody1Static) bodiesColors[manifold.rigidBodyComponentIndexBody1] |= uint32(1) << color;
+            if (!manifold.isBody2Static) bodiesColors[manifold.rigidBodyComponentIndexBody2] |= uint32(1) << color;
+        }
+
+        manifoldsColors[m - startManifoldIndex] = static_cast<uint8>(color);
+        nbManifoldsPerColor[color]++;
+        nbContactPointsPerColor[color] += manifold.nbContacts;
+    }
+
+    // Reset the colors of the bodies of the island for the next colored island
+    for (uint m=startManifoldIndex; m < endManifoldIndex; m++) {
+        bodiesColors[mContactConstraints[m].rigidBodyComponentIndexBody1] = 0;
+        bodiesColors[mContactConstraints[m].rigidBodyComponentIndexBody2] = 0;
+    }
+
+    // Create the colors of the island
+    uint colorsManifoldIndex[NB_MAX_COLORS + 1];
+    uint colorsContactPointIndex[NB_MAX_COLORS + 1];
+    uint manifoldIndex = startManifoldIndex;
+    uint contactPointIndex = island.contactPointsIndex;
+    island.colorsIndex = mNbColors;
+    island.nbColors = 0;
+    for (uint c=0; c <= NB_MAX_COLORS; c++) {
+
+        colorsManifoldIndex[c] = manifoldIndex;
+        colorsContactPointIndex[c] = contactPointIndex;
+
+        if (nbManifoldsPerColor[c] > 0) {
+
+            ContactSolverColor& color = mColors[mNbColors];
+            color.contactManifoldsIndex = manifoldIndex;
+            color.nbContactManifolds = nbManifoldsPerColor[c];
+            color.contactPointsIndex = contactPointIndex;
+            color.contactManifoldBatchesIndex = 0;
+            color.nbContactManifoldBatches = 0;
+            color.tasksIndex = 0;
+            color.nbTasks = 0;
+            color.isOverflow = c == NB_MAX_COLORS;
+            mNbColors++;
+            island.nbColors++;
+        }
+
+        manifoldIndex += nbManifoldsPerColor[c];
+        contactPointIndex += nbContactPointsPerColor[c];
+    }
+
+    // Copy the contact manifolds and contact points of the island
+    ContactManifoldSolver* manifolds = static_cast<ContactManifoldSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                           sizeof(ContactManifoldSolver) * island.nbContactManifolds));
+    ContactPointSolver* contactPoints = static_cast<ContactPointSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                         sizeof(ContactPointSolver) * nbContactPoints));
+    for (uint m=0; m < island.nbContactManifolds; m++) {
+        new (manifolds + m) ContactManifoldSolver(mContactConstraints[startManifoldIndex + m]);
+    }
+    for (uint c=0; c < nbContactPoints; c++) {
+        new (contactPoints + c) ContactPointSolver(mContactPoints[island.contactPointsIndex + c]);
+    }
+
+    // Sort the contact manifolds and contact points by color
+    uint islandContactPointIndex = 0;
+    for (uint m=0; m < island.nbContactManifolds; m++) {
+
+        const uint color = manifoldsColors[m];
+        const uint nbContacts = static_cast<uint>(manifolds[m].nbContacts);
+
+        mContactConstraints[colorsManifoldIndex[color]] = manifolds[m];
+        colorsManifoldIndex[color]++;
+
+        for (uint c=0; c < nbContacts; c++) {
+            mContactPoints[colorsContactPointIndex[color] + c] = contactPoints[islandContactPointIndex + c];
+        }
+        colorsContactPointIndex[color] += nbContacts;
+        islandContactPointIndex += nbContacts;
+    }
+
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, contactPoints, sizeof(ContactPointSolver) * nbContactPoints);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, manifolds, sizeof(ContactManifoldSolver) * island.nbContactManifolds);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, manifoldsColors, sizeof(uint8) * island.nbContactManifolds);
+}
+
+// Split the colors of the colored islands into tasks.
+/// With the scalar solver, a task solves NB_MANIFOLDS_PER_COLOR_TASK contact manifolds of a color
+/// and with the SIMD solver, it solves the batches containing about the same number of manifolds.
+/// The overflow color of an island is solved by a single task because its manifolds can share bodies.
+void ContactSolverSystem::initializeColorTasks() {
+
+    const uint nbBatchesPerTask = std::max(NB_MANIFOLDS_PER_COLOR_TASK / SIMD_WIDTH, uint(1));
+
+    for (uint i=0; i < mNbColors; i++) {
+
+        ContactSolverColor& color = mColors[i];
+        color.tasksIndex = mNbColorTasks;
+
+        if (mContactManifoldBatches != nullptr) {
+
+            const uint endBatchIndex = color.contactManifoldBatchesIndex + color.nbContactManifoldBatches;
+            const uint nbTaskBatches = color.isOverflow ? color.nbContactManifoldBatches : nbBatchesPerTask;
+
+            for (uint b=color.contactManifoldBatchesIndex; b < endBatchIndex; b += nbTaskBatches) {
+
+                ContactColorTask& task = mColorTasks[mNbColorTasks];
+                task.startIndex = b;
+                task.endIndex = std::min(b + nbTaskBatches, endBatchIndex);
+                task.contactPointsIndex = 0;
+                mNbColorTasks++;
+            }
+        }
+        else {
+
+            const uint endManifoldIndex = color.contactManifoldsIndex + color.nbContactManifolds;
+            const uint nbTaskManifolds = color.isOverflow ? color.nbContactManifolds : NB_MANIFOLDS_PER_COLOR_TASK;
+
+            uint contactPointIndex = color.contactPointsIndex;
+            for (uint m=color.contactManifoldsIndex; m < endManifoldIndex; m += nbTaskManifolds) {
+
+                ContactColorTask& task = mColorTasks[mNbColorTasks];
+                task.startIndex = m;
+                task.endIndex = std::min(m + nbTaskManifolds, endManifoldIndex);
+                task.contactPointsIndex = contactPointIndex;
+                mNbColorTasks++;
+
+                for (uint j=task.startIndex; j < task.endIndex; j++) {
+                    contactPointIndex += mContactConstraints[j].nbContacts;
+                }
+            }
+        }
+
+        color.nbTasks = mNbColorTasks - color.tasksIndex;
+    }
+
+    assert(mNbColorTasks <= mNbColoredContactManifolds);
 }
 
 // Initialize the constraint solver for a given island
@@ -151,6 +619,8 @@ void ContactSolverSystem::initializeForIsland(uint islandIndex) {
         mContactConstraints[mNbContactManifolds].inverseInertiaTensorBody2 = RigidBody::getWorldInertiaTensorInverse(mWorld, externalManifold.bodyEntity2);
         mContactConstraints[mNbContactManifolds].massInverseBody1 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex1];
         mContactConstraints[mNbContactManifolds].massInverseBody2 = mRigidBodyComponents.mInverseMasses[rigidBodyIndex2];
+        mContactConstraints[mNbContactManifolds].isBody1Static = mRigidBodyComponents.mBodyTypes[rigidBodyIndex1] == BodyType::STATIC;
+        mContactConstraints[mNbContactManifolds].isBody2Static = mRigidBodyComponents.mBodyTypes[rigidBodyIndex2] == BodyType::STATIC;
         mContactConstraints[mNbContactManifolds].nbContacts = externalManifold.nbContactPoints;
         mContactConstraints[mNbContactManifolds].frictionCoefficient = computeMixedFrictionCoefficient(collider1, collider2);
         mContactConstraints[mNbContactManifolds].rollingResistanceFactor = computeMixedRollingResistance(collider1, collider2);
@@ -242,7 +712,13 @@ void ContactSolverSystem::initializeForIsland(uint islandIndex) {
                                  deltaV.y * mContactPoints[mNbContactPoints].normal.y +
                                  deltaV.z * mContactPoints[mNbContactPoints].normal.z;
             const decimal restitutionFactor = computeMixedRestitutionFactor(collider1, collider2);
-            if (deltaVDotN < -mRestitutionVelocityThreshold) {
+            if (mContactPoints[mNbContactPoints].penetrationDepth <= decimal(0.0)) {
+
+                // For a speculative contact (the colliders are still apart), the bias lets the bodies
+                // approach each other by the distance between them during the step and no more
+                mContactPoints[mNbContactPoints].restitutionBias = -mContactPoints[mNbContactPoints].penetrationDepth / mTimeStep;
+            }
+            else if (deltaVDotN < -mRestitutionVelocityThreshold) {
                 mContactPoints[mNbContactPoints].restitutionBias = restitutionFactor * deltaVDotN;
             }
 
@@ -492,27 +968,346 @@ void ContactSolverSystem::warmStart() {
     }
 }
 
+// Pack the contact manifolds into batches for the SIMD solver
+/// Each manifold is put in the first batch with a free lane that comes after all the batches
+/// containing one of its non-static bodies. Therefore, the manifolds of a batch never write the
+/// same body and the constraints of each body are solved in the same order as with the scalar
+/// solver. Consecutive islands are packed together into groups of batches.
+void ContactSolverSystem::initializeBatches() {
+
+    RP3D_PROFILE("ContactSolver::initializeBatches()", mProfiler);
+
+    if (mNbContactManifolds == 0) return;
+
+    // Batch of each contact manifold and number of used lanes of each batch (there
+    // cannot be more batches than contact manifolds)
+    uint* manifoldBatches = static_cast<uint*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                       sizeof(uint) * mNbContactManifolds));
+    uint* nbBatchLanes = static_cast<uint*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                    sizeof(uint) * mNbContactManifolds));
+
+    // Index (plus one) of the last batch containing each body
+    const uint32 nbRigidBodies = mRigidBodyComponents.getNbComponents();
+    uint* bodiesLastBatch = static_cast<uint*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                       sizeof(uint) * nbRigidBodies));
+    std::fill(bodiesLastBatch, bodiesLastBatch + nbRigidBodies, 0);
+
+    mBatchGroups = static_cast<ContactBatchGroup*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                           sizeof(ContactBatchGroup) * mNbSolverIslands));
+
+    // Assign a batch to each contact manifold
+    uint groupFirstBatch = 0;
+    uint firstOpenBatch = 0;
+    uint nbGroupManifolds = 0;
+    // Put a contact manifold in the first batch with a free lane after the batches of its bodies
+    auto assignBatch = [&](uint m) {
+
+        const ContactManifoldSolver& manifold = mContactConstraints[m];
+
+        uint batch = firstOpenBatch;
+        if (!manifold.isBody1Static) {
+            batch = std::max(batch, bodiesLastBatch[manifold.rigidBodyComponentIndexBody1]);
+        }
+        if (!manifold.isBody2Static) {
+            batch = std::max(batch, bodiesLastBatch[manifold.rigidBodyComponentIndexBody2]);
+        }
+        while (batch < mNbContactManifoldBatches && nbBatchLanes[batch] == SIMD_WIDTH) {
+            batch++;
+        }
+        if (batch == mNbContactManifoldBatches) {
+            nbBatchLanes[batch] = 0;
+            mNbContactManifoldBatches++;
+        }
+
+        nbBatchLanes[batch]++;
+        manifoldBatches[m] = batch;
+        bodiesLastBatch[manifold.rigidBodyComponentIndexBody1] = batch + 1;
+        bodiesLastBatch[manifold.rigidBodyComponentIndexBody2] = batch + 1;
+
+        while (firstOpenBatch < mNbContactManifoldBatches && nbBatchLanes[firstOpenBatch] == SIMD_WIDTH) {
+            firstOpenBatch++;
+        }
+    };
+    for (uint i=0; i < mNbSolverIslands; i++) {
+
+        const ContactSolverIsland& island = mSolverIslands[i];
+
+        // The batches of each color of a colored island are not part of a group
+        if (island.nbColors > 0) {
+
+            // Close the current group of batches
+            if (nbGroupManifolds > 0) {
+
+                mBatchGroups[mNbBatchGroups].contactManifoldBatchesIndex = groupFirstBatch;
+                mBatchGroups[mNbBatchGroups].nbContactManifoldBatches = mNbContactManifoldBatches - groupFirstBatch;
+                mNbBatchGroups++;
+                nbGroupManifolds = 0;
+            }
+
+            for (uint c=island.colorsIndex; c < island.colorsIndex + island.nbColors; c++) {
+
+                ContactSolverColor& color = mColors[c];
+
+                // The manifolds of a color are never packed with the ones of another color
+                firstOpenBatch = mNbContactManifoldBatches;
+                color.contactManifoldBatchesIndex = mNbContactManifoldBatches;
+
+                for (uint m=color.contactManifoldsIndex; m < color.contactManifoldsIndex + color.nbContactManifolds; m++) {
+                    assignBatch(m);
+                }
+
+                color.nbContactManifoldBatches = mNbContactManifoldBatches - color.contactManifoldBatchesIndex;
+            }
+
+            groupFirstBatch = mNbContactManifoldBatches;
+            firstOpenBatch = mNbContactManifoldBatches;
+
+            continue;
+        }
+
+        for (uint m=island.contactManifoldsIndex; m < island.contactManifoldsIndex + island.nbContactManifolds; m++) {
+            assignBatch(m);
+        }
+
+        // Close the current group of batches
+        nbGroupManifolds += island.nbContactManifolds;
+        if (nbGroupManifolds >= NB_MIN_MANIFOLDS_PER_BATCH_GROUP || i == mNbSolverIslands - 1) {
+
+            mBatchGroups[mNbBatchGroups].contactManifoldBatchesIndex = groupFirstBatch;
+            mBatchGroups[mNbBatchGroups].nbContactManifoldBatches = mNbContactManifoldBatches - groupFirstBatch;
+            mNbBatchGroups++;
+
+            groupFirstBatch = mNbContactManifoldBatches;
+            firstOpenBatch = mNbContactManifoldBatches;
+            nbGroupManifolds = 0;
+        }
+    }
+
+    mContactManifoldBatches = static_cast<ContactManifoldBatchSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                       sizeof(ContactManifoldBatchSolver) * mNbContactManifoldBatches));
+    for (uint b=0; b < mNbContactManifoldBatches; b++) {
+        new (mContactManifoldBatches + b) ContactManifoldBatchSolver();
+    }
+
+    // Fill the lanes of the batches with the contact manifolds
+    uint contactPointIndex = 0;
+    for (uint m=0; m < mNbContactManifolds; m++) {
+
+        const ContactManifoldSolver& manifold = mContactConstraints[m];
+        ContactManifoldBatchSolver& batch = mContactManifoldBatches[manifoldBatches[m]];
+        const uint lane = batch.nbLanes;
+        batch.nbLanes++;
+
+        batch.contactManifoldIndices[lane] = m;
+        batch.contactPointIndices[lane] = contactPointIndex;
+        batch.rigidBodyComponentIndexBody1[lane] = manifold.rigidBodyComponentIndexBody1;
+        batch.rigidBodyComponentIndexBody2[lane] = manifold.rigidBodyComponentIndexBody2;
+        batch.isBody1Written[lane] = !manifold.isBody1Static;
+        batch.isBody2Written[lane] = !manifold.isBody2Static;
+        batch.nbContactPointBatches = std::max(batch.nbContactPointBatches, static_cast<uint>(manifold.nbContacts));
+        batch.hasRollingResistance |= manifold.rollingResistanceFactor > 0;
+        batch.massInverseBody1[lane] = manifold.massInverseBody1;
+        batch.massInverseBody2[lane] = manifold.massInverseBody2;
+        setLane(batch.inverseInertiaTensorBody1, lane, manifold.inverseInertiaTensorBody1);
+        setLane(batch.inverseInertiaTensorBody2, lane, manifold.inverseInertiaTensorBody2);
+        batch.frictionCoefficient[lane] = manifold.frictionCoefficient;
+        batch.rollingResistanceFactor[lane] = manifold.rollingResistanceFactor;
+        setLane(batch.normal, lane, manifold.normal);
+        setLane(batch.r1Friction, lane, manifold.r1Friction);
+        setLane(batch.r2Friction, lane, manifold.r2Friction);
+        setLane(batch.r1CrossT1, lane, manifold.r1CrossT1);
+        setLane(batch.r1CrossT2, lane, manifold.r1CrossT2);
+        setLane(batch.r2CrossT1, lane, manifold.r2CrossT1);
+        setLane(batch.r2CrossT2, lane, manifold.r2CrossT2);
+        setLane(batch.frictionVector1, lane, manifold.frictionVector1);
+        setLane(batch.frictionVector2, lane, manifold.frictionVector2);
+        batch.inverseFriction1Mass[lane] = manifold.inverseFriction1Mass;
+        batch.inverseFriction2Mass[lane] = manifold.inverseFriction2Mass;
+        batch.inverseTwistFrictionMass[lane] = manifold.inverseTwistFrictionMass;
+        setLane(batch.inverseRollingResistance, lane, manifold.inverseRollingResistance);
+        batch.friction1Impulse[lane] = manifold.friction1Impulse;
+        batch.friction2Impulse[lane] = manifold.friction2Impulse;
+        batch.frictionTwistImpulse[lane] = manifold.frictionTwistImpulse;
+        setLane(batch.rollingResistanceImpulse, lane, manifold.rollingResistanceImpulse);
+
+        contactPointIndex += manifold.nbContacts;
+    }
+
+    // The unused lanes read the velocities of the bodies of the first lane but never write them
+    for (uint b=0; b < mNbContactManifoldBatches; b++) {
+
+        ContactManifoldBatchSolver& batch = mContactManifoldBatches[b];
+        for (uint lane = batch.nbLanes; lane < SIMD_WIDTH; lane++) {
+            batch.rigidBodyComponentIndexBody1[lane] = batch.rigidBodyComponentIndexBody1[0];
+            batch.rigidBodyComponentIndexBody2[lane] = batch.rigidBodyComponentIndexBody2[0];
+        }
+
+        batch.contactPointBatchesIndex = mNbContactPointBatches;
+        mNbContactPointBatches += batch.nbContactPointBatches;
+    }
+
+    mContactPointBatches = static_cast<ContactPointBatchSolver*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame,
+                                                                 sizeof(ContactPointBatchSolver) * mNbContactPointBatches));
+
+    const decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
+
+    // Fill the contact point batches
+    for (uint b=0; b < mNbContactManifoldBatches; b++) {
+
+        const ContactManifoldBatchSolver& batch = mContactManifoldBatches[b];
+
+        for (uint c=0; c < batch.nbContactPointBatches; c++) {
+            new (mContactPointBatches + batch.contactPointBatchesIndex + c) ContactPointBatchSolver();
+        }
+
+        for (uint lane=0; lane < batch.nbLanes; lane++) {
+
+            const ContactManifoldSolver& manifold = mContactConstraints[batch.contactManifoldIndices[lane]];
+
+            for (int c=0; c < manifold.nbContacts; c++) {
+
+                const ContactPointSolver& contactPoint = mContactPoints[batch.contactPointIndices[lane] + c];
+                ContactPointBatchSolver& pointBatch = mContactPointBatches[batch.contactPointBatchesIndex + c];
+
+                // Same bias as the one computed at each iteration by the scalar solver
+                decimal biasPenetrationDepth = 0.0;
+                if (contactPoint.penetrationDepth > SLOP) {
+                    biasPenetrationDepth = -(beta/mTimeStep) * max(0.0f, float(contactPoint.penetrationDepth - SLOP));
+                }
+
+                setLane(pointBatch.normal, lane, contactPoint.normal);
+                setLane(pointBatch.r1, lane, contactPoint.r1);
+                setLane(pointBatch.r2, lane, contactPoint.r2);
+                setLane(pointBatch.i1TimesR1CrossN, lane, contactPoint.i1TimesR1CrossN);
+                setLane(pointBatch.i2TimesR2CrossN, lane, contactPoint.i2TimesR2CrossN);
+                pointBatch.biasPenetrationDepth[lane] = biasPenetrationDepth;
+                pointBatch.restitutionBias[lane] = contactPoint.restitutionBias;
+                pointBatch.inversePenetrationMass[lane] = contactPoint.inversePenetrationMass;
+                pointBatch.penetrationImpulse[lane] = contactPoint.penetrationImpulse;
+                pointBatch.penetrationSplitImpulse[lane] = contactPoint.penetrationSplitImpulse;
+            }
+        }
+    }
+
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, bodiesLastBatch, sizeof(uint) * nbRigidBodies);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, nbBatchLanes, sizeof(uint) * mNbContactManifolds);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, manifoldBatches, sizeof(uint) * mNbContactManifolds);
+}
+
 // Solve the contacts
 void ContactSolverSystem::solve() {
 
     RP3D_PROFILE("ContactSolverSystem::solve()", mProfiler);
 
+    if (mContactManifoldBatches != nullptr) {
+        solveContactBatches(0, mNbContactManifoldBatches);
+    }
+    else {
+        solveContactManifolds(0, mNbContactManifolds, 0);
+    }
+}
+
+// Solve all the iterations of the velocity solver for the contacts of the islands.
+/// Islands do not share any non-static body and the contacts of an island are solved
+/// in the same order as in solve(). Therefore, the result is exactly the same as calling
+/// solve() nbIterations times, whatever the number of threads of the pool. With the SIMD
+/// solver, the tasks are the groups of batches instead of the islands. The colored islands
+/// are solved afterwards by colors.
+void ContactSolverSystem::solveIslands(ThreadPool& threadPool, uint nbIterations) {
+
+    RP3D_PROFILE("ContactSolverSystem::solveIslands()", mProfiler);
+
+    if (mContactManifoldBatches != nullptr) {
+
+        threadPool.parallelFor(mNbBatchGroups, [this, nbIterations](uint taskIndex) {
+
+            const ContactBatchGroup& group = mBatchGroups[taskIndex];
+
+            for (uint i=0; i < nbIterations; i++) {
+                solveContactBatches(group.contactManifoldBatchesIndex,
+                                    group.contactManifoldBatchesIndex + group.nbContactManifoldBatches);
+            }
+        });
+    }
+    else {
+
+        threadPool.parallelFor(mNbSolverIslands, [this, nbIterations](uint taskIndex) {
+
+            const ContactSolverIsland& island = mSolverIslands[mSolverIslandsOrder[taskIndex]];
+
+            // The colored islands are solved by colors
+            if (island.nbColors > 0) return;
+
+            for (uint i=0; i < nbIterations; i++) {
+                solveContactManifolds(island.contactManifoldsIndex, island.contactManifoldsIndex + island.nbContactManifolds,
+                                      island.contactPointsIndex);
+            }
+        });
+    }
+
+    if (mNbColoredIslands > 0) {
+        solveColoredIslands(threadPool, nbIterations);
+    }
+}
+
+// Solve the colored islands with the tasks of each color solved in parallel.
+/// The contact manifolds of a color do not share any non-static body so its tasks can run in
+/// parallel, with a barrier between two colors. The colors are solved in the order of the solver
+/// arrays so that the result is the same as with solve().
+void ContactSolverSystem::solveColoredIslands(ThreadPool& threadPool, uint nbIterations) {
+
+    RP3D_PROFILE("ContactSolverSystem::solveColoredIslands()", mProfiler);
+
+    for (uint i=0; i < nbIterations; i++) {
+
+        for (uint c=0; c < mNbColors; c++) {
+
+            const ContactSolverColor& color = mColors[c];
+
+            threadPool.parallelFor(color.nbTasks, [this, &color](uint taskIndex) {
+
+                const ContactColorTask& task = mColorTasks[color.tasksIndex + taskIndex];
+
+                if (mContactManifoldBatches != nullptr) {
+                    solveContactBatches(task.startIndex, task.endIndex);
+                }
+                else {
+                    solveContactManifolds(task.startIndex, task.endIndex, task.contactPointsIndex);
+                }
+            });
+        }
+    }
+}
+
+// Solve the contact manifolds in [startManifoldIndex, endManifoldIndex)
+void ContactSolverSystem::solveContactManifolds(uint startManifoldIndex, uint endManifoldIndex, uint startContactPointIndex) {
+
     decimal deltaLambda;
     decimal lambdaTemp;
-    uint contactPointIndex = 0;
+    uint contactPointIndex = startContactPointIndex;
 
     const decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
 
     // For each contact manifold
-    for (uint c=0; c<mNbContactManifolds; c++) {
+    for (uint c=startManifoldIndex; c<endManifoldIndex; c++) {
 
         decimal sumPenetrationImpulse = 0.0;
 
-        // Get the constrained velocities
-        const Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1];
-        const Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1];
-        const Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2];
-        const Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2];
+        const uint32 rigidBodyIndex1 = mContactConstraints[c].rigidBodyComponentIndexBody1;
+        const uint32 rigidBodyIndex2 = mContactConstraints[c].rigidBodyComponentIndexBody2;
+
+        // Get the constrained velocities. We work on local copies that are written back at the end
+        // of the manifold so that static bodies (shared between islands) are never written.
+        Vector3 v1 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBodyIndex1];
+        Vector3 w1 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBodyIndex1];
+        Vector3 v2 = mRigidBodyComponents.mConstrainedLinearVelocities[rigidBodyIndex2];
+        Vector3 w2 = mRigidBodyComponents.mConstrainedAngularVelocities[rigidBodyIndex2];
+
+        // Get the split velocities
+        Vector3 v1Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBodyIndex1];
+        Vector3 w1Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBodyIndex1];
+        Vector3 v2Split = mRigidBodyComponents.mSplitLinearVelocities[rigidBodyIndex2];
+        Vector3 w2Split = mRigidBodyComponents.mSplitAngularVelocities[rigidBodyIndex2];
 
         for (short int i=0; i<mContactConstraints[c].nbContacts; i++) {
 
@@ -556,22 +1351,22 @@ void ContactSolverSystem::solve() {
                                   mContactPoints[contactPointIndex].normal.z * deltaLambda);
 
             // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z;
+            v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x;
+            v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y;
+            v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z;
 
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * deltaLambda;
+            w1.x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * deltaLambda;
+            w1.y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * deltaLambda;
+            w1.z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * deltaLambda;
 
             // Update the velocities of the body 2 by applying the impulse P
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactConstraints[c].massInverseBody2 * linearImpulse.x;
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactConstraints[c].massInverseBody2 * linearImpulse.y;
-            mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactConstraints[c].massInverseBody2 * linearImpulse.z;
+            v2.x += mContactConstraints[c].massInverseBody2 * linearImpulse.x;
+            v2.y += mContactConstraints[c].massInverseBody2 * linearImpulse.y;
+            v2.z += mContactConstraints[c].massInverseBody2 * linearImpulse.z;
 
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * deltaLambda;
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * deltaLambda;
+            w2.x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * deltaLambda;
+            w2.y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * deltaLambda;
+            w2.z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * deltaLambda;
 
             sumPenetrationImpulse += mContactPoints[contactPointIndex].penetrationImpulse;
 
@@ -579,10 +1374,6 @@ void ContactSolverSystem::solve() {
             if (mIsSplitImpulseActive) {
 
                 // Split impulse (position correction)
-                const Vector3& v1Split = mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1];
-                const Vector3& w1Split = mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1];
-                const Vector3& v2Split = mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2];
-                const Vector3& w2Split = mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2];
 
                 //Vector3 deltaVSplit = v2Split + w2Split.cross(mContactPoints[contactPointIndex].r2) - v1Split - w1Split.cross(mContactPoints[contactPointIndex].r1);
                 Vector3 deltaVSplit(v2Split.x + w2Split.y * mContactPoints[contactPointIndex].r2.z - w2Split.z * mContactPoints[contactPointIndex].r2.y - v1Split.x -
@@ -607,22 +1398,22 @@ void ContactSolverSystem::solve() {
                                       mContactPoints[contactPointIndex].normal.z * deltaLambdaSplit);
 
                 // Update the velocities of the body 1 by applying the impulse P
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x;
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y;
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z;
+                v1Split.x -= mContactConstraints[c].massInverseBody1 * linearImpulse.x;
+                v1Split.y -= mContactConstraints[c].massInverseBody1 * linearImpulse.y;
+                v1Split.z -= mContactConstraints[c].massInverseBody1 * linearImpulse.z;
 
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * deltaLambdaSplit;
+                w1Split.x -= mContactPoints[contactPointIndex].i1TimesR1CrossN.x * deltaLambdaSplit;
+                w1Split.y -= mContactPoints[contactPointIndex].i1TimesR1CrossN.y * deltaLambdaSplit;
+                w1Split.z -= mContactPoints[contactPointIndex].i1TimesR1CrossN.z * deltaLambdaSplit;
 
                 // Update the velocities of the body 1 by applying the impulse P
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactConstraints[c].massInverseBody2 * linearImpulse.x;
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactConstraints[c].massInverseBody2 * linearImpulse.y;
-                mRigidBodyComponents.mSplitLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactConstraints[c].massInverseBody2 * linearImpulse.z;
+                v2Split.x += mContactConstraints[c].massInverseBody2 * linearImpulse.x;
+                v2Split.y += mContactConstraints[c].massInverseBody2 * linearImpulse.y;
+                v2Split.z += mContactConstraints[c].massInverseBody2 * linearImpulse.z;
 
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * deltaLambdaSplit;
-                mRigidBodyComponents.mSplitAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * deltaLambdaSplit;
+                w2Split.x += mContactPoints[contactPointIndex].i2TimesR2CrossN.x * deltaLambdaSplit;
+                w2Split.y += mContactPoints[contactPointIndex].i2TimesR2CrossN.y * deltaLambdaSplit;
+                w2Split.z += mContactPoints[contactPointIndex].i2TimesR2CrossN.z * deltaLambdaSplit;
             }
 
             contactPointIndex++;
@@ -665,18 +1456,18 @@ void ContactSolverSystem::solve() {
                                     mContactConstraints[c].r2CrossT1.z * deltaLambda);
 
         // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z;
+        v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x;
+        v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y;
+        v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z;
 
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1] += mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1;
+        w1 += mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1;
 
         // Update the velocities of the body 2 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z;
+        v2.x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x;
+        v2.y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y;
+        v2.z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z;
 
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2] += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
+        w2 += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
 
         // ------ Second friction constraint at the center of the contact manifold ----- //
 
@@ -714,16 +1505,16 @@ void ContactSolverSystem::solve() {
         angularImpulseBody2.z = mContactConstraints[c].r2CrossT2.z * deltaLambda;
 
         // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1].z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z;
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1] += mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1;
+        v1.x -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.x;
+        v1.y -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.y;
+        v1.z -= mContactConstraints[c].massInverseBody1 * linearImpulseBody2.z;
+        w1 += mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody1;
 
         // Update the velocities of the body 2 by applying the impulse P
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y;
-        mRigidBodyComponents.mConstrainedLinearVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2].z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z;
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2] += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
+        v2.x += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.x;
+        v2.y += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.y;
+        v2.z += mContactConstraints[c].massInverseBody2 * linearImpulseBody2.z;
+        w2 += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
 
         // ------ Twist friction constraint at the center of the contact manifol ------ //
 
@@ -746,10 +1537,10 @@ void ContactSolverSystem::solve() {
         angularImpulseBody2.z = mContactConstraints[c].normal.z * deltaLambda;
 
         // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1] -= mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2;
+        w1 -= mContactConstraints[c].inverseInertiaTensorBody1 * angularImpulseBody2;
 
         // Update the velocities of the body 1 by applying the impulse P
-        mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2] += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
+        w2 += mContactConstraints[c].inverseInertiaTensorBody2 * angularImpulseBody2;
 
         // --------- Rolling resistance constraint at the center of the contact manifold --------- //
 
@@ -767,14 +1558,280 @@ void ContactSolverSystem::solve() {
             deltaLambdaRolling = mContactConstraints[c].rollingResistanceImpulse - lambdaTempRolling;
 
             // Update the velocities of the body 1 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody1] -= mContactConstraints[c].inverseInertiaTensorBody1 * deltaLambdaRolling;
+            w1 -= mContactConstraints[c].inverseInertiaTensorBody1 * deltaLambdaRolling;
 
             // Update the velocities of the body 2 by applying the impulse P
-            mRigidBodyComponents.mConstrainedAngularVelocities[mContactConstraints[c].rigidBodyComponentIndexBody2] += mContactConstraints[c].inverseInertiaTensorBody2 * deltaLambdaRolling;
+            w2 += mContactConstraints[c].inverseInertiaTensorBody2 * deltaLambdaRolling;
+        }
+
+        // Write back the velocities of the bodies
+        if (!mContactConstraints[c].isBody1Static) {
+            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBodyIndex1] = v1;
+            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBodyIndex1] = w1;
+            mRigidBodyComponents.mSplitLinearVelocities[rigidBodyIndex1] = v1Split;
+            mRigidBodyComponents.mSplitAngularVelocities[rigidBodyIndex1] = w1Split;
+        }
+        if (!mContactConstraints[c].isBody2Static) {
+            mRigidBodyComponents.mConstrainedLinearVelocities[rigidBodyIndex2] = v2;
+            mRigidBodyComponents.mConstrainedAngularVelocities[rigidBodyIndex2] = w2;
+            mRigidBodyComponents.mSplitLinearVelocities[rigidBodyIndex2] = v2Split;
+            mRigidBodyComponents.mSplitAngularVelocities[rigidBodyIndex2] = w2Split;
         }
     }
 }
 
+// Solve the contact manifold batches in [startBatchIndex, endBatchIndex)
+/// This is the same computation as in solveContactManifolds() for the SIMD_WIDTH lanes of each
+/// batch at once (with the same operations order to get the same results).
+void ContactSolverSystem::solveContactBatches(uint startBatchIndex, uint endBatchIndex) {
+
+    const SimdDecimal zero = SimdDecimal::broadcast(decimal(0.0));
+
+    // For each batch of contact manifolds
+    for (uint b=startBatchIndex; b<endBatchIndex; b++) {
+
+        ContactManifoldBatchSolver& batch = mContactManifoldBatches[b];
+
+        // Get the constrained velocities and the split velocities of the bodies of each lane
+        SimdVector3 v1 = gatherVectors(mRigidBodyComponents.mConstrainedLinearVelocities, batch.rigidBodyComponentIndexBody1);
+        SimdVector3 w1 = gatherVectors(mRigidBodyComponents.mConstrainedAngularVelocities, batch.rigidBodyComponentIndexBody1);
+        SimdVector3 v2 = gatherVectors(mRigidBodyComponents.mConstrainedLinearVelocities, batch.rigidBodyComponentIndexBody2);
+        SimdVector3 w2 = gatherVectors(mRigidBodyComponents.mConstrainedAngularVelocities, batch.rigidBodyComponentIndexBody2);
+        SimdVector3 v1Split = gatherVectors(mRigidBodyComponents.mSplitLinearVelocities, batch.rigidBodyComponentIndexBody1);
+        SimdVector3 w1Split = gatherVectors(mRigidBodyComponents.mSplitAngularVelocities, batch.rigidBodyComponentIndexBody1);
+        SimdVector3 v2Split = gatherVectors(mRigidBodyComponents.mSplitLinearVelocities, batch.rigidBodyComponentIndexBody2);
+        SimdVector3 w2Split = gatherVectors(mRigidBodyComponents.mSplitAngularVelocities, batch.rigidBodyComponentIndexBody2);
+
+        const SimdDecimal massInverseBody1 = SimdDecimal::load(batch.massInverseBody1);
+        const SimdDecimal massInverseBody2 = SimdDecimal::load(batch.massInverseBody2);
+
+        SimdDecimal sumPenetrationImpulse = zero;
+
+        for (uint c=0; c<batch.nbContactPointBatches; c++) {
+
+            ContactPointBatchSolver& point = mContactPointBatches[batch.contactPointBatchesIndex + c];
+
+            const SimdVector3 normal = SimdVector3::load(point.normal);
+            const SimdVector3 r1 = SimdVector3::load(point.r1);
+            const SimdVector3 r2 = SimdVector3::load(point.r2);
+            const SimdVector3 i1TimesR1CrossN = SimdVector3::load(point.i1TimesR1CrossN);
+            const SimdVector3 i2TimesR2CrossN = SimdVector3::load(point.i2TimesR2CrossN);
+            const SimdDecimal inversePenetrationMass = SimdDecimal::load(point.inversePenetrationMass);
+            const SimdDecimal biasPenetrationDepth = SimdDecimal::load(point.biasPenetrationDepth);
+            const SimdDecimal restitutionBias = SimdDecimal::load(point.restitutionBias);
+
+            // --------- Penetration --------- //
+
+            // Compute J*v
+            const SimdDecimal Jv = (v2.x + w2.y * r2.z - w2.z * r2.y - v1.x - w1.y * r1.z + w1.z * r1.y) * normal.x +
+                                   (v2.y + w2.z * r2.x - w2.x * r2.z - v1.y - w1.z * r1.x + w1.x * r1.z) * normal.y +
+                                   (v2.z + w2.x * r2.y - w2.y * r2.x - v1.z - w1.x * r1.y + w1.y * r1.x) * normal.z;
+
+            // Compute the Lagrange multiplier lambda
+            SimdDecimal deltaLambda;
+            if (mIsSplitImpulseActive) {
+                deltaLambda = -(Jv + restitutionBias) * inversePenetrationMass;
+            }
+            else {
+                deltaLambda = -(Jv + (biasPenetrationDepth + restitutionBias)) * inversePenetrationMass;
+            }
+            const SimdDecimal lambdaTemp = SimdDecimal::load(point.penetrationImpulse);
+            const SimdDecimal penetrationImpulse = SimdDecimal::max(lambdaTemp + deltaLambda, zero);
+            penetrationImpulse.store(point.penetrationImpulse);
+            deltaLambda = penetrationImpulse - lambdaTemp;
+
+            // Update the velocities of the bodies by applying the impulse P
+            v1.x = v1.x - massInverseBody1 * (normal.x * deltaLambda);
+            v1.y = v1.y - massInverseBody1 * (normal.y * deltaLambda);
+            v1.z = v1.z - massInverseBody1 * (normal.z * deltaLambda);
+            w1.x = w1.x - i1TimesR1CrossN.x * deltaLambda;
+            w1.y = w1.y - i1TimesR1CrossN.y * deltaLambda;
+            w1.z = w1.z - i1TimesR1CrossN.z * deltaLambda;
+            v2.x = v2.x + massInverseBody2 * (normal.x * deltaLambda);
+            v2.y = v2.y + massInverseBody2 * (normal.y * deltaLambda);
+            v2.z = v2.z + massInverseBody2 * (normal.z * deltaLambda);
+            w2.x = w2.x + i2TimesR2CrossN.x * deltaLambda;
+            w2.y = w2.y + i2TimesR2CrossN.y * deltaLambda;
+            w2.z = w2.z + i2TimesR2CrossN.z * deltaLambda;
+
+            sumPenetrationImpulse = sumPenetrationImpulse + penetrationImpulse;
+
+            // If the split impulse position correction is active
+            if (mIsSplitImpulseActive) {
+
+                const SimdDecimal JvSplit = (v2Split.x + w2Split.y * r2.z - w2Split.z * r2.y - v1Split.x -
+                                             w1Split.y * r1.z + w1Split.z * r1.y) * normal.x +
+                                            (v2Split.y + w2Split.z * r2.x - w2Split.x * r2.z - v1Split.y -
+                                             w1Split.z * r1.x + w1Split.x * r1.z) * normal.y +
+                                            (v2Split.z + w2Split.x * r2.y - w2Split.y * r2.x - v1Split.z -
+                                             w1Split.x * r1.y + w1Split.y * r1.x) * normal.z;
+                SimdDecimal deltaLambdaSplit = -(JvSplit + biasPenetrationDepth) * inversePenetrationMass;
+                const SimdDecimal lambdaTempSplit = SimdDecimal::load(point.penetrationSplitImpulse);
+                const SimdDecimal penetrationSplitImpulse = SimdDecimal::max(lambdaTempSplit + deltaLambdaSplit, zero);
+                penetrationSplitImpulse.store(point.penetrationSplitImpulse);
+                deltaLambdaSplit = penetrationSplitImpulse - lambdaTempSplit;
+
+                v1Split.x = v1Split.x - massInverseBody1 * (normal.x * deltaLambdaSplit);
+                v1Split.y = v1Split.y - massInverseBody1 * (normal.y * deltaLambdaSplit);
+                v1Split.z = v1Split.z - massInverseBody1 * (normal.z * deltaLambdaSplit);
+                w1Split.x = w1Split.x - i1TimesR1CrossN.x * deltaLambdaSplit;
+                w1Split.y = w1Split.y - i1TimesR1CrossN.y * deltaLambdaSplit;
+                w1Split.z = w1Split.z - i1TimesR1CrossN.z * deltaLambdaSplit;
+                v2Split.x = v2Split.x + massInverseBody2 * (normal.x * deltaLambdaSplit);
+                v2Split.y = v2Split.y + massInverseBody2 * (normal.y * deltaLambdaSplit);
+                v2Split.z = v2Split.z + massInverseBody2 * (normal.z * deltaLambdaSplit);
+                w2Split.x = w2Split.x + i2TimesR2CrossN.x * deltaLambdaSplit;
+                w2Split.y = w2Split.y + i2TimesR2CrossN.y * deltaLambdaSplit;
+                w2Split.z = w2Split.z + i2TimesR2CrossN.z * deltaLambdaSplit;
+            }
+        }
+
+        const SimdVector3 r1Friction = SimdVector3::load(batch.r1Friction);
+        const SimdVector3 r2Friction = SimdVector3::load(batch.r2Friction);
+        const SimdDecimal frictionLimit = SimdDecimal::load(batch.frictionCoefficient) * sumPenetrationImpulse;
+
+        // ------ First and second friction constraints at the center of the contact manifold ------ //
+
+        for (int f=0; f < 2; f++) {
+
+            const SimdVector3 frictionVector = SimdVector3::load(f == 0 ? batch.frictionVector1 : batch.frictionVector2);
+            const SimdVector3 r1CrossT = SimdVector3::load(f == 0 ? batch.r1CrossT1 : batch.r1CrossT2);
+            const SimdVector3 r2CrossT = SimdVector3::load(f == 0 ? batch.r2CrossT1 : batch.r2CrossT2);
+            decimal* frictionImpulse = f == 0 ? batch.friction1Impulse : batch.friction2Impulse;
+
+            // Compute J*v
+            const SimdDecimal Jv = (v2.x + w2.y * r2Friction.z - w2.z * r2Friction.y - v1.x -
+                                    w1.y * r1Friction.z + w1.z * r1Friction.y) * frictionVector.x +
+                                   (v2.y + w2.z * r2Friction.x - w2.x * r2Friction.z - v1.y -
+                                    w1.z * r1Friction.x + w1.x * r1Friction.z) * frictionVector.y +
+                                   (v2.z + w2.x * r2Friction.y - w2.y * r2Friction.x - v1.z -
+                                    w1.x * r1Friction.y + w1.y * r1Friction.x) * frictionVector.z;
+
+            // Compute the Lagrange multiplier lambda
+            SimdDecimal deltaLambda = -Jv * SimdDecimal::load(f == 0 ? batch.inverseFriction1Mass : batch.inverseFriction2Mass);
+            const SimdDecimal lambdaTemp = SimdDecimal::load(frictionImpulse);
+            const SimdDecimal impulse = SimdDecimal::max(-frictionLimit, SimdDecimal::min(lambdaTemp + deltaLambda, frictionLimit));
+            impulse.store(frictionImpulse);
+            deltaLambda = impulse - lambdaTemp;
+
+            // Compute the impulse P=J^T * lambda
+            SimdVector3 angularImpulseBody1;
+            angularImpulseBody1.x = -r1CrossT.x * deltaLambda;
+            angularImpulseBody1.y = -r1CrossT.y * deltaLambda;
+            angularImpulseBody1.z = -r1CrossT.z * deltaLambda;
+            SimdVector3 angularImpulseBody2;
+            angularImpulseBody2.x = r2CrossT.x * deltaLambda;
+            angularImpulseBody2.y = r2CrossT.y * deltaLambda;
+            angularImpulseBody2.z = r2CrossT.z * deltaLambda;
+
+            // Update the velocities of the bodies by applying the impulse P
+            const SimdVector3 deltaW1 = multiply(batch.inverseInertiaTensorBody1, angularImpulseBody1);
+            const SimdVector3 deltaW2 = multiply(batch.inverseInertiaTensorBody2, angularImpulseBody2);
+            v1.x = v1.x - massInverseBody1 * (frictionVector.x * deltaLambda);
+            v1.y = v1.y - massInverseBody1 * (frictionVector.y * deltaLambda);
+            v1.z = v1.z - massInverseBody1 * (frictionVector.z * deltaLambda);
+            w1.x = w1.x + deltaW1.x;
+            w1.y = w1.y + deltaW1.y;
+            w1.z = w1.z + deltaW1.z;
+            v2.x = v2.x + massInverseBody2 * (frictionVector.x * deltaLambda);
+            v2.y = v2.y + massInverseBody2 * (frictionVector.y * deltaLambda);
+            v2.z = v2.z + massInverseBody2 * (frictionVector.z * deltaLambda);
+            w2.x = w2.x + deltaW2.x;
+            w2.y = w2.y + deltaW2.y;
+            w2.z = w2.z + deltaW2.z;
+        }
+
+        // ------ Twist friction constraint at the center of the contact manifol ------ //
+
+        const SimdVector3 normal = SimdVector3::load(batch.normal);
+
+        // Compute J*v
+        const SimdDecimal Jv = (w2.x - w1.x) * normal.x + (w2.y - w1.y) * normal.y + (w2.z - w1.z) * normal.z;
+
+        SimdDecimal deltaLambda = -Jv * SimdDecimal::load(batch.inverseTwistFrictionMass);
+        const SimdDecimal lambdaTemp = SimdDecimal::load(batch.frictionTwistImpulse);
+        const SimdDecimal twistImpulse = SimdDecimal::max(-frictionLimit, SimdDecimal::min(lambdaTemp + deltaLambda, frictionLimit));
+        twistImpulse.store(batch.frictionTwistImpulse);
+        deltaLambda = twistImpulse - lambdaTemp;
+
+        // Compute the impulse P=J^T * lambda
+        SimdVector3 angularImpulse;
+        angularImpulse.x = normal.x * deltaLambda;
+        angularImpulse.y = normal.y * deltaLambda;
+        angularImpulse.z = normal.z * deltaLambda;
+
+        // Update the velocities of the bodies by applying the impulse P
+        SimdVector3 deltaW1 = multiply(batch.inverseInertiaTensorBody1, angularImpulse);
+        SimdVector3 deltaW2 = multiply(batch.inverseInertiaTensorBody2, angularImpulse);
+        w1.x = w1.x - deltaW1.x;
+        w1.y = w1.y - deltaW1.y;
+        w1.z = w1.z - deltaW1.z;
+        w2.x = w2.x + deltaW2.x;
+        w2.y = w2.y + deltaW2.y;
+        w2.z = w2.z + deltaW2.z;
+
+        // --------- Rolling resistance constraint at the center of the contact manifold --------- //
+
+        // The lanes without rolling resistance have a zero inverse K matrix and limit and are not changed
+        if (batch.hasRollingResistance) {
+
+            // Compute J*v
+            SimdVector3 JvRolling;
+            JvRolling.x = -(w2.x - w1.x);
+            JvRolling.y = -(w2.y - w1.y);
+            JvRolling.z = -(w2.z - w1.z);
+
+            // Compute the Lagrange multiplier lambda
+            const SimdVector3 deltaLambdaRolling = multiply(batch.inverseRollingResistance, JvRolling);
+            const SimdDecimal rollingLimit = SimdDecimal::load(batch.rollingResistanceFactor) * sumPenetrationImpulse;
+            const SimdVector3 lambdaTempRolling = SimdVector3::load(batch.rollingResistanceImpulse);
+            SimdVector3 impulse;
+            impulse.x = lambdaTempRolling.x + deltaLambdaRolling.x;
+            impulse.y = lambdaTempRolling.y + deltaLambdaRolling.y;
+            impulse.z = lambdaTempRolling.z + deltaLambdaRolling.z;
+
+            // Clamp the length of the impulse to the limit (as clamp(const Vector3&, decimal))
+            const SimdDecimal lengthSquare = impulse.x * impulse.x + impulse.y * impulse.y + impulse.z * impulse.z;
+            const SimdDecimal length = SimdDecimal::sqrt(lengthSquare);
+            const SimdDecimal lengthInverse = SimdDecimal::broadcast(decimal(1.0)) / length;
+            const SimdDecimal epsilon = SimdDecimal::broadcast(MACHINE_EPSILON);
+            const SimdDecimal limitSquare = rollingLimit * rollingLimit;
+            impulse.x = SimdDecimal::selectLess(limitSquare, lengthSquare, SimdDecimal::selectLess(length, epsilon, impulse.x,
+                                                impulse.x * lengthInverse) * rollingLimit, impulse.x);
+            impulse.y = SimdDecimal::selectLess(limitSquare, lengthSquare, SimdDecimal::selectLess(length, epsilon, impulse.y,
+                                                impulse.y * lengthInverse) * rollingLimit, impulse.y);
+            impulse.z = SimdDecimal::selectLess(limitSquare, lengthSquare, SimdDecimal::selectLess(length, epsilon, impulse.z,
+                                                impulse.z * lengthInverse) * rollingLimit, impulse.z);
+            impulse.store(batch.rollingResistanceImpulse);
+
+            SimdVector3 deltaImpulse;
+            deltaImpulse.x = impulse.x - lambdaTempRolling.x;
+            deltaImpulse.y = impulse.y - lambdaTempRolling.y;
+            deltaImpulse.z = impulse.z - lambdaTempRolling.z;
+
+            // Update the velocities of the bodies by applying the impulse P
+            deltaW1 = multiply(batch.inverseInertiaTensorBody1, deltaImpulse);
+            deltaW2 = multiply(batch.inverseInertiaTensorBody2, deltaImpulse);
+            w1.x = w1.x - deltaW1.x;
+            w1.y = w1.y - deltaW1.y;
+            w1.z = w1.z - deltaW1.z;
+            w2.x = w2.x + deltaW2.x;
+            w2.y = w2.y + deltaW2.y;
+            w2.z = w2.z + deltaW2.z;
+        }
+
+        // Write back the velocities of the bodies (except static bodies and unused lanes)
+        scatterVectors(v1, mRigidBodyComponents.mConstrainedLinearVelocities, batch.rigidBodyComponentIndexBody1, batch.isBody1Written);
+        scatterVectors(w1, mRigidBodyComponents.mConstrainedAngularVelocities, batch.rigidBodyComponentIndexBody1, batch.isBody1Written);
+        scatterVectors(v1Split, mRigidBodyComponents.mSplitLinearVelocities, batch.rigidBodyComponentIndexBody1, batch.isBody1Written);
+        scatterVectors(w1Split, mRigidBodyComponents.mSplitAngularVelocities, batch.rigidBodyComponentIndexBody1, batch.isBody1Written);
+        scatterVectors(v2, mRigidBodyComponents.mConstrainedLinearVelocities, batch.rigidBodyComponentIndexBody2, batch.isBody2Written);
+        scatterVectors(w2, mRigidBodyComponents.mConstrainedAngularVelocities, batch.rigidBodyComponentIndexBody2, batch.isBody2Written);
+        scatterVectors(v2Split, mRigidBodyComponents.mSplitLinearVelocities, batch.rigidBodyComponentIndexBody2, batch.isBody2Written);
+        scatterVectors(w2Split, mRigidBodyComponents.mSplitAngularVelocities, batch.rigidBodyComponentIndexBody2, batch.isBody2Written);
+    }
+}
+
 // Compute the collision restitution factor from the restitution factor of each collider
 decimal ContactSolverSystem::computeMixedRestitutionFactor(Collider* collider1, Collider* collider2) const {
     decimal restitution1 = collider1->getMaterial().getBounciness();
@@ -803,6 +1860,10 @@ void ContactSolverSystem::storeImpulses() {
 
     RP3D_PROFILE("ContactSolver::storeImpulses()", mProfiler);
 
+    if (mContactManifoldBatches != nullptr) {
+        storeBatchImpulses();
+    }
+
     uint contactPointIndex = 0;
 
     // For each contact manifold
@@ -824,6 +1885,135 @@ void ContactSolverSystem::storeImpulses() {
     }
 }
 
+// Copy the impulses of the contact manifold batches back to the contact manifolds
+void ContactSolverSystem::storeBatchImpulses() {
+
+    for (uint b=0; b < mNbContactManifoldBatches; b++) {
+
+        const ContactManifoldBatchSolver& batch = mContactManifoldBatches[b];
+
+        for (uint lane=0; lane < batch.nbLanes; lane++) {
+
+            ContactManifoldSolver& manifold = mContactConstraints[batch.contactManifoldIndices[lane]];
+
+            for (int c=0; c < manifold.nbContacts; c++) {
+                mContactPoints[batch.contactPointIndices[lane] + c].penetrationImpulse =
+                        mContactPointBatches[batch.contactPointBatchesIndex + c].penetrationImpulse[lane];
+            }
+
+            manifold.friction1Impulse = batch.friction1Impulse[lane];
+            manifold.friction2Impulse = batch.friction2Impulse[lane];
+            manifold.frictionTwistImpulse = batch.frictionTwistImpulse[lane];
+            manifold.rollingResistanceImpulse.setAllValues(batch.rollingResistanceImpulse[0][lane],
+                                                           batch.rollingResistanceImpulse[1][lane],
+                                                           batch.rollingResistanceImpulse[2][lane]);
+        }
+    }
+}
+
+// Solve the contacts with both the SIMD and the scalar solvers and compare their impulses.
+/// This replaces init(), the solve() iterations, storeImpulses() and reset() of a step without joints.
+/// The contacts are first solved with the solver that is not enabled. The velocities of the bodies and
+/// the warm starting state of the contacts are then restored and the contacts are solved again with the
+/// enabled solver, so that the step has the same result as without the comparison. The accumulated
+/// impulses of both solvers are compared and the largest differences are kept in the parity.
+void ContactSolverSystem::solveWithParityCheck(List<ContactManifold>* contactManifolds, List<ContactPoint>* contactPoints,
+                                               decimal timeStep, uint nbIterations) {
+
+    RP3D_PROFILE("ContactSolverSystem::solveWithParityCheck()", mProfiler);
+
+    // Warm starting state of the contacts (impulses of the previous step and resting flags)
+    const List<ContactManifold> initialManifolds(*contactManifolds);
+    const List<ContactPoint> initialPoints(*contactPoints);
+
+    // Velocities of the bodies before the warm starting
+    const uint32 nbRigidBodies = mRigidBodyComponents.getNbComponents();
+    const size_t velocitiesSize = sizeof(Vector3) * nbRigidBodies * 4;
+    Vector3* velocities = static_cast<Vector3*>(mMemoryManager.allocate(MemoryManager::AllocationType::Frame, velocitiesSize));
+    std::copy(mRigidBodyComponents.mConstrainedLinearVelocities, mRigidBodyComponents.mConstrainedLinearVelocities + nbRigidBodies, velocities);
+    std::copy(mRigidBodyComponents.mConstrainedAngularVelocities, mRigidBodyComponents.mConstrainedAngularVelocities + nbRigidBodies, velocities + nbRigidBodies);
+    std::copy(mRigidBodyComponents.mSplitLinearVelocities, mRigidBodyComponents.mSplitLinearVelocities + nbRigidBodies, velocities + 2 * nbRigidBodies);
+    std::copy(mRigidBodyComponents.mSplitAngularVelocities, mRigidBodyComponents.mSplitAngularVelocities + nbRigidBodies, velocities + 3 * nbRigidBodies);
+
+    const bool isSimdSolverEnabled = mIsSimdSolverEnabled;
+
+    // Solve with the other solver and keep its impulses aside
+    mIsSimdSolverEnabled = !isSimdSolverEnabled;
+    init(contactManifolds, contactPoints, timeStep);
+    for (uint i=0; i < nbIterations; i++) {
+        solve();
+    }
+    storeImpulses();
+    reset();
+    const List<ContactManifold> otherManifolds(*contactManifolds);
+    const List<ContactPoint> otherPoints(*contactPoints);
+
+    // Restore the state before the other solver (storeImpulses() only writes the impulses and friction vectors of manifolds)
+    for (uint m=0; m < contactManifolds->size(); m++) {
+        ContactManifold& manifold = (*contactManifolds)[m];
+        const ContactManifold& initialManifold = initialManifolds[m];
+        manifold.frictionImpulse1 = initialManifold.frictionImpulse1;
+        manifold.frictionImpulse2 = initialManifold.frictionImpulse2;
+        manifold.frictionTwistImpulse = initialManifold.frictionTwistImpulse;
+        manifold.rollingResistanceImpulse = initialManifold.rollingResistanceImpulse;
+        manifold.frictionVector1 = initialManifold.frictionVector1;
+        manifold.frictionVector2 = initialManifold.frictionVector2;
+    }
+    for (uint c=0; c < contactPoints->size(); c++) {
+        (*contactPoints)[c] = initialPoints[c];
+    }
+    std::copy(velocities, velocities + nbRigidBodies, mRigidBodyComponents.mConstrainedLinearVelocities);
+    std::copy(velocities + nbRigidBodies, velocities + 2 * nbRigidBodies, mRigidBodyComponents.mConstrainedAngularVelocities);
+    std::copy(velocities + 2 * nbRigidBodies, velocities + 3 * nbRigidBodies, mRigidBodyComponents.mSplitLinearVelocities);
+    std::copy(velocities + 3 * nbRigidBodies, velocities + 4 * nbRigidBodies, mRigidBodyComponents.mSplitAngularVelocities);
+    mMemoryManager.release(MemoryManager::AllocationType::Frame, velocities, velocitiesSize);
+
+    // Solve with the enabled solver
+    mIsSimdSolverEnabled = isSimdSolverEnabled;
+    init(contactManifolds, contactPoints, timeStep);
+    for (uint i=0; i < nbIterations; i++) {
+        solve();
+    }
+    storeImpulses();
+    reset();
+
+    compareImpulses(otherManifolds, otherPoints);
+}
+
+// Compare the impulses stored in the contact manifolds and points with the ones of the other solver
+void ContactSolverSystem::compareImpulses(const List<ContactManifold>& otherManifolds, const List<ContactPoint>& otherPoints) {
+
+    for (uint m=0; m < mAllContactManifolds->size(); m++) {
+
+        const ContactManifold& manifold = (*mAllContactManifolds)[m];
+        const ContactManifold& otherManifold = otherManifolds[m];
+
+        mParity.maxFrictionImpulse = std::max(mParity.maxFrictionImpulse,
+                                              std::max(std::abs(manifold.frictionImpulse1), std::abs(manifold.frictionImpulse2)));
+        mParity.maxFrictionImpulseError = std::max(mParity.maxFrictionImpulseError,
+                                                   std::max(std::abs(manifold.frictionImpulse1 - otherManifold.frictionImpulse1),
+                                                            std::abs(manifold.frictionImpulse2 - otherManifold.frictionImpulse2)));
+        mParity.maxTwistImpulse = std::max(mParity.maxTwistImpulse, std::abs(manifold.frictionTwistImpulse));
+        mParity.maxTwistImpulseError = std::max(mParity.maxTwistImpulseError,
+                                                std::abs(manifold.frictionTwistImpulse - otherManifold.frictionTwistImpulse));
+        mParity.maxRollingResistanceImpulse = std::max(mParity.maxRollingResistanceImpulse,
+                                                       manifold.rollingResistanceImpulse.getAbsoluteVector().getMaxValue());
+        mParity.maxRollingResistanceImpulseError = std::max(mParity.maxRollingResistanceImpulseError,
+                                                            (manifold.rollingResistanceImpulse - otherManifold.rollingResistanceImpulse).getAbsoluteVector().getMaxValue());
+    }
+
+    for (uint c=0; c < mAllContactPoints->size(); c++) {
+
+        const decimal impulse = (*mAllContactPoints)[c].getPenetrationImpulse();
+        mParity.maxPenetrationImpulse = std::max(mParity.maxPenetrationImpulse, std::abs(impulse));
+        mParity.maxPenetrationImpulseError = std::max(mParity.maxPenetrationImpulseError,
+                                                      std::abs(impulse - otherPoints[c].getPenetrationImpulse()));
+    }
+
+    mParity.nbContactManifolds += mAllContactManifolds->size();
+    mParity.nbContactPoints += mAllContactPoints->size();
+}
+
 // Compute the two unit orthogonal vectors "t1" and "t2" that span the tangential friction plane
 // for a contact manifold. The two vectors have to be such that : t1 x t2 = contactNormal.
 void ContactSolverSystem::computeFrictionVectors(const Vector3& deltaVelocity, ContactManifoldSolver& contact) const {
@@ -27,27 +27,59 @@
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/body/RigidBody.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/systems/CollisionDetectionSystem.h>
+#include <reactphysics3d/utils/ThreadPool.h>
 
 using namespace reactphysics3d;
 
+// Static variables definition
+const uint32 DynamicsSystem::NB_COMPONENTS_PER_TASK = 1024;
+
 // Constructor
 DynamicsSystem::DynamicsSystem(PhysicsWorld& world, CollisionBodyComponents& collisionBodyComponents, RigidBodyComponents& rigidBodyComponents,
                                TransformComponents& transformComponents, ColliderComponents& colliderComponents, bool& isGravityEnabled, Vector3& gravity)
               :mWorld(world), mCollisionBodyComponents(collisionBodyComponents), mRigidBodyComponents(rigidBodyComponents), mTransformComponents(transformComponents), mColliderComponents(colliderComponents),
-               mIsGravityEnabled(isGravityEnabled), mGravity(gravity) {
+               mIsGravityEnabled(isGravityEnabled), mGravity(gravity), mThreadPool(nullptr) {
+
+}
+
+// Call functor(startIndex, endIndex) for ranges of [0, nbComponents) executed in parallel.
+/// Each task processes NB_COMPONENTS_PER_TASK consecutive components. With less components
+/// (or without worker threads), the functor is called once on the calling thread.
+template<typename Functor>
+void DynamicsSystem::runInParallel(uint32 nbComponents, const Functor& functor) {
 
+    if (mThreadPool == nullptr || nbComponents <= NB_COMPONENTS_PER_TASK) {
+        functor(0, nbComponents);
+        return;
+    }
+
+    const uint32 nbTasks = (nbComponents + NB_COMPONENTS_PER_TASK - 1) / NB_COMPONENTS_PER_TASK;
+    mThreadPool->parallelFor(nbTasks, [&functor, nbComponents](uint taskIndex) {
+        const uint32 startIndex = taskIndex * NB_COMPONENTS_PER_TASK;
+        functor(startIndex, std::min(startIndex + NB_COMPONENTS_PER_TASK, nbComponents));
+    });
 }
 
 // Integrate position and orientation of the rigid bodies.
 /// The positions and orientations of the bodies are integrated using
-/// the sympletic Euler time stepping scheme.
+/// the sympletic Euler time stepping scheme. The bodies do not depend on each
+/// other so they are integrated by ranges in parallel.
 void DynamicsSystem::integrateRigidBodiesPositions(decimal timeStep, bool isSplitImpulseActive) {
 
     RP3D_PROFILE("DynamicsSystem::integrateRigidBodiesPositions()", mProfiler);
 
+    runInParallel(mRigidBodyComponents.getNbEnabledComponents(), [this, timeStep, isSplitImpulseActive](uint32 startIndex, uint32 endIndex) {
+        integrateRigidBodiesPositions(startIndex, endIndex, timeStep, isSplitImpulseActive);
+    });
+}
+
+// Integrate the positions and orientations of the rigid bodies in [startIndex, endIndex)
+void DynamicsSystem::integrateRigidBodiesPositions(uint32 startIndex, uint32 endIndex, decimal timeStep, bool isSplitImpulseActive) {
+
     const decimal isSplitImpulseFactor = isSplitImpulseActive ? decimal(1.0) : decimal(0.0);
 
-    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
+    for (uint32 i=startIndex; i < endIndex; i++) {
 
         // Get the constrained velocity
         Vector3 newLinVelocity = mRigidBodyComponents.mConstrainedLinearVelocities[i];
@@ -69,12 +101,87 @@ void DynamicsSystem::integrateRigidBodiesPositions(decimal timeStep, bool isSpli
     }
 }
 
+// Stop the bodies with continuous collision detection at their time of impact.
+/// This method must be called after the integration of the positions (and the position correction of
+/// the joints), when the colliders are still at their position of the beginning of the step. Each collider
+/// of a dynamic body with continuous collision detection that moves more than half of its smallest extent
+/// is swept along the linear motion of the body (relative to the motion of the other bodies). If it hits
+/// something, the body is only moved to the time of impact (and pushed slightly inside the other body along
+/// the hit normal) and keeps its velocity. The next step then creates and solves the contact with the
+/// discrete collision detection. The collision detection already creates speculative contacts for most of
+/// these hits at the beginning of the step (see CollisionDetectionSystem::computeSpeculativeContact()),
+/// this catches the ones caused by a change of velocity during the step (forces, other contacts).
+void DynamicsSystem::solveContinuousCollisions(const CollisionDetectionSystem& collisionDetection) {
+
+    RP3D_PROFILE("DynamicsSystem::solveContinuousCollisions()", mProfiler);
+
+    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
+
+        if (!mRigidBodyComponents.mIsCCDEnabled[i] || mRigidBodyComponents.mBodyTypes[i] != BodyType::DYNAMIC) continue;
+
+        const Vector3& startPosition = mRigidBodyComponents.mCentersOfMassWorld[i];
+        const Vector3 translation = mRigidBodyComponents.mConstrainedPositions[i] - startPosition;
+        const decimal translationLengthSquare = translation.lengthSquare();
+        if (translationLengthSquare < MACHINE_EPSILON) continue;
+
+        decimal hitFraction = decimal(1.0);
+        Vector3 hitNormal;
+        Vector3 hitBodyTranslation;
+
+        // For each collider of the body
+        const List<Entity>& colliderEntities = mCollisionBodyComponents.getColliders(mRigidBodyComponents.mBodiesEntities[i]);
+        for (uint c=0; c < colliderEntities.size(); c++) {
+
+            // If the collider does not move more than half of its size, the discrete collision detection cannot miss a contact
+            Vector3 minBounds, maxBounds;
+            mColliderComponents.getCollisionShape(colliderEntities[c])->getLocalBounds(minBounds, maxBounds);
+            const decimal motionThreshold = decimal(0.5) * (maxBounds - minBounds).getMinValue();
+            if (translationLengthSquare <= motionThreshold * motionThreshold) continue;
+
+            decimal colliderHitFraction;
+            Vector3 colliderHitNormal;
+            Vector3 colliderHitBodyTranslation;
+            if (collisionDetection.computeTimeOfImpact(colliderEntities[c], colliderHitFraction, colliderHitNormal, colliderHitBodyTranslation) &&
+                colliderHitFraction < hitFraction) {
+                hitFraction = colliderHitFraction;
+                hitNormal = colliderHitNormal;
+                hitBodyTranslation = colliderHitBodyTranslation;
+            }
+        }
+
+        if (hitFraction < decimal(1.0)) {
+
+            // Move the body at the time of impact and then along with the body it has hit for the rest of the
+            // step, so that they still touch at the end of the step. Push it inside the other body along the
+            // normal (and not along the translation), so that they overlap even if the body hits at a grazing
+            // angle or right before the end of its translation.
+            mRigidBodyComponents.mConstrainedPositions[i] = startPosition + hitFraction * translation +
+                                                            (decimal(1.0) - hitFraction) * hitBodyTranslation -
+                                                            CCD_PENETRATION_DEPTH * hitNormal;
+        }
+    }
+}
+
 // Update the postion/orientation of the bodies
+/// The bodies are updated by ranges in parallel and then the colliders once all
+/// the transforms of the bodies are up to date.
 void DynamicsSystem::updateBodiesState() {
 
     RP3D_PROFILE("DynamicsSystem::updateBodiesState()", mProfiler);
 
-    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
+    runInParallel(mRigidBodyComponents.getNbEnabledComponents(), [this](uint32 startIndex, uint32 endIndex) {
+        updateBodiesState(startIndex, endIndex);
+    });
+
+    runInParallel(mColliderComponents.getNbEnabledComponents(), [this](uint32 startIndex, uint32 endIndex) {
+        updateCollidersState(startIndex, endIndex);
+    });
+}
+
+// Update the postion/orientation of the bodies in [startIndex, endIndex)
+void DynamicsSystem::updateBodiesState(uint32 startIndex, uint32 endIndex) {
+
+    for (uint32 i=startIndex; i < endIndex; i++) {
 
         // Update the linear and angular velocity of the body
         mRigidBodyComponents.mLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i];
@@ -84,21 +191,20 @@ void DynamicsSystem::updateBodiesState() {
         mRigidBodyComponents.mCentersOfMassWorld[i] = mRigidBodyComponents.mConstrainedPositions[i];
 
         // Update the orientation of the body
-        const Quaternion& constrainedOrientation = mRigidBodyComponents.mConstrainedOrientations[i];
-        mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]).setOrientation(constrainedOrientation.getUnit());
-    }
-
-    // Update the position of the body (using the new center of mass and new orientation)
-    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
-
         Transform& transform = mTransformComponents.getTransform(mRigidBodyComponents.mBodiesEntities[i]);
+        transform.setOrientation(mRigidBodyComponents.mConstrainedOrientations[i].getUnit());
+
+        // Update the position of the body (using the new center of mass and new orientation)
         const Vector3& centerOfMassWorld = mRigidBodyComponents.mCentersOfMassWorld[i];
         const Vector3& centerOfMassLocal = mRigidBodyComponents.mCentersOfMassLocal[i];
         transform.setPosition(centerOfMassWorld - transform.getOrientation() * centerOfMassLocal);
     }
+}
+
+// Update the local-to-world transform of the colliders in [startIndex, endIndex)
+void DynamicsSystem::updateCollidersState(uint32 startIndex, uint32 endIndex) {
 
-    // Update the local-to-world transform of the colliders
-    for (uint32 i=0; i < mColliderComponents.getNbEnabledComponents(); i++) {
+    for (uint32 i=startIndex; i < endIndex; i++) {
 
         // Update the local-to-world transform of the collider
         mColliderComponents.mLocalToWorldTransforms[i] = mTransformComponents.getTransform(mColliderComponents.mBodiesEntities[i]) *
@@ -110,66 +216,76 @@ void DynamicsSystem::updateBodiesState() {
 /// This method only set the temporary velocities but does not update
 /// the actual velocitiy of the bodies. The velocities updated in this method
 /// might violate the constraints and will be corrected in the constraint and
-/// contact solver.
+/// contact solver. The bodies are integrated by ranges in parallel.
 void DynamicsSystem::integrateRigidBodiesVelocities(decimal timeStep) {
 
     RP3D_PROFILE("DynamicsSystem::integrateRigidBodiesVelocities()", mProfiler);
 
-    // Reset the split velocities of the bodies
-    resetSplitVelocities();
+    runInParallel(mRigidBodyComponents.getNbEnabledComponents(), [this, timeStep](uint32 startIndex, uint32 endIndex) {
+        integrateRigidBodiesVelocities(startIndex, endIndex, timeStep);
+    });
+}
 
-    // Integration component velocities using force/torque
-    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
+// Integrate the velocities of the rigid bodies in [startIndex, endIndex).
+/// The split velocities are reset and the external forces, the gravity and the damping are
+/// applied to each body in a single pass over the components.
+void DynamicsSystem::integrateRigidBodiesVelocities(uint32 startIndex, uint32 endIndex, decimal timeStep) {
+
+    const bool isGravityEnabled = mIsGravityEnabled;
+
+    // Damping factors of the previous body and the corresponding damping over the time step
+    // (most bodies have the same damping so we avoid computing the same powers again)
+    decimal previousLinDampingFactor = decimal(0.0);
+    decimal previousAngDampingFactor = decimal(0.0);
+    decimal linearDamping = decimal(1.0);
+    decimal angularDamping = decimal(1.0);
 
-        assert(mRigidBodyComponents.mSplitLinearVelocities[i] == Vector3(0, 0, 0));
-        assert(mRigidBodyComponents.mSplitAngularVelocities[i] == Vector3(0, 0, 0));
+    for (uint32 i=startIndex; i < endIndex; i++) {
+
+        // Reset the split velocities of the body
+        mRigidBodyComponents.mSplitLinearVelocities[i].setToZero();
+        mRigidBodyComponents.mSplitAngularVelocities[i].setToZero();
 
         const Vector3& linearVelocity = mRigidBodyComponents.mLinearVelocities[i];
         const Vector3& angularVelocity = mRigidBodyComponents.mAngularVelocities[i];
 
         // Integrate the external force to get the new velocity of the body
-        mRigidBodyComponents.mConstrainedLinearVelocities[i] = linearVelocity + timeStep *
-                                                              mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mExternalForces[i];
-        mRigidBodyComponents.mConstrainedAngularVelocities[i] = angularVelocity + timeStep *
-                                                 RigidBody::getWorldInertiaTensorInverse(mWorld, mRigidBodyComponents.mBodiesEntities[i]) * mRigidBodyComponents.mExternalTorques[i];
-    }
+        Vector3 newLinVelocity = linearVelocity + timeStep * mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mExternalForces[i];
+        Vector3 newAngVelocity = angularVelocity + timeStep *
+                                 RigidBody::getWorldInertiaTensorInverse(mWorld, mRigidBodyComponents.mBodiesEntities[i]) * mRigidBodyComponents.mExternalTorques[i];
 
-    // Apply gravity force
-    if (mIsGravityEnabled) {
+        // If the gravity has to be applied to this rigid body
+        if (isGravityEnabled && mRigidBodyComponents.mIsGravityEnabled[i]) {
 
-        for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
-
-            // If the gravity has to be applied to this rigid body
-            if (mRigidBodyComponents.mIsGravityEnabled[i]) {
-
-                // Integrate the gravity force
-                mRigidBodyComponents.mConstrainedLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i] + timeStep *
-                                                                       mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mMasses[i] * mGravity;
-            }
+            // Integrate the gravity force
+            newLinVelocity = newLinVelocity + timeStep * mRigidBodyComponents.mInverseMasses[i] * mRigidBodyComponents.mMasses[i] * mGravity;
         }
-    }
-
-    // Apply the velocity damping
-    // Damping force : F_c = -c' * v (c=damping factor)
-    // Equation      : m * dv/dt = -c' * v
-    //                 => dv/dt = -c * v (with c=c'/m)
-    //                 => dv/dt + c * v = 0
-    // Solution      : v(t) = v0 * e^(-c * t)
-    //                 => v(t + dt) = v0 * e^(-c(t + dt))
-    //                              = v0 * e^(-ct) * e^(-c * dt)
-    //                              = v(t) * e^(-c * dt)
-    //                 => v2 = v1 * e^(-c * dt)
-    // Using Taylor Serie for e^(-x) : e^x ~ 1 + x + x^2/2! + ...
-    //                              => e^(-x) ~ 1 - x
-    //                 => v2 = v1 * (1 - c * dt)
-    for (uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
 
+        // Apply the velocity damping
+        // Damping force : F_c = -c' * v (c=damping factor)
+        // Equation      : m * dv/dt = -c' * v
+        //                 => dv/dt = -c * v (with c=c'/m)
+        //                 => dv/dt + c * v = 0
+        // Solution      : v(t) = v0 * e^(-c * t)
+        //                 => v(t + dt) = v0 * e^(-c(t + dt))
+        //                              = v0 * e^(-ct) * e^(-c * dt)
+        //                              = v(t) * e^(-c * dt)
+        //                 => v2 = v1 * e^(-c * dt)
+        // Using Taylor Serie for e^(-x) : e^x ~ 1 + x + x^2/2! + ...
+        //                              => e^(-x) ~ 1 - x
+        //                 => v2 = v1 * (1 - c * dt)
         const decimal linDampingFactor = mRigidBodyComponents.mLinearDampings[i];
         const decimal angDampingFactor = mRigidBodyComponents.mAngularDampings[i];
-        const decimal linearDamping = std::pow(decimal(1.0) - linDampingFactor, timeStep);
-        const decimal angularDamping = std::pow(decimal(1.0) - angDampingFactor, timeStep);
-        mRigidBodyComponents.mConstrainedLinearVelocities[i] = mRigidBodyComponents.mConstrainedLinearVelocities[i] * linearDamping;
-        mRigidBodyComponents.mConstrainedAngularVelocities[i] = mRigidBodyComponents.mConstrainedAngularVelocities[i] * angularDamping;
+        if (i == startIndex || linDampingFactor != previousLinDampingFactor) {
+            linearDamping = std::pow(decimal(1.0) - linDampingFactor, timeStep);
+            previousLinDampingFactor = linDampingFactor;
+        }
+        if (i == startIndex || angDampingFactor != previousAngDampingFactor) {
+            angularDamping = std::pow(decimal(1.0) - angDampingFactor, timeStep);
+            previousAngDampingFactor = angDampingFactor;
+        }
+        mRigidBodyComponents.mConstrainedLinearVelocities[i] = newLinVelocity * linearDamping;
+        mRigidBodyComponents.mConstrainedAngularVelocities[i] = newAngVelocity * angularDamping;
     }
 }
 
@@ -177,18 +293,10 @@ void DynamicsSystem::integrateRigidBodiesVelocities(decimal timeStep) {
 void DynamicsSystem::resetBodiesForceAndTorque() {
 
     // For each body of the world
-    for (uint32 i=0; i < mRigidBodyComponents.getNbComponents(); i++) {
-        mRigidBodyComponents.mExternalForces[i].setToZero();
-        mRigidBodyComponents.mExternalTorques[i].setToZero();
-    }
-}
-
-// Reset the split velocities of the bodies
-void DynamicsSystem::resetSplitVelocities() {
-
-    for(uint32 i=0; i < mRigidBodyComponents.getNbEnabledComponents(); i++) {
-        mRigidBodyComponents.mSplitLinearVelocities[i].setToZero();
-        mRigidBodyComponents.mSplitAngularVelocities[i].setToZero();
-    }
+    runInParallel(mRigidBodyComponents.getNbComponents(), [this](uint32 startIndex, uint32 endIndex) {
+        for (uint32 i=startIndex; i < endIndex; i++) {
+            mRigidBodyComponents.mExternalForces[i].setToZero();
+            mRigidBodyComponents.mExternalTorques[i].setToZero();
+        }
+    });
 }
-
@@ -203,46 +203,51 @@ void SolveBallAndSocketJointSystem::solveVelocityConstraint() {
 
     // For each joint component
     for (uint32 i=0; i < mBallAndSocketJointComponents.getNbEnabledComponents(); i++) {
+        solveVelocityConstraint(i);
+    }
+}
 
-        const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
+// Solve the velocity constraint of the joint with a given component index
+void SolveBallAndSocketJointSystem::solveVelocityConstraint(uint32 i) {
 
-        const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
-        const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
+    const Entity jointEntity = mBallAndSocketJointComponents.mJointEntities[i];
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
+    const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
-        const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
+    // Get the velocities
+    Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        // Compute J*v
-        const Vector3 Jv = v2 + w2.cross(mBallAndSocketJointComponents.mR2World[i]) - v1 - w1.cross(mBallAndSocketJointComponents.mR1World[i]);
+    const Matrix3x3& i1 = mBallAndSocketJointComponents.mI1[i];
+    const Matrix3x3& i2 = mBallAndSocketJointComponents.mI2[i];
 
-        // Compute the Lagrange multiplier lambda
-        const Vector3 deltaLambda = mBallAndSocketJointComponents.mInverseMassMatrix[i] * (-Jv - mBallAndSocketJointComponents.mBiasVector[i]);
-        mBallAndSocketJointComponents.mImpulse[i] += deltaLambda;
+    // Compute J*v
+    const Vector3 Jv = v2 + w2.cross(mBallAndSocketJointComponents.mR2World[i]) - v1 - w1.cross(mBallAndSocketJointComponents.mR1World[i]);
 
-        // Compute the impulse P=J^T * lambda for the body 1
-        const Vector3 linearImpulseBody1 = -deltaLambda;
-        const Vector3 angularImpulseBody1 = deltaLambda.cross(mBallAndSocketJointComponents.mR1World[i]);
+    // Compute the Lagrange multiplier lambda
+    const Vector3 deltaLambda = mBallAndSocketJointComponents.mInverseMassMatrix[i] * (-Jv - mBallAndSocketJointComponents.mBiasVector[i]);
+    mBallAndSocketJointComponents.mImpulse[i] += deltaLambda;
 
-        // Apply the impulse to the body 1
-        v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * linearImpulseBody1;
-        w1 += i1 * angularImpulseBody1;
+    // Compute the impulse P=J^T * lambda for the body 1
+    const Vector3 linearImpulseBody1 = -deltaLambda;
+    const Vector3 angularImpulseBody1 = deltaLambda.cross(mBallAndSocketJointComponents.mR1World[i]);
 
-        // Compute the impulse P=J^T * lambda for the body 2
-        const Vector3 angularImpulseBody2 = -deltaLambda.cross(mBallAndSocketJointComponents.mR2World[i]);
+    // Apply the impulse to the body 1
+    v1 += mRigidBodyComponents.mInverseMasses[componentIndexBody1] * linearImpulseBody1;
+    w1 += i1 * angularImpulseBody1;
 
-        // Apply the impulse to the body 2
-        v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * deltaLambda;
-        w2 += i2 * angularImpulseBody2;
-    }
+    // Compute the impulse P=J^T * lambda for the body 2
+    const Vector3 angularImpulseBody2 = -deltaLambda.cross(mBallAndSocketJointComponents.mR2World[i]);
+
+    // Apply the impulse to the body 2
+    v2 += mRigidBodyComponents.mInverseMasses[componentIndexBody2] * deltaLambda;
+    w2 += i2 * angularImpulseBody2;
 }
 
 // Solve the position constraint (for position error correction)
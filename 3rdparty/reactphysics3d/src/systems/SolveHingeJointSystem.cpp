@@ -358,169 +358,174 @@ void SolveHingeJointSystem::solveVelocityConstraint() {
 
     // For each joint component
     for (uint32 i=0; i < mHingeJointComponents.getNbEnabledComponents(); i++) {
+        solveVelocityConstraint(i);
+    }
+}
 
-        const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
+// Solve the velocity constraint of the joint with a given component index
+void SolveHingeJointSystem::solveVelocityConstraint(uint32 i) {
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
-        const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
+    const Entity jointEntity = mHingeJointComponents.mJointEntities[i];
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
+    const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Get the velocities
+    Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        const Matrix3x3& i1 = mHingeJointComponents.mI1[i];
-        const Matrix3x3& i2 = mHingeJointComponents.mI2[i];
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        const Vector3& r1World = mHingeJointComponents.mR1World[i];
-        const Vector3& r2World = mHingeJointComponents.mR2World[i];
+    const Matrix3x3& i1 = mHingeJointComponents.mI1[i];
+    const Matrix3x3& i2 = mHingeJointComponents.mI2[i];
 
-        const Vector3& a1 = mHingeJointComponents.mA1[i];
+    const Vector3& r1World = mHingeJointComponents.mR1World[i];
+    const Vector3& r2World = mHingeJointComponents.mR2World[i];
 
-        const decimal inverseMassMatrixLimitMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i];
+    const Vector3& a1 = mHingeJointComponents.mA1[i];
 
-        // --------------- Translation Constraints --------------- //
+    const decimal inverseMassMatrixLimitMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i];
 
-        // Compute J*v
-        const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
+    // --------------- Translation Constraints --------------- //
 
-        // Compute the Lagrange multiplier lambda
-        const Vector3 deltaLambdaTranslation = mHingeJointComponents.mInverseMassMatrixTranslation[i] *
-                                               (-JvTranslation - mHingeJointComponents.mBiasTranslation[i]);
-        mHingeJointComponents.mImpulseTranslation[i] += deltaLambdaTranslation;
+    // Compute J*v
+    const Vector3 JvTranslation = v2 + w2.cross(r2World) - v1 - w1.cross(r1World);
 
-        // Compute the impulse P=J^T * lambda of body 1
-        const Vector3 linearImpulseBody1 = -deltaLambdaTranslation;
-        Vector3 angularImpulseBody1 = deltaLambdaTranslation.cross(r1World);
+    // Compute the Lagrange multiplier lambda
+    const Vector3 deltaLambdaTranslation = mHingeJointComponents.mInverseMassMatrixTranslation[i] *
+                                           (-JvTranslation - mHingeJointComponents.mBiasTranslation[i]);
+    mHingeJointComponents.mImpulseTranslation[i] += deltaLambdaTranslation;
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * linearImpulseBody1;
-        w1 += i1 * angularImpulseBody1;
+    // Compute the impulse P=J^T * lambda of body 1
+    const Vector3 linearImpulseBody1 = -deltaLambdaTranslation;
+    Vector3 angularImpulseBody1 = deltaLambdaTranslation.cross(r1World);
 
-        // Compute the impulse P=J^T * lambda of body 2
-        Vector3 angularImpulseBody2 = -deltaLambdaTranslation.cross(r2World);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * linearImpulseBody1;
+    w1 += i1 * angularImpulseBody1;
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * deltaLambdaTranslation;
-        w2 += i2 * angularImpulseBody2;
+    // Compute the impulse P=J^T * lambda of body 2
+    Vector3 angularImpulseBody2 = -deltaLambdaTranslation.cross(r2World);
 
-        // --------------- Rotation Constraints --------------- //
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * deltaLambdaTranslation;
+    w2 += i2 * angularImpulseBody2;
 
-        const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
-        const Vector3& c2CrossA1 = mHingeJointComponents.mC2CrossA1[i];
+    // --------------- Rotation Constraints --------------- //
 
-        // Compute J*v for the 2 rotation constraints
-        const Vector2 JvRotation(-b2CrossA1.dot(w1) + b2CrossA1.dot(w2),
-                                 -c2CrossA1.dot(w1) + c2CrossA1.dot(w2));
+    const Vector3& b2CrossA1 = mHingeJointComponents.mB2CrossA1[i];
+    const Vector3& c2CrossA1 = mHingeJointComponents.mC2CrossA1[i];
 
-        // Compute the Lagrange multiplier lambda for the 2 rotation constraints
-        Vector2 deltaLambdaRotation = mHingeJointComponents.mInverseMassMatrixRotation[i] *
-                                      (-JvRotation - mHingeJointComponents.mBiasRotation[i]);
-        mHingeJointComponents.mImpulseRotation[i] += deltaLambdaRotation;
+    // Compute J*v for the 2 rotation constraints
+    const Vector2 JvRotation(-b2CrossA1.dot(w1) + b2CrossA1.dot(w2),
+                             -c2CrossA1.dot(w1) + c2CrossA1.dot(w2));
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
-        angularImpulseBody1 = -b2CrossA1 * deltaLambdaRotation.x - c2CrossA1 * deltaLambdaRotation.y;
+    // Compute the Lagrange multiplier lambda for the 2 rotation constraints
+    Vector2 deltaLambdaRotation = mHingeJointComponents.mInverseMassMatrixRotation[i] *
+                                  (-JvRotation - mHingeJointComponents.mBiasRotation[i]);
+    mHingeJointComponents.mImpulseRotation[i] += deltaLambdaRotation;
 
-        // Apply the impulse to the body 1
-        w1 += i1 * angularImpulseBody1;
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 1
+    angularImpulseBody1 = -b2CrossA1 * deltaLambdaRotation.x - c2CrossA1 * deltaLambdaRotation.y;
 
-        // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
-        angularImpulseBody2 = b2CrossA1 * deltaLambdaRotation.x + c2CrossA1 * deltaLambdaRotation.y;
+    // Apply the impulse to the body 1
+    w1 += i1 * angularImpulseBody1;
 
-        // Apply the impulse to the body 2
-        w2 += i2 * angularImpulseBody2;
+    // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
+    angularImpulseBody2 = b2CrossA1 * deltaLambdaRotation.x + c2CrossA1 * deltaLambdaRotation.y;
 
-        // --------------- Limits Constraints --------------- //
+    // Apply the impulse to the body 2
+    w2 += i2 * angularImpulseBody2;
 
-        if (mHingeJointComponents.mIsLimitEnabled[i]) {
+    // --------------- Limits Constraints --------------- //
 
-            // If the lower limit is violated
-            if (mHingeJointComponents.mIsLowerLimitViolated[i]) {
+    if (mHingeJointComponents.mIsLimitEnabled[i]) {
 
-                // Compute J*v for the lower limit constraint
-                const decimal JvLowerLimit = (w2 - w1).dot(a1);
+        // If the lower limit is violated
+        if (mHingeJointComponents.mIsLowerLimitViolated[i]) {
 
-                // Compute the Lagrange multiplier lambda for the lower limit constraint
-                decimal deltaLambdaLower = inverseMassMatrixLimitMotor * (-JvLowerLimit -mHingeJointComponents.mBLowerLimit[i]);
-                decimal lambdaTemp = mHingeJointComponents.mImpulseLowerLimit[i];
-                mHingeJointComponents.mImpulseLowerLimit[i] = std::max(mHingeJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
-                deltaLambdaLower = mHingeJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
+            // Compute J*v for the lower limit constraint
+            const decimal JvLowerLimit = (w2 - w1).dot(a1);
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
-                const Vector3 angularImpulseBody1 = -deltaLambdaLower * a1;
+            // Compute the Lagrange multiplier lambda for the lower limit constraint
+            decimal deltaLambdaLower = inverseMassMatrixLimitMotor * (-JvLowerLimit -mHingeJointComponents.mBLowerLimit[i]);
+            decimal lambdaTemp = mHingeJointComponents.mImpulseLowerLimit[i];
+            mHingeJointComponents.mImpulseLowerLimit[i] = std::max(mHingeJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
+            deltaLambdaLower = mHingeJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
 
-                // Apply the impulse to the body 1
-                w1 += i1 * angularImpulseBody1;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
+            const Vector3 angularImpulseBody1 = -deltaLambdaLower * a1;
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
-                const Vector3 angularImpulseBody2 = deltaLambdaLower * a1;
+            // Apply the impulse to the body 1
+            w1 += i1 * angularImpulseBody1;
 
-                // Apply the impulse to the body 2
-                w2 += i2 * angularImpulseBody2;
-            }
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
+            const Vector3 angularImpulseBody2 = deltaLambdaLower * a1;
 
-            // If the upper limit is violated
-            if (mHingeJointComponents.mIsUpperLimitViolated[i]) {
+            // Apply the impulse to the body 2
+            w2 += i2 * angularImpulseBody2;
+        }
 
-                // Compute J*v for the upper limit constraint
-                const decimal JvUpperLimit = -(w2 - w1).dot(a1);
+        // If the upper limit is violated
+        if (mHingeJointComponents.mIsUpperLimitViolated[i]) {
 
-                // Compute the Lagrange multiplier lambda for the upper limit constraint
-                decimal deltaLambdaUpper = inverseMassMatrixLimitMotor * (-JvUpperLimit -mHingeJointComponents.mBUpperLimit[i]);
-                decimal lambdaTemp = mHingeJointComponents.mImpulseUpperLimit[i];
-                mHingeJointComponents.mImpulseUpperLimit[i] = std::max(mHingeJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
-                deltaLambdaUpper = mHingeJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
+            // Compute J*v for the upper limit constraint
+            const decimal JvUpperLimit = -(w2 - w1).dot(a1);
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
-                const Vector3 angularImpulseBody1 = deltaLambdaUpper * a1;
+            // Compute the Lagrange multiplier lambda for the upper limit constraint
+            decimal deltaLambdaUpper = inverseMassMatrixLimitMotor * (-JvUpperLimit -mHingeJointComponents.mBUpperLimit[i]);
+            decimal lambdaTemp = mHingeJointComponents.mImpulseUpperLimit[i];
+            mHingeJointComponents.mImpulseUpperLimit[i] = std::max(mHingeJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
+            deltaLambdaUpper = mHingeJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
 
-                // Apply the impulse to the body 1
-                w1 += i1 * angularImpulseBody1;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
+            const Vector3 angularImpulseBody1 = deltaLambdaUpper * a1;
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
-                const Vector3 angularImpulseBody2 = -deltaLambdaUpper * a1;
+            // Apply the impulse to the body 1
+            w1 += i1 * angularImpulseBody1;
 
-                // Apply the impulse to the body 2
-                w2 += i2 * angularImpulseBody2;
-            }
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
+            const Vector3 angularImpulseBody2 = -deltaLambdaUpper * a1;
+
+            // Apply the impulse to the body 2
+            w2 += i2 * angularImpulseBody2;
         }
+    }
 
-        // --------------- Motor --------------- //
+    // --------------- Motor --------------- //
 
-        // If the motor is enabled
-        if (mHingeJointComponents.mIsMotorEnabled[i]) {
+    // If the motor is enabled
+    if (mHingeJointComponents.mIsMotorEnabled[i]) {
 
-            // Compute J*v for the motor
-            const decimal JvMotor = a1.dot(w1 - w2);
+        // Compute J*v for the motor
+        const decimal JvMotor = a1.dot(w1 - w2);
 
-            // Compute the Lagrange multiplier lambda for the motor
-            const decimal maxMotorImpulse = mHingeJointComponents.mMaxMotorTorque[i] * mTimeStep;
-            decimal deltaLambdaMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i] * (-JvMotor - mHingeJointComponents.mMotorSpeed[i]);
-            decimal lambdaTemp = mHingeJointComponents.mImpulseMotor[i];
-            mHingeJointComponents.mImpulseMotor[i] = clamp(mHingeJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
-            deltaLambdaMotor = mHingeJointComponents.mImpulseMotor[i] - lambdaTemp;
+        // Compute the Lagrange multiplier lambda for the motor
+        const decimal maxMotorImpulse = mHingeJointComponents.mMaxMotorTorque[i] * mTimeStep;
+        decimal deltaLambdaMotor = mHingeJointComponents.mInverseMassMatrixLimitMotor[i] * (-JvMotor - mHingeJointComponents.mMotorSpeed[i]);
+        decimal lambdaTemp = mHingeJointComponents.mImpulseMotor[i];
+        mHingeJointComponents.mImpulseMotor[i] = clamp(mHingeJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
+        deltaLambdaMotor = mHingeJointComponents.mImpulseMotor[i] - lambdaTemp;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 1
-            const Vector3 angularImpulseBody1 = -deltaLambdaMotor * a1;
+        // Compute the impulse P=J^T * lambda for the motor of body 1
+        const Vector3 angularImpulseBody1 = -deltaLambdaMotor * a1;
 
-            // Apply the impulse to the body 1
-            w1 += i1 * angularImpulseBody1;
+        // Apply the impulse to the body 1
+        w1 += i1 * angularImpulseBody1;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 2
-            const Vector3 angularImpulseBody2 = deltaLambdaMotor * a1;
+        // Compute the impulse P=J^T * lambda for the motor of body 2
+        const Vector3 angularImpulseBody2 = deltaLambdaMotor * a1;
 
-            // Apply the impulse to the body 2
-            w2 += i2 * angularImpulseBody2;
-        }
+        // Apply the impulse to the body 2
+        w2 += i2 * angularImpulseBody2;
     }
 }
 
@@ -381,226 +381,249 @@ void SolveSliderJointSystem::solveVelocityConstraint() {
 
     // For each joint component
     for (uint32 i=0; i < mSliderJointComponents.getNbEnabledComponents(); i++) {
+        solveTranslationVelocityConstraint(i);
+    }
 
-        const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
+    // For each joint component
+    for (uint32 i=0; i < mSliderJointComponents.getNbEnabledComponents(); i++) {
+        solveRotationVelocityConstraint(i);
+    }
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
-        const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
+    // For each joint component
+    for (uint32 i=0; i < mSliderJointComponents.getNbEnabledComponents(); i++) {
+        solveLimitsAndMotorVelocityConstraint(i);
+    }
+}
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+// Solve the velocity constraint of the joint with a given component index
+void SolveSliderJointSystem::solveVelocityConstraint(uint32 i) {
 
-        // Get the velocities
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    solveTranslationVelocityConstraint(i);
+    solveRotationVelocityConstraint(i);
+    solveLimitsAndMotorVelocityConstraint(i);
+}
 
-        const Matrix3x3& i1 = mSliderJointComponents.mI1[i];
-        const Matrix3x3& i2 = mSliderJointComponents.mI2[i];
+// Solve the velocity of the translation constraints of the joint with a given component index
+void SolveSliderJointSystem::solveTranslationVelocityConstraint(uint32 i) {
 
-        const Vector3& n1 = mSliderJointComponents.mN1[i];
-        const Vector3& n2 = mSliderJointComponents.mN2[i];
+    const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
 
-        const Vector3& r2CrossN1 = mSliderJointComponents.mR2CrossN1[i];
-        const Vector3& r2CrossN2 = mSliderJointComponents.mR2CrossN2[i];
-        const Vector3& r1PlusUCrossN1 = mSliderJointComponents.mR1PlusUCrossN1[i];
-        const Vector3& r1PlusUCrossN2 = mSliderJointComponents.mR1PlusUCrossN2[i];
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
+    const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
 
-        // Get the inverse mass and inverse inertia tensors of the bodies
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // --------------- Translation Constraints --------------- //
+    // Get the velocities
+    Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        // Compute J*v for the 2 translation constraints
-        const decimal el1 = -n1.dot(v1) - w1.dot(r1PlusUCrossN1) +
-                             n1.dot(v2) + w2.dot(r2CrossN1);
-        const decimal el2 = -n2.dot(v1) - w1.dot(r1PlusUCrossN2) +
-                             n2.dot(v2) + w2.dot(r2CrossN2);
-        const Vector2 JvTranslation(el1, el2);
+    const Matrix3x3& i1 = mSliderJointComponents.mI1[i];
+    const Matrix3x3& i2 = mSliderJointComponents.mI2[i];
 
-        // Compute the Lagrange multiplier lambda for the 2 translation constraints
-        Vector2 deltaLambda = mSliderJointComponents.mInverseMassMatrixTranslation[i] * (-JvTranslation - mSliderJointComponents.mBiasTranslation[i]);
-        mSliderJointComponents.mImpulseTranslation[i] += deltaLambda;
+    const Vector3& n1 = mSliderJointComponents.mN1[i];
+    const Vector3& n2 = mSliderJointComponents.mN2[i];
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
-        const Vector3 linearImpulseBody1 = -n1 * deltaLambda.x - n2 * deltaLambda.y;
-        Vector3 angularImpulseBody1 = -r1PlusUCrossN1 * deltaLambda.x -
-                r1PlusUCrossN2 * deltaLambda.y;
+    const Vector3& r2CrossN1 = mSliderJointComponents.mR2CrossN1[i];
+    const Vector3& r2CrossN2 = mSliderJointComponents.mR2CrossN2[i];
+    const Vector3& r1PlusUCrossN1 = mSliderJointComponents.mR1PlusUCrossN1[i];
+    const Vector3& r1PlusUCrossN2 = mSliderJointComponents.mR1PlusUCrossN2[i];
 
-        // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * linearImpulseBody1;
-        w1 += i1 * angularImpulseBody1;
+    // Get the inverse mass and inverse inertia tensors of the bodies
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-        // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
-        const Vector3 linearImpulseBody2 = n1 * deltaLambda.x + n2 * deltaLambda.y;
-        Vector3 angularImpulseBody2 = r2CrossN1 * deltaLambda.x + r2CrossN2 * deltaLambda.y;
+    // --------------- Translation Constraints --------------- //
 
-        // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * linearImpulseBody2;
-        w2 += i2 * angularImpulseBody2;
-    }
+    // Compute J*v for the 2 translation constraints
+    const decimal el1 = -n1.dot(v1) - w1.dot(r1PlusUCrossN1) +
+                         n1.dot(v2) + w2.dot(r2CrossN1);
+    const decimal el2 = -n2.dot(v1) - w1.dot(r1PlusUCrossN2) +
+                         n2.dot(v2) + w2.dot(r2CrossN2);
+    const Vector2 JvTranslation(el1, el2);
 
-    // For each joint component
-    for (uint32 i=0; i < mSliderJointComponents.getNbEnabledComponents(); i++) {
+    // Compute the Lagrange multiplier lambda for the 2 translation constraints
+    Vector2 deltaLambda = mSliderJointComponents.mInverseMassMatrixTranslation[i] * (-JvTranslation - mSliderJointComponents.mBiasTranslation[i]);
+    mSliderJointComponents.mImpulseTranslation[i] += deltaLambda;
 
-        const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 1
+    const Vector3 linearImpulseBody1 = -n1 * deltaLambda.x - n2 * deltaLambda.y;
+    Vector3 angularImpulseBody1 = -r1PlusUCrossN1 * deltaLambda.x -
+            r1PlusUCrossN2 * deltaLambda.y;
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
-        const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
+    // Apply the impulse to the body 1
+    v1 += inverseMassBody1 * linearImpulseBody1;
+    w1 += i1 * angularImpulseBody1;
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
+    const Vector3 linearImpulseBody2 = n1 * deltaLambda.x + n2 * deltaLambda.y;
+    Vector3 angularImpulseBody2 = r2CrossN1 * deltaLambda.x + r2CrossN2 * deltaLambda.y;
 
-        // --------------- Rotation Constraints --------------- //
+    // Apply the impulse to the body 2
+    v2 += inverseMassBody2 * linearImpulseBody2;
+    w2 += i2 * angularImpulseBody2;
+}
 
-        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+// Solve the velocity of the rotation constraints of the joint with a given component index
+void SolveSliderJointSystem::solveRotationVelocityConstraint(uint32 i) {
 
-        // Compute J*v for the 3 rotation constraints
-        const Vector3 JvRotation = w2 - w1;
+    const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
 
-        // Compute the Lagrange multiplier lambda for the 3 rotation constraints
-        Vector3 deltaLambda2 = mSliderJointComponents.mInverseMassMatrixRotation[i] *
-                               (-JvRotation - mSliderJointComponents.getBiasRotation(jointEntity));
-        mSliderJointComponents.mImpulseRotation[i] += deltaLambda2;
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
+    const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
-        Vector3 angularImpulseBody1 = -deltaLambda2;
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-        // Apply the impulse to the body to body 1
-        w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
+    // --------------- Rotation Constraints --------------- //
 
-        // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
-        Vector3 angularImpulseBody2 = deltaLambda2;
+    Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+    Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-        // Apply the impulse to the body 2
-        w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
-    }
-
-    // For each joint component
-    for (uint32 i=0; i < mSliderJointComponents.getNbEnabledComponents(); i++) {
-
-        const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
+    // Compute J*v for the 3 rotation constraints
+    const Vector3 JvRotation = w2 - w1;
 
-        // Get the bodies entities
-        const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
-        const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
+    // Compute the Lagrange multiplier lambda for the 3 rotation constraints
+    Vector3 deltaLambda2 = mSliderJointComponents.mInverseMassMatrixRotation[i] *
+                           (-JvRotation - mSliderJointComponents.getBiasRotation(jointEntity));
+    mSliderJointComponents.mImpulseRotation[i] += deltaLambda2;
 
-        const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
-        const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 1
+    Vector3 angularImpulseBody1 = -deltaLambda2;
 
-        Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
-        Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
+    // Apply the impulse to the body to body 1
+    w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
 
-        decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
-        decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
+    // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
+    Vector3 angularImpulseBody2 = deltaLambda2;
 
-        const Vector3& r2CrossSliderAxis = mSliderJointComponents.mR2CrossSliderAxis[i];
-        const Vector3& r1PlusUCrossSliderAxis = mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
+    // Apply the impulse to the body 2
+    w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
+}
 
-        const Vector3& sliderAxisWorld = mSliderJointComponents.mSliderAxisWorld[i];
+// Solve the velocity of the limits and motor constraints of the joint with a given component index
+void SolveSliderJointSystem::solveLimitsAndMotorVelocityConstraint(uint32 i) {
 
-        // --------------- Limits Constraints --------------- //
+    const Entity jointEntity = mSliderJointComponents.mJointEntities[i];
 
-        if (mSliderJointComponents.mIsLimitEnabled[i]) {
+    // Get the bodies entities
+    const Entity body1Entity = mJointComponents.getBody1Entity(jointEntity);
+    const Entity body2Entity = mJointComponents.getBody2Entity(jointEntity);
 
-            Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
-            Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
+    const uint32 componentIndexBody1 = mRigidBodyComponents.getEntityIndex(body1Entity);
+    const uint32 componentIndexBody2 = mRigidBodyComponents.getEntityIndex(body2Entity);
 
-            const decimal inverseMassMatrixLimit = mSliderJointComponents.mInverseMassMatrixLimit[i];
+    Vector3& v1 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody1];
+    Vector3& v2 = mRigidBodyComponents.mConstrainedLinearVelocities[componentIndexBody2];
 
-            // If the lower limit is violated
-            if (mSliderJointComponents.mIsLowerLimitViolated[i]) {
+    decimal inverseMassBody1 = mRigidBodyComponents.mInverseMasses[componentIndexBody1];
+    decimal inverseMassBody2 = mRigidBodyComponents.mInverseMasses[componentIndexBody2];
 
-                // Compute J*v for the lower limit constraint
-                const decimal JvLowerLimit = sliderAxisWorld.dot(v2) + r2CrossSliderAxis.dot(w2) -
-                                             sliderAxisWorld.dot(v1) - r1PlusUCrossSliderAxis.dot(w1);
+    const Vector3& r2CrossSliderAxis = mSliderJointComponents.mR2CrossSliderAxis[i];
+    const Vector3& r1PlusUCrossSliderAxis = mSliderJointComponents.mR1PlusUCrossSliderAxis[i];
 
-                // Compute the Lagrange multiplier lambda for the lower limit constraint
-                decimal deltaLambdaLower = inverseMassMatrixLimit * (-JvLowerLimit - mSliderJointComponents.mBLowerLimit[i]);
-                decimal lambdaTemp = mSliderJointComponents.mImpulseLowerLimit[i];
-                mSliderJointComponents.mImpulseLowerLimit[i] = std::max(mSliderJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
-                deltaLambdaLower = mSliderJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
+    const Vector3& sliderAxisWorld = mSliderJointComponents.mSliderAxisWorld[i];
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
-                const Vector3 linearImpulseBody1 = -deltaLambdaLower * sliderAxisWorld;
-                const Vector3 angularImpulseBody1 = -deltaLambdaLower * r1PlusUCrossSliderAxis;
+    // --------------- Limits Constraints --------------- //
 
-                // Apply the impulse to the body 1
-                v1 += inverseMassBody1 * linearImpulseBody1;
-                w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
+    if (mSliderJointComponents.mIsLimitEnabled[i]) {
 
-                // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
-                const Vector3 linearImpulseBody2 = deltaLambdaLower * sliderAxisWorld;
-                const Vector3 angularImpulseBody2 = deltaLambdaLower * r2CrossSliderAxis;
+        Vector3& w1 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody1];
+        Vector3& w2 = mRigidBodyComponents.mConstrainedAngularVelocities[componentIndexBody2];
 
-                // Apply the impulse to the body 2
-                v2 += inverseMassBody2 * linearImpulseBody2;
-                w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
-            }
+        const decimal inverseMassMatrixLimit = mSliderJointComponents.mInverseMassMatrixLimit[i];
 
-            // If the upper limit is violated
-            if (mSliderJointComponents.mIsUpperLimitViolated[i]) {
+        // If the lower limit is violated
+        if (mSliderJointComponents.mIsLowerLimitViolated[i]) {
 
-                // Compute J*v for the upper limit constraint
-                const decimal JvUpperLimit = sliderAxisWorld.dot(v1) + r1PlusUCrossSliderAxis.dot(w1)
-                                            - sliderAxisWorld.dot(v2) - r2CrossSliderAxis.dot(w2);
+            // Compute J*v for the lower limit constraint
+            const decimal JvLowerLimit = sliderAxisWorld.dot(v2) + r2CrossSliderAxis.dot(w2) -
+                                         sliderAxisWorld.dot(v1) - r1PlusUCrossSliderAxis.dot(w1);
 
-                // Compute the Lagrange multiplier lambda for the upper limit constraint
-                decimal deltaLambdaUpper = inverseMassMatrixLimit * (-JvUpperLimit -mSliderJointComponents.mBUpperLimit[i]);
-                decimal lambdaTemp = mSliderJointComponents.mImpulseUpperLimit[i];
-                mSliderJointComponents.mImpulseUpperLimit[i] = std::max(mSliderJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
-                deltaLambdaUpper = mSliderJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
+            // Compute the Lagrange multiplier lambda for the lower limit constraint
+            decimal deltaLambdaLower = inverseMassMatrixLimit * (-JvLowerLimit - mSliderJointComponents.mBLowerLimit[i]);
+            decimal lambdaTemp = mSliderJointComponents.mImpulseLowerLimit[i];
+            mSliderJointComponents.mImpulseLowerLimit[i] = std::max(mSliderJointComponents.mImpulseLowerLimit[i] + deltaLambdaLower, decimal(0.0));
+            deltaLambdaLower = mSliderJointComponents.mImpulseLowerLimit[i] - lambdaTemp;
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
-                const Vector3 linearImpulseBody1 = deltaLambdaUpper * sliderAxisWorld;
-                const Vector3 angularImpulseBody1 = deltaLambdaUpper * r1PlusUCrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 1
+            const Vector3 linearImpulseBody1 = -deltaLambdaLower * sliderAxisWorld;
+            const Vector3 angularImpulseBody1 = -deltaLambdaLower * r1PlusUCrossSliderAxis;
 
-                // Apply the impulse to the body 1
-                v1 += inverseMassBody1 * linearImpulseBody1;
-                w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
+            // Apply the impulse to the body 1
+            v1 += inverseMassBody1 * linearImpulseBody1;
+            w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
 
-                // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
-                const Vector3 linearImpulseBody2 = -deltaLambdaUpper * sliderAxisWorld;
-                const Vector3 angularImpulseBody2 = -deltaLambdaUpper * r2CrossSliderAxis;
+            // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
+            const Vector3 linearImpulseBody2 = deltaLambdaLower * sliderAxisWorld;
+            const Vector3 angularImpulseBody2 = deltaLambdaLower * r2CrossSliderAxis;
 
-                // Apply the impulse to the body 2
-                v2 += inverseMassBody2 * linearImpulseBody2;
-                w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
-            }
+            // Apply the impulse to the body 2
+            v2 += inverseMassBody2 * linearImpulseBody2;
+            w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
         }
 
-        // --------------- Motor --------------- //
-
-        if (mSliderJointComponents.mIsMotorEnabled[i]) {
+        // If the upper limit is violated
+        if (mSliderJointComponents.mIsUpperLimitViolated[i]) {
 
-            // Compute J*v for the motor
-            const decimal JvMotor = sliderAxisWorld.dot(v1) - sliderAxisWorld.dot(v2);
+            // Compute J*v for the upper limit constraint
+            const decimal JvUpperLimit = sliderAxisWorld.dot(v1) + r1PlusUCrossSliderAxis.dot(w1)
+                                        - sliderAxisWorld.dot(v2) - r2CrossSliderAxis.dot(w2);
 
-            // Compute the Lagrange multiplier lambda for the motor
-            const decimal maxMotorImpulse = mSliderJointComponents.mMaxMotorForce[i] * mTimeStep;
-            decimal deltaLambdaMotor = mSliderJointComponents.mInverseMassMatrixMotor[i] * (-JvMotor - mSliderJointComponents.mMotorSpeed[i]);
-            decimal lambdaTemp = mSliderJointComponents.mImpulseMotor[i];
-            mSliderJointComponents.mImpulseMotor[i] = clamp(mSliderJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
-            deltaLambdaMotor = mSliderJointComponents.mImpulseMotor[i] - lambdaTemp;
+            // Compute the Lagrange multiplier lambda for the upper limit constraint
+            decimal deltaLambdaUpper = inverseMassMatrixLimit * (-JvUpperLimit -mSliderJointComponents.mBUpperLimit[i]);
+            decimal lambdaTemp = mSliderJointComponents.mImpulseUpperLimit[i];
+            mSliderJointComponents.mImpulseUpperLimit[i] = std::max(mSliderJointComponents.mImpulseUpperLimit[i] + deltaLambdaUpper, decimal(0.0));
+            deltaLambdaUpper = mSliderJointComponents.mImpulseUpperLimit[i] - lambdaTemp;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 1
-            const Vector3 linearImpulseBody1 = deltaLambdaMotor * sliderAxisWorld;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 1
+            const Vector3 linearImpulseBody1 = deltaLambdaUpper * sliderAxisWorld;
+            const Vector3 angularImpulseBody1 = deltaLambdaUpper * r1PlusUCrossSliderAxis;
 
             // Apply the impulse to the body 1
             v1 += inverseMassBody1 * linearImpulseBody1;
+            w1 += mSliderJointComponents.mI1[i] * angularImpulseBody1;
 
-            // Compute the impulse P=J^T * lambda for the motor of body 2
-            const Vector3 linearImpulseBody2 = -deltaLambdaMotor * sliderAxisWorld;
+            // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
+            const Vector3 linearImpulseBody2 = -deltaLambdaUpper * sliderAxisWorld;
+            const Vector3 angularImpulseBody2 = -deltaLambdaUpper * r2CrossSliderAxis;
 
             // Apply the impulse to the body 2
             v2 += inverseMassBody2 * linearImpulseBody2;
+            w2 += mSliderJointComponents.mI2[i] * angularImpulseBody2;
         }
     }
+
+    // --------------- Motor --------------- //
+
+    if (mSliderJointComponents.mIsMotorEnabled[i]) {
+
+        // Compute J*v for the motor
+        const decimal JvMotor = sliderAxisWorld.dot(v1) - sliderAxisWorld.dot(v2);
+
+        // Compute the Lagrange multiplier lambda for the motor
+        const decimal maxMotorImpulse = mSliderJointComponents.mMaxMotorForce[i] * mTimeStep;
+        decimal deltaLambdaMotor = mSliderJointComponents.mInverseMassMatrixMotor[i] * (-JvMotor - mSliderJointComponents.mMotorSpeed[i]);
+        decimal lambdaTemp = mSliderJointComponents.mImpulseMotor[i];
+        mSliderJointComponents.mImpulseMotor[i] = clamp(mSliderJointComponents.mImpulseMotor[i] + deltaLambdaMotor, -maxMotorImpulse, maxMotorImpulse);
+        deltaLambdaMotor = mSliderJointComponents.mImpulseMotor[i] - lambdaTemp;
+
+        // Compute the impulse P=J^T * lambda for the motor of body 1
+        const Vector3 linearImpulseBody1 = deltaLambdaMotor * sliderAxisWorld;
+
+        // Apply the impulse to the body 1
+        v1 += inverseMassBody1 * linearImpulseBody1;
+
+        // Compute the impulse P=J^T * lambda for the motor of body 2
+        const Vector3 linearImpulseBody2 = -deltaLambdaMotor * sliderAxisWorld;
+
+        // Apply the impulse to the body 2
+        v2 += inverseMassBody2 * linearImpulseBody2;
+    }
 }
 
 // Solve the position constraint (for position error correction)
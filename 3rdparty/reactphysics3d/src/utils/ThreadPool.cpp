@@ -0,0 +1,153 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2020 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/ThreadPool.h>
+#include <reactphysics3d/memory/MemoryManager.h>
+#include <new>
+
+using namespace reactphysics3d;
+
+// Constructor
+ThreadPool::ThreadPool(MemoryManager& memoryManager, uint nbWorkers)
+           : mMemoryManager(memoryManager), mThreads(nullptr), mNbWorkers(nbWorkers), mJobGeneration(0),
+             mTaskFunction(nullptr), mTaskData(nullptr), mNbTasks(0), mNextTaskIndex(0), mNbActiveWorkers(0),
+             mIsStopping(false) {
+
+    if (mNbWorkers > 0) {
+
+        // The base allocator is used because the threads and the synchronization primitives need
+        // their natural alignment (the heap allocator does not align the memory units it splits)
+        mThreads = static_cast<std::thread*>(mMemoryManager.allocate(MemoryManager::AllocationType::Base,
+                                                                     sizeof(std::thread) * mNbWorkers));
+
+        for (uint i=0; i < mNbWorkers; i++) {
+            new (mThreads + i) std::thread(&ThreadPool::workerLoop, this);
+        }
+    }
+}
+
+// Destructor
+ThreadPool::~ThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mJobCondition.notify_all();
+
+    for (uint i=0; i < mNbWorkers; i++) {
+        mThreads[i].join();
+        mThreads[i].~thread();
+    }
+
+    if (mThreads != nullptr) {
+        mMemoryManager.release(MemoryManager::AllocationType::Base, mThreads, sizeof(std::thread) * mNbWorkers);
+    }
+}
+
+// Main loop of a worker thread
+void ThreadPool::workerLoop() {
+
+    // The worker allocates from its own pool cache and single frame arena
+    mMemoryManager.bindCurrentThread();
+
+    uint64 lastJobGeneration = 0;
+
+    while (true) {
+
+        TaskFunction taskFunction;
+        void* data;
+        uint nbTasks;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobCondition.wait(lock, [&] { return mIsStopping || mJobGeneration != lastJobGeneration; });
+
+            if (mIsStopping) break;
+
+            // Copy the job under the lock so that it cannot change while we execute it
+            lastJobGeneration = mJobGeneration;
+            taskFunction = mTaskFunction;
+            data = mTaskData;
+            nbTasks = mNbTasks;
+            mNbActiveWorkers++;
+        }
+
+        executeTasks(taskFunction, data, nbTasks);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mNbActiveWorkers--;
+        }
+        mDoneCondition.notify_all();
+    }
+
+    mMemoryManager.unbindCurrentThread();
+}
+
+// Claim and execute tasks until there is no task left
+void ThreadPool::executeTasks(TaskFunction taskFunction, void* data, uint nbTasks) {
+
+    uint taskIndex = mNextTaskIndex.fetch_add(1);
+    while (taskIndex < nbTasks) {
+        taskFunction(data, taskIndex);
+        taskIndex = mNextTaskIndex.fetch_add(1);
+    }
+}
+
+// Execute the tasks [0, nbTasks) and return when all of them are done
+void ThreadPool::run(uint nbTasks, TaskFunction taskFunction, void* data) {
+
+    if (nbTasks == 0) return;
+
+    // Without workers or with a single task, there is nothing to gain from waking up threads
+    if (mNbWorkers == 0 || nbTasks == 1) {
+        for (uint i=0; i < nbTasks; i++) {
+            taskFunction(data, i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+
+        // A worker that woke up late for the previous job may still be running it
+        mDoneCondition.wait(lock, [&] { return mNbActiveWorkers == 0; });
+
+        mTaskFunction = taskFunction;
+        mTaskData = data;
+        mNbTasks = nbTasks;
+        mNextTaskIndex.store(0);
+        mJobGeneration++;
+    }
+    mJobCondition.notify_all();
+
+    executeTasks(taskFunction, data, nbTasks);
+
+    // All the tasks have been claimed, wait for the workers to finish the ones they are executing
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDoneCondition.wait(lock, [&] { return mNbActiveWorkers == 0; });
+}
@@ -3,18 +3,20 @@
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec3 in_normal;
 layout (location = 2) in vec2 in_tex_coords;
+// Per-instance model matrix, occupies locations 3-6
+layout (location = 3) in mat4 instance_model;
 
 out vec3 fragment_position;
 out vec3 normal;
 out vec2 tex_coords;
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 void main() {
-    fragment_position = vec3(model * vec4(in_position, 1.0));
-    normal = mat3(transpose(inverse(model))) * in_normal;  
+    fragment_position = vec3(instance_model * vec4(in_position, 1.0));
+    // Physics transforms are rigid (meshes are scaled on load), so rotation part is the normal matrix
+    normal = mat3(instance_model) * in_normal;
 
     tex_coords = in_tex_coords;
     
@@ -0,0 +1,72 @@
+#ifndef BULLSEYE_ASSET_LOADER_H
+#define BULLSEYE_ASSET_LOADER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bullseye::asset {
+    // Time (in milliseconds) GL thread may spend on uploads per frame
+    static const float ASSET_UPLOAD_BUDGET_MS = 2.f;
+
+    // Runs on worker thread, does file I/O and decoding only (no GL calls). Returns false on failure.
+    typedef std::function<bool()> LoadFunction;
+    // Runs on GL thread with result of load function
+    typedef std::function<void(bool loaded)> UploadFunction;
+
+    // Handle to CPU stage of asset, becomes ready (with load result) before upload is queued.
+    // GPU stage is tracked by assets themselves (e.g. Mesh::is_ready).
+    typedef std::shared_future<bool> AssetHandle;
+
+    // Loads assets on worker threads and hands finished CPU buffers to GL thread, which uploads them
+    // in process_uploads() within time budget, so that loading never stalls the frame.
+    class AssetLoader {
+        public:
+            AssetLoader(uint32_t nb_workers);
+            ~AssetLoader();
+
+            AssetHandle enqueue(LoadFunction load, UploadFunction upload);
+            // Must be called from GL thread, returns number of uploads done. At least one upload runs
+            // per call, so loading progresses even if single upload does not fit into budget.
+            uint32_t process_uploads(float budget_ms);
+            // Blocks until all queued assets are loaded and uploaded, must be called from GL thread
+            void finish();
+            uint32_t get_pending_count();
+            void unload();
+
+        private:
+            struct Job {
+                LoadFunction load;
+                UploadFunction upload;
+                std::promise<bool> loaded;
+            };
+
+            struct Upload {
+                UploadFunction upload;
+                bool loaded;
+            };
+
+            std::vector<std::thread> workers;
+            std::mutex jobs_mutex;
+            std::condition_variable jobs_condition;
+            std::deque<Job> jobs;
+            bool stopping;
+
+            std::mutex uploads_mutex;
+            std::condition_variable uploads_condition;
+            std::deque<Upload> uploads;
+
+            // Assets enqueued but not uploaded yet
+            std::atomic<uint32_t> pending;
+
+            void worker_loop();
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef BULLSEYE_BENCH_CHECKS_H
+#define BULLSEYE_BENCH_CHECKS_H
+
+#include <stdint.h>
+#include "reactphysics3d/reactphysics3d.h"
+
+// Correctness checks of physics fast paths for bullseye_bench --verify. Each check compares the results
+// of optimized code with a reference (or expected results) on generated cases and returns number of mismatches.
+namespace bullseye::bench_checks {
+    // Small boxes cast at large boxes from a few mm away must hit at the gap distance, with the face normal
+    uint32_t verify_shape_cast(rp3d::PhysicsCommon& physics_common, uint32_t seed);
+    // SIMD and scalar contact solvers must accumulate the same impulses on the same contacts of box piles and stacks hit by bullets
+    uint32_t verify_solver(rp3d::PhysicsCommon& physics_common, uint32_t seed);
+    // Box vs box algorithm must report contacts of random box pairs along their axis of minimum penetration (of the 15 separating axes)
+    uint32_t verify_box_vs_box(rp3d::PhysicsCommon& physics_common, uint32_t seed);
+    // Every broad-phase must find all pairs of moving boxes with overlapping AABBs, the same as a brute-force sweep over all pairs
+    uint32_t verify_broad_phase(rp3d::PhysicsCommon& physics_common, uint32_t seed);
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef BULLSEYE_BULLET_POOL_H
+#define BULLSEYE_BULLET_POOL_H
+
+#include <stdint.h>
+#include <vector>
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+#include "entity.h"
+#include "mesh_manager.h"
+#include "shape_cache.h"
+
+namespace bullseye::bullet_pool {
+    static const uint32_t BULLET_POOL_DEFAULT_CAPACITY = 256;
+    // Time (in seconds) after which bullet is recycled
+    static const float BULLET_TTL = 5.f;
+    // Distance from muzzle after which bullet is recycled
+    static const float BULLET_MAX_RANGE = 150.f;
+    // Bullets are parked far below range while disabled
+    static const glm::vec3 BULLET_PARK_POSITION = glm::vec3(0.f, -1000.f, 0.f);
+    // Collision category of bullet colliders, lets swept bullets ignore each other
+    static const unsigned short BULLET_COLLISION_CATEGORY = 0x0002;
+
+    struct Bullet {
+        entity::Entity entity;
+        glm::vec3 origin;
+        glm::vec3 direction;
+        float ttl;
+        uint64_t fire_sequence;
+        bool in_use;
+        bool hit;
+    };
+
+    // Fixed set of bullet bodies created up front. Spent bullets are disabled and reused,
+    // so firing never creates rp3d bodies or shapes and world size stays bounded.
+    class BulletPool : public rp3d::EventListener {
+        public:
+            BulletPool(uint32_t capacity, rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager);
+            ~BulletPool();
+
+            // Returns index of fired bullet in get_bullets(), or capacity when pool has no bullets
+            uint32_t fire(const glm::vec3& position, const glm::vec3& direction);
+            void update(float delta_time);
+            void unload(rp3d::PhysicsWorld* world);
+
+            // When enabled, every bullet casts its shape along the distance it travels in next step
+            // and is marked spent at the time of impact, so fast bullets cannot tunnel through thin targets
+            void set_swept(bool swept);
+
+            // Enables rp3d continuous collision detection on bullet bodies, world update itself then creates contacts
+            // of fast bullets in the step they reach a target, so they register hits even with longer time step.
+            void set_continuous(bool continuous);
+
+            std::vector<Bullet>& get_bullets();
+            uint32_t get_active_count();
+            uint32_t get_capacity();
+            // Number of bullets recycled after hitting something since pool creation
+            uint64_t get_hit_count();
+
+            // Marks bullets that touched anything other than another bullet as spent, they are recycled in next update()
+            void onContact(const rp3d::CollisionCallback::CallbackData& callback_data) override;
+
+        private:
+            std::vector<Bullet> bullets;
+            std::vector<uint32_t> free_slots;
+            uint64_t fire_sequence;
+            uint64_t hit_count;
+            rp3d::PhysicsWorld* world;
+            bool swept;
+
+            uint32_t acquire_slot();
+            void release(uint32_t slot);
+            void sweep(Bullet& bullet, float delta_time);
+            Bullet* get_bullet(rp3d::CollisionBody* body);
+    };
+}
+
+#endif
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "mesh.h"
 #include "shader.h"
 #include "camera.h"
+#include "shape_cache.h"
 
 namespace bullseye::entity {
     enum class BodyType {
@@ -23,7 +24,6 @@ namespace bullseye::entity {
             ~Entity();
 
             void update(float delta_time);
-            glm::mat4 get_model_matrix(float interp);
             virtual void unload(rp3d::PhysicsWorld* world);
 
             void set_mesh(std::string mesh_name);
@@ -33,8 +33,11 @@ namespace bullseye::entity {
             const glm::vec3& get_rotation();
             void set_rotation_speed(glm::vec3 rotation_speed);
             void set_force(glm::vec3 force);
+            void set_active(bool active);
+            bool is_active();
+            void reset_physics(const glm::vec3& position, const rp3d::Quaternion& orientation);
 
-            void init_physics(rp3d::PhysicsWorld* physics_world, rp3d::PhysicsCommon* physics_common, mesh::Mesh* mesh, float mass = -1.f);
+            void init_physics(rp3d::PhysicsWorld* physics_world, shape_cache::ShapeCache* shape_cache, mesh::Mesh* mesh, float mass = -1.f);
             rp3d::CollisionBody* get_collision_body();
             rp3d::RigidBody* get_rigid_body();
 
@@ -43,7 +46,8 @@ namespace bullseye::entity {
             std::string mesh_name;
 
             rp3d::PhysicsWorld* physics_world;
-            rp3d::PhysicsCommon* physics_common;
+            shape_cache::ShapeCache* shape_cache;
+            rp3d::CollisionShape* collision_shape;
             rp3d::CollisionBody* physics_body;
             BodyType body_type;
 
@@ -52,7 +56,8 @@ namespace bullseye::entity {
             glm::vec3 rotation;
             glm::vec3 previous_rotation;
 
-            rp3d::Transform previous_transform;
+            // Transform body is created with (or moved to by reset_physics), rendering uses published physics state
+            rp3d::Transform initial_transform;
             rp3d::Vector3 applied_force;
             float force_timer;
 
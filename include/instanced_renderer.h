@@ -0,0 +1,43 @@
+#ifndef BULLSEYE_INSTANCED_RENDERER_H
+#define BULLSEYE_INSTANCED_RENDERER_H
+
+#include <stdint.h>
+#include <vector>
+#include "glm/glm.hpp"
+#include "mesh.h"
+#include "shader.h"
+
+namespace bullseye::render {
+    static const uint32_t INSTANCED_RENDERER_INITIAL_BATCHES = 8;
+
+    // All instances sharing mesh and texture, drawn with single glDrawElementsInstanced call
+    struct InstanceBatch {
+        mesh::Mesh* mesh;
+        uint32_t texture_id;
+        uint32_t instance_vbo;
+        uint32_t instance_vbo_capacity;
+        std::vector<glm::mat4> models;
+    };
+
+    class InstancedRenderer {
+        public:
+            InstancedRenderer();
+            ~InstancedRenderer();
+
+            // Resolves uniforms of instanced shader once, must be called before draw() with the same shader
+            void init(shader::Shader &shader);
+            void begin_frame();
+            void submit(mesh::Mesh* mesh, const uint32_t texture_id, const glm::mat4& model);
+            void draw(shader::Shader &shader);
+            void unload();
+        private:
+            // Batches are kept between frames so instance buffers are reused
+            std::vector<InstanceBatch> batches;
+            shader::UniformHandle texture_diffuse;
+
+            InstanceBatch& get_batch(mesh::Mesh* mesh, const uint32_t texture_id);
+            void update_instance_vbo(InstanceBatch& batch);
+    };
+}
+
+#endif
\ No newline at end of file
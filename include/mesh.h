@@ -3,11 +3,19 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include "glm/glm.hpp"
 
 #include "shader.h"
 
 namespace bullseye::mesh {
+    namespace cache {
+        class MappedMeshCache;
+    }
+
+    // First of four attribute locations taken by per-instance model matrix (see instanced_vert.glsl)
+    static const uint32_t INSTANCE_MODEL_LOCATION = 3;
+
     struct Vertex {
         glm::vec3 position;
         glm::vec3 normal;
@@ -24,21 +32,37 @@ namespace bullseye::mesh {
             std::string name;
             std::vector<Vertex> vertices;
             std::vector<uint32_t> indices;
+            // Kept separately, indices are not loaded into memory when mesh comes from cache
+            uint32_t index_count;
             std::vector<Texture> textures;
             uint32_t vao;
             uint32_t vbo;
             glm::vec3 scale;
             glm::vec3 extents;
+            glm::vec3 bounds_min;
+            bool gpu_uploaded;
+            // Set on GL thread once buffers exist (or CPU data is loaded for meshes without GPU upload)
+            bool ready;
+            std::shared_ptr<cache::MappedMeshCache> mapped_cache;
 
             void load_obj_file(std::string path);
+            // Welds duplicate vertices and reorders triangles and vertices for GPU caches
+            void optimize();
             void load_and_setup_vertices(const float* vertices, uint32_t vertices_len);
-            void setup_mesh();
+            bool load_cached(const std::string& cache_path, const std::string& path);
+            void setup_mesh(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count);
             void calculate_bounding_box();
             
         public:
-            Mesh(std::string name, std::string path, glm::vec3 scale = glm::vec3(1.f));
+            Mesh(std::string name, std::string path, glm::vec3 scale = glm::vec3(1.f), bool gpu_upload = true, bool use_cache = true);
+            // Empty mesh, loaded later in two steps: load() on any thread, then upload() on GL thread
+            Mesh(std::string name, glm::vec3 scale, bool gpu_upload = true);
             Mesh(std::string name, const float* vertices, uint32_t vertices_len);
+            bool load(const std::string& path, bool use_cache = true);
+            void upload();
+            bool is_ready();
             void draw();
+            void draw_instanced(uint32_t instance_vbo, uint32_t instance_count);
             void draw_light_cube();
             void unload();
             const char* get_name();
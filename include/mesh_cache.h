@@ -0,0 +1,70 @@
+#ifndef BULLSEYE_MESH_CACHE_H
+#define BULLSEYE_MESH_CACHE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+
+#include "mesh.h"
+
+// Binary mesh blob written next to source model on first load. Layout is header, index stream and vertex
+// stream, streams are stored exactly as uploaded with glBufferData so cached mesh is mapped and uploaded as-is.
+namespace bullseye::mesh::cache {
+    // "BMSH"
+    static const uint32_t MESH_CACHE_MAGIC = 0x48534D42;
+    // Bump whenever header, Vertex layout or mesh optimizations change
+    static const uint32_t MESH_CACHE_VERSION = 1;
+    static const char* const MESH_CACHE_EXTENSION = ".bmesh";
+
+    struct MeshCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertex_size;
+        uint32_t vertex_count;
+        uint32_t index_count;
+        uint32_t reserved;
+        // Source model file the blob was built from, hash is only checked when mtime differs
+        uint64_t source_mtime;
+        uint64_t source_size;
+        uint64_t source_hash;
+        float scale[3];
+        float aabb_min[3];
+        float aabb_max[3];
+        uint32_t padding;
+    };
+
+    // Same model can be loaded under different names with different scale, each gets its own blob
+    std::string get_cache_path(const std::string& source_path, const std::string& mesh_name);
+
+    bool write(const std::string& cache_path, const std::string& source_path, const glm::vec3& scale, const glm::vec3& aabb_min,
+        const glm::vec3& aabb_max, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+    // Read-only memory mapping of cache blob, streams point directly into mapped file
+    class MappedMeshCache {
+        public:
+            MappedMeshCache();
+            ~MappedMeshCache();
+
+            // Returns false when blob is missing, corrupted or does not match source file and scale
+            bool open(const std::string& cache_path, const std::string& source_path, const glm::vec3& scale);
+            void close();
+
+            const MeshCacheHeader* get_header();
+            const uint32_t* get_indices();
+            const Vertex* get_vertices();
+
+        private:
+            const unsigned char* data;
+            size_t size;
+#ifdef _WIN32
+            void* file_handle;
+            void* mapping_handle;
+#endif
+
+            bool map(const std::string& cache_path);
+            bool validate(const std::string& source_path, const glm::vec3& scale);
+    };
+}
+
+#endif
\ No newline at end of file
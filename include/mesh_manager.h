@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "mesh.h"
+#include "asset_loader.h"
 
 #include <string>
 #include <unordered_map>
@@ -15,9 +16,12 @@ namespace bullseye::mesh {
 
     class MeshManager {
         public:
-            MeshManager();
+            MeshManager(bool gpu_upload = true);
             ~MeshManager();
             void load_mesh(std::string name, std::string mesh_file_path, glm::vec3 scale = glm::vec3(1.f));
+            // Mesh is available through get_mesh() right away, but is drawn only once uploaded. Handle
+            // becomes ready when CPU data (e.g. extents needed for colliders) is loaded.
+            asset::AssetHandle load_mesh_async(std::string name, std::string mesh_file_path, asset::AssetLoader& loader, glm::vec3 scale = glm::vec3(1.f));
             void unload_mesh(const std::string &name);
             void unload();
 
@@ -26,6 +30,7 @@ namespace bullseye::mesh {
 
         private:
             std::unordered_map<std::string, Mesh*> meshes;
+            bool gpu_upload;
     };
 }
 
@@ -0,0 +1,31 @@
+#ifndef BULLSEYE_MESH_OPTIMIZER_H
+#define BULLSEYE_MESH_OPTIMIZER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "mesh.h"
+
+// Offline-style optimizations run once when mesh is loaded. All functions work on indexed triangle lists.
+namespace bullseye::mesh::optimizer {
+    // Size of FIFO post-transform cache used to report ACMR (common for older and mobile GPUs)
+    static const uint32_t ACMR_CACHE_SIZE = 16;
+    // Size of LRU cache modelled by vertex cache optimization (Forsyth)
+    static const uint32_t FORSYTH_CACHE_SIZE = 32;
+
+    // Average cache miss ratio, number of transformed vertices per triangle (from 0.5 best to 3.0 worst)
+    float calculate_acmr(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size = ACMR_CACHE_SIZE);
+
+    // Merges vertices with identical position, normal and texture coordinates and rewrites indices
+    void weld_vertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    // Reorders triangles for post-transform vertex cache (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation")
+    void optimize_vertex_cache(std::vector<uint32_t>& indices, uint32_t vertex_count);
+    // Splits cache optimized triangles into clusters at cache resets and draws outward facing clusters first
+    // (Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"). Vertex cache
+    // efficiency is kept as clusters are only cut where cache would be cold anyway.
+    void optimize_overdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);
+    // Reorders vertices in order of first use by index buffer, so vertex fetch reads memory linearly
+    void optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+}
+
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define BULLSEYE_PHYSICS_DEBUG_RENDERER_H
 
 #include <stdint.h>
+#include <vector>
 #include "reactphysics3d/reactphysics3d.h"
 #include "shader.h"
 #include "camera.h"
@@ -13,7 +14,10 @@ namespace bullseye::render {
             PhysicsDebugRenderer(rp3d::PhysicsWorld* physics_world);
             ~PhysicsDebugRenderer();
 
-            void draw(shader::Shader &shader, camera::Camera &camera, float interp);
+            // Lines and triangles are copied out of world by physics thread, world debug renderer is rebuilt during its update
+            void draw(shader::Shader &shader, camera::Camera &camera, float interp, const std::vector<rp3d::DebugRenderer::DebugLine>& lines,
+                const std::vector<rp3d::DebugRenderer::DebugTriangle>& triangles);
+            // Toggles world debug rendering, has to run on physics thread while it is stepping the world
             void update_settings(app_settings::AppSettings* app_settings);
         private:
             rp3d::PhysicsWorld* physics_world;
@@ -26,7 +30,7 @@ namespace bullseye::render {
             uint32_t triangles_vbo;
 
             void init();
-            void update_vbo_data(const rp3d::DebugRenderer& physics_debug_renderer, const uint32_t lines_count, const uint32_t triangles_count);
+            void update_vbo_data(const std::vector<rp3d::DebugRenderer::DebugLine>& lines, const std::vector<rp3d::DebugRenderer::DebugTriangle>& triangles);
 
     };
 }
@@ -0,0 +1,129 @@
+#ifndef BULLSEYE_PHYSICS_THREAD_H
+#define BULLSEYE_PHYSICS_THREAD_H
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+namespace bullseye::physics_thread {
+    // Time between physics steps in microseconds (60 Hz, bullets rely on continuous collision detection to hit thin targets)
+    static const uint64_t PHYSICS_STEP_US = 1000 * 1000 / 60;
+    // Physics falling further behind than this (in microseconds) skips the missed time instead of catching up
+    static const uint64_t PHYSICS_MAX_LAG_US = 250000;
+
+    // Runs on physics thread, only place where world and bodies can be touched while thread is running
+    typedef std::function<void()> Command;
+    // Fixed step game logic (forces, recycling bullets), runs on physics thread before each world update
+    typedef std::function<void(float delta_time)> StepFunction;
+
+    // Transforms of body after the two latest steps, both are published so renderer can blend them
+    struct BodyState {
+        rp3d::Transform previous;
+        rp3d::Transform current;
+        // Inactive bodies (e.g. parked bullets) are not drawn
+        bool visible;
+    };
+
+    // World state after one step. Times are steady clock microseconds (get_time_us) of the ticks
+    // at which previous and current states were due.
+    struct Snapshot {
+        uint64_t sequence;
+        uint64_t previous_time;
+        uint64_t time;
+        // Wall time spent in step function and world update
+        float step_ms;
+        // Indexed by body slot, slots reserved but not tracked yet are not visible
+        std::vector<BodyState> bodies;
+        // Filled only while world debug rendering is enabled
+        std::vector<rp3d::DebugRenderer::DebugLine> debug_lines;
+        std::vector<rp3d::DebugRenderer::DebugTriangle> debug_triangles;
+    };
+
+    // Lock-free triple buffer with single writer and single reader. Each side owns one snapshot,
+    // third one is exchanged atomically, so neither side ever waits for the other.
+    class SnapshotBuffer {
+        public:
+            SnapshotBuffer();
+
+            // Writer side, snapshot content is left over from older steps and has to be fully overwritten
+            Snapshot& get_write_snapshot();
+            void publish();
+            // Reader side, swaps in latest published snapshot if there is one. Snapshot stays valid until next call.
+            const Snapshot& acquire();
+
+        private:
+            static const uint32_t FRESH_BIT = 1u << 31;
+
+            Snapshot snapshots[3];
+            // Index of exchanged snapshot, with FRESH_BIT set when it has been published but not acquired
+            std::atomic<uint32_t> middle;
+            uint32_t write_index;
+            uint32_t read_index;
+    };
+
+    // Steps world at fixed rate on its own thread and publishes body transforms after every step,
+    // so slow physics step never stalls presentation and rendering overlaps simulation.
+    class PhysicsThread {
+        public:
+            PhysicsThread(rp3d::PhysicsWorld* world, uint64_t step_us = PHYSICS_STEP_US);
+            ~PhysicsThread();
+
+            void start(StepFunction step);
+            // Joins thread, world can be touched from caller afterwards. Commands not run yet are dropped.
+            void stop();
+
+            // Queues command to run on physics thread before next step
+            void submit(Command command);
+            // Snapshot slot for body that is going to be tracked, can be called from any thread
+            uint32_t reserve_slot();
+            // Publishes body transform in reserved slot, must be called from physics thread (command) or before start()
+            void track(uint32_t slot, rp3d::CollisionBody* body);
+            // Body in slot has been moved (e.g. bullet reused by fire), next snapshot does not blend it from its old position.
+            // Must be called from physics thread (command) or before start().
+            void reset(uint32_t slot);
+
+            // Must be called from single (render) thread
+            const Snapshot& acquire_snapshot();
+            uint64_t get_step_us();
+
+        private:
+            rp3d::PhysicsWorld* world;
+            uint64_t step_us;
+            uint64_t sequence;
+
+            std::thread thread;
+            std::atomic<bool> stopping;
+
+            std::mutex commands_mutex;
+            std::vector<Command> commands;
+            // Swapped with commands, so queue is never locked while commands run
+            std::vector<Command> running_commands;
+
+            std::atomic<uint32_t> nb_slots;
+            // Owned by physics thread, indexed by slot
+            std::vector<rp3d::CollisionBody*> bodies;
+            std::vector<BodyState> states;
+            // Reset sequence of each slot and the one its last published state was taken at
+            std::vector<uint32_t> reset_sequences;
+            std::vector<uint32_t> published_reset_sequences;
+
+            SnapshotBuffer snapshot_buffer;
+
+            void thread_loop(StepFunction step);
+            void run_commands();
+            void resize(uint32_t nb_slots);
+            void publish(uint64_t time, float step_ms);
+    };
+
+    uint64_t get_time_us();
+    // Presentation runs one step behind simulation, returns blend factor between previous and current states at given time
+    float get_interpolation_factor(const Snapshot& snapshot, uint64_t time_us);
+    glm::mat4 get_model_matrix(const BodyState& state, float interp);
+}
+
+#endif
@@ -2,9 +2,23 @@
 #define BULLSEYE_SHADER_H
 
 #include <string>
+#include <vector>
 #include "glm/glm.hpp"
 
 namespace bullseye::shader {
+    // Index into shader's uniform table, resolved once with get_uniform_handle()
+    typedef int32_t UniformHandle;
+    static const UniformHandle INVALID_UNIFORM_HANDLE = -1;
+
+    struct Uniform {
+        std::string name;
+        int32_t location;
+        uint32_t type;
+        // Last uploaded value (large enough for mat4), used to skip redundant uploads
+        float value[16];
+        bool has_value;
+    };
+
     class Shader {
     private:
         unsigned int id;
@@ -13,8 +27,11 @@ namespace bullseye::shader {
         std::string fragment_shader_src;
         uint32_t vertex_shader_id;
         uint32_t fragment_shader_id;
+        std::vector<Uniform> uniforms;
 
         inline std::string load_file(const char* path);
+        void load_uniforms();
+        bool update_uniform_value(UniformHandle handle, const void* value, size_t size);
 
     public:
         Shader(std::string _name);
@@ -32,6 +49,13 @@ namespace bullseye::shader {
         void set_mat3(const std::string &name, const glm::mat3 &value);
         void set_mat4(const std::string &name, const glm::mat4 &value);
         void set_mat4(const std::string& name, const float value[]);
+        UniformHandle get_uniform_handle(const std::string &name);
+        void set_bool(UniformHandle handle, bool value);
+        void set_int(UniformHandle handle, int value);
+        void set_float(UniformHandle handle, float value);
+        void set_vec3(UniformHandle handle, const glm::vec3 &value);
+        void set_mat3(UniformHandle handle, const glm::mat3 &value);
+        void set_mat4(UniformHandle handle, const glm::mat4 &value);
         uint32_t get_attrib_location(const std::string &name);
         uint32_t get_id();
     };
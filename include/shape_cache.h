@@ -0,0 +1,57 @@
+#ifndef BULLSEYE_SHAPE_CACHE_H
+#define BULLSEYE_SHAPE_CACHE_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+namespace bullseye::shape_cache {
+    static const uint32_t SHAPE_CACHE_INITIAL_SIZE = 16;
+
+    enum class ShapeType {
+        BOX
+    };
+
+    struct ShapeKey {
+        ShapeType type;
+        glm::vec3 extents;
+
+        bool operator==(const ShapeKey& other) const {
+            return this->type == other.type && this->extents == other.extents;
+        }
+    };
+
+    struct ShapeKeyHash {
+        size_t operator()(const ShapeKey& key) const;
+    };
+
+    struct CachedShape {
+        rp3d::CollisionShape* shape;
+        uint32_t ref_count;
+    };
+
+    // Shapes are immutable and can be attached to any number of colliders, so all entities with
+    // the same shape type and extents share single rp3d shape. Shape is destroyed with its last reference.
+    class ShapeCache {
+        public:
+            ShapeCache(rp3d::PhysicsCommon* physics_common);
+            ~ShapeCache();
+
+            rp3d::CollisionShape* acquire_box_shape(const glm::vec3& extents);
+            // Must be called after collider using the shape has been removed (e.g. its body destroyed)
+            void release(rp3d::CollisionShape* shape);
+            void unload();
+
+            uint32_t get_shape_count();
+
+        private:
+            rp3d::PhysicsCommon* physics_common;
+            std::unordered_map<ShapeKey, CachedShape, ShapeKeyHash> shapes;
+            std::unordered_map<rp3d::CollisionShape*, ShapeKey> keys;
+
+            void destroy_shape(const ShapeKey& key, rp3d::CollisionShape* shape);
+    };
+}
+
+#endif
\ No newline at end of file
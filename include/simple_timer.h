@@ -12,6 +12,7 @@ namespace bullseye::simple_timer {
 
             uint64_t get_milliseconds_since_start();
             uint64_t get_microseconds_since_start();
+            uint64_t get_nanoseconds_since_start();
 
         private:
             std::chrono::high_resolution_clock::time_point begin;
@@ -6,6 +6,7 @@
 #include "glm/glm.hpp"
 
 #include "shader.h"
+#include "asset_loader.h"
 
 namespace bullseye::skybox {
     static const float SKYBOX_VERTICES[] = {
@@ -20,16 +21,23 @@ namespace bullseye::skybox {
     class Skybox {
         public:
             Skybox(std::vector<std::string> texture_paths, std::string vert_shader_path, std::string frag_shader_path);
+            // Skybox without faces, they are loaded with load_faces_async() and skybox is not drawn until all are uploaded
+            Skybox(std::string vert_shader_path, std::string frag_shader_path);
             virtual ~Skybox();
 
+            void load_faces_async(std::vector<std::string> texture_paths, asset::AssetLoader& loader);
+            bool is_ready();
+
             void draw(glm::mat4 projection, glm::mat4 view);
             void unload();
         private:
             shader::Shader *shader;
             uint32_t texture_id;
             uint32_t vao;
+            uint32_t faces_uploaded;
 
-            void setup_skybox(std::vector<std::string> texture_paths);
+            void setup_skybox();
+            void upload_face(uint32_t face, const unsigned char* data, int x, int y);
     };
 }
 
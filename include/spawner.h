@@ -0,0 +1,24 @@
+#ifndef BULLSEYE_SPAWNER_H
+#define BULLSEYE_SPAWNER_H
+
+#include <string>
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+#include "entity.h"
+#include "mesh_manager.h"
+#include "shape_cache.h"
+
+namespace bullseye::spawner {
+    const float RANDOM_BOX_SPAWN_RANGE = 25.f;
+    const float BULLET_MASS = 0.1f;
+    const float BULLET_FORCE = 10.f;
+
+    // Box with random position and orientation, dropped onto the range (same as [G] key in app)
+    entity::Entity spawn_random_box(const std::string& name, rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager);
+    // Bullet pushed along direction (same as left click in app)
+    entity::Entity spawn_bullet(const std::string& name, const glm::vec3& position, const glm::vec3& direction, 
+        rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager);
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <string>
 #include <unordered_map>
 
+#include "asset_loader.h"
+
 namespace bullseye::texture {
     static const uint32_t TEXTURE_MANAGER_INITIAL_SIZE = 64;
 
@@ -16,7 +18,9 @@ namespace bullseye::texture {
             TextureManager();
 
             void load_texture(const std::string name, const std::string& path);
-            void use_texture(const std::string& name, const uint32_t shader_id);
+            // Texture id is valid right away and shows placeholder texel until image is uploaded
+            asset::AssetHandle load_texture_async(const std::string name, const std::string& path, asset::AssetLoader& loader);
+            uint32_t get_texture_id(const std::string& name);
             void unload_texture(std::string& name);
             void unload();
         private:
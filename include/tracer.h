@@ -0,0 +1,65 @@
+#ifndef BULLSEYE_TRACER_H
+#define BULLSEYE_TRACER_H
+
+#include <stdint.h>
+#include <string>
+
+// Scoped-zone tracer. Zones are recorded only while capturing a range of frames, otherwise a zone
+// costs one flag check. Each thread writes completed zones into its own ring buffer without locking,
+// capture is written as Chrome trace JSON (chrome://tracing, Perfetto).
+namespace bullseye::trace {
+    // Zones kept per thread, oldest are overwritten when capture is longer than that
+    static const uint32_t TRACE_RING_BUFFER_SIZE = 1 << 18;
+    // Nesting depth of unscoped zones (begin_zone and rp3d hooks)
+    static const uint32_t TRACE_MAX_DEPTH = 64;
+
+    struct TraceEvent {
+        const char* name;
+        uint64_t begin_ns;
+        uint64_t end_ns;
+    };
+
+    // Name has to stay valid until capture is written (string literal)
+    class Zone {
+        public:
+            Zone(const char* name);
+            ~Zone();
+
+        private:
+            const char* name;
+            // Zero when zone started outside of capture
+            uint64_t begin_ns;
+    };
+
+    // Unscoped zone for flat code, every begin_zone() has to be matched by end_zone() on same thread
+    void begin_zone(const char* name);
+    void end_zone();
+
+    // Forwards rp3d profiled blocks to begin_zone/end_zone, they are recorded only while capturing.
+    // Hooks are plain globals read by world update, so this must be called before any world is updated on another thread.
+    void install_rp3d_hooks();
+    // Shown as thread name in trace, must be called from named thread with string literal
+    void set_thread_name(const char* name);
+    // Records frames [first_frame, first_frame + frame_count) and writes them to path after last one
+    void capture_frames(uint64_t first_frame, uint32_t frame_count, const std::string& path);
+    // Starts new frame, must be called once per frame from main thread (outside of any zone)
+    void next_frame();
+    uint64_t get_frame();
+    bool is_capturing();
+    bool write_chrome_trace(const std::string& path, uint64_t begin_ns, uint64_t end_ns);
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef BULLSEYE_TRACING_ENABLED
+#define TRACE_ZONE(name) bullseye::trace::Zone TRACE_CONCAT(trace_zone_, __LINE__)(name)
+#define TRACE_BEGIN(name) bullseye::trace::begin_zone(name)
+#define TRACE_END() bullseye::trace::end_zone()
+#else
+#define TRACE_ZONE(name)
+#define TRACE_BEGIN(name)
+#define TRACE_END()
+#endif
+
+#endif
\ No newline at end of file
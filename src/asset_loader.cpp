@@ -0,0 +1,138 @@
+#include "asset_loader.h"
+#include "simple_timer.h"
+#include "tracer.h"
+#include "clogger.h"
+
+#include <utility>
+
+namespace bullseye::asset {
+    AssetLoader::AssetLoader(uint32_t nb_workers) {
+        this->stopping = false;
+        this->pending = 0;
+
+        if (nb_workers == 0) {
+            nb_workers = 1;
+        }
+
+        this->workers.reserve(nb_workers);
+        for (uint32_t i = 0; i < nb_workers; i++) {
+            this->workers.emplace_back(&AssetLoader::worker_loop, this);
+        }
+
+        CLOG_DEBUG("Asset loader started [workers=%u]", nb_workers);
+    }
+
+    AssetLoader::~AssetLoader() {
+        unload();
+    }
+
+    AssetHandle AssetLoader::enqueue(LoadFunction load, UploadFunction upload) {
+        Job job;
+        job.load = std::move(load);
+        job.upload = std::move(upload);
+        AssetHandle handle = job.loaded.get_future().share();
+
+        this->pending++;
+        {
+            std::lock_guard<std::mutex> lock(this->jobs_mutex);
+            this->jobs.push_back(std::move(job));
+        }
+        this->jobs_condition.notify_one();
+
+        return handle;
+    }
+
+    void AssetLoader::worker_loop() {
+        trace::set_thread_name("Asset loader");
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(this->jobs_mutex);
+                this->jobs_condition.wait(lock, [this] { return this->stopping || !this->jobs.empty(); });
+                if (this->stopping) {
+                    return;
+                }
+
+                job = std::move(this->jobs.front());
+                this->jobs.pop_front();
+            }
+
+            TRACE_BEGIN("Asset load");
+            const bool loaded = job.load();
+            TRACE_END();
+
+            {
+                std::lock_guard<std::mutex> lock(this->uploads_mutex);
+                this->uploads.push_back(Upload { std::move(job.upload), loaded });
+            }
+            this->uploads_condition.notify_one();
+
+            // Only after upload is queued, so waiting on handle and then calling finish() never misses it
+            job.loaded.set_value(loaded);
+        }
+    }
+
+    uint32_t AssetLoader::process_uploads(float budget_ms) {
+        simple_timer::SimpleTimer timer;
+        timer.start();
+
+        const uint64_t budget_us = static_cast<uint64_t>(budget_ms * 1000.f);
+        uint32_t uploaded = 0;
+
+        do {
+            Upload upload;
+            {
+                std::lock_guard<std::mutex> lock(this->uploads_mutex);
+                if (this->uploads.empty()) {
+                    break;
+                }
+
+                upload = std::move(this->uploads.front());
+                this->uploads.pop_front();
+            }
+
+            upload.upload(upload.loaded);
+            this->pending--;
+            uploaded++;
+        } while (timer.get_microseconds_since_start() < budget_us);
+
+        return uploaded;
+    }
+
+    void AssetLoader::finish() {
+        while (this->pending > 0) {
+            {
+                std::unique_lock<std::mutex> lock(this->uploads_mutex);
+                this->uploads_condition.wait(lock, [this] { return !this->uploads.empty(); });
+            }
+
+            process_uploads(0.f);
+        }
+    }
+
+    uint32_t AssetLoader::get_pending_count() {
+        return this->pending;
+    }
+
+    void AssetLoader::unload() {
+        {
+            std::lock_guard<std::mutex> lock(this->jobs_mutex);
+            if (this->stopping) {
+                return;
+            }
+            this->stopping = true;
+        }
+        this->jobs_condition.notify_all();
+
+        for (auto& worker : this->workers) {
+            worker.join();
+        }
+        this->workers.clear();
+
+        // Assets that did not finish loading are dropped, they stay in their placeholder state
+        this->jobs.clear();
+        this->uploads.clear();
+        this->pending = 0;
+    }
+}
\ No newline at end of file
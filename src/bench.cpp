@@ -0,0 +1,558 @@
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+#include "clogger.h"
+#include "entity.h"
+#include "mesh_manager.h"
+#include "simple_timer.h"
+#include "spawner.h"
+#include "shape_cache.h"
+#include "bullet_pool.h"
+#include "tracer.h"
+#include "bench_checks.h"
+
+// Headless benchmark of the fixed-step update loop from main.cpp. No window and no GL context
+// is created, meshes are loaded CPU-side only so that colliders get the same extents as in app.
+
+using namespace bullseye;
+
+namespace {
+    // Fixed timestep rate (in Hz), same as main loop
+    const uint32_t DEFAULT_STEP_RATE = 100;
+
+    // Volleys are fired from camera starting position towards the middle of spawned boxes
+    const glm::vec3 VOLLEY_ORIGIN = glm::vec3(-10.f, 0.f, 4.f);
+    const glm::vec3 VOLLEY_TARGET = glm::vec3(spawner::RANDOM_BOX_SPAWN_RANGE / 2.f);
+    const float VOLLEY_SPREAD = 0.05f;
+
+    // Hitscan rays are cast from the volley origin, in a wider spread than bullets
+    const float RAY_SPREAD = 0.2f;
+    const float RAY_LENGTH = 100.f;
+
+    // Static wall across the volley path in wall scene, thinner than the distance bullets travel in one step
+    const glm::vec3 WALL_HALF_EXTENTS = glm::vec3(0.05f, 10.f, 10.f);
+
+    enum class Scene {
+        BOXES, VOLLEY, MIXED, WALL
+    };
+
+    // Correctness checks run instead of the benchmark
+    enum class Check {
+        NONE, SHAPE_CAST, SOLVER, BOX_VS_BOX, BROAD_PHASE
+    };
+
+    struct BenchSettings {
+        Scene scene = Scene::MIXED;
+        uint32_t boxes = 500;
+        uint32_t bullets_per_volley = 16;
+        uint32_t pool_capacity = bullet_pool::BULLET_POOL_DEFAULT_CAPACITY;
+        uint32_t volley_interval = 10;
+        uint32_t steps = 2000;
+        uint32_t warmup_steps = 100;
+        uint32_t seed = 1;
+        uint32_t worker_threads = 0;
+        uint32_t rays = 0;
+        bool batch_rays = true;
+        bool sweep_bullets = false;
+        bool ccd_bullets = false;
+        uint32_t step_rate = DEFAULT_STEP_RATE;
+        bool simd_solver = true;
+        uint32_t color_threshold = 0;
+        bool box_vs_box = true;
+        rp3d::BroadPhaseType broad_phase = rp3d::BroadPhaseType::DYNAMIC_AABB_TREE;
+        std::string assets_path = "assets";
+        std::string trace_path;
+        uint32_t trace_steps = 5;
+        bool csv = false;
+        Check check = Check::NONE;
+    };
+
+    const char* scene_name(Scene scene) {
+        switch (scene) {
+            case Scene::BOXES: return "boxes";
+            case Scene::VOLLEY: return "volley";
+            case Scene::MIXED: return "mixed";
+            case Scene::WALL: return "wall";
+        }
+
+        return "unknown";
+    }
+
+    const char* broad_phase_name(rp3d::BroadPhaseType broad_phase) {
+        switch (broad_phase) {
+            case rp3d::BroadPhaseType::DYNAMIC_AABB_TREE: return "tree";
+            case rp3d::BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: return "wide";
+            case rp3d::BroadPhaseType::SWEEP_AND_PRUNE: return "sap";
+        }
+
+        return "unknown";
+    }
+
+    void print_usage(const char* program) {
+        printf("Usage: %s [options]\n", program);
+        printf("  --scene <name>                Scripted scene to run: boxes, volley, mixed or wall (default: mixed)\n");
+        printf("  --boxes <n>                   Number of boxes spawned at start (default: 500)\n");
+        printf("  --bullets <n>                 Bullets per volley (default: 16)\n");
+        printf("  --volley-interval <n>         Steps between volleys (default: 10)\n");
+        printf("  --pool <n>                    Bullet pool capacity (default: %u)\n", bullet_pool::BULLET_POOL_DEFAULT_CAPACITY);
+        printf("  --steps <n>                   Number of measured steps (default: 2000)\n");
+        printf("  --warmup <n>                  Number of unmeasured steps before measuring (default: 100)\n");
+        printf("  --seed <n>                    Seed for box placement (default: 1)\n");
+        printf("  --threads <n>                 Physics worker threads in addition to main thread (default: 0)\n");
+        printf("  --scalar-solver               Solve contacts with scalar instead of SIMD contact solver\n");
+        printf("  --color-threshold <n>         Solve islands with at least n contacts by colors in parallel (default: 0, off)\n");
+        printf("  --sat-boxes                   Collide boxes with generic SAT instead of box vs box algorithm\n");
+        printf("  --rays <n>                    Hitscan rays cast each step after world update (default: 0)\n");
+        printf("  --scalar-rays                 Cast rays one by one with a callback instead of a single batch\n");
+        printf("  --sweep-bullets               Move bullets with a shape cast each step so they cannot tunnel\n");
+        printf("  --ccd-bullets                 Enable continuous collision detection on bullet bodies\n");
+        printf("  --hz <n>                      Fixed timestep rate in steps per simulated second (default: %u)\n", DEFAULT_STEP_RATE);
+        printf("  --broadphase <tree|wide|sap>  Broad-phase binary or wide (SIMD, quantized) AABB tree or sweep and prune (default: tree)\n");
+        printf("  --assets <path>               Path to assets directory (default: assets)\n");
+        printf("  --trace <path>                Write Chrome trace JSON of first measured steps\n");
+        printf("  --trace-steps <n>             Number of traced steps (default: 5)\n");
+        printf("  --csv                         Print results as single CSV line\n");
+        printf("  --verify <check>              Run correctness check instead of benchmark: shapecast, solver, boxes, broadphase\n");
+    }
+
+    bool parse_args(int argc, char* argv[], BenchSettings& settings) {
+        for (int i = 1; i < argc; i++) {
+            const bool has_value = i + 1 < argc;
+
+            if (strcmp(argv[i], "--csv") == 0) {
+                settings.csv = true;
+            } else if (strcmp(argv[i], "--scalar-solver") == 0) {
+                settings.simd_solver = false;
+            } else if (strcmp(argv[i], "--scalar-rays") == 0) {
+                settings.batch_rays = false;
+            } else if (strcmp(argv[i], "--sweep-bullets") == 0) {
+                settings.sweep_bullets = true;
+            } else if (strcmp(argv[i], "--ccd-bullets") == 0) {
+                settings.ccd_bullets = true;
+            } else if (strcmp(argv[i], "--hz") == 0 && has_value) {
+                settings.step_rate = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+            } else if (strcmp(argv[i], "--sat-boxes") == 0) {
+                settings.box_vs_box = false;
+            } else if (strcmp(argv[i], "--broadphase") == 0 && has_value) {
+                const char* value = argv[++i];
+                if (strcmp(value, "tree") == 0) {
+                    settings.broad_phase = rp3d::BroadPhaseType::DYNAMIC_AABB_TREE;
+                } else if (strcmp(value, "wide") == 0) {
+                    settings.broad_phase = rp3d::BroadPhaseType::DYNAMIC_WIDE_AABB_TREE;
+                } else if (strcmp(value, "sap") == 0) {
+                    settings.broad_phase = rp3d::BroadPhaseType::SWEEP_AND_PRUNE;
+                } else {
+                    CLOG_ERROR("Unknown broad-phase [broadphase=%s]", value);
+                    return false;
+                }
+            } else if (strcmp(argv[i], "--scene") == 0 && has_value) {
+                const char* value = argv[++i];
+                if (strcmp(value, "boxes") == 0) {
+                    settings.scene = Scene::BOXES;
+                } else if (strcmp(value, "volley") == 0) {
+                    settings.scene = Scene::VOLLEY;
+                } else if (strcmp(value, "mixed") == 0) {
+                    settings.scene = Scene::MIXED;
+                } else if (strcmp(value, "wall") == 0) {
+                    settings.scene = Scene::WALL;
+                } else {
+                    CLOG_ERROR("Unknown scene [scene=%s]", value);
+                    return false;
+                }
+            } else if (strcmp(argv[i], "--verify") == 0 && has_value) {
+                const char* value = argv[++i];
+                if (strcmp(value, "shapecast") == 0) {
+                    settings.check = Check::SHAPE_CAST;
+                } else if (strcmp(value, "solver") == 0) {
+                    settings.check = Check::SOLVER;
+                } else if (strcmp(value, "boxes") == 0) {
+                    settings.check = Check::BOX_VS_BOX;
+                } else if (strcmp(value, "broadphase") == 0) {
+                    settings.check = Check::BROAD_PHASE;
+                } else {
+                    CLOG_ERROR("Unknown check [verify=%s]", value);
+                    return false;
+                }
+            } else if (strcmp(argv[i], "--boxes") == 0 && has_value) {
+                settings.boxes = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--bullets") == 0 && has_value) {
+                settings.bullets_per_volley = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--volley-interval") == 0 && has_value) {
+                settings.volley_interval = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+            } else if (strcmp(argv[i], "--pool") == 0 && has_value) {
+                settings.pool_capacity = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--steps") == 0 && has_value) {
+                settings.steps = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+            } else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+                settings.warmup_steps = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--seed") == 0 && has_value) {
+                settings.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+                settings.worker_threads = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--color-threshold") == 0 && has_value) {
+                settings.color_threshold = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--rays") == 0 && has_value) {
+                settings.rays = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--trace") == 0 && has_value) {
+                settings.trace_path = argv[++i];
+            } else if (strcmp(argv[i], "--trace-steps") == 0 && has_value) {
+                settings.trace_steps = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            } else if (strcmp(argv[i], "--assets") == 0 && has_value) {
+                settings.assets_path = argv[++i];
+            } else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    float random_spread() {
+        return (static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * 2.f - 1.f) * VOLLEY_SPREAD;
+    }
+
+    void fire_volley(uint32_t bullets, bullet_pool::BulletPool& pool) {
+        const glm::vec3 direction = glm::normalize(VOLLEY_TARGET - VOLLEY_ORIGIN);
+
+        for (uint32_t i = 0; i < bullets; i++) {
+            glm::vec3 bullet_direction = glm::normalize(direction + glm::vec3(random_spread(), random_spread(), random_spread()));
+
+            pool.fire(VOLLEY_ORIGIN, bullet_direction);
+        }
+    }
+
+    // Keeps the closest hit of a ray cast with the per-ray API, to compare with batch raycasts
+    class ClosestHitCallback : public rp3d::RaycastCallback {
+    public:
+        rp3d::RaycastBatchHit hit;
+
+        rp3d::decimal notifyRaycastHit(const rp3d::RaycastInfo& info) override {
+            if (!hit.isHit() || info.hitFraction < hit.hitFraction) {
+                hit.worldPoint = info.worldPoint;
+                hit.worldNormal = info.worldNormal;
+                hit.hitFraction = info.hitFraction;
+                hit.body = info.body;
+                hit.collider = info.collider;
+            }
+
+            return info.hitFraction;
+        }
+    };
+
+    // Rays are generated once with their own generator, so that volleys get the same random spread with and without rays
+    std::vector<rp3d::Ray> create_rays(uint32_t count, uint32_t seed) {
+        std::minstd_rand generator(seed);
+        std::uniform_real_distribution<float> spread(-RAY_SPREAD, RAY_SPREAD);
+        const glm::vec3 direction = glm::normalize(VOLLEY_TARGET - VOLLEY_ORIGIN);
+        const rp3d::Vector3 origin(VOLLEY_ORIGIN.x, VOLLEY_ORIGIN.y, VOLLEY_ORIGIN.z);
+
+        std::vector<rp3d::Ray> rays;
+        rays.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            glm::vec3 end = VOLLEY_ORIGIN + glm::normalize(direction + glm::vec3(spread(generator), spread(generator), spread(generator))) * RAY_LENGTH;
+
+            rays.emplace_back(origin, rp3d::Vector3(end.x, end.y, end.z));
+        }
+
+        return rays;
+    }
+
+    // FNV-1a over closest hit fractions of rays that hit something
+    uint64_t ray_hits_checksum(const std::vector<rp3d::RaycastBatchHit>& hits, uint64_t hash) {
+        for (auto& hit : hits) {
+            if (!hit.isHit()) {
+                continue;
+            }
+
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&hit.hitFraction);
+            for (size_t i = 0; i < sizeof(rp3d::decimal); i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        }
+
+        return hash;
+    }
+
+    // Positions of bullet centers relative to the middle of the wall
+    void get_wall_positions(bullet_pool::BulletPool& pool, std::vector<glm::vec3>& positions) {
+        std::vector<bullet_pool::Bullet>& bullets = pool.get_bullets();
+        for (size_t i = 0; i < bullets.size(); i++) {
+            const rp3d::Vector3& position = bullets[i].entity.get_rigid_body()->getTransform().getPosition();
+            positions[i] = glm::vec3(position.x, position.y, position.z) - VOLLEY_TARGET;
+        }
+    }
+
+    // Number of bullets whose center crossed the middle plane of the wall through its face since previous positions,
+    // bullets scattered around the wall by other bullets do not count
+    uint32_t count_wall_crossings(bullet_pool::BulletPool& pool, const std::vector<glm::vec3>& previous_positions, std::vector<glm::vec3>& positions) {
+        get_wall_positions(pool, positions);
+
+        uint32_t crossings = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            const glm::vec3& previous = previous_positions[i];
+            const glm::vec3& current = positions[i];
+            if (!pool.get_bullets()[i].in_use || previous.x > 0.f || current.x <= 0.f) {
+                continue;
+            }
+
+            const glm::vec3 crossing = previous + (current - previous) * (-previous.x / (current.x - previous.x));
+            if (std::abs(crossing.y) <= WALL_HALF_EXTENTS.y && std::abs(crossing.z) <= WALL_HALF_EXTENTS.z) {
+                crossings++;
+            }
+        }
+
+        return crossings;
+    }
+
+    // FNV-1a over final body positions, used to check that simulation is identical between runs (e.g. thread counts)
+    uint64_t state_checksum(entity::Entity& entity, uint64_t hash) {
+        const rp3d::Vector3& position = entity.get_rigid_body()->getTransform().getPosition();
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&position);
+        for (size_t i = 0; i < sizeof(rp3d::Vector3); i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Checks create their own worlds, nothing from the scene is needed
+    int run_check(const BenchSettings& settings) {
+        rp3d::PhysicsCommon physics_common;
+
+        uint32_t mismatches = 0;
+        switch (settings.check) {
+            case Check::SHAPE_CAST: mismatches = bench_checks::verify_shape_cast(physics_common, settings.seed); break;
+            case Check::SOLVER: mismatches = bench_checks::verify_solver(physics_common, settings.seed); break;
+            case Check::BOX_VS_BOX: mismatches = bench_checks::verify_box_vs_box(physics_common, settings.seed); break;
+            case Check::BROAD_PHASE: mismatches = bench_checks::verify_broad_phase(physics_common, settings.seed); break;
+            case Check::NONE: break;
+        }
+
+        return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Nearest-rank percentile of sorted samples
+    uint64_t percentile(const std::vector<uint64_t>& sorted_samples, float p) {
+        size_t rank = static_cast<size_t>(p / 100.f * static_cast<float>(sorted_samples.size()) + 0.5f);
+        rank = std::min(std::max(rank, static_cast<size_t>(1)), sorted_samples.size());
+
+        return sorted_samples[rank - 1];
+    }
+}
+
+int main(int argc, char *argv[]) {
+    BenchSettings settings;
+    if (!parse_args(argc, argv, settings)) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (settings.check != Check::NONE) {
+        return run_check(settings);
+    }
+
+    srand(settings.seed);
+
+    mesh::MeshManager mesh_manager(false);
+    mesh_manager.load_mesh("plane", settings.assets_path + "/models/plane.obj", glm::vec3(5.f, 1.f, 5.f));
+    mesh_manager.load_mesh("box", settings.assets_path + "/models/cube.obj");
+    mesh_manager.load_mesh("bullet", settings.assets_path + "/models/cube.obj", glm::vec3(0.3f, 0.3f, 0.3f));
+    mesh_manager.load_mesh("wall", settings.assets_path + "/models/cube.obj", WALL_HALF_EXTENTS);
+
+    rp3d::PhysicsCommon physics_common;
+    rp3d::PhysicsWorld::WorldSettings world_settings;
+    world_settings.nbWorkerThreads = settings.worker_threads;
+    world_settings.isSimdContactSolverEnabled = settings.simd_solver;
+    world_settings.islandColoringThreshold = settings.color_threshold;
+    world_settings.broadPhaseType = settings.broad_phase;
+    rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld(world_settings);
+    world->getCollisionDispatch().setIsBoxVsBoxAlgorithmEnabled(settings.box_vs_box);
+    shape_cache::ShapeCache shape_cache(&physics_common);
+
+    std::vector<entity::Entity> entities;
+    entities.reserve(settings.boxes + 1);
+
+    entity::Entity plane("plane", glm::vec3(0.f, -3.f, 0.f), rp3d::Quaternion::identity(), entity::BodyType::RIGID);
+    plane.set_mesh("plane");
+    plane.init_physics(world, &shape_cache, mesh_manager.get_mesh(plane.get_mesh_name()));
+    entities.push_back(std::move(plane));
+
+    // Pool is created up front in all scenes (as in app), its disabled bodies are not part of the simulation
+    bullet_pool::BulletPool pool(settings.pool_capacity, world, &shape_cache, mesh_manager);
+    pool.set_swept(settings.sweep_bullets);
+    pool.set_continuous(settings.ccd_bullets);
+
+    const bool spawn_boxes = settings.scene == Scene::BOXES || settings.scene == Scene::MIXED;
+    const bool fire_volleys = settings.scene != Scene::BOXES;
+
+    // Wall cannot be knocked out of the way like boxes, so every bullet should hit it unless it tunnels through
+    if (settings.scene == Scene::WALL) {
+        entity::Entity wall("wall", VOLLEY_TARGET, rp3d::Quaternion::identity(), entity::BodyType::RIGID);
+        wall.set_mesh("wall");
+        wall.init_physics(world, &shape_cache, mesh_manager.get_mesh(wall.get_mesh_name()));
+        wall.get_rigid_body()->setType(rp3d::BodyType::STATIC);
+        entities.push_back(std::move(wall));
+    }
+
+    if (spawn_boxes) {
+        for (uint32_t i = 0; i < settings.boxes; i++) {
+            char namebuf[16];
+            snprintf(namebuf, 16, "%s%d", "box", static_cast<int>(entities.size()));
+
+            entities.push_back(spawner::spawn_random_box(namebuf, world, &shape_cache, mesh_manager));
+        }
+    }
+
+    const std::vector<rp3d::Ray> rays = create_rays(settings.rays, settings.seed);
+    std::vector<rp3d::RaycastBatchHit> ray_hits(rays.size());
+    uint64_t ray_hits_count = 0;
+    uint64_t ray_checksum = 14695981039346656037ull;
+
+    // Bullet positions before and after world update, bullets through the wall cross it within a single step
+    std::vector<glm::vec3> wall_positions(pool.get_capacity());
+    std::vector<glm::vec3> previous_wall_positions(pool.get_capacity());
+    uint64_t tunneled_count = 0;
+
+    std::vector<uint64_t> step_times;
+    step_times.reserve(settings.steps);
+
+    simple_timer::SimpleTimer step_timer;
+    simple_timer::SimpleTimer total_timer;
+
+    // Each step is one trace frame, frame numbers start at 1
+    trace::set_thread_name("Main");
+    if (!settings.trace_path.empty()) {
+        trace::install_rp3d_hooks();
+        trace::capture_frames(settings.warmup_steps + 1, std::min(settings.trace_steps, settings.steps), settings.trace_path);
+    }
+
+    const float dt = 1.f / settings.step_rate;
+    const uint32_t total_steps = settings.warmup_steps + settings.steps;
+    for (uint32_t step = 0; step < total_steps; step++) {
+        trace::next_frame();
+        TRACE_ZONE("Step");
+
+        // Spawning is part of the step, as it is in the app where input is handled each frame
+        step_timer.start();
+
+        if (step == settings.warmup_steps) {
+            total_timer.start();
+        }
+
+        if (fire_volleys && step % settings.volley_interval == 0) {
+            fire_volley(settings.bullets_per_volley, pool);
+        }
+
+        TRACE_BEGIN("Entities update");
+        for (auto& entity : entities) {
+            entity.update(dt);
+        }
+        pool.update(dt);
+        TRACE_END();
+
+        if (settings.scene == Scene::WALL) {
+            get_wall_positions(pool, previous_wall_positions);
+        }
+
+        world->update(dt);
+
+        if (settings.scene == Scene::WALL) {
+            tunneled_count += count_wall_crossings(pool, previous_wall_positions, wall_positions);
+        }
+
+        if (!rays.empty()) {
+            TRACE_ZONE("Raycasts");
+            if (settings.batch_rays) {
+                world->raycastBatch(rays.data(), static_cast<rp3d::uint>(rays.size()), ray_hits.data());
+            } else {
+                for (size_t i = 0; i < rays.size(); i++) {
+                    ClosestHitCallback callback;
+                    world->raycast(rays[i], &callback);
+                    ray_hits[i] = callback.hit;
+                }
+            }
+
+            for (auto& hit : ray_hits) {
+                ray_hits_count += hit.isHit() ? 1 : 0;
+            }
+            ray_checksum = ray_hits_checksum(ray_hits, ray_checksum);
+        }
+
+        const uint64_t step_time = step_timer.get_nanoseconds_since_start();
+        if (step >= settings.warmup_steps) {
+            step_times.push_back(step_time);
+        }
+    }
+    // Ends last step, so that capture running until the end is written
+    trace::next_frame();
+
+    const uint64_t total_time = total_timer.get_nanoseconds_since_start();
+    const size_t bodies = entities.size() + pool.get_active_count();
+    uint64_t checksum = 14695981039346656037ull;
+    for (auto& entity : entities) {
+        checksum = state_checksum(entity, checksum);
+    }
+    for (auto& bullet : pool.get_bullets()) {
+        checksum = state_checksum(bullet.entity, checksum);
+    }
+
+    std::sort(step_times.begin(), step_times.end());
+    uint64_t sum = 0;
+    for (auto step_time : step_times) {
+        sum += step_time;
+    }
+
+    const double to_ms = 1.0 / 1000000.0;
+    const double p50 = percentile(step_times, 50.f) * to_ms;
+    const double p99 = percentile(step_times, 99.f) * to_ms;
+    const double max = step_times.back() * to_ms;
+    const double mean = static_cast<double>(sum) / step_times.size() * to_ms;
+    const double steps_per_second = settings.steps / (total_time / 1000000000.0);
+    // Simulated time relative to wall time, >1 means faster than real time
+    const double realtime_factor = steps_per_second * dt;
+
+    if (settings.csv) {
+        printf("scene,bodies,steps,threads,p50_ms,p99_ms,max_ms,mean_ms,steps_per_s,realtime_factor\n");
+        printf("%s,%zu,%u,%u,%.4f,%.4f,%.4f,%.4f,%.1f,%.2f\n", scene_name(settings.scene), bodies, settings.steps,
+            settings.worker_threads, p50, p99, max, mean, steps_per_second, realtime_factor);
+    } else {
+        printf("Scene: %s [bodies=%zu, steps=%u, warmup=%u, threads=%u, solver=%s, narrowphase=%s, broadphase=%s, dt=%.1f ms]\n",
+            scene_name(settings.scene), bodies, settings.steps, settings.warmup_steps, settings.worker_threads,
+            settings.simd_solver ? "simd" : "scalar", settings.box_vs_box ? "box" : "sat", broad_phase_name(settings.broad_phase),
+            dt * 1000.f);
+        printf("Step latency: p50=%.3f ms, p99=%.3f ms, max=%.3f ms, mean=%.3f ms\n", p50, p99, max, mean);
+        printf("Throughput: %.1f steps/s (%.2fx realtime)\n", steps_per_second, realtime_factor);
+        printf("State checksum: %016llx\n", static_cast<unsigned long long>(checksum));
+        if (fire_volleys) {
+            printf("Bullet hits: %llu\n", static_cast<unsigned long long>(pool.get_hit_count()));
+        }
+        if (settings.scene == Scene::WALL) {
+            printf("Bullets through wall: %llu\n", static_cast<unsigned long long>(tunneled_count));
+        }
+        if (!rays.empty()) {
+            printf("Ray hits: %llu (%s, checksum %016llx)\n", static_cast<unsigned long long>(ray_hits_count),
+                settings.batch_rays ? "batch" : "scalar", static_cast<unsigned long long>(ray_checksum));
+        }
+    }
+
+    for (auto& entity : entities) {
+        entity.unload(world);
+    }
+    pool.unload(world);
+    shape_cache.unload();
+    mesh_manager.unload();
+
+    physics_common.destroyPhysicsWorld(world);
+
+    return EXIT_SUCCESS;
+}
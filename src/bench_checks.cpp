@@ -0,0 +1,561 @@
+#include "bench_checks.h"
+#include "clogger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "reactphysics3d/reactphysics3d.h"
+#include "reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h"
+
+namespace bullseye::bench_checks {
+    namespace {
+        // Only first mismatches of each check are logged in detail
+        const uint32_t MAX_REPORTED_MISMATCHES = 10;
+
+        // Bullet sized box cast at thin walls, large walls make GJK tolerance (relative to shape size) reach a few mm
+        const float SHAPE_CAST_BOX_HALF_EXTENT = 0.15f;
+        const float SHAPE_CAST_WALL_HALF_THICKNESS = 0.05f;
+        const float SHAPE_CAST_WALL_SIZES[] = { 1.f, 10.f, 50.f };
+        const float SHAPE_CAST_GAPS[] = { 0.001f, 0.003f, 0.006f, 0.01f, 0.02f, 0.05f };
+        const uint32_t SHAPE_CAST_CASES = 500;
+        // Allowed float error on top of conservative advancement tolerance
+        const float SHAPE_CAST_EPSILON = 0.0001f;
+
+        // Boxes dropped in a pile and stacked in towers, shot at by bullets so that contacts keep changing
+        const uint32_t SOLVER_STEPS = 400;
+        const float SOLVER_TIME_STEP = 1.f / 100.f;
+        const uint32_t SOLVER_PILE_BOXES = 200;
+        const uint32_t SOLVER_TOWERS = 4;
+        const uint32_t SOLVER_TOWER_HEIGHT = 12;
+        const float SOLVER_BOX_HALF_EXTENT = 0.5f;
+        const uint32_t SOLVER_VOLLEY_INTERVAL = 20;
+        const uint32_t SOLVER_VOLLEY_BULLETS = 8;
+        const float SOLVER_BULLET_HALF_EXTENT = 0.15f;
+        const float SOLVER_BULLET_SPEED = 40.f;
+        // Half of the boxes also get rolling resistance, so that its impulses are not all zero
+        const float SOLVER_ROLLING_RESISTANCE = 0.05f;
+        // Impulse differences are relative to the largest impulse of their kind
+        const float SOLVER_TOLERANCE = 0.0001f;
+
+        // Random box pairs, from bullet sized to large, placed so that about half of them overlap
+        const uint32_t BOX_PAIR_CASES = 20000;
+        const float BOX_PAIR_MIN_HALF_EXTENT = 0.05f;
+        const float BOX_PAIR_MAX_HALF_EXTENT = 2.f;
+        const float BOX_PAIR_TIME_STEP = 1.f / 100.f;
+        // Allowed float error of depths, pairs touching closer than that may be reported either way
+        const float BOX_PAIR_DEPTH_EPSILON = 0.001f;
+        // Both algorithms may pick a face normal instead of a slightly shallower edge axis and then a face of the first
+        // box instead of a slightly shallower face of the second one, each within these tolerances
+        const float BOX_PAIR_AXIS_RELATIVE_TOLERANCE = 1.002f;
+        const float BOX_PAIR_AXIS_ABSOLUTE_TOLERANCE = 0.0005f;
+
+        // Axis-aligned boxes moved by the world (so that narrow-phase overlap is AABB overlap), some of them fast
+        // like bullets and some large, among static boxes. Moving and static boxes are teleported or replaced by new
+        // bodies between steps, so that the static AABB tree is rebuilt during the check
+        const rp3d::BroadPhaseType BROAD_PHASE_TYPES[] = { rp3d::BroadPhaseType::DYNAMIC_AABB_TREE, rp3d::BroadPhaseType::DYNAMIC_WIDE_AABB_TREE,
+            rp3d::BroadPhaseType::SWEEP_AND_PRUNE };
+        const uint32_t BROAD_PHASE_STEPS = 300;
+        const float BROAD_PHASE_TIME_STEP = 1.f / 60.f;
+        const uint32_t BROAD_PHASE_BOXES = 400;
+        const uint32_t BROAD_PHASE_STATIC_BOXES = 150;
+        const float BROAD_PHASE_AREA_HALF_SIZE = 20.f;
+        const float BROAD_PHASE_MIN_HALF_EXTENT = 0.1f;
+        const float BROAD_PHASE_MAX_HALF_EXTENT = 1.f;
+        const float BROAD_PHASE_LARGE_HALF_EXTENT = 5.f;
+        const float BROAD_PHASE_SPEED = 10.f;
+        const float BROAD_PHASE_FAST_SPEED = 60.f;
+        const uint32_t BROAD_PHASE_CHANGE_INTERVAL = 10;
+        const uint32_t BROAD_PHASE_CHANGED_BOXES = 5;
+        // Pairs of AABBs overlapping (or separated) by less than that may be reported either way
+        const float BROAD_PHASE_EPSILON = 0.0001f;
+
+        typedef std::pair<const rp3d::CollisionBody*, const rp3d::CollisionBody*> BodyPair;
+
+        BodyPair make_body_pair(const rp3d::CollisionBody* body1, const rp3d::CollisionBody* body2) {
+            return body1 < body2 ? BodyPair(body1, body2) : BodyPair(body2, body1);
+        }
+
+        // Pairs of bodies found overlapping by the world
+        struct OverlappingBodies : public rp3d::OverlapCallback {
+            std::set<BodyPair> pairs;
+
+            void onOverlap(CallbackData& data) override {
+                for (uint32_t p = 0; p < data.getNbOverlappingPairs(); p++) {
+                    const OverlapPair pair = data.getOverlappingPair(p);
+                    this->pairs.insert(make_body_pair(pair.getBody1(), pair.getBody2()));
+                }
+            }
+        };
+
+        // Smallest overlap of two AABBs over the three axes, negative if they are separated
+        float aabb_overlap(const rp3d::AABB& aabb1, const rp3d::AABB& aabb2) {
+            const rp3d::Vector3 overlap = rp3d::Vector3::min(aabb1.getMax(), aabb2.getMax()) - rp3d::Vector3::max(aabb1.getMin(), aabb2.getMin());
+            return overlap.getMinValue();
+        }
+
+        const char* broad_phase_name(rp3d::BroadPhaseType broad_phase) {
+            switch (broad_phase) {
+                case rp3d::BroadPhaseType::DYNAMIC_AABB_TREE: return "tree";
+                case rp3d::BroadPhaseType::DYNAMIC_WIDE_AABB_TREE: return "wide";
+                case rp3d::BroadPhaseType::SWEEP_AND_PRUNE: return "sap";
+            }
+
+            return "unknown";
+        }
+
+        // Deepest contact point of the pair, normal pointing from the first to the second body
+        struct DeepestContact : public rp3d::CollisionCallback {
+            rp3d::CollisionBody* body1 = nullptr;
+            bool has_contact = false;
+            uint32_t nb_points = 0;
+            float depth = 0.f;
+            rp3d::Vector3 normal;
+
+            void onContact(const CallbackData& data) override {
+                for (uint32_t p = 0; p < data.getNbContactPairs(); p++) {
+                    const ContactPair pair = data.getContactPair(p);
+                    const float sign = pair.getBody1() == this->body1 ? 1.f : -1.f;
+                    for (uint32_t c = 0; c < pair.getNbContactPoints(); c++) {
+                        const ContactPoint point = pair.getContactPoint(c);
+                        if (!this->has_contact || point.getPenetrationDepth() > this->depth) {
+                            this->depth = point.getPenetrationDepth();
+                            this->normal = point.getWorldNormal() * sign;
+                        }
+                        this->has_contact = true;
+                        this->nb_points++;
+                    }
+                }
+            }
+        };
+
+        // Reference box pair for the contacts, from the projections of all box vertices
+        struct BoxPair {
+            rp3d::Vector3 vertices[2][8];
+            rp3d::Vector3 axes[2][3];
+
+            BoxPair(const rp3d::Vector3* half_extents, const rp3d::Transform* transforms) {
+                for (uint32_t b = 0; b < 2; b++) {
+                    const rp3d::Matrix3x3 rotation = transforms[b].getOrientation().getMatrix();
+                    for (int k = 0; k < 3; k++) {
+                        this->axes[b][k] = rotation.getColumn(k);
+                    }
+                    for (uint32_t v = 0; v < 8; v++) {
+                        const rp3d::Vector3 corner((v & 1) ? half_extents[b].x : -half_extents[b].x,
+                            (v & 2) ? half_extents[b].y : -half_extents[b].y, (v & 4) ? half_extents[b].z : -half_extents[b].z);
+                        this->vertices[b][v] = transforms[b] * corner;
+                    }
+                }
+            }
+
+            // Overlap of the boxes along a unit axis, not positive if it separates them
+            float overlap(const rp3d::Vector3& axis) const {
+                float min[2] = { axis.dot(this->vertices[0][0]), axis.dot(this->vertices[1][0]) };
+                float max[2] = { min[0], min[1] };
+                for (uint32_t b = 0; b < 2; b++) {
+                    for (uint32_t v = 1; v < 8; v++) {
+                        const float projection = axis.dot(this->vertices[b][v]);
+                        min[b] = std::min(min[b], projection);
+                        max[b] = std::max(max[b], projection);
+                    }
+                }
+
+                return std::min(max[0] - min[1], max[1] - min[0]);
+            }
+
+            // Penetration depth, the smallest overlap along the face normals and the cross products of the edges
+            // (the face normals of the Minkowski difference of two boxes are all among these 15 axes)
+            float depth() const {
+                float depth = std::min(this->face_depth(0), this->face_depth(1));
+                for (uint32_t i = 0; i < 3; i++) {
+                    for (uint32_t j = 0; j < 3; j++) {
+                        const rp3d::Vector3 axis = this->axes[0][i].cross(this->axes[1][j]);
+                        if (axis.lengthSquare() > 0.000001f) {
+                            depth = std::min(depth, this->overlap(axis.getUnit()));
+                        }
+                    }
+                }
+
+                return depth;
+            }
+
+            float face_depth(uint32_t box) const {
+                return std::min({ this->overlap(this->axes[box][0]), this->overlap(this->axes[box][1]), this->overlap(this->axes[box][2]) });
+            }
+        };
+
+        // Contacts match the reference if there are some exactly when the boxes overlap, along an axis of minimum
+        // penetration (or a face normal within tolerance of it) and with the deepest point not deeper than that
+        bool is_contact_valid(const DeepestContact& contact, const BoxPair& pair, float depth) {
+            if (!contact.has_contact) {
+                return depth <= BOX_PAIR_DEPTH_EPSILON;
+            }
+            if (depth < -BOX_PAIR_DEPTH_EPSILON) {
+                return false;
+            }
+
+            const float normal_depth = pair.overlap(contact.normal);
+            const float max_depth = (depth * BOX_PAIR_AXIS_RELATIVE_TOLERANCE + BOX_PAIR_AXIS_ABSOLUTE_TOLERANCE) * BOX_PAIR_AXIS_RELATIVE_TOLERANCE +
+                BOX_PAIR_AXIS_ABSOLUTE_TOLERANCE;
+            return normal_depth <= max_depth + BOX_PAIR_DEPTH_EPSILON &&
+                contact.depth <= normal_depth + BOX_PAIR_DEPTH_EPSILON;
+        }
+
+        bool check_parity(const char* kind, rp3d::decimal error, rp3d::decimal max_impulse) {
+            const bool matches = error <= SOLVER_TOLERANCE * std::max(max_impulse, static_cast<rp3d::decimal>(1.0));
+            printf("  %-18s max error %.3g (largest impulse %.3g)%s\n", kind, error, max_impulse, matches ? "" : " MISMATCH");
+
+            return matches;
+        }
+    }
+
+    uint32_t verify_shape_cast(rp3d::PhysicsCommon& physics_common, uint32_t seed) {
+        std::minstd_rand generator(seed);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld();
+        rp3d::BoxShape* box_shape = physics_common.createBoxShape(rp3d::Vector3(SHAPE_CAST_BOX_HALF_EXTENT, SHAPE_CAST_BOX_HALF_EXTENT, SHAPE_CAST_BOX_HALF_EXTENT));
+        const rp3d::Vector3 wall_normal(-1.f, 0.f, 0.f);
+
+        uint32_t casts = 0;
+        uint32_t mismatches = 0;
+        for (float size : SHAPE_CAST_WALL_SIZES) {
+            rp3d::BoxShape* wall_shape = physics_common.createBoxShape(rp3d::Vector3(SHAPE_CAST_WALL_HALF_THICKNESS, size, size));
+            rp3d::RigidBody* wall = world->createRigidBody(rp3d::Transform::identity());
+            wall->setType(rp3d::BodyType::STATIC);
+            rp3d::Collider* wall_collider = wall->addCollider(wall_shape, rp3d::Transform::identity());
+
+            for (float gap : SHAPE_CAST_GAPS) {
+                for (uint32_t i = 0; i < SHAPE_CAST_CASES; i++) {
+                    // Anywhere in front of the wall face, moving toward it at up to 55 degrees from its normal
+                    const rp3d::Vector3 position(-SHAPE_CAST_WALL_HALF_THICKNESS - gap - SHAPE_CAST_BOX_HALF_EXTENT,
+                        unit(generator) * size * 0.5f, unit(generator) * size * 0.5f);
+                    const rp3d::Vector3 translation(1.f, unit(generator), unit(generator));
+
+                    rp3d::ShapeCastInfo cast_info;
+                    const bool hit = world->shapeCast(box_shape, rp3d::Transform(position, rp3d::Quaternion::identity()), translation, cast_info);
+                    casts++;
+
+                    // Cast stops within tolerance of contact, so boxes starting closer than that hit right away
+                    const float advance = cast_info.hitFraction * translation.x;
+                    const float min_advance = std::max(0.f, gap - rp3d::CONSERVATIVE_ADVANCEMENT_TOLERANCE) - SHAPE_CAST_EPSILON;
+                    if (hit && cast_info.collider == wall_collider && advance >= min_advance && advance <= gap + SHAPE_CAST_EPSILON &&
+                        cast_info.worldNormal.dot(wall_normal) > 0.99f) {
+                        continue;
+                    }
+
+                    if (mismatches < MAX_REPORTED_MISMATCHES) {
+                        CLOG_WARN("Shape cast mismatch [wall=%.0f m, gap=%.1f mm, hit=%d, advance=%.2f mm, normal=(%.2f, %.2f, %.2f)]",
+                            size, gap * 1000.f, hit ? 1 : 0, advance * 1000.f, cast_info.worldNormal.x, cast_info.worldNormal.y, cast_info.worldNormal.z);
+                    }
+                    mismatches++;
+                }
+            }
+
+            world->destroyRigidBody(wall);
+            physics_common.destroyBoxShape(wall_shape);
+        }
+
+        physics_common.destroyBoxShape(box_shape);
+        physics_common.destroyPhysicsWorld(world);
+
+        printf("Shape cast: %u casts, %u mismatches\n", casts, mismatches);
+
+        return mismatches;
+    }
+
+    uint32_t verify_solver(rp3d::PhysicsCommon& physics_common, uint32_t seed) {
+        std::minstd_rand generator(seed);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        rp3d::PhysicsWorld::WorldSettings world_settings;
+        world_settings.isSimdContactSolverEnabled = true;
+        rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld(world_settings);
+        world->enableContactSolverParityCheck(true);
+
+        rp3d::BoxShape* ground_shape = physics_common.createBoxShape(rp3d::Vector3(50.f, 1.f, 50.f));
+        rp3d::BoxShape* box_shape = physics_common.createBoxShape(rp3d::Vector3(SOLVER_BOX_HALF_EXTENT, SOLVER_BOX_HALF_EXTENT, SOLVER_BOX_HALF_EXTENT));
+        rp3d::BoxShape* bullet_shape = physics_common.createBoxShape(rp3d::Vector3(SOLVER_BULLET_HALF_EXTENT, SOLVER_BULLET_HALF_EXTENT, SOLVER_BULLET_HALF_EXTENT));
+
+        std::vector<rp3d::RigidBody*> bodies;
+        rp3d::RigidBody* ground = world->createRigidBody(rp3d::Transform(rp3d::Vector3(0.f, -1.f, 0.f), rp3d::Quaternion::identity()));
+        ground->setType(rp3d::BodyType::STATIC);
+        ground->addCollider(ground_shape, rp3d::Transform::identity());
+        bodies.push_back(ground);
+
+        for (uint32_t i = 0; i < SOLVER_PILE_BOXES; i++) {
+            const rp3d::Vector3 position(unit(generator) * 4.f, 2.f + i * 0.25f, unit(generator) * 4.f);
+            rp3d::Quaternion orientation(unit(generator), unit(generator), unit(generator), 1.f);
+            orientation.normalize();
+
+            rp3d::RigidBody* box = world->createRigidBody(rp3d::Transform(position, orientation));
+            rp3d::Collider* collider = box->addCollider(box_shape, rp3d::Transform::identity());
+            if (i % 2 == 0) {
+                collider->getMaterial().setRollingResistance(SOLVER_ROLLING_RESISTANCE);
+            }
+            bodies.push_back(box);
+        }
+
+        for (uint32_t t = 0; t < SOLVER_TOWERS; t++) {
+            for (uint32_t i = 0; i < SOLVER_TOWER_HEIGHT; i++) {
+                const rp3d::Vector3 position(10.f + t * 3.f, SOLVER_BOX_HALF_EXTENT + i * 2.f * SOLVER_BOX_HALF_EXTENT, 0.f);
+                rp3d::RigidBody* box = world->createRigidBody(rp3d::Transform(position, rp3d::Quaternion::identity()));
+                box->addCollider(box_shape, rp3d::Transform::identity());
+                bodies.push_back(box);
+            }
+        }
+
+        for (uint32_t step = 0; step < SOLVER_STEPS; step++) {
+            // Bullets are fired at the towers and left in the world
+            if (step % SOLVER_VOLLEY_INTERVAL == 0) {
+                for (uint32_t i = 0; i < SOLVER_VOLLEY_BULLETS; i++) {
+                    const rp3d::Vector3 target(10.f + (i % SOLVER_TOWERS) * 3.f, 1.f + (unit(generator) + 1.f) * SOLVER_TOWER_HEIGHT * SOLVER_BOX_HALF_EXTENT, 0.f);
+                    const rp3d::Vector3 position(target.x + unit(generator), target.y, -10.f);
+
+                    rp3d::RigidBody* bullet = world->createRigidBody(rp3d::Transform(position, rp3d::Quaternion::identity()));
+                    bullet->addCollider(bullet_shape, rp3d::Transform::identity());
+                    bullet->setLinearVelocity((target - position).getUnit() * SOLVER_BULLET_SPEED);
+                    bodies.push_back(bullet);
+                }
+            }
+
+            world->update(SOLVER_TIME_STEP);
+        }
+
+        const rp3d::ContactSolverParity& parity = world->getContactSolverParity();
+        printf("Contact solver: %u steps, %u contact manifolds, %u contact points\n", SOLVER_STEPS, parity.nbContactManifolds, parity.nbContactPoints);
+
+        uint32_t mismatches = 0;
+        mismatches += check_parity("Penetration", parity.maxPenetrationImpulseError, parity.maxPenetrationImpulse) ? 0 : 1;
+        mismatches += check_parity("Friction", parity.maxFrictionImpulseError, parity.maxFrictionImpulse) ? 0 : 1;
+        mismatches += check_parity("Twist friction", parity.maxTwistImpulseError, parity.maxTwistImpulse) ? 0 : 1;
+        mismatches += check_parity("Rolling resistance", parity.maxRollingResistanceImpulseError, parity.maxRollingResistanceImpulse) ? 0 : 1;
+
+        for (auto body : bodies) {
+            world->destroyRigidBody(body);
+        }
+        physics_common.destroyBoxShape(bullet_shape);
+        physics_common.destroyBoxShape(box_shape);
+        physics_common.destroyBoxShape(ground_shape);
+        physics_common.destroyPhysicsWorld(world);
+
+        return mismatches;
+    }
+
+    uint32_t verify_box_vs_box(rp3d::PhysicsCommon& physics_common, uint32_t seed) {
+        std::minstd_rand generator(seed);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+        std::uniform_real_distribution<float> extent(BOX_PAIR_MIN_HALF_EXTENT, BOX_PAIR_MAX_HALF_EXTENT);
+
+        // Algorithm is selected when the overlapping pair is created, so each world keeps its own
+        rp3d::PhysicsWorld* worlds[2] = { physics_common.createPhysicsWorld(), physics_common.createPhysicsWorld() };
+        worlds[1]->getCollisionDispatch().setIsBoxVsBoxAlgorithmEnabled(false);
+        // Shapes are resized for each pair instead of creating new colliders
+        rp3d::BoxShape* shapes[2] = { physics_common.createBoxShape(rp3d::Vector3(1.f, 1.f, 1.f)), physics_common.createBoxShape(rp3d::Vector3(1.f, 1.f, 1.f)) };
+        rp3d::RigidBody* bodies[2][2];
+        for (uint32_t w = 0; w < 2; w++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                bodies[w][b] = worlds[w]->createRigidBody(rp3d::Transform::identity());
+                bodies[w][b]->setType(rp3d::BodyType::KINEMATIC);
+                bodies[w][b]->setIsAllowedToSleep(false);
+                bodies[w][b]->addCollider(shapes[b], rp3d::Transform::identity());
+            }
+        }
+
+        uint32_t collisions = 0;
+        uint32_t mismatches = 0;
+        uint32_t sat_mismatches = 0;
+        for (uint32_t i = 0; i < BOX_PAIR_CASES; i++) {
+            rp3d::Vector3 half_extents[2];
+            rp3d::Transform transforms[2];
+            for (uint32_t b = 0; b < 2; b++) {
+                half_extents[b] = rp3d::Vector3(extent(generator), extent(generator), extent(generator));
+                rp3d::Quaternion orientation(unit(generator), unit(generator), unit(generator), 1.f);
+                orientation.normalize();
+                transforms[b] = rp3d::Transform(rp3d::Vector3::zero(), orientation);
+            }
+            // Every fourth pair keeps the same orientation, face to face contacts are where clipping differs most
+            if (i % 4 == 0) {
+                transforms[1].setOrientation(transforms[0].getOrientation());
+            }
+            // Second box around the first one, within the distance of their bounding spheres
+            const float reach = half_extents[0].length() + half_extents[1].length();
+            rp3d::Vector3 direction(unit(generator), unit(generator), unit(generator));
+            direction.normalize();
+            transforms[1].setPosition(direction * reach * (0.2f + 0.6f * (unit(generator) + 1.f) * 0.5f));
+
+            DeepestContact contacts[2];
+            for (uint32_t b = 0; b < 2; b++) {
+                shapes[b]->setHalfExtents(half_extents[b]);
+            }
+            for (uint32_t w = 0; w < 2; w++) {
+                for (uint32_t b = 0; b < 2; b++) {
+                    bodies[w][b]->setTransform(transforms[b]);
+                }
+                contacts[w].body1 = bodies[w][0];
+                worlds[w]->testCollision(bodies[w][0], bodies[w][1], contacts[w]);
+                // Queries keep their memory until the next step (resting kinematic bodies do not move)
+                worlds[w]->update(BOX_PAIR_TIME_STEP);
+            }
+
+            const BoxPair pair(half_extents, transforms);
+            const float depth = pair.depth();
+            if (depth > 0.f) {
+                collisions++;
+            }
+
+            // Generic SAT is the previous path, its mismatches are reported but do not fail the check
+            if (!is_contact_valid(contacts[1], pair, depth)) {
+                sat_mismatches++;
+            }
+            if (is_contact_valid(contacts[0], pair, depth)) {
+                continue;
+            }
+
+            if (mismatches < MAX_REPORTED_MISMATCHES) {
+                const DeepestContact& box = contacts[0];
+                CLOG_WARN("Box vs box mismatch [case=%u, depth=%.4f, contact=%d, points=%u, contact depth=%.4f, normal=(%.2f, %.2f, %.2f), depth along normal=%.4f]",
+                    i, depth, box.has_contact ? 1 : 0, box.nb_points, box.depth, box.normal.x, box.normal.y, box.normal.z,
+                    box.has_contact ? pair.overlap(box.normal) : 0.f);
+            }
+            mismatches++;
+        }
+
+        for (uint32_t w = 0; w < 2; w++) {
+            for (uint32_t b = 0; b < 2; b++) {
+                worlds[w]->destroyRigidBody(bodies[w][b]);
+            }
+            physics_common.destroyPhysicsWorld(worlds[w]);
+        }
+        physics_common.destroyBoxShape(shapes[0]);
+        physics_common.destroyBoxShape(shapes[1]);
+
+        printf("Box vs box: %u pairs, %u colliding, %u mismatches (generic SAT: %u)\n", BOX_PAIR_CASES, collisions, mismatches, sat_mismatches);
+
+        return mismatches;
+    }
+
+    uint32_t verify_broad_phase(rp3d::PhysicsCommon& physics_common, uint32_t seed) {
+        uint32_t mismatches = 0;
+        for (rp3d::BroadPhaseType broad_phase : BROAD_PHASE_TYPES) {
+            // Same scene for each broad-phase
+            std::minstd_rand generator(seed);
+            std::uniform_real_distribution<float> unit(-1.f, 1.f);
+            std::uniform_real_distribution<float> extent(BROAD_PHASE_MIN_HALF_EXTENT, BROAD_PHASE_MAX_HALF_EXTENT);
+
+            rp3d::PhysicsWorld::WorldSettings world_settings;
+            world_settings.broadPhaseType = broad_phase;
+            rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld(world_settings);
+
+            // Static boxes come after the moving ones
+            const uint32_t nb_boxes = BROAD_PHASE_BOXES + BROAD_PHASE_STATIC_BOXES;
+            std::vector<rp3d::BoxShape*> shapes;
+            std::vector<rp3d::RigidBody*> bodies;
+            for (uint32_t i = 0; i < nb_boxes; i++) {
+                const float half_extent = i % 50 == 0 ? BROAD_PHASE_LARGE_HALF_EXTENT : 0.f;
+                shapes.push_back(physics_common.createBoxShape(half_extent > 0.f ? rp3d::Vector3(half_extent, half_extent, half_extent) :
+                    rp3d::Vector3(extent(generator), extent(generator), extent(generator))));
+                bodies.push_back(nullptr);
+            }
+
+            const auto random_position = [&]() {
+                return rp3d::Vector3(unit(generator), unit(generator), unit(generator)) * BROAD_PHASE_AREA_HALF_SIZE;
+            };
+            const auto create_box = [&](uint32_t i) {
+                rp3d::RigidBody* body = world->createRigidBody(rp3d::Transform(random_position(), rp3d::Quaternion::identity()));
+                body->addCollider(shapes[i], rp3d::Transform::identity());
+                bodies[i] = body;
+                if (i >= BROAD_PHASE_BOXES) {
+                    body->setType(rp3d::BodyType::STATIC);
+                    return;
+                }
+
+                body->setType(rp3d::BodyType::KINEMATIC);
+                body->setIsAllowedToSleep(false);
+                rp3d::Vector3 direction(unit(generator), unit(generator), unit(generator));
+                direction.normalize();
+                body->setLinearVelocity(direction * (i % 10 == 0 ? BROAD_PHASE_FAST_SPEED : BROAD_PHASE_SPEED));
+            };
+            for (uint32_t i = 0; i < nb_boxes; i++) {
+                create_box(i);
+            }
+
+            uint32_t pairs = 0;
+            uint32_t type_mismatches = 0;
+            for (uint32_t step = 0; step < BROAD_PHASE_STEPS; step++) {
+                if (step % BROAD_PHASE_CHANGE_INTERVAL == 0) {
+                    for (uint32_t c = 0; c < BROAD_PHASE_CHANGED_BOXES; c++) {
+                        const uint32_t i = generator() % nb_boxes;
+                        bodies[i]->setTransform(rp3d::Transform(random_position(), rp3d::Quaternion::identity()));
+                    }
+                    for (uint32_t c = 0; c < BROAD_PHASE_CHANGED_BOXES; c++) {
+                        const uint32_t i = generator() % nb_boxes;
+                        world->destroyRigidBody(bodies[i]);
+                        create_box(i);
+                    }
+                }
+
+                world->update(BROAD_PHASE_TIME_STEP);
+
+                // Moving boxes bounce back into the area
+                for (uint32_t i = 0; i < BROAD_PHASE_BOXES; i++) {
+                    rp3d::RigidBody* body = bodies[i];
+                    const rp3d::Vector3& position = body->getTransform().getPosition();
+                    rp3d::Vector3 velocity = body->getLinearVelocity();
+                    for (int k = 0; k < 3; k++) {
+                        if (std::abs(position[k]) > BROAD_PHASE_AREA_HALF_SIZE && position[k] * velocity[k] > 0.f) {
+                            velocity[k] = -velocity[k];
+                        }
+                    }
+                    body->setLinearVelocity(velocity);
+                }
+
+                OverlappingBodies overlapping;
+                world->testOverlap(overlapping);
+
+                // Every pair of overlapping AABBs must be found (except pairs of static boxes), and only those
+                std::vector<rp3d::AABB> aabbs;
+                for (auto body : bodies) {
+                    aabbs.push_back(body->getCollider(0)->getWorldAABB());
+                }
+                for (uint32_t i = 0; i < BROAD_PHASE_BOXES; i++) {
+                    for (uint32_t j = i + 1; j < bodies.size(); j++) {
+                        const float overlap = aabb_overlap(aabbs[i], aabbs[j]);
+                        if (std::abs(overlap) <= BROAD_PHASE_EPSILON) {
+                            continue;
+                        }
+
+                        const bool is_found = overlapping.pairs.count(make_body_pair(bodies[i], bodies[j])) > 0;
+                        if (overlap > 0.f) {
+                            pairs++;
+                        }
+                        if (is_found == (overlap > 0.f)) {
+                            continue;
+                        }
+
+                        if (type_mismatches < MAX_REPORTED_MISMATCHES) {
+                            CLOG_WARN("Broad phase mismatch [broadphase=%s, step=%u, boxes=(%u, %u), found=%d, overlap=%.4f]",
+                                broad_phase_name(broad_phase), step, i, j, is_found ? 1 : 0, overlap);
+                        }
+                        type_mismatches++;
+                    }
+                }
+            }
+
+            for (auto body : bodies) {
+                world->destroyRigidBody(body);
+            }
+            for (auto shape : shapes) {
+                physics_common.destroyBoxShape(shape);
+            }
+            physics_common.destroyPhysicsWorld(world);
+
+            printf("Broad phase %s: %u steps, %u overlapping pairs, %u mismatches\n", broad_phase_name(broad_phase), BROAD_PHASE_STEPS, pairs, type_mismatches);
+            mismatches += type_mismatches;
+        }
+
+        return mismatches;
+    }
+}
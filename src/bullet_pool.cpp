@@ -0,0 +1,214 @@
+#include "bullet_pool.h"
+#include "spawner.h"
+#include "clogger.h"
+
+#include <string>
+
+namespace bullseye::bullet_pool {
+    BulletPool::BulletPool(uint32_t capacity, rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager) {
+        this->fire_sequence = 0;
+        this->hit_count = 0;
+        this->world = world;
+        this->swept = false;
+
+        // Reserved once, pointers to bullets are stored as body user data so vector must never reallocate
+        this->bullets.reserve(capacity);
+        this->free_slots.reserve(capacity);
+
+        for (uint32_t i = 0; i < capacity; i++) {
+            entity::Entity bullet_entity("bullet" + std::to_string(i), BULLET_PARK_POSITION, rp3d::Quaternion::identity(), entity::BodyType::RIGID);
+            bullet_entity.set_mesh("bullet");
+            bullet_entity.init_physics(world, shape_cache, mesh_manager.get_mesh("bullet"), spawner::BULLET_MASS);
+            bullet_entity.set_active(false);
+            bullet_entity.get_collision_body()->getCollider(0)->setCollisionCategoryBits(BULLET_COLLISION_CATEGORY);
+
+            this->bullets.push_back(Bullet { bullet_entity, BULLET_PARK_POSITION, glm::vec3(0.f), 0.f, 0, false, false });
+            this->bullets.back().entity.get_collision_body()->setUserData(&this->bullets.back());
+        }
+
+        // Slots are popped from back, keep lowest indices first
+        for (uint32_t i = capacity; i > 0; i--) {
+            this->free_slots.push_back(i - 1);
+        }
+
+        world->setEventListener(this);
+
+        CLOG_DEBUG("Bullet pool created [capacity=%u]", capacity);
+    }
+
+    BulletPool::~BulletPool() {
+
+    }
+
+    uint32_t BulletPool::acquire_slot() {
+        if (!this->free_slots.empty()) {
+            const uint32_t slot = this->free_slots.back();
+            this->free_slots.pop_back();
+
+            return slot;
+        }
+
+        // Pool exhausted, reuse bullet that has been flying for the longest time
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < this->bullets.size(); i++) {
+            if (this->bullets[i].fire_sequence < this->bullets[oldest].fire_sequence) {
+                oldest = i;
+            }
+        }
+
+        return oldest;
+    }
+
+    uint32_t BulletPool::fire(const glm::vec3& position, const glm::vec3& direction) {
+        if (this->bullets.empty()) {
+            return static_cast<uint32_t>(this->bullets.size());
+        }
+
+        const uint32_t slot = acquire_slot();
+        Bullet& bullet = this->bullets[slot];
+        bullet.origin = position;
+        bullet.direction = direction;
+        bullet.ttl = BULLET_TTL;
+        bullet.fire_sequence = this->fire_sequence++;
+        bullet.in_use = true;
+        bullet.hit = false;
+
+        bullet.entity.reset_physics(position, rp3d::Quaternion::fromEulerAngles(rp3d::Vector3(direction.x, direction.y, direction.z)));
+        bullet.entity.set_force(direction * spawner::BULLET_FORCE);
+        bullet.entity.set_active(true);
+
+        return slot;
+    }
+
+    void BulletPool::release(uint32_t slot) {
+        Bullet& bullet = this->bullets[slot];
+        bullet.in_use = false;
+        bullet.hit = false;
+
+        bullet.entity.set_force(glm::vec3(0.f));
+        bullet.entity.reset_physics(BULLET_PARK_POSITION, rp3d::Quaternion::identity());
+        bullet.entity.set_active(false);
+
+        this->free_slots.push_back(slot);
+    }
+
+    void BulletPool::update(float delta_time) {
+        for (uint32_t i = 0; i < this->bullets.size(); i++) {
+            Bullet& bullet = this->bullets[i];
+            if (!bullet.in_use) {
+                continue;
+            }
+
+            bullet.ttl -= delta_time;
+
+            const rp3d::Vector3& position = bullet.entity.get_rigid_body()->getTransform().getPosition();
+            const float distance = glm::length(glm::vec3(position.x, position.y, position.z) - bullet.origin);
+
+            if (bullet.hit) {
+                this->hit_count++;
+            }
+
+            if (bullet.hit || bullet.ttl <= 0.f || distance > BULLET_MAX_RANGE) {
+                release(i);
+                continue;
+            }
+
+            bullet.entity.update(delta_time);
+
+            if (this->swept) {
+                sweep(bullet, delta_time);
+            }
+        }
+    }
+
+    void BulletPool::sweep(Bullet& bullet, float delta_time) {
+        rp3d::RigidBody* body = bullet.entity.get_rigid_body();
+        const rp3d::Collider* collider = body->getCollider(0);
+
+        // Same semi-implicit Euler step the world is going to take: velocity is integrated first, then position
+        const glm::vec3 thrust = bullet.direction * (spawner::BULLET_FORCE / spawner::BULLET_MASS);
+        rp3d::Vector3 acceleration(thrust.x, thrust.y, thrust.z);
+        if (this->world->isGravityEnabled() && body->isGravityEnabled()) {
+            acceleration += this->world->getGravity();
+        }
+        const rp3d::Vector3 translation = (body->getLinearVelocity() + acceleration * delta_time) * delta_time;
+
+        rp3d::ShapeCastInfo cast_info;
+        const unsigned short cast_mask = static_cast<unsigned short>(~BULLET_COLLISION_CATEGORY);
+        if (!this->world->shapeCast(collider->getCollisionShape(), collider->getLocalToWorldTransform(), translation, cast_info, cast_mask, body)) {
+            return;
+        }
+
+        // Leave bullet at the point of impact, it is recycled in next update() just like after a contact
+        rp3d::Transform transform = body->getTransform();
+        transform.setPosition(transform.getPosition() + translation * cast_info.hitFraction);
+        body->setTransform(transform);
+        body->setLinearVelocity(rp3d::Vector3::zero());
+        bullet.hit = true;
+    }
+
+    Bullet* BulletPool::get_bullet(rp3d::CollisionBody* body) {
+        Bullet* bullet = static_cast<Bullet*>(body->getUserData());
+        if (bullet >= this->bullets.data() && bullet < this->bullets.data() + this->bullets.size()) {
+            return bullet;
+        }
+
+        return nullptr;
+    }
+
+    void BulletPool::onContact(const rp3d::CollisionCallback::CallbackData& callback_data) {
+        for (uint32_t p = 0; p < callback_data.getNbContactPairs(); p++) {
+            rp3d::CollisionCallback::ContactPair contact_pair = callback_data.getContactPair(p);
+            if (contact_pair.getEventType() != rp3d::CollisionCallback::ContactPair::EventType::ContactStart) {
+                continue;
+            }
+
+            // Bodies cannot be disabled while world is updating, only mark them here.
+            // Bullets fired together start overlapping, so contacts between bullets do not count as hits.
+            Bullet* bullet1 = get_bullet(contact_pair.getBody1());
+            Bullet* bullet2 = get_bullet(contact_pair.getBody2());
+            if (bullet1 != nullptr && bullet2 == nullptr) {
+                bullet1->hit = true;
+            } else if (bullet2 != nullptr && bullet1 == nullptr) {
+                bullet2->hit = true;
+            }
+        }
+    }
+
+    void BulletPool::unload(rp3d::PhysicsWorld* world) {
+        world->setEventListener(nullptr);
+
+        for (auto& bullet : this->bullets) {
+            bullet.entity.unload(world);
+        }
+
+        this->bullets.clear();
+        this->free_slots.clear();
+    }
+
+    std::vector<Bullet>& BulletPool::get_bullets() {
+        return this->bullets;
+    }
+
+    uint32_t BulletPool::get_active_count() {
+        return this->bullets.size() - this->free_slots.size();
+    }
+
+    void BulletPool::set_swept(bool swept) {
+        this->swept = swept;
+    }
+
+    void BulletPool::set_continuous(bool continuous) {
+        for (auto& bullet : this->bullets) {
+            bullet.entity.get_rigid_body()->setIsCCDEnabled(continuous);
+        }
+    }
+
+    uint32_t BulletPool::get_capacity() {
+        return this->bullets.size();
+    }
+
+    uint64_t BulletPool::get_hit_count() {
+        return this->hit_count;
+    }
+}
\ No newline at end of file
@@ -9,7 +9,6 @@
 #include <vector>
 
 #include "glm/gtc/matrix_transform.hpp"
-#include "glm/gtc/type_ptr.hpp"
 #include "reactphysics3d/reactphysics3d.h"
 
 namespace bullseye::entity {
@@ -21,34 +20,36 @@ namespace bullseye::entity {
         this->previous_rotation = glm::vec3(0.f);
         this->rotation_speed = glm::vec3(0.f);
         this->body_type = body_type;
+        this->shape_cache = nullptr;
+        this->collision_shape = nullptr;
 
-        this->previous_transform = rp3d::Transform(rp3d::Vector3(position.x, position.y, position.z), orientation);
+        this->initial_transform = rp3d::Transform(rp3d::Vector3(position.x, position.y, position.z), orientation);
     }
 
     Entity::~Entity() {
 
     }
 
-    void Entity::init_physics(rp3d::PhysicsWorld* physics_world, rp3d::PhysicsCommon* physics_common, mesh::Mesh* mesh, float mass) {
-        assert(physics_common != nullptr);
+    void Entity::init_physics(rp3d::PhysicsWorld* physics_world, shape_cache::ShapeCache* shape_cache, mesh::Mesh* mesh, float mass) {
+        assert(shape_cache != nullptr);
         assert(physics_world != nullptr);
 
-        this->physics_common = physics_common;
+        this->shape_cache = shape_cache;
         this->physics_world = physics_world;
 
         CLOG_DEBUG("Initializing physics for entity %s, transform[pos=[%.2f, %.2f, %.2f], orientation=[%.2f, %.2f, %.2f, %.2f]]",
-            this->name.c_str(), this->previous_transform.getPosition().x, this->previous_transform.getPosition().y, this->previous_transform.getPosition().z,
-            this->previous_transform.getOrientation().x, this->previous_transform.getOrientation().y, this->previous_transform.getOrientation().z, this->previous_transform.getOrientation().w);
+            this->name.c_str(), this->initial_transform.getPosition().x, this->initial_transform.getPosition().y, this->initial_transform.getPosition().z,
+            this->initial_transform.getOrientation().x, this->initial_transform.getOrientation().y, this->initial_transform.getOrientation().z, this->initial_transform.getOrientation().w);
 
         if (body_type != BodyType::NO_PHYSICS) {
-            rp3d::BoxShape* boxShape = physics_common->createBoxShape(rp3d::Vector3(
-                mesh->get_extents().x, mesh->get_extents().y, mesh->get_extents().z));
+            // Shared with all other entities using mesh with same extents
+            this->collision_shape = shape_cache->acquire_box_shape(mesh->get_extents());
 
             if (body_type == BodyType::RIGID) {
                 CLOG_DEBUG("Adding rigid body for entity: %s, mesh: %s", this->name.c_str(), mesh->get_name());
                     
-                this->physics_body = physics_world->createRigidBody(this->previous_transform);
-                this->physics_body->addCollider(boxShape, rp3d::Transform(rp3d::Vector3(), rp3d::Quaternion::identity()));
+                this->physics_body = physics_world->createRigidBody(this->initial_transform);
+                this->physics_body->addCollider(this->collision_shape, rp3d::Transform(rp3d::Vector3(), rp3d::Quaternion::identity()));
                 if (mass > 0.f) {
                     dynamic_cast<rp3d::RigidBody*>(this->physics_body)->setMass(mass);
                 }
@@ -62,8 +63,8 @@ namespace bullseye::entity {
             if (body_type == BodyType::COLLISION) {
                 CLOG_DEBUG("Adding collision body for entity: %s, mesh: %s", this->name.c_str(), mesh->get_name());
 
-                this->physics_body = physics_world->createCollisionBody(this->previous_transform);
-                this->physics_body->addCollider(boxShape, rp3d::Transform(rp3d::Vector3(), rp3d::Quaternion::identity()));
+                this->physics_body = physics_world->createCollisionBody(this->initial_transform);
+                this->physics_body->addCollider(this->collision_shape, rp3d::Transform(rp3d::Vector3(), rp3d::Quaternion::identity()));
             }
             
         }
@@ -83,17 +84,6 @@ namespace bullseye::entity {
         }
     }
 
-    glm::mat4 Entity::get_model_matrix(float interp) {
-        rp3d::Transform current_transform = this->physics_body->getTransform();
-        rp3d::Transform interpolated_transform = rp3d::Transform::interpolateTransforms(this->previous_transform, current_transform, interp);
-        this->previous_transform = current_transform;
-
-        float model_matrix[16];
-        interpolated_transform.getOpenGLMatrix(model_matrix);
-
-        return glm::make_mat4(model_matrix);
-    }
-
     void Entity::unload(rp3d::PhysicsWorld* world) {
         if (world != nullptr && this->physics_body != nullptr) {
             if (this->body_type == BodyType::COLLISION) {
@@ -104,6 +94,12 @@ namespace bullseye::entity {
                 world->destroyRigidBody(dynamic_cast<rp3d::RigidBody*>(this->physics_body));
             }
         }
+
+        // Collider is gone with the body, shape can be released now
+        if (this->shape_cache != nullptr && this->collision_shape != nullptr) {
+            this->shape_cache->release(this->collision_shape);
+            this->collision_shape = nullptr;
+        }
     }
 
     void Entity::set_mesh(std::string mesh_name) {
@@ -142,4 +138,26 @@ namespace bullseye::entity {
     void Entity::set_force(glm::vec3 force) {
         this->applied_force = rp3d::Vector3(force.x, force.y, force.z);
     }
+
+    void Entity::set_active(bool active) {
+        this->physics_body->setIsActive(active);
+    }
+
+    bool Entity::is_active() {
+        return this->physics_body->isActive();
+    }
+
+    // Moves body to new transform and stops it, so that the same body can be reused (e.g. pooled bullets)
+    void Entity::reset_physics(const glm::vec3& position, const rp3d::Quaternion& orientation) {
+        this->position = position;
+        this->previous_position = position;
+        this->initial_transform = rp3d::Transform(rp3d::Vector3(position.x, position.y, position.z), orientation);
+        this->physics_body->setTransform(this->initial_transform);
+
+        if (this->body_type == BodyType::RIGID) {
+            rp3d::RigidBody* rigid_body = dynamic_cast<rp3d::RigidBody*>(this->physics_body);
+            rigid_body->setLinearVelocity(rp3d::Vector3::zero());
+            rigid_body->setAngularVelocity(rp3d::Vector3::zero());
+        }
+    }
 }
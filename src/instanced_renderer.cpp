@@ -0,0 +1,87 @@
+#include "instanced_renderer.h"
+#include "clogger.h"
+
+#include "glad/glad.h"
+
+namespace bullseye::render {
+    InstancedRenderer::InstancedRenderer() {
+        this->batches.reserve(INSTANCED_RENDERER_INITIAL_BATCHES);
+        this->texture_diffuse = shader::INVALID_UNIFORM_HANDLE;
+    }
+
+    InstancedRenderer::~InstancedRenderer() {
+
+    }
+
+    void InstancedRenderer::init(shader::Shader &shader) {
+        this->texture_diffuse = shader.get_uniform_handle("texture_diffuse1");
+    }
+
+    void InstancedRenderer::begin_frame() {
+        for (auto& batch : this->batches) {
+            batch.models.clear();
+        }
+    }
+
+    void InstancedRenderer::submit(mesh::Mesh* mesh, const uint32_t texture_id, const glm::mat4& model) {
+        get_batch(mesh, texture_id).models.push_back(model);
+    }
+
+    InstanceBatch& InstancedRenderer::get_batch(mesh::Mesh* mesh, const uint32_t texture_id) {
+        // There are only a few mesh/texture combinations, linear search is fine
+        for (auto& batch : this->batches) {
+            if (batch.mesh == mesh && batch.texture_id == texture_id) {
+                return batch;
+            }
+        }
+
+        InstanceBatch batch;
+        batch.mesh = mesh;
+        batch.texture_id = texture_id;
+        batch.instance_vbo_capacity = 0;
+        glGenBuffers(1, &batch.instance_vbo);
+
+        CLOG_DEBUG("Created instance batch [mesh=%s, texture_id=%u]", mesh->get_name(), texture_id);
+
+        this->batches.push_back(std::move(batch));
+
+        return this->batches.back();
+    }
+
+    void InstancedRenderer::update_instance_vbo(InstanceBatch& batch) {
+        const uint32_t count = batch.models.size();
+
+        glBindBuffer(GL_ARRAY_BUFFER, batch.instance_vbo);
+        if (count > batch.instance_vbo_capacity) {
+            // Grow geometrically so spawning bullets does not reallocate buffer every frame
+            batch.instance_vbo_capacity = count > batch.instance_vbo_capacity * 2 ? count : batch.instance_vbo_capacity * 2;
+            glBufferData(GL_ARRAY_BUFFER, batch.instance_vbo_capacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(glm::mat4), batch.models.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void InstancedRenderer::draw(shader::Shader &shader) {
+        // Shader is expected to be in use with per-frame uniforms already set
+        shader.set_int(this->texture_diffuse, 0);
+        glActiveTexture(GL_TEXTURE0);
+
+        for (auto& batch : this->batches) {
+            if (batch.models.empty()) {
+                continue;
+            }
+
+            update_instance_vbo(batch);
+
+            glBindTexture(GL_TEXTURE_2D, batch.texture_id);
+            batch.mesh->draw_instanced(batch.instance_vbo, batch.models.size());
+        }
+    }
+
+    void InstancedRenderer::unload() {
+        for (auto& batch : this->batches) {
+            glDeleteBuffers(1, &batch.instance_vbo);
+        }
+        this->batches.clear();
+    }
+}
\ No newline at end of file
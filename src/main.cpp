@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <cstring>
 #include <cmath>
+#include <thread>
 
 #include <SDL.h>
 #include <SDL_keycode.h>
@@ -31,16 +32,45 @@
 #include "consts.h"
 #include "texture_manager.h"
 #include "physics_debug_renderer.h"
+#include "instanced_renderer.h"
 #include "mesh_manager.h"
+#include "spawner.h"
+#include "shape_cache.h"
+#include "bullet_pool.h"
+#include "asset_loader.h"
+#include "tracer.h"
+#include "physics_thread.h"
 
 const int WIDTH = 1280;
 const int HEIGHT = 720;
+// Frames recorded by "Capture trace" button
+const uint32_t TRACE_CAPTURE_FRAMES = 120;
+
+// Body drawn from physics snapshots, indexed by its snapshot slot
+struct RenderItem {
+    std::string name;
+    std::string mesh_name;
+    uint32_t texture_id;
+};
 
 using namespace bullseye;
 
 int main(int argc, char *argv[]) {
     CLOG_INFO("Starting Bullseye");
 
+    trace::set_thread_name("Main");
+    // --trace <first frame> <frame count> [path] records given frames into Chrome trace JSON
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 2 < argc) {
+            const uint64_t first_frame = strtoull(argv[i + 1], nullptr, 10);
+            const uint32_t frame_count = static_cast<uint32_t>(strtoul(argv[i + 2], nullptr, 10));
+            const bool has_path = i + 3 < argc && strncmp(argv[i + 3], "--", 2) != 0;
+
+            trace::capture_frames(first_frame, frame_count, has_path ? argv[i + 3] : "trace.json");
+            i += has_path ? 3 : 2;
+        }
+    }
+
     app_settings::AppSettings app_settings { false,  false, true };
 
     CLOG_DEBUG("Initializing SDL");
@@ -114,35 +144,79 @@ int main(int argc, char *argv[]) {
 
     shader::ShaderManager shader_manager;
     shader_manager.load_shader("lightcube", "assets/shaders/light_cube_vert.glsl", "assets/shaders/light_cube_frag.glsl");
-    shader_manager.load_shader("main", "assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
+    shader_manager.load_shader("instanced", "assets/shaders/instanced_vert.glsl", "assets/shaders/fragment.glsl");
     shader_manager.load_shader("gun", "assets/shaders/gun_vert.glsl", "assets/shaders/gun_frag.glsl");
     shader_manager.load_shader("physics_debug", "assets/shaders/physics_debug_vert.glsl", "assets/shaders/physics_debug_frag.glsl");
 
+    // Resolve uniforms used in render loop once, setting them is then just table index
+    shader::Shader& gun_shader = shader_manager.get_shader("gun");
+    const shader::UniformHandle gun_projection = gun_shader.get_uniform_handle("projection");
+    const shader::UniformHandle gun_view = gun_shader.get_uniform_handle("view");
+    const shader::UniformHandle gun_light_pos = gun_shader.get_uniform_handle("light_pos");
+    const shader::UniformHandle gun_view_pos = gun_shader.get_uniform_handle("view_pos");
+    const shader::UniformHandle gun_light_color = gun_shader.get_uniform_handle("light_color");
+    const shader::UniformHandle gun_object_color = gun_shader.get_uniform_handle("object_color");
+    const shader::UniformHandle gun_model = gun_shader.get_uniform_handle("model");
+
+    shader::Shader& instanced_shader = shader_manager.get_shader("instanced");
+    const shader::UniformHandle instanced_projection = instanced_shader.get_uniform_handle("projection");
+    const shader::UniformHandle instanced_view = instanced_shader.get_uniform_handle("view");
+    const shader::UniformHandle instanced_light_pos = instanced_shader.get_uniform_handle("light_pos");
+    const shader::UniformHandle instanced_view_pos = instanced_shader.get_uniform_handle("view_pos");
+    const shader::UniformHandle instanced_light_color = instanced_shader.get_uniform_handle("light_color");
+    const shader::UniformHandle instanced_object_color = instanced_shader.get_uniform_handle("object_color");
+
+    shader::Shader& lightcube_shader = shader_manager.get_shader("lightcube");
+    const shader::UniformHandle lightcube_projection = lightcube_shader.get_uniform_handle("projection");
+    const shader::UniformHandle lightcube_view = lightcube_shader.get_uniform_handle("view");
+    const shader::UniformHandle lightcube_model = lightcube_shader.get_uniform_handle("model");
+
+    // File reads, image decoding and mesh processing run on workers, GL uploads are spread over frames
+    asset::AssetLoader asset_loader(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+
     texture::TextureManager texture_manager;
-    texture_manager.load_texture("grass", "assets/textures/grass.jpg");
-    texture_manager.load_texture("metal", "assets/textures/metal.jpg");
+    texture_manager.load_texture_async("grass", "assets/textures/grass.jpg", asset_loader);
+    texture_manager.load_texture_async("metal", "assets/textures/metal.jpg", asset_loader);
+    const uint32_t grass_texture_id = texture_manager.get_texture_id("grass");
+    const uint32_t metal_texture_id = texture_manager.get_texture_id("metal");
 
     mesh::MeshManager mesh_manager;
-    mesh_manager.load_mesh("plane", "assets/models/plane.obj", glm::vec3(5.f, 1.f, 5.f));
-    mesh_manager.load_mesh("box", "assets/models/cube.obj");
-    mesh_manager.load_mesh("gun", "assets/models/M4A1.obj", glm::vec3(0.016f, 0.016f, 0.016f));
-    mesh_manager.load_mesh("bullet", "assets/models/cube.obj", glm::vec3(0.3f, 0.3f, 0.3f));
+    // Colliders are sized from mesh extents, so these have to be loaded before physics init
+    const std::vector<asset::AssetHandle> collider_meshes({
+        mesh_manager.load_mesh_async("plane", "assets/models/plane.obj", asset_loader, glm::vec3(5.f, 1.f, 5.f)),
+        mesh_manager.load_mesh_async("box", "assets/models/cube.obj", asset_loader),
+        mesh_manager.load_mesh_async("bullet", "assets/models/cube.obj", asset_loader, glm::vec3(0.3f, 0.3f, 0.3f))
+    });
+    mesh_manager.load_mesh_async("gun", "assets/models/M4A1.obj", asset_loader, glm::vec3(0.016f, 0.016f, 0.016f));
 
     rp3d::PhysicsCommon physics_common;
-    rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld();
+    // Islands are solved on remaining cores (render and physics threads take one each), result does not depend on thread count
+    rp3d::PhysicsWorld::WorldSettings world_settings;
+    world_settings.nbWorkerThreads = std::thread::hardware_concurrency() > 2 ? std::thread::hardware_concurrency() - 2 : 0;
+    rp3d::PhysicsWorld* world = physics_common.createPhysicsWorld(world_settings);
     rp3d::DefaultLogger* logger = physics_common.createDefaultLogger();
     uint32_t logLevel = static_cast<uint32_t>(static_cast<uint32_t>(rp3d::Logger::Level::Information) | static_cast<uint32_t>(rp3d::Logger::Level::Warning) | static_cast<uint32_t>(rp3d::Logger::Level::Error));
     logger->addStreamDestination(std::cout, logLevel, rp3d::DefaultLogger::Format::Text);
     physics_common.setLogger(logger);
+    shape_cache::ShapeCache shape_cache(&physics_common);
     //world->setGravity(rp3d::Vector3(0.f, -1.f, 0.f));
     //world->setNbIterationsPositionSolver(24);
 
     CLOG_DEBUG("Initialized rp3d physics");
 
     render::PhysicsDebugRenderer physics_debug_renderer(world);
+    render::InstancedRenderer instanced_renderer;
+    instanced_renderer.init(instanced_shader);
 
     CLOG_DEBUG("Initialized rp3d physics debug renderer");
 
+    for (auto& collider_mesh : collider_meshes) {
+        if (!collider_mesh.get()) {
+            CLOG_ERROR("Failed to load mesh required for physics");
+            return EXIT_FAILURE;
+        }
+    }
+
     entity::Entity plane("plane", glm::vec3(0.f, -3.f, 0.f), rp3d::Quaternion::identity(), entity::BodyType::RIGID);
     plane.set_mesh("plane");
     entity::Entity box("box", glm::vec3(0.f, 9.f, -5.f), rp3d::Quaternion::identity(), entity::BodyType::RIGID);
@@ -152,17 +226,32 @@ int main(int argc, char *argv[]) {
 
     entity::gun::Gun gun;
 
-    plane.init_physics(world, &physics_common, mesh_manager.get_mesh(plane.get_mesh_name()));
-    box.init_physics(world, &physics_common, mesh_manager.get_mesh(box.get_mesh_name()));
-    box2.init_physics(world, &physics_common, mesh_manager.get_mesh(box2.get_mesh_name()));
+    plane.init_physics(world, &shape_cache, mesh_manager.get_mesh(plane.get_mesh_name()));
+    box.init_physics(world, &shape_cache, mesh_manager.get_mesh(box.get_mesh_name()));
+    box2.init_physics(world, &shape_cache, mesh_manager.get_mesh(box2.get_mesh_name()));
 
     std::vector<entity::Entity> entities;
     entities.push_back(std::move(box));
     entities.push_back(std::move(box2));
     entities.push_back(std::move(plane));
 
-    std::vector<entity::Entity> volatile_entities;
-    volatile_entities.reserve(1024);
+    bullet_pool::BulletPool bullet_pool(bullet_pool::BULLET_POOL_DEFAULT_CAPACITY, world, &shape_cache, mesh_manager);
+    // Bullets get contacts in the step they reach a target, so they cannot tunnel through thin targets at 60 Hz
+    bullet_pool.set_continuous(true);
+
+    // World is stepped on its own thread, renderer draws bodies from published snapshots
+    physics_thread::PhysicsThread physics_thread(world);
+    std::vector<RenderItem> render_items;
+    const uint32_t bullets_first_slot = static_cast<uint32_t>(entities.size());
+    for (auto& entity : entities) {
+        physics_thread.track(physics_thread.reserve_slot(), entity.get_collision_body());
+        render_items.push_back(RenderItem { entity.get_name(), entity.get_mesh_name(), strcmp(entity.get_name(), "plane") == 0 ? grass_texture_id : metal_texture_id });
+    }
+    for (auto& bullet : bullet_pool.get_bullets()) {
+        physics_thread.track(physics_thread.reserve_slot(), bullet.entity.get_collision_body());
+        render_items.push_back(RenderItem { bullet.entity.get_name(), bullet.entity.get_mesh_name(), metal_texture_id });
+    }
+    uint32_t entities_count = static_cast<uint32_t>(entities.size());
 
     std::vector<mesh::Mesh> light_cubes;
     light_cubes.push_back(mesh::Mesh("light", consts::SIMPLE_CUBE_VERTICES, sizeof(consts::SIMPLE_CUBE_VERTICES) / sizeof(float)));
@@ -178,7 +267,8 @@ int main(int argc, char *argv[]) {
         "assets/textures/skybox/posz.jpg",
         "assets/textures/skybox/negz.jpg"
     });
-    skybox::Skybox skybox(skybox_texture_paths, "assets/shaders/skybox_vert.glsl", "assets/shaders/skybox_frag.glsl");
+    skybox::Skybox skybox("assets/shaders/skybox_vert.glsl", "assets/shaders/skybox_frag.glsl");
+    skybox.load_faces_async(skybox_texture_paths, asset_loader);
 
     static int listbox_item_current = 0;
 
@@ -188,15 +278,32 @@ int main(int argc, char *argv[]) {
     typedef std::chrono::high_resolution_clock Clock;
     simple_timer::SimpleTimer frame_timer;
 
-    // Time between updates in microseconds
-    const uint64_t dt = static_cast<const uint64_t>(10 * 1000);
+    // Time between updates in microseconds (same rate as physics steps)
+    const uint64_t dt = physics_thread.get_step_us();
 
     uint64_t current_time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count());
     uint64_t accumulator = 0, new_time = 0, loop_time = 0, time_elapsed = 0;
     float interp = 0.f, last_render_time = 0.f, update_time = 0.f;
 
+    physics_debug_renderer.update_settings(&app_settings);
+    bool physics_debug_draw = app_settings.physics_debug_draw;
+
+    // Before physics thread starts, hooks must not change while world is updating
+    trace::install_rp3d_hooks();
+
+    // Entities and bullet pool belong to physics thread from now on, main thread changes them through commands only
+    physics_thread.start([&entities, &bullet_pool](float delta_time) {
+        for (auto &entity : entities) {
+            entity.update(delta_time);
+        }
+        bullet_pool.update(delta_time);
+    });
+
     bool running = true;
     while (running) {
+        trace::next_frame();
+        TRACE_ZONE("Frame");
+
         // ===== Timer ops
         frame_timer.start();
 
@@ -212,6 +319,7 @@ int main(int argc, char *argv[]) {
         }
 
         // ===== Event handling
+        TRACE_BEGIN("Event pump");
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
             switch (event.type) {
@@ -234,28 +342,17 @@ int main(int argc, char *argv[]) {
                     if (event.key.keysym.sym == SDLK_f) {
                        app_settings.camera_free_fly = !app_settings.camera_free_fly;
                     }
-                     if (event.key.keysym.sym == SDLK_g) {
-                         const float X = 25.f;
-                         const float Y = 360.f;
-                         float x = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
-                         float y = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
-                         float z = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
-                         float s = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X)) / 10.f;
-
-                         float q1 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
-                         float q2 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
-                         float q3 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
-
-                         char namebuf[16];
-                         snprintf(namebuf, 16, "%s%d", "box", entities.size());
-                         rp3d::Quaternion q = rp3d::Quaternion(q1, q2, q3, 1.0f);
-                         q.normalize();
-                         entity::Entity box(namebuf, glm::vec3(x, y, z), q, entity::BodyType::RIGID);
-                         box.set_mesh("box");
-                         box.init_physics(world, &physics_common, mesh_manager.get_mesh("box"));
-
-                         entities.push_back(std::move(box));
-                     }
+                    if (event.key.keysym.sym == SDLK_g) {
+                        char namebuf[16];
+                        snprintf(namebuf, 16, "%s%u", "box", entities_count++);
+
+                        const uint32_t slot = physics_thread.reserve_slot();
+                        render_items.push_back(RenderItem { namebuf, "box", metal_texture_id });
+                        physics_thread.submit([&entities, &physics_thread, &shape_cache, &mesh_manager, world, slot, name = std::string(namebuf)]() {
+                            entities.push_back(spawner::spawn_random_box(name, world, &shape_cache, mesh_manager));
+                            physics_thread.track(slot, entities.back().get_collision_body());
+                        });
+                    }
                     break;  
                 case SDL_KEYUP:
                     pressed_keys[event.key.keysym.sym] = false;
@@ -276,21 +373,20 @@ int main(int argc, char *argv[]) {
 
                         glm::vec3 bullet_starting_pos = glm::vec3(camera.get_position()->x + 0.1f, camera.get_position()->y + 0.1f, camera.get_position()->z + 0.1f);
 
-                        entity::Entity bullet("bullet" + std::to_string(volatile_entities.size() + 1024), 
-                            bullet_starting_pos, 
-                            rp3d::Quaternion::fromEulerAngles(rp3d::Vector3(camera.get_front().x, camera.get_front().y, camera.get_front().z)),
-                            entity::BodyType::RIGID);
-                        bullet.set_mesh("bullet");
-                        bullet.init_physics(world, &physics_common, mesh_manager.get_mesh("bullet"), 0.1f);
-                        bullet.set_force(camera.get_front() * 10.f);
-
-                        volatile_entities.push_back(std::move(bullet));
+                        physics_thread.submit([&bullet_pool, &physics_thread, bullets_first_slot, bullet_starting_pos, direction = camera.get_front()]() {
+                            // Bullet may be reused while still flying when pool is exhausted, it must not be blended to the muzzle
+                            const uint32_t bullet = bullet_pool.fire(bullet_starting_pos, direction);
+                            if (bullet < bullet_pool.get_capacity()) {
+                                physics_thread.reset(bullets_first_slot + bullet);
+                            }
+                        });
                     }
                     break;
             }
 
             ImGui_ImplSDL2_ProcessEvent(&event);
         }
+        TRACE_END();
 
         // ===== Process movement input
         if (pressed_keys[SDLK_w] && pressed_keys[SDLK_d]) {
@@ -320,23 +416,20 @@ int main(int argc, char *argv[]) {
         // ===== App settings
         camera.update_settings(&app_settings);
 
-        physics_debug_renderer.update_settings(&app_settings);
+        if (app_settings.physics_debug_draw != physics_debug_draw) {
+            physics_debug_draw = app_settings.physics_debug_draw;
+            physics_thread.submit([&physics_debug_renderer, settings = app_settings]() mutable {
+                physics_debug_renderer.update_settings(&settings);
+            });
+        }
 
-        // ===== Logic update
+        // ===== Logic update (physics is stepped on physics thread)
         const float dt_ms = dt / 1000000.f;
         while(accumulator >= dt) {
+            TRACE_ZONE("Fixed step");
 
             camera.update(dt_ms);
             gun.update(dt_ms);
-            
-            for (auto &entity : entities) {
-                entity.update(dt_ms);
-            }
-            for (auto& entity : volatile_entities) {
-                entity.update(dt_ms);
-            }
-
-            world->update(dt_ms);
 
             time_elapsed += dt;
             accumulator -= dt;
@@ -349,6 +442,14 @@ int main(int argc, char *argv[]) {
         // ===== Rendering
         frame_timer.start();
 
+        // Latest published world state, physics thread keeps stepping while it is drawn
+        const physics_thread::Snapshot& snapshot = physics_thread.acquire_snapshot();
+        const float physics_interp = physics_thread::get_interpolation_factor(snapshot, physics_thread::get_time_us());
+
+        TRACE_BEGIN("Asset uploads");
+        asset_loader.process_uploads(asset::ASSET_UPLOAD_BUDGET_MS);
+        TRACE_END();
+
         glClearColor(0.0f, 0.5f, 1.0f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -358,86 +459,69 @@ int main(int argc, char *argv[]) {
 
         glm::vec3 light = glm::vec3(9.f, 4.5f, (5.f * sin(math_utils::to_radians(movement)) + 2.f));
 
-        shader_manager.use_shader("gun");
-        shader_manager.set_mat4("gun", "projection", proj);
-        shader_manager.set_mat4("gun", "view", view);
-        shader_manager.set_vec3("gun", "light_pos", light);
-        shader_manager.set_vec3("gun", "view_pos", *camera.get_position());
-        shader_manager.set_vec3("gun", "light_color", glm::vec3(1.f, 1.f, 1.f));
-        shader_manager.set_vec3("gun", "object_color", glm::vec3(0.1f, 0.1f, 0.1f));  
-        shader_manager.set_mat4("gun", "model", gun.get_model_matrix());
+        TRACE_BEGIN("Gun pass");
+        gun_shader.use();
+        gun_shader.set_mat4(gun_projection, proj);
+        gun_shader.set_mat4(gun_view, view);
+        gun_shader.set_vec3(gun_light_pos, light);
+        gun_shader.set_vec3(gun_view_pos, *camera.get_position());
+        gun_shader.set_vec3(gun_light_color, glm::vec3(1.f, 1.f, 1.f));
+        gun_shader.set_vec3(gun_object_color, glm::vec3(0.1f, 0.1f, 0.1f));
+        gun_shader.set_mat4(gun_model, gun.get_model_matrix());
         mesh_manager.draw_mesh("gun");
-
-        for (auto &entity : entities) {
-            if (strcmp(entity.get_name(), "plane") == 0) {
-                texture_manager.use_texture("grass", shader_manager.get_shader("main").get_id());
-            }
-            else {
-                texture_manager.use_texture("metal", shader_manager.get_shader("main").get_id());
+        TRACE_END();
+
+        TRACE_BEGIN("Instanced pass");
+        instanced_renderer.begin_frame();
+        for (uint32_t i = 0; i < snapshot.bodies.size(); i++) {
+            const physics_thread::BodyState& body = snapshot.bodies[i];
+            if (body.visible) {
+                const RenderItem& render_item = render_items[i];
+                instanced_renderer.submit(mesh_manager.get_mesh(render_item.mesh_name), render_item.texture_id, physics_thread::get_model_matrix(body, physics_interp));
             }
-         
-            shader_manager.use_shader("main");
-            shader_manager.set_mat4("main", "projection", proj);
-            shader_manager.set_mat4("main", "view", view);
-            shader_manager.set_vec3("main", "light_pos", light);
-            shader_manager.set_vec3("main", "view_pos", *camera.get_position());
-            shader_manager.set_vec3("main", "light_color", glm::vec3(1.f, 1.f, 1.f));
-            shader_manager.set_vec3("main", "object_color", glm::vec3(0.1f, 0.5f, 0.3f)); 
-            shader_manager.set_mat4("main", "model", entity.get_model_matrix(interp));
-            
-            mesh_manager.draw_mesh(entity.get_mesh_name());
         }
 
-        // TODO: Consolidate that to one draw loop
-        for (auto& entity : volatile_entities) {
-            if (strcmp(entity.get_name(), "plane") == 0) {
-                texture_manager.use_texture("grass", shader_manager.get_shader("main").get_id());
-            }
-            else {
-                texture_manager.use_texture("metal", shader_manager.get_shader("main").get_id());
-            }
-
-            shader_manager.use_shader("main");
-            shader_manager.set_mat4("main", "projection", proj);
-            shader_manager.set_mat4("main", "view", view);
-            shader_manager.set_vec3("main", "light_pos", light);
-            shader_manager.set_vec3("main", "view_pos", *camera.get_position());
-            shader_manager.set_vec3("main", "light_color", glm::vec3(1.f, 1.f, 1.f));
-            shader_manager.set_vec3("main", "object_color", glm::vec3(0.1f, 0.5f, 0.3f));
-            shader_manager.set_mat4("main", "model", entity.get_model_matrix(interp));
-
-            mesh_manager.draw_mesh(entity.get_mesh_name());
-        }
-
-        shader_manager.use_shader("lightcube");
-        shader_manager.set_mat4("lightcube", "projection", proj);
-        shader_manager.set_mat4("lightcube", "view", view);
+        instanced_shader.use();
+        instanced_shader.set_mat4(instanced_projection, proj);
+        instanced_shader.set_mat4(instanced_view, view);
+        instanced_shader.set_vec3(instanced_light_pos, light);
+        instanced_shader.set_vec3(instanced_view_pos, *camera.get_position());
+        instanced_shader.set_vec3(instanced_light_color, glm::vec3(1.f, 1.f, 1.f));
+        instanced_shader.set_vec3(instanced_object_color, glm::vec3(0.1f, 0.5f, 0.3f));
+        instanced_renderer.draw(instanced_shader);
+        TRACE_END();
+
+        TRACE_BEGIN("Light cube pass");
+        lightcube_shader.use();
+        lightcube_shader.set_mat4(lightcube_projection, proj);
+        lightcube_shader.set_mat4(lightcube_view, view);
         for (auto &light_cube_mesh : light_cubes) {
             glm::mat4 model = glm::mat4(1.0f);
             model = glm::translate(model, light);
             model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));
-            shader_manager.set_mat4("lightcube", "model", model);
+            lightcube_shader.set_mat4(lightcube_model, model);
 
             light_cube_mesh.draw_light_cube(); 
         }
+        TRACE_END();
 
-        if (world->getIsDebugRenderingEnabled()) {
-            physics_debug_renderer.draw(shader_manager.get_shader("physics_debug"), camera, interp);
+        if (!snapshot.debug_lines.empty() || !snapshot.debug_triangles.empty()) {
+            TRACE_ZONE("Physics debug pass");
+            physics_debug_renderer.draw(shader_manager.get_shader("physics_debug"), camera, interp, snapshot.debug_lines, snapshot.debug_triangles);
         }
 
         // Skybox
+        TRACE_BEGIN("Skybox pass");
         skybox.draw(proj, view);
+        TRACE_END();
 
         // Debug GUI 
+        TRACE_BEGIN("ImGui");
         const char* entities_names[1024];
-        {
-            assert(entities.size() <= 1024);
-            uint32_t i = 0, j = 0;
-            for (i = 0; i < entities.size(); i++) {
-                entities_names[i] = entities[i].get_name();
-            }
-            for (j = 0; j < volatile_entities.size(); j++) {
-                entities_names[i + j] = volatile_entities[j].get_name();
+        uint32_t entities_names_count = 0;
+        for (uint32_t i = 0; i < snapshot.bodies.size() && entities_names_count < 1024; i++) {
+            if (snapshot.bodies[i].visible) {
+                entities_names[entities_names_count++] = render_items[i].name.c_str();
             }
         }
 
@@ -449,7 +533,9 @@ int main(int argc, char *argv[]) {
         ImGui::Separator();
         ImGui::Text("Size: [%.2f, %.2f]", ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y);
         ImGui::Text("Update: %.2f ms", update_time);
+        ImGui::Text("Physics step: %.2f ms", snapshot.step_ms);
         ImGui::Text("Render: %.2f ms (%.2f FPS)", last_render_time, 1000.f / last_render_time);
+        ImGui::Text("Assets loading: %u", asset_loader.get_pending_count());
         ImGui::Spacing();
         ImGui::Text("Camera");
         ImGui::Separator();
@@ -461,39 +547,52 @@ int main(int argc, char *argv[]) {
         ImGui::Checkbox("Free fly [F]", &app_settings.camera_free_fly);
         ImGui::Spacing();
         ImGui::Checkbox("Physics debug", &app_settings.physics_debug_draw);
+        ImGui::Spacing();
+        if (ImGui::Button("Capture trace") && !trace::is_capturing()) {
+            trace::capture_frames(trace::get_frame() + 1, TRACE_CAPTURE_FRAMES, "trace.json");
+        }
         ImGui::End();
         ImGui::Begin("Entities");
         ImGui::PushItemWidth(-1);
-        ImGui::ListBox("", &listbox_item_current, entities_names, entities.size() + volatile_entities.size(), 12);
+        ImGui::ListBox("", &listbox_item_current, entities_names, entities_names_count, 12);
         ImGui::Separator();
         ImGui::End();
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        TRACE_END();
 
+        TRACE_BEGIN("Swap");
         SDL_GL_SwapWindow(window);
+        TRACE_END();
 
         last_render_time = (frame_timer.get_microseconds_since_start() / 1000.f) + update_time;
     }
 
     // Cleanup
+    CLOG_DEBUG("Stopping physics thread");
+    physics_thread.stop();
+
+    CLOG_DEBUG("Stopping asset loader");
+    asset_loader.unload();
+
     CLOG_DEBUG("Unloading managers");
     shader_manager.unload();
     texture_manager.unload();
+    instanced_renderer.unload();
     mesh_manager.unload();
 
     CLOG_DEBUG("Unloading entities");
     for (auto &entity : entities) {
         entity.unload(world);
     }
-    for (auto& entity : volatile_entities) {
-        entity.unload(world);
-    }
+    bullet_pool.unload(world);
 
     for (auto light_cube_mesh : light_cubes) {
         light_cube_mesh.unload();
     }
 
     gun.unload(world);
+    shape_cache.unload();
 
     skybox.unload();
 
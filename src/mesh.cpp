@@ -2,27 +2,99 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include "glad/glad.h"
 #include "glm/gtc/matrix_transform.hpp"
 #include "tobjl/tiny_obj_loader.h"
 
+#include "mesh_optimizer.h"
+#include "mesh_cache.h"
 #include "clogger.h"
 
 namespace bullseye::mesh {
-    Mesh::Mesh(std::string name, std::string path, glm::vec3 scale) {
+    Mesh::Mesh(std::string name, std::string path, glm::vec3 scale, bool gpu_upload, bool use_cache) : Mesh(name, scale, gpu_upload) {
+        load(path, use_cache);
+        upload();
+    }
+
+    Mesh::Mesh(std::string name, glm::vec3 scale, bool gpu_upload) {
         this->name = name;
         this->scale = scale;
+        this->vao = 0;
+        this->vbo = 0;
+        this->index_count = 0;
+        this->extents = glm::vec3(0.f);
+        this->bounds_min = glm::vec3(0.f);
+        this->gpu_uploaded = gpu_upload;
+        this->ready = false;
+    }
+
+    bool Mesh::load(const std::string& path, bool use_cache) {
+        const std::string cache_path = cache::get_cache_path(path, this->name);
+        if (use_cache && load_cached(cache_path, path)) {
+            return true;
+        }
 
         load_obj_file(path);
-        setup_mesh();
+        if (this->vertices.empty()) {
+            CLOG_ERROR("Mesh has no vertices [name=%s, path=%s]", this->name.c_str(), path.c_str());
+            return false;
+        }
+
         calculate_bounding_box();
+        this->index_count = this->indices.size();
+
+        if (use_cache) {
+            cache::write(cache_path, path, this->scale, this->bounds_min, this->extents, this->vertices, this->indices);
+        }
+
+        return true;
+    }
+
+    bool Mesh::load_cached(const std::string& cache_path, const std::string& path) {
+        std::shared_ptr<cache::MappedMeshCache> mesh_cache = std::make_shared<cache::MappedMeshCache>();
+        if (!mesh_cache->open(cache_path, path, this->scale)) {
+            return false;
+        }
+
+        const cache::MeshCacheHeader* header = mesh_cache->get_header();
+        this->bounds_min = glm::vec3(header->aabb_min[0], header->aabb_min[1], header->aabb_min[2]);
+        this->extents = glm::vec3(header->aabb_max[0], header->aabb_max[1], header->aabb_max[2]);
+        this->index_count = header->index_count;
+
+        // Streams are uploaded straight from mapped file, mapping is kept only until upload
+        if (this->gpu_uploaded) {
+            this->mapped_cache = mesh_cache;
+        }
+
+        CLOG_DEBUG("Loaded %s mesh from cache [vertices=%u, indices=%u]", cache_path.c_str(), header->vertex_count, header->index_count);
+
+        return true;
+    }
+
+    void Mesh::upload() {
+        // Without GL context (headless bench) only CPU-side data like extents is available
+        if (this->gpu_uploaded) {
+            if (this->mapped_cache != nullptr) {
+                const cache::MeshCacheHeader* header = this->mapped_cache->get_header();
+                setup_mesh(this->mapped_cache->get_vertices(), header->vertex_count, this->mapped_cache->get_indices(), header->index_count);
+                this->mapped_cache.reset();
+            } else if (!this->vertices.empty()) {
+                setup_mesh(this->vertices.data(), this->vertices.size(), this->indices.data(), this->indices.size());
+            }
+        }
+
+        this->ready = this->gpu_uploaded ? this->vao != 0 : this->index_count > 0;
     }
 
     Mesh::Mesh(std::string name, const float* vertices, uint32_t vertices_len) {
         this->name = name;
         this->scale = glm::vec3(1.f);
+        this->index_count = 0;
+        this->gpu_uploaded = true;
 
         load_and_setup_vertices(vertices, vertices_len);
+        this->ready = true;
     }
 
     void Mesh::load_and_setup_vertices(const float* vertices, uint32_t vertices_len) {
@@ -59,6 +131,13 @@ namespace bullseye::mesh {
         auto& shapes = reader.GetShapes();
         auto& materials = reader.GetMaterials();
 
+        size_t index_count = 0;
+        for (const auto& shape : shapes) {
+            index_count += shape.mesh.indices.size();
+        }
+        this->vertices.reserve(index_count);
+        this->indices.reserve(index_count);
+
         for (const auto& shape : shapes) {
             for (const auto& index : shape.mesh.indices) {
                 mesh::Vertex vertex{};
@@ -83,10 +162,36 @@ namespace bullseye::mesh {
             }
         }
 
-        CLOG_DEBUG("Loaded %s mesh [vertices=%d, indices=%d]", path.c_str(), vertices.size(), indices.size());
+        optimize();
+
+        CLOG_DEBUG("Loaded %s mesh [vertices=%zu, indices=%zu]", path.c_str(), vertices.size(), indices.size());
+    }
+
+    void Mesh::optimize() {
+        // ACMR is computed for debug log only, each pass simulates vertex cache over all indices
+#if CLOGGER_LOG_LEVEL == CLOG_LVL_DEBUG
+        // OBJ faces are read as one vertex per index, every vertex is transformed exactly once per triangle
+        const size_t unindexed_vertex_count = this->vertices.size();
+        const float unindexed_acmr = optimizer::calculate_acmr(this->indices, this->vertices.size());
+#endif
+
+        optimizer::weld_vertices(this->vertices, this->indices);
+#if CLOGGER_LOG_LEVEL == CLOG_LVL_DEBUG
+        const float welded_acmr = optimizer::calculate_acmr(this->indices, this->vertices.size());
+#endif
+
+        optimizer::optimize_vertex_cache(this->indices, this->vertices.size());
+        optimizer::optimize_overdraw(this->indices, this->vertices);
+        optimizer::optimize_vertex_fetch(this->vertices, this->indices);
+
+#if CLOGGER_LOG_LEVEL == CLOG_LVL_DEBUG
+        const float optimized_acmr = optimizer::calculate_acmr(this->indices, this->vertices.size());
+        CLOG_DEBUG("Optimized mesh %s [vertices=%zu -> %zu, acmr unindexed=%.3f, welded=%.3f, optimized=%.3f]", this->name.c_str(),
+            unindexed_vertex_count, this->vertices.size(), unindexed_acmr, welded_acmr, optimized_acmr);
+#endif
     }
 
-    void Mesh::setup_mesh() {
+    void Mesh::setup_mesh(const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices, uint32_t index_count) {
         uint32_t ebo;
 
         glGenVertexArrays(1, &this->vao);
@@ -95,10 +200,10 @@ namespace bullseye::mesh {
 
         glBindVertexArray(this->vao);
         glBindBuffer(GL_ARRAY_BUFFER, this->vbo);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, vertex_count * sizeof(Vertex), vertices, GL_STATIC_DRAW);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), &indices[0], GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
 
         // positions
         glEnableVertexAttribArray(0);
@@ -120,8 +225,11 @@ namespace bullseye::mesh {
         max_x = this->vertices[0].position.x;
         max_y = this->vertices[0].position.y;
         max_z = this->vertices[0].position.z;
+        glm::vec3 min = this->vertices[0].position;
 
         for (auto &vert : this->vertices) {
+            min = glm::min(min, vert.position);
+
             if (vert.position.x > max_x) {
                 max_x = vert.position.x;
             }
@@ -136,11 +244,36 @@ namespace bullseye::mesh {
         CLOG_DEBUG("Calculated bounding box for Mesh %s, max extents [x=%.2f, y=%.2f, z=%.2f]", this->name.c_str(), max_x, max_y, max_z);
 
         this->extents = glm::vec3(max_x, max_y, max_z);
+        this->bounds_min = min;
     }
 
     void Mesh::draw() {
+        // Mesh still loading in background, nothing to draw yet
+        if (!this->ready) {
+            return;
+        }
+
+        glBindVertexArray(this->vao);
+        glDrawElements(GL_TRIANGLES, this->index_count, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+    }
+
+    void Mesh::draw_instanced(uint32_t instance_vbo, uint32_t instance_count) {
+        if (!this->ready) {
+            return;
+        }
+
         glBindVertexArray(this->vao);
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+
+        // Instance buffer can differ between draws of the same mesh (e.g. different textures), so point attributes at it each time
+        glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+        for (uint32_t i = 0; i < 4; i++) {
+            glEnableVertexAttribArray(INSTANCE_MODEL_LOCATION + i);
+            glVertexAttribPointer(INSTANCE_MODEL_LOCATION + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void *) (i * sizeof(glm::vec4)));
+            glVertexAttribDivisor(INSTANCE_MODEL_LOCATION + i, 1);
+        }
+
+        glDrawElementsInstanced(GL_TRIANGLES, this->index_count, GL_UNSIGNED_INT, 0, instance_count);
         glBindVertexArray(0);
     }
 
@@ -153,6 +286,10 @@ namespace bullseye::mesh {
     void Mesh::unload() {
         CLOG_DEBUG("Unloading mesh [name=%s]", this->name.c_str());
 
+        if (!this->gpu_uploaded) {
+            return;
+        }
+
         glDeleteVertexArrays(1, &this->vao);
         glDeleteBuffers(1, &this->vbo);
     }
@@ -161,6 +298,10 @@ namespace bullseye::mesh {
         return this->name.c_str();
     }
 
+    bool Mesh::is_ready() {
+        return this->ready;
+    }
+
     const glm::vec3& Mesh::get_extents() {
         return this->extents;
     }
@@ -0,0 +1,282 @@
+#include "mesh_cache.h"
+#include "clogger.h"
+
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye::mesh::cache {
+    static_assert(sizeof(MeshCacheHeader) % 8 == 0, "Mesh cache streams must stay aligned after header");
+
+    namespace {
+        struct SourceInfo {
+            uint64_t mtime;
+            uint64_t size;
+        };
+
+        bool get_source_info(const std::string& source_path, SourceInfo& info) {
+            std::error_code error;
+            const auto mtime = std::filesystem::last_write_time(source_path, error);
+            if (error) {
+                return false;
+            }
+            const auto size = std::filesystem::file_size(source_path, error);
+            if (error) {
+                return false;
+            }
+
+            info.mtime = static_cast<uint64_t>(mtime.time_since_epoch().count());
+            info.size = static_cast<uint64_t>(size);
+
+            return true;
+        }
+
+        // FNV-1a over whole source file
+        bool hash_source(const std::string& source_path, uint64_t& hash) {
+            std::ifstream file(source_path, std::ios::binary);
+            if (!file) {
+                return false;
+            }
+
+            hash = 14695981039346656037ull;
+            char buffer[64 * 1024];
+            while (file) {
+                file.read(buffer, sizeof(buffer));
+                const std::streamsize read = file.gcount();
+                for (std::streamsize i = 0; i < read; i++) {
+                    hash = (hash ^ static_cast<unsigned char>(buffer[i])) * 1099511628211ull;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    std::string get_cache_path(const std::string& source_path, const std::string& mesh_name) {
+        return source_path + "." + mesh_name + MESH_CACHE_EXTENSION;
+    }
+
+    bool write(const std::string& cache_path, const std::string& source_path, const glm::vec3& scale, const glm::vec3& aabb_min,
+        const glm::vec3& aabb_max, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        SourceInfo source_info;
+        MeshCacheHeader header{};
+        if (!get_source_info(source_path, source_info) || !hash_source(source_path, header.source_hash)) {
+            CLOG_WARN("Cannot write mesh cache, source file not readable [source=%s]", source_path.c_str());
+            return false;
+        }
+
+        header.magic = MESH_CACHE_MAGIC;
+        header.version = MESH_CACHE_VERSION;
+        header.vertex_size = sizeof(Vertex);
+        header.vertex_count = static_cast<uint32_t>(vertices.size());
+        header.index_count = static_cast<uint32_t>(indices.size());
+        header.source_mtime = source_info.mtime;
+        header.source_size = source_info.size;
+        for (uint32_t i = 0; i < 3; i++) {
+            header.scale[i] = scale[i];
+            header.aabb_min[i] = aabb_min[i];
+            header.aabb_max[i] = aabb_max[i];
+        }
+
+        // Written under temporary name and renamed, so that interrupted write never leaves valid-looking blob
+        const std::string temp_path = cache_path + ".tmp";
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                CLOG_WARN("Cannot write mesh cache [path=%s]", cache_path.c_str());
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+            file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+
+            if (!file) {
+                CLOG_WARN("Cannot write mesh cache [path=%s]", cache_path.c_str());
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp_path, cache_path, error);
+        if (error) {
+            CLOG_WARN("Cannot write mesh cache [path=%s, error=%s]", cache_path.c_str(), error.message().c_str());
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+
+        CLOG_DEBUG("Mesh cache written [path=%s, vertices=%u, indices=%u]", cache_path.c_str(), header.vertex_count, header.index_count);
+
+        return true;
+    }
+
+    MappedMeshCache::MappedMeshCache() {
+        this->data = nullptr;
+        this->size = 0;
+#ifdef _WIN32
+        this->file_handle = INVALID_HANDLE_VALUE;
+        this->mapping_handle = nullptr;
+#endif
+    }
+
+    MappedMeshCache::~MappedMeshCache() {
+        close();
+    }
+
+    bool MappedMeshCache::open(const std::string& cache_path, const std::string& source_path, const glm::vec3& scale) {
+        close();
+
+        if (!map(cache_path)) {
+            return false;
+        }
+
+        if (!validate(source_path, scale)) {
+            CLOG_DEBUG("Mesh cache is stale [path=%s]", cache_path.c_str());
+            close();
+
+            return false;
+        }
+
+        return true;
+    }
+
+#ifdef _WIN32
+    bool MappedMeshCache::map(const std::string& cache_path) {
+        HANDLE file = CreateFileA(cache_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        this->file_handle = file;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(MeshCacheHeader))) {
+            close();
+            return false;
+        }
+
+        this->mapping_handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (this->mapping_handle == nullptr) {
+            close();
+            return false;
+        }
+
+        this->data = static_cast<const unsigned char*>(MapViewOfFile(this->mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        if (this->data == nullptr) {
+            close();
+            return false;
+        }
+        this->size = static_cast<size_t>(file_size.QuadPart);
+
+        return true;
+    }
+
+    void MappedMeshCache::close() {
+        if (this->data != nullptr) {
+            UnmapViewOfFile(this->data);
+        }
+        if (this->mapping_handle != nullptr) {
+            CloseHandle(this->mapping_handle);
+        }
+        if (this->file_handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(this->file_handle);
+        }
+
+        this->data = nullptr;
+        this->size = 0;
+        this->mapping_handle = nullptr;
+        this->file_handle = INVALID_HANDLE_VALUE;
+    }
+#else
+    bool MappedMeshCache::map(const std::string& cache_path) {
+        const int fd = ::open(cache_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(MeshCacheHeader))) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapped = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // Mapping stays valid after descriptor is closed
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+
+        this->data = static_cast<const unsigned char*>(mapped);
+        this->size = static_cast<size_t>(file_stat.st_size);
+
+        return true;
+    }
+
+    void MappedMeshCache::close() {
+        if (this->data != nullptr) {
+            munmap(const_cast<unsigned char*>(this->data), this->size);
+        }
+
+        this->data = nullptr;
+        this->size = 0;
+    }
+#endif
+
+    bool MappedMeshCache::validate(const std::string& source_path, const glm::vec3& scale) {
+        const MeshCacheHeader* header = get_header();
+        if (header->magic != MESH_CACHE_MAGIC || header->version != MESH_CACHE_VERSION || header->vertex_size != sizeof(Vertex)) {
+            return false;
+        }
+
+        const uint64_t expected_size = sizeof(MeshCacheHeader) + static_cast<uint64_t>(header->index_count) * sizeof(uint32_t)
+            + static_cast<uint64_t>(header->vertex_count) * sizeof(Vertex);
+        if (this->size != expected_size) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < 3; i++) {
+            if (header->scale[i] != scale[i]) {
+                return false;
+            }
+        }
+
+        SourceInfo source_info;
+        if (!get_source_info(source_path, source_info) || source_info.size != header->source_size) {
+            return false;
+        }
+
+        // Touched but unchanged source (e.g. fresh checkout) still matches by content
+        if (source_info.mtime != header->source_mtime) {
+            uint64_t source_hash;
+            if (!hash_source(source_path, source_hash) || source_hash != header->source_hash) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const MeshCacheHeader* MappedMeshCache::get_header() {
+        return reinterpret_cast<const MeshCacheHeader*>(this->data);
+    }
+
+    const uint32_t* MappedMeshCache::get_indices() {
+        return reinterpret_cast<const uint32_t*>(this->data + sizeof(MeshCacheHeader));
+    }
+
+    const Vertex* MappedMeshCache::get_vertices() {
+        return reinterpret_cast<const Vertex*>(this->data + sizeof(MeshCacheHeader) + get_header()->index_count * sizeof(uint32_t));
+    }
+}
\ No newline at end of file
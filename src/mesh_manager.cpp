@@ -5,8 +5,8 @@
 #include <stdexcept>
 
 namespace bullseye::mesh {
-    MeshManager::MeshManager() {
-
+    MeshManager::MeshManager(bool gpu_upload) {
+        this->gpu_upload = gpu_upload;
     }
 
     MeshManager::~MeshManager() {
@@ -14,13 +14,31 @@ namespace bullseye::mesh {
     }
 
     void MeshManager::load_mesh(std::string name, std::string mesh_file_path, glm::vec3 scale) {
-        Mesh* mesh = new Mesh(name, mesh_file_path, scale);
+        Mesh* mesh = new Mesh(name, mesh_file_path, scale, this->gpu_upload);
 
         this->meshes.insert({ name, mesh });
 
         CLOG_DEBUG("Mesh loaded from file [name=%s, file=%s]", name.c_str(), mesh_file_path.c_str());
     }
 
+    asset::AssetHandle MeshManager::load_mesh_async(std::string name, std::string mesh_file_path, asset::AssetLoader& loader, glm::vec3 scale) {
+        Mesh* mesh = new Mesh(name, scale, this->gpu_upload);
+
+        this->meshes.insert({ name, mesh });
+
+        return loader.enqueue(
+            [mesh, mesh_file_path]() {
+                return mesh->load(mesh_file_path);
+            },
+            [mesh, name, mesh_file_path](bool loaded) {
+                if (loaded) {
+                    mesh->upload();
+
+                    CLOG_DEBUG("Mesh loaded from file [name=%s, file=%s]", name.c_str(), mesh_file_path.c_str());
+                }
+            });
+    }
+
     mesh::Mesh* MeshManager::get_mesh(const std::string &name) {
         return this->meshes.at(name);
     }
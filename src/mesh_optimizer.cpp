@@ -0,0 +1,324 @@
+#include "mesh_optimizer.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+#include "glm/glm.hpp"
+
+namespace bullseye::mesh::optimizer {
+    namespace {
+        // Scoring constants from Forsyth's article
+        const float CACHE_DECAY_POWER = 1.5f;
+        const float LAST_TRIANGLE_SCORE = 0.75f;
+        const float VALENCE_BOOST_SCALE = 2.f;
+        const float VALENCE_BOOST_POWER = 0.5f;
+
+        struct VertexHash {
+            size_t operator()(const Vertex& vertex) const {
+                // FNV-1a over raw bytes, Vertex is tightly packed floats
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+                size_t hash = 2166136261u;
+                for (size_t i = 0; i < sizeof(Vertex); i++) {
+                    hash = (hash ^ bytes[i]) * 16777619u;
+                }
+
+                return hash;
+            }
+        };
+
+        struct VertexEqual {
+            bool operator()(const Vertex& a, const Vertex& b) const {
+                return memcmp(&a, &b, sizeof(Vertex)) == 0;
+            }
+        };
+
+        float vertex_score(int32_t cache_position, uint32_t remaining_triangles) {
+            if (remaining_triangles == 0) {
+                return -1.f;
+            }
+
+            float score = 0.f;
+            if (cache_position >= 0) {
+                if (cache_position < 3) {
+                    // Vertices of last triangle get fixed score, so that strips are not preferred over fans
+                    score = LAST_TRIANGLE_SCORE;
+                } else {
+                    const float scaler = 1.f / (FORSYTH_CACHE_SIZE - 3);
+                    score = powf(1.f - (cache_position - 3) * scaler, CACHE_DECAY_POWER);
+                }
+            }
+
+            // Boost vertices with few triangles left, so that lone triangles are not left behind
+            score += VALENCE_BOOST_SCALE * powf(static_cast<float>(remaining_triangles), -VALENCE_BOOST_POWER);
+
+            return score;
+        }
+    }
+
+    float calculate_acmr(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size) {
+        if (indices.size() < 3) {
+            return 0.f;
+        }
+
+        // FIFO cache, timestamp of when vertex entered cache
+        std::vector<uint32_t> cache_timestamps(vertex_count, 0);
+        uint32_t timestamp = cache_size + 1;
+        uint32_t misses = 0;
+
+        for (auto index : indices) {
+            if (timestamp - cache_timestamps[index] > cache_size) {
+                cache_timestamps[index] = timestamp++;
+                misses++;
+            }
+        }
+
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+
+    void weld_vertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> unique_vertices;
+        unique_vertices.reserve(vertices.size());
+
+        std::vector<Vertex> welded_vertices;
+        welded_vertices.reserve(vertices.size());
+
+        for (auto& index : indices) {
+            const Vertex& vertex = vertices[index];
+
+            auto it = unique_vertices.find(vertex);
+            if (it == unique_vertices.end()) {
+                it = unique_vertices.insert({ vertex, static_cast<uint32_t>(welded_vertices.size()) }).first;
+                welded_vertices.push_back(vertex);
+            }
+
+            index = it->second;
+        }
+
+        welded_vertices.shrink_to_fit();
+        vertices.swap(welded_vertices);
+    }
+
+    void optimize_vertex_cache(std::vector<uint32_t>& indices, uint32_t vertex_count) {
+        const uint32_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0) {
+            return;
+        }
+
+        // Vertex to triangle adjacency, as offsets into single array
+        std::vector<uint32_t> remaining_triangles(vertex_count, 0);
+        for (auto index : indices) {
+            remaining_triangles[index]++;
+        }
+
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (uint32_t v = 0; v < vertex_count; v++) {
+            adjacency_offsets[v + 1] = adjacency_offsets[v] + remaining_triangles[v];
+        }
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> adjacency_fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (uint32_t t = 0; t < triangle_count; t++) {
+            for (uint32_t k = 0; k < 3; k++) {
+                adjacency[adjacency_fill[indices[t * 3 + k]]++] = t;
+            }
+        }
+
+        std::vector<int32_t> cache_positions(vertex_count, -1);
+        std::vector<float> vertex_scores(vertex_count);
+        for (uint32_t v = 0; v < vertex_count; v++) {
+            vertex_scores[v] = vertex_score(-1, remaining_triangles[v]);
+        }
+
+        std::vector<float> triangle_scores(triangle_count);
+        std::vector<bool> triangle_added(triangle_count, false);
+        for (uint32_t t = 0; t < triangle_count; t++) {
+            triangle_scores[t] = vertex_scores[indices[t * 3]] + vertex_scores[indices[t * 3 + 1]] + vertex_scores[indices[t * 3 + 2]];
+        }
+
+        // Cache has 3 extra slots for vertices pushed out by newly added triangle
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> new_cache;
+        cache.reserve(FORSYTH_CACHE_SIZE + 3);
+        new_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        int64_t best_triangle = -1;
+        // Triangles before this one are all added, used when cache has no more candidates
+        uint32_t scan_position = 0;
+
+        for (uint32_t added = 0; added < triangle_count; added++) {
+            if (best_triangle < 0) {
+                float best_score = -1.f;
+                for (uint32_t t = scan_position; t < triangle_count; t++) {
+                    if (!triangle_added[t] && triangle_scores[t] > best_score) {
+                        best_score = triangle_scores[t];
+                        best_triangle = t;
+                    }
+                }
+            }
+
+            const uint32_t* triangle = &indices[best_triangle * 3];
+            triangle_added[best_triangle] = true;
+            result.insert(result.end(), triangle, triangle + 3);
+
+            while (scan_position < triangle_count && triangle_added[scan_position]) {
+                scan_position++;
+            }
+
+            // Move triangle vertices to front of LRU cache
+            new_cache.clear();
+            for (uint32_t k = 0; k < 3; k++) {
+                new_cache.push_back(triangle[k]);
+                remaining_triangles[triangle[k]]--;
+
+                // Remove triangle from vertex adjacency, it is never candidate again
+                uint32_t* begin = &adjacency[adjacency_offsets[triangle[k]]];
+                uint32_t* end = begin + remaining_triangles[triangle[k]] + 1;
+                *std::find(begin, end, static_cast<uint32_t>(best_triangle)) = *(end - 1);
+            }
+            for (auto v : cache) {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                    new_cache.push_back(v);
+                }
+            }
+
+            for (uint32_t i = 0; i < new_cache.size(); i++) {
+                const uint32_t v = new_cache[i];
+                cache_positions[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+                vertex_scores[v] = vertex_score(cache_positions[v], remaining_triangles[v]);
+            }
+
+            if (new_cache.size() > FORSYTH_CACHE_SIZE) {
+                new_cache.resize(FORSYTH_CACHE_SIZE);
+            }
+            cache.swap(new_cache);
+
+            // Only triangles using cached vertices changed score, next triangle is best of them
+            best_triangle = -1;
+            float best_score = -1.f;
+            for (auto v : cache) {
+                for (uint32_t a = 0; a < remaining_triangles[v]; a++) {
+                    const uint32_t t = adjacency[adjacency_offsets[v] + a];
+                    const float score = vertex_scores[indices[t * 3]] + vertex_scores[indices[t * 3 + 1]] + vertex_scores[indices[t * 3 + 2]];
+                    triangle_scores[t] = score;
+
+                    if (score > best_score) {
+                        best_score = score;
+                        best_triangle = t;
+                    }
+                }
+            }
+        }
+
+        indices.swap(result);
+    }
+
+    void optimize_overdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+        const uint32_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0) {
+            return;
+        }
+
+        // Cluster starts at every triangle with all vertices missing FIFO cache
+        std::vector<uint32_t> cluster_starts;
+        std::vector<uint32_t> cache_timestamps(vertices.size(), 0);
+        uint32_t timestamp = ACMR_CACHE_SIZE + 1;
+
+        for (uint32_t t = 0; t < triangle_count; t++) {
+            uint32_t misses = 0;
+            for (uint32_t k = 0; k < 3; k++) {
+                const uint32_t index = indices[t * 3 + k];
+                if (timestamp - cache_timestamps[index] > ACMR_CACHE_SIZE) {
+                    cache_timestamps[index] = timestamp++;
+                    misses++;
+                }
+            }
+
+            if (t == 0 || misses == 3) {
+                cluster_starts.push_back(t);
+            }
+        }
+
+        if (cluster_starts.size() < 2) {
+            return;
+        }
+
+        glm::vec3 mesh_centroid(0.f);
+        for (auto& vertex : vertices) {
+            mesh_centroid += vertex.position;
+        }
+        mesh_centroid /= static_cast<float>(vertices.size());
+
+        // Clusters facing out of mesh are more likely to occlude rest of it
+        std::vector<float> cluster_sort_keys(cluster_starts.size());
+        for (uint32_t c = 0; c < cluster_starts.size(); c++) {
+            const uint32_t end = c + 1 < cluster_starts.size() ? cluster_starts[c + 1] : triangle_count;
+
+            glm::vec3 centroid(0.f);
+            glm::vec3 normal(0.f);
+            float area = 0.f;
+            for (uint32_t t = cluster_starts[c]; t < end; t++) {
+                const glm::vec3& p0 = vertices[indices[t * 3]].position;
+                const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+                const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+
+                const glm::vec3 triangle_normal = glm::cross(p1 - p0, p2 - p0);
+                const float triangle_area = glm::length(triangle_normal);
+
+                centroid += (p0 + p1 + p2) * (triangle_area / 3.f);
+                normal += triangle_normal;
+                area += triangle_area;
+            }
+
+            if (area > 0.f) {
+                centroid /= area;
+            }
+            const float normal_length = glm::length(normal);
+            if (normal_length > 0.f) {
+                normal /= normal_length;
+            }
+
+            cluster_sort_keys[c] = glm::dot(centroid - mesh_centroid, normal);
+        }
+
+        std::vector<uint32_t> cluster_order(cluster_starts.size());
+        for (uint32_t c = 0; c < cluster_order.size(); c++) {
+            cluster_order[c] = c;
+        }
+        std::stable_sort(cluster_order.begin(), cluster_order.end(), [&cluster_sort_keys](uint32_t a, uint32_t b) {
+            return cluster_sort_keys[a] > cluster_sort_keys[b];
+        });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (auto c : cluster_order) {
+            const uint32_t end = c + 1 < cluster_starts.size() ? cluster_starts[c + 1] : triangle_count;
+            result.insert(result.end(), indices.begin() + cluster_starts[c] * 3, indices.begin() + end * 3);
+        }
+
+        indices.swap(result);
+    }
+
+    void optimize_vertex_fetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+        const uint32_t unused = static_cast<uint32_t>(-1);
+        std::vector<uint32_t> remap(vertices.size(), unused);
+
+        std::vector<Vertex> ordered_vertices;
+        ordered_vertices.reserve(vertices.size());
+
+        for (auto& index : indices) {
+            if (remap[index] == unused) {
+                remap[index] = static_cast<uint32_t>(ordered_vertices.size());
+                ordered_vertices.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        vertices.swap(ordered_vertices);
+    }
+}
\ No newline at end of file
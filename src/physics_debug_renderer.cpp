@@ -30,26 +30,26 @@ namespace bullseye::render {
         glGenBuffers(1, &this->triangles_vbo);
     }
 
-    void PhysicsDebugRenderer::update_vbo_data(const rp3d::DebugRenderer& physics_debug_renderer, const uint32_t lines_count, const uint32_t triangles_count) {
-        if (lines_count > 0) {
+    void PhysicsDebugRenderer::update_vbo_data(const std::vector<rp3d::DebugRenderer::DebugLine>& lines, const std::vector<rp3d::DebugRenderer::DebugTriangle>& triangles) {
+        if (!lines.empty()) {
             glBindBuffer(GL_ARRAY_BUFFER, this->lines_vbo);
-            glBufferData(GL_ARRAY_BUFFER, lines_count * sizeof(rp3d::DebugRenderer::DebugLine), physics_debug_renderer.getLinesArray(), GL_STREAM_DRAW);
+            glBufferData(GL_ARRAY_BUFFER, lines.size() * sizeof(rp3d::DebugRenderer::DebugLine), lines.data(), GL_STREAM_DRAW);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
 
-        if (triangles_count > 0) {
+        if (!triangles.empty()) {
             glBindBuffer(GL_ARRAY_BUFFER, this->triangles_vbo);
-            glBufferData(GL_ARRAY_BUFFER, triangles_count * sizeof(rp3d::DebugRenderer::DebugTriangle), physics_debug_renderer.getTrianglesArray(), GL_STREAM_DRAW);
+            glBufferData(GL_ARRAY_BUFFER, triangles.size() * sizeof(rp3d::DebugRenderer::DebugTriangle), triangles.data(), GL_STREAM_DRAW);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
     }
     
-    void PhysicsDebugRenderer::draw(shader::Shader &shader, camera::Camera &camera, float interp) {
-        const rp3d::DebugRenderer& physics_debug_renderer = this->physics_world->getDebugRenderer();
-        const uint32_t lines_count = physics_debug_renderer.getNbLines();
-        const uint32_t triangles_count = physics_debug_renderer.getNbTriangles();
+    void PhysicsDebugRenderer::draw(shader::Shader &shader, camera::Camera &camera, float interp, const std::vector<rp3d::DebugRenderer::DebugLine>& lines,
+        const std::vector<rp3d::DebugRenderer::DebugTriangle>& triangles) {
+        const uint32_t lines_count = static_cast<uint32_t>(lines.size());
+        const uint32_t triangles_count = static_cast<uint32_t>(triangles.size());
 
-        update_vbo_data(physics_debug_renderer, lines_count, triangles_count);
+        update_vbo_data(lines, triangles);
 
         shader.use();
         shader.set_mat4("model", glm::mat4(1.0f));
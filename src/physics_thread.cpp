@@ -0,0 +1,232 @@
+#include "physics_thread.h"
+#include "simple_timer.h"
+#include "tracer.h"
+#include "clogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include "glm/gtc/type_ptr.hpp"
+
+namespace bullseye::physics_thread {
+    SnapshotBuffer::SnapshotBuffer() {
+        for (auto& snapshot : this->snapshots) {
+            snapshot.sequence = 0;
+            snapshot.previous_time = 0;
+            snapshot.time = 0;
+            snapshot.step_ms = 0.f;
+        }
+
+        this->write_index = 0;
+        this->middle = 1;
+        this->read_index = 2;
+    }
+
+    Snapshot& SnapshotBuffer::get_write_snapshot() {
+        return this->snapshots[this->write_index];
+    }
+
+    void SnapshotBuffer::publish() {
+        // Release makes written snapshot visible to reader, acquire makes sure reader is done with the one we get back
+        const uint32_t previous_middle = this->middle.exchange(this->write_index | FRESH_BIT, std::memory_order_acq_rel);
+        this->write_index = previous_middle & ~FRESH_BIT;
+    }
+
+    const Snapshot& SnapshotBuffer::acquire() {
+        // Only writer can set the bit, so it cannot get cleared between the check and exchange
+        if (this->middle.load(std::memory_order_relaxed) & FRESH_BIT) {
+            const uint32_t previous_middle = this->middle.exchange(this->read_index, std::memory_order_acq_rel);
+            this->read_index = previous_middle & ~FRESH_BIT;
+        }
+
+        return this->snapshots[this->read_index];
+    }
+
+    PhysicsThread::PhysicsThread(rp3d::PhysicsWorld* world, uint64_t step_us) {
+        this->world = world;
+        this->step_us = step_us;
+        this->sequence = 0;
+        this->stopping = false;
+        this->nb_slots = 0;
+    }
+
+    PhysicsThread::~PhysicsThread() {
+        stop();
+    }
+
+    void PhysicsThread::start(StepFunction step) {
+        assert(!this->thread.joinable());
+
+        this->stopping = false;
+        this->thread = std::thread(&PhysicsThread::thread_loop, this, std::move(step));
+
+        CLOG_DEBUG("Physics thread started [step=%llu us]", static_cast<unsigned long long>(this->step_us));
+    }
+
+    void PhysicsThread::stop() {
+        if (!this->thread.joinable()) {
+            return;
+        }
+
+        this->stopping = true;
+        this->thread.join();
+
+        std::lock_guard<std::mutex> lock(this->commands_mutex);
+        this->commands.clear();
+
+        CLOG_DEBUG("Physics thread stopped");
+    }
+
+    void PhysicsThread::submit(Command command) {
+        std::lock_guard<std::mutex> lock(this->commands_mutex);
+        this->commands.push_back(std::move(command));
+    }
+
+    uint32_t PhysicsThread::reserve_slot() {
+        return this->nb_slots++;
+    }
+
+    void PhysicsThread::track(uint32_t slot, rp3d::CollisionBody* body) {
+        assert(slot < this->nb_slots);
+
+        resize(std::max(slot + 1, static_cast<uint32_t>(this->bodies.size())));
+
+        // First published state is not blended with anything
+        this->bodies[slot] = body;
+        this->states[slot] = BodyState { body->getTransform(), body->getTransform(), false };
+        reset(slot);
+    }
+
+    void PhysicsThread::reset(uint32_t slot) {
+        assert(slot < this->reset_sequences.size());
+
+        this->reset_sequences[slot]++;
+    }
+
+    void PhysicsThread::resize(uint32_t nb_slots) {
+        this->bodies.resize(nb_slots, nullptr);
+        this->states.resize(nb_slots, BodyState { rp3d::Transform::identity(), rp3d::Transform::identity(), false });
+        this->reset_sequences.resize(nb_slots, 0);
+        this->published_reset_sequences.resize(nb_slots, 0);
+    }
+
+    const Snapshot& PhysicsThread::acquire_snapshot() {
+        return this->snapshot_buffer.acquire();
+    }
+
+    uint64_t PhysicsThread::get_step_us() {
+        return this->step_us;
+    }
+
+    void PhysicsThread::thread_loop(StepFunction step) {
+        trace::set_thread_name("Physics");
+
+        const float delta_time = this->step_us / 1000000.f;
+        simple_timer::SimpleTimer step_timer;
+
+        // Tick of next step, steps are due at fixed times no matter how long each of them takes
+        uint64_t next_time = get_time_us();
+        while (!this->stopping) {
+            const uint64_t time = get_time_us();
+            if (time < next_time) {
+                std::this_thread::sleep_for(std::chrono::microseconds(next_time - time));
+                continue;
+            }
+
+            // Prevent endless catching up when steps take longer than step time
+            if (time - next_time > PHYSICS_MAX_LAG_US) {
+                next_time = time;
+            }
+
+            TRACE_BEGIN("Physics step");
+            step_timer.start();
+
+            run_commands();
+            step(delta_time);
+            this->world->update(delta_time);
+
+            publish(next_time, step_timer.get_microseconds_since_start() / 1000.f);
+            TRACE_END();
+
+            next_time += this->step_us;
+        }
+    }
+
+    void PhysicsThread::run_commands() {
+        {
+            std::lock_guard<std::mutex> lock(this->commands_mutex);
+            std::swap(this->commands, this->running_commands);
+        }
+
+        for (auto& command : this->running_commands) {
+            command();
+        }
+        this->running_commands.clear();
+    }
+
+    void PhysicsThread::publish(uint64_t time, float step_ms) {
+        // Slots reserved by render thread but not tracked yet stay invisible
+        const uint32_t nb_slots = std::max(this->nb_slots.load(), static_cast<uint32_t>(this->bodies.size()));
+        resize(nb_slots);
+
+        for (uint32_t i = 0; i < nb_slots; i++) {
+            rp3d::CollisionBody* body = this->bodies[i];
+            if (body == nullptr) {
+                continue;
+            }
+
+            // Blending across a reset would streak body from where it was before being moved
+            BodyState& state = this->states[i];
+            const rp3d::Transform& current = body->getTransform();
+            const bool moved = this->published_reset_sequences[i] != this->reset_sequences[i];
+            this->published_reset_sequences[i] = this->reset_sequences[i];
+            state.previous = moved ? current : state.current;
+            state.current = current;
+            state.visible = body->isActive();
+        }
+
+        Snapshot& snapshot = this->snapshot_buffer.get_write_snapshot();
+        snapshot.sequence = ++this->sequence;
+        snapshot.previous_time = time - this->step_us;
+        snapshot.time = time;
+        snapshot.step_ms = step_ms;
+        // Snapshots keep their capacity, so copies do not allocate once world stops growing
+        snapshot.bodies = this->states;
+
+        snapshot.debug_lines.clear();
+        snapshot.debug_triangles.clear();
+        if (this->world->getIsDebugRenderingEnabled()) {
+            const rp3d::DebugRenderer& debug_renderer = this->world->getDebugRenderer();
+            snapshot.debug_lines.assign(debug_renderer.getLinesArray(), debug_renderer.getLinesArray() + debug_renderer.getNbLines());
+            snapshot.debug_triangles.assign(debug_renderer.getTrianglesArray(), debug_renderer.getTrianglesArray() + debug_renderer.getNbTriangles());
+        }
+
+        this->snapshot_buffer.publish();
+    }
+
+    uint64_t get_time_us() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    float get_interpolation_factor(const Snapshot& snapshot, uint64_t time_us) {
+        // Shown time is one step behind, so it falls between previous and current state while physics keeps up
+        const uint64_t step_us = snapshot.time - snapshot.previous_time;
+        if (step_us == 0 || time_us >= snapshot.time + step_us) {
+            return 1.f;
+        }
+        if (time_us <= snapshot.time) {
+            return 0.f;
+        }
+
+        return static_cast<float>(time_us - snapshot.time) / static_cast<float>(step_us);
+    }
+
+    glm::mat4 get_model_matrix(const BodyState& state, float interp) {
+        const rp3d::Transform interpolated_transform = rp3d::Transform::interpolateTransforms(state.previous, state.current, interp);
+
+        float model_matrix[16];
+        interpolated_transform.getOpenGLMatrix(model_matrix);
+
+        return glm::make_mat4(model_matrix);
+    }
+}
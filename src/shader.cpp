@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <sstream>
+#include <cstring>
 #include "glad/glad.h"
 
 using namespace bullseye;
@@ -84,6 +85,67 @@ namespace bullseye::shader {
 
         glDeleteShader(this->vertex_shader_id);
         glDeleteShader(this->fragment_shader_id);
+
+        load_uniforms();
+    }
+
+    void Shader::load_uniforms() {
+        int uniforms_count = 0;
+        glGetProgramiv(this->id, GL_ACTIVE_UNIFORMS, &uniforms_count);
+
+        this->uniforms.clear();
+        this->uniforms.reserve(uniforms_count);
+
+        char name_buffer[256];
+        for (int i = 0; i < uniforms_count; i++) {
+            int size;
+            uint32_t type;
+            glGetActiveUniform(this->id, i, sizeof(name_buffer), NULL, &size, &type, name_buffer);
+
+            Uniform uniform;
+            uniform.name = name_buffer;
+            // Arrays are reported as "name[0]", we only set them by base name
+            const size_t bracket = uniform.name.find('[');
+            if (bracket != std::string::npos) {
+                uniform.name.resize(bracket);
+            }
+            uniform.location = glGetUniformLocation(this->id, name_buffer);
+            uniform.type = type;
+            uniform.has_value = false;
+
+            this->uniforms.push_back(uniform);
+        }
+
+        CLOG_DEBUG("Loaded active uniforms [name=%s, count=%d]", this->name.c_str(), uniforms_count);
+    }
+
+    UniformHandle Shader::get_uniform_handle(const std::string &name) {
+        for (size_t i = 0; i < this->uniforms.size(); i++) {
+            if (this->uniforms[i].name == name) {
+                return static_cast<UniformHandle>(i);
+            }
+        }
+
+        // Not an error - uniforms not used by shader code are optimized out by driver
+        CLOG_DEBUG("Uniform not active in shader [name=%s, uniform=%s]", this->name.c_str(), name.c_str());
+
+        return INVALID_UNIFORM_HANDLE;
+    }
+
+    bool Shader::update_uniform_value(UniformHandle handle, const void* value, size_t size) {
+        if (handle < 0) {
+            return false;
+        }
+
+        Uniform &uniform = this->uniforms[handle];
+        if (uniform.has_value && memcmp(uniform.value, value, size) == 0) {
+            return false;
+        }
+
+        memcpy(uniform.value, value, size);
+        uniform.has_value = true;
+
+        return true;
     }
 
     const char* Shader::get_vertex_shader_src() {
@@ -105,33 +167,71 @@ namespace bullseye::shader {
     }
 
     void Shader::set_bool(const std::string &name, bool value) {
-        glUniform1i(glGetUniformLocation(this->id, name.c_str()), (int) value);
+        set_bool(get_uniform_handle(name), value);
     }
 
     void Shader::set_int(const std::string &name, int value) {
-        glUniform1i(glGetUniformLocation(this->id, name.c_str()), value);
+        set_int(get_uniform_handle(name), value);
     }
 
     void Shader::set_float(const std::string &name, float value) {
-        glUniform1f(glGetUniformLocation(this->id, name.c_str()), value);
+        set_float(get_uniform_handle(name), value);
     }
 
     void Shader::set_vec3(const std::string &name, const glm::vec3 &value) {
-        glUniform3fv(glGetUniformLocation(this->id, name.c_str()), 1, &value[0]);
+        set_vec3(get_uniform_handle(name), value);
     }
 
     void Shader::set_mat3(const std::string &name, const glm::mat3 &value) {
-        glUniformMatrix3fv(glGetUniformLocation(this->id, name.c_str()), 1, false, &value[0][0]);
+        set_mat3(get_uniform_handle(name), value);
     }
 
     void Shader::set_mat4(const std::string &name, const glm::mat4 &value) {
-        glUniformMatrix4fv(glGetUniformLocation(this->id, name.c_str()), 1, false, &value[0][0]);
+        set_mat4(get_uniform_handle(name), value);
     }
 
     void Shader::set_mat4(const std::string& name, const float value[]) {
         //assert(sizeof(value) == 16 * sizeof(float));
 
-        glUniformMatrix4fv(glGetUniformLocation(this->id, name.c_str()), 1, false, value);
+        UniformHandle handle = get_uniform_handle(name);
+        if (update_uniform_value(handle, value, 16 * sizeof(float))) {
+            glUniformMatrix4fv(this->uniforms[handle].location, 1, false, value);
+        }
+    }
+
+    // Handle setters expect this shader to be in use, values are compared with last upload and skipped when unchanged
+    void Shader::set_bool(UniformHandle handle, bool value) {
+        set_int(handle, (int) value);
+    }
+
+    void Shader::set_int(UniformHandle handle, int value) {
+        if (update_uniform_value(handle, &value, sizeof(int))) {
+            glUniform1i(this->uniforms[handle].location, value);
+        }
+    }
+
+    void Shader::set_float(UniformHandle handle, float value) {
+        if (update_uniform_value(handle, &value, sizeof(float))) {
+            glUniform1f(this->uniforms[handle].location, value);
+        }
+    }
+
+    void Shader::set_vec3(UniformHandle handle, const glm::vec3 &value) {
+        if (update_uniform_value(handle, &value[0], sizeof(glm::vec3))) {
+            glUniform3fv(this->uniforms[handle].location, 1, &value[0]);
+        }
+    }
+
+    void Shader::set_mat3(UniformHandle handle, const glm::mat3 &value) {
+        if (update_uniform_value(handle, &value[0][0], sizeof(glm::mat3))) {
+            glUniformMatrix3fv(this->uniforms[handle].location, 1, false, &value[0][0]);
+        }
+    }
+
+    void Shader::set_mat4(UniformHandle handle, const glm::mat4 &value) {
+        if (update_uniform_value(handle, &value[0][0], sizeof(glm::mat4))) {
+            glUniformMatrix4fv(this->uniforms[handle].location, 1, false, &value[0][0]);
+        }
     }
 
     uint32_t Shader::get_attrib_location(const std::string &name) {
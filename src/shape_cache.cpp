@@ -0,0 +1,91 @@
+#include "shape_cache.h"
+#include "clogger.h"
+
+#include <functional>
+
+namespace bullseye::shape_cache {
+    size_t ShapeKeyHash::operator()(const ShapeKey& key) const {
+        std::hash<float> float_hash;
+
+        size_t hash = static_cast<size_t>(key.type);
+        hash = hash * 31 + float_hash(key.extents.x);
+        hash = hash * 31 + float_hash(key.extents.y);
+        hash = hash * 31 + float_hash(key.extents.z);
+
+        return hash;
+    }
+
+    ShapeCache::ShapeCache(rp3d::PhysicsCommon* physics_common) {
+        this->physics_common = physics_common;
+
+        this->shapes.reserve(SHAPE_CACHE_INITIAL_SIZE);
+        this->keys.reserve(SHAPE_CACHE_INITIAL_SIZE);
+    }
+
+    ShapeCache::~ShapeCache() {
+
+    }
+
+    rp3d::CollisionShape* ShapeCache::acquire_box_shape(const glm::vec3& extents) {
+        const ShapeKey key { ShapeType::BOX, extents };
+
+        auto it = this->shapes.find(key);
+        if (it != this->shapes.end()) {
+            it->second.ref_count++;
+
+            return it->second.shape;
+        }
+
+        rp3d::CollisionShape* shape = this->physics_common->createBoxShape(rp3d::Vector3(extents.x, extents.y, extents.z));
+        this->shapes.insert({ key, CachedShape { shape, 1 } });
+        this->keys.insert({ shape, key });
+
+        CLOG_DEBUG("Box shape created [extents=[%.2f, %.2f, %.2f]]", extents.x, extents.y, extents.z);
+
+        return shape;
+    }
+
+    void ShapeCache::release(rp3d::CollisionShape* shape) {
+        auto key_it = this->keys.find(shape);
+        if (key_it == this->keys.end()) {
+            CLOG_ERROR("Cannot release shape, shape not present in ShapeCache!");
+            return;
+        }
+
+        const ShapeKey key = key_it->second;
+        CachedShape& cached_shape = this->shapes.at(key);
+        cached_shape.ref_count--;
+
+        if (cached_shape.ref_count == 0) {
+            destroy_shape(key, shape);
+        }
+    }
+
+    void ShapeCache::destroy_shape(const ShapeKey& key, rp3d::CollisionShape* shape) {
+        if (key.type == ShapeType::BOX) {
+            this->physics_common->destroyBoxShape(static_cast<rp3d::BoxShape*>(shape));
+        }
+
+        this->shapes.erase(key);
+        this->keys.erase(shape);
+    }
+
+    void ShapeCache::unload() {
+        if (!this->shapes.empty()) {
+            CLOG_DEBUG("Destroying shapes still referenced on unload [count=%zu]", this->shapes.size());
+        }
+
+        for (auto& cached_shape : this->shapes) {
+            if (cached_shape.first.type == ShapeType::BOX) {
+                this->physics_common->destroyBoxShape(static_cast<rp3d::BoxShape*>(cached_shape.second.shape));
+            }
+        }
+
+        this->shapes.clear();
+        this->keys.clear();
+    }
+
+    uint32_t ShapeCache::get_shape_count() {
+        return static_cast<uint32_t>(this->shapes.size());
+    }
+}
\ No newline at end of file
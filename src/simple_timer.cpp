@@ -27,4 +27,11 @@ namespace bullseye::simple_timer {
 
         return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count());
     }
+
+    uint64_t SimpleTimer::get_nanoseconds_since_start()
+    {
+        std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    }
 }
\ No newline at end of file
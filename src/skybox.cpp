@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <stb/stb_image.h>
 #include "glad/glad.h"
 
@@ -9,29 +10,15 @@
 #include "shader.h"
 
 namespace bullseye::skybox {
-    Skybox::Skybox(std::vector<std::string> texture_paths, std::string vert_shader_path, std::string frag_shader_path) {
-        this->shader = new shader::Shader("skybox");
-        this->shader->load_vertex_shader(vert_shader_path.c_str());
-        this->shader->load_fragment_shader(frag_shader_path.c_str());
-        this->shader->link_shaders();
-
-        this->setup_skybox(texture_paths);
-    }
-
-    Skybox::~Skybox() {
-    }
-
-    void Skybox::setup_skybox(std::vector<std::string> texture_paths) {
-        glGenTextures(1, &this->texture_id);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, this->texture_id);
-
+    Skybox::Skybox(std::vector<std::string> texture_paths, std::string vert_shader_path, std::string frag_shader_path)
+        : Skybox(vert_shader_path, frag_shader_path) {
         int x, y, n;
         uint32_t i = 0;
         for (auto texture_path : texture_paths) {
             unsigned char *data = stbi_load(texture_path.c_str(), &x, &y, &n, 0);
             
             if (data) {
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, x, y, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                upload_face(i, data, x, y);
                 stbi_image_free(data);
 
                 CLOG_DEBUG("Loaded texture [path=%s, w=%d, h=%d]", texture_path.c_str(), x, y);
@@ -41,6 +28,68 @@ namespace bullseye::skybox {
 
             i++;
         }
+        this->faces_uploaded = 6;
+    }
+
+    Skybox::Skybox(std::string vert_shader_path, std::string frag_shader_path) {
+        this->shader = new shader::Shader("skybox");
+        this->shader->load_vertex_shader(vert_shader_path.c_str());
+        this->shader->load_fragment_shader(frag_shader_path.c_str());
+        this->shader->link_shaders();
+        this->faces_uploaded = 0;
+
+        this->setup_skybox();
+    }
+
+    Skybox::~Skybox() {
+    }
+
+    void Skybox::load_faces_async(std::vector<std::string> texture_paths, asset::AssetLoader& loader) {
+        // Freed here if upload never happens (e.g. app closed while loading)
+        struct FaceData {
+            unsigned char* data = nullptr;
+            int x = 0, y = 0, n = 0;
+
+            ~FaceData() {
+                if (data != nullptr) {
+                    stbi_image_free(data);
+                }
+            }
+        };
+
+        // Faces are decoded in parallel, each is uploaded as soon as it arrives
+        for (uint32_t i = 0; i < texture_paths.size(); i++) {
+            std::shared_ptr<FaceData> face = std::make_shared<FaceData>();
+            const std::string texture_path = texture_paths[i];
+
+            loader.enqueue(
+                [face, texture_path]() {
+                    face->data = stbi_load(texture_path.c_str(), &face->x, &face->y, &face->n, 0);
+
+                    return face->data != nullptr;
+                },
+                [this, face, texture_path, i](bool loaded) {
+                    // Missing face keeps skybox not ready, so clear color stays in place of incomplete cube map
+                    if (loaded) {
+                        upload_face(i, face->data, face->x, face->y);
+                        this->faces_uploaded++;
+
+                        CLOG_DEBUG("Loaded texture [path=%s, w=%d, h=%d]", texture_path.c_str(), face->x, face->y);
+                    } else {
+                        CLOG_ERROR("Failed to load texture [path=%s]", texture_path.c_str());
+                    }
+                });
+        }
+    }
+
+    void Skybox::upload_face(uint32_t face, const unsigned char* data, int x, int y) {
+        glBindTexture(GL_TEXTURE_CUBE_MAP, this->texture_id);
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGB, x, y, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+    }
+
+    void Skybox::setup_skybox() {
+        glGenTextures(1, &this->texture_id);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, this->texture_id);
 
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -59,6 +108,11 @@ namespace bullseye::skybox {
     }
 
     void Skybox::draw(glm::mat4 projection, glm::mat4 view) {
+        // Incomplete cube map samples black, clear color stands in for sky until all faces are uploaded
+        if (!is_ready()) {
+            return;
+        }
+
         glDepthFunc(GL_LEQUAL);
         this->shader->use();
         this->shader->set_mat4("proj", projection);
@@ -72,6 +126,10 @@ namespace bullseye::skybox {
         glDepthFunc(GL_LESS);
     }
 
+    bool Skybox::is_ready() {
+        return this->faces_uploaded >= 6;
+    }
+
     void Skybox::unload() {
         CLOG_DEBUG("Unloading skybox shader");
 
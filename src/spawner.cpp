@@ -0,0 +1,43 @@
+#include "spawner.h"
+#include "entity.h"
+#include "mesh_manager.h"
+
+#include <cstdlib>
+#include <string>
+#include "glm/glm.hpp"
+#include "reactphysics3d/reactphysics3d.h"
+
+namespace bullseye::spawner {
+    entity::Entity spawn_random_box(const std::string& name, rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager) {
+        const float X = RANDOM_BOX_SPAWN_RANGE;
+        const float Y = 360.f;
+        float x = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
+        float y = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
+        float z = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / X));
+
+        float q1 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
+        float q2 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
+        float q3 = static_cast <float> (rand()) / (static_cast <float> (RAND_MAX / Y));
+
+        rp3d::Quaternion q = rp3d::Quaternion(q1, q2, q3, 1.0f);
+        q.normalize();
+        entity::Entity box(name, glm::vec3(x, y, z), q, entity::BodyType::RIGID);
+        box.set_mesh("box");
+        box.init_physics(world, shape_cache, mesh_manager.get_mesh("box"));
+
+        return box;
+    }
+
+    entity::Entity spawn_bullet(const std::string& name, const glm::vec3& position, const glm::vec3& direction, 
+        rp3d::PhysicsWorld* world, shape_cache::ShapeCache* shape_cache, mesh::MeshManager& mesh_manager) {
+        entity::Entity bullet(name, 
+            position, 
+            rp3d::Quaternion::fromEulerAngles(rp3d::Vector3(direction.x, direction.y, direction.z)),
+            entity::BodyType::RIGID);
+        bullet.set_mesh("bullet");
+        bullet.init_physics(world, shape_cache, mesh_manager.get_mesh("bullet"), BULLET_MASS);
+        bullet.set_force(direction * BULLET_FORCE);
+
+        return bullet;
+    }
+}
@@ -1,6 +1,7 @@
 #include "texture_manager.h"
 
 #include <string>
+#include <memory>
 
 #include "clogger.h"
 #include "stb/stb_image.h"
@@ -38,12 +39,62 @@ namespace bullseye::texture {
         this->textures.insert({ name, texture });
     }
 
-    void TextureManager::use_texture(const std::string& name, const uint32_t shader_id) {
-        Texture* texture = this->textures.at(name);
+    asset::AssetHandle TextureManager::load_texture_async(const std::string name, const std::string& path, asset::AssetLoader& loader) {
+        Texture* texture = new Texture;
+
+        // Grey placeholder, image data replaces it in the same texture object so id never changes
+        const unsigned char placeholder[3] = { 128, 128, 128 };
 
-        glActiveTexture(GL_TEXTURE0);
-        glUniform1i(glGetUniformLocation(shader_id, "texture_diffuse1"), 0);
+        glGenTextures(1, &texture->id);
         glBindTexture(GL_TEXTURE_2D, texture->id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, placeholder);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        this->textures.insert({ name, texture });
+
+        // Freed here if upload never happens (e.g. app closed while loading)
+        struct ImageData {
+            unsigned char* data = nullptr;
+            int x = 0, y = 0, n = 0;
+
+            ~ImageData() {
+                if (data != nullptr) {
+                    stbi_image_free(data);
+                }
+            }
+        };
+        std::shared_ptr<ImageData> image = std::make_shared<ImageData>();
+
+        return loader.enqueue(
+            [image, path]() {
+                image->data = stbi_load(path.c_str(), &image->x, &image->y, &image->n, 0);
+
+                return image->data != nullptr;
+            },
+            [image, texture, path](bool loaded) {
+                if (!loaded) {
+                    CLOG_ERROR("Failed to load texture [path=%s]", path.c_str());
+                    return;
+                }
+
+                glBindTexture(GL_TEXTURE_2D, texture->id);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, image->x, image->y, 0, GL_RGB, GL_UNSIGNED_BYTE, image->data);
+                glGenerateMipmap(GL_TEXTURE_2D);
+
+                stbi_image_free(image->data);
+                image->data = nullptr;
+
+                CLOG_DEBUG("Loaded texture [path=%s, w=%d, h=%d]", path.c_str(), image->x, image->y);
+            });
+    }
+
+    uint32_t TextureManager::get_texture_id(const std::string& name) {
+        return this->textures.at(name)->id;
     }
 
     void TextureManager::unload_texture(std::string& name) {
@@ -0,0 +1,230 @@
+#include "tracer.h"
+#include "clogger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "reactphysics3d/utils/TraceHooks.h"
+
+namespace bullseye::trace {
+    namespace {
+        struct ThreadBuffer {
+            TraceEvent events[TRACE_RING_BUFFER_SIZE];
+            // Total number of events written, slot is count % TRACE_RING_BUFFER_SIZE
+            std::atomic<uint64_t> count;
+            uint32_t thread_id;
+            std::string thread_name;
+        };
+
+        std::mutex buffers_mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::atomic<bool> recording(false);
+        bool rp3d_hooks_installed = false;
+
+        // Capture state, only touched from main thread
+        uint64_t frame = 0;
+        uint64_t capture_first_frame = 0;
+        uint64_t capture_last_frame = 0;
+        uint64_t capture_begin_ns = 0;
+        std::string capture_path;
+        bool capture_requested = false;
+
+        thread_local ThreadBuffer* thread_buffer = nullptr;
+        thread_local const char* thread_name = nullptr;
+
+        // Unscoped zones (rp3d hooks, begin_zone) have no object to keep begin time in
+        thread_local const char* zone_names[TRACE_MAX_DEPTH];
+        thread_local uint64_t zone_begin_ns[TRACE_MAX_DEPTH];
+        thread_local uint32_t zone_depth = 0;
+
+        uint64_t now_ns() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        ThreadBuffer* get_thread_buffer() {
+            if (thread_buffer == nullptr) {
+                std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+                buffer->count = 0;
+
+                std::lock_guard<std::mutex> lock(buffers_mutex);
+                buffer->thread_id = static_cast<uint32_t>(buffers.size());
+                buffer->thread_name = thread_name != nullptr ? thread_name : "Thread " + std::to_string(buffer->thread_id);
+                thread_buffer = buffer.get();
+                buffers.push_back(std::move(buffer));
+            }
+
+            return thread_buffer;
+        }
+
+        void record(const char* name, uint64_t begin_ns, uint64_t end_ns) {
+            ThreadBuffer* buffer = get_thread_buffer();
+
+            // Single writer per buffer, readers only trust slots that were not overwritten while reading
+            const uint64_t index = buffer->count.load(std::memory_order_relaxed);
+            buffer->events[index % TRACE_RING_BUFFER_SIZE] = TraceEvent { name, begin_ns, end_ns };
+            buffer->count.store(index + 1, std::memory_order_release);
+        }
+
+
+        void write_json_string(FILE* file, const char* value) {
+            fputc('"', file);
+            for (const char* c = value; *c != '\0'; c++) {
+                if (*c == '"' || *c == '\\') {
+                    fputc('\\', file);
+                }
+                fputc(*c, file);
+            }
+            fputc('"', file);
+        }
+    }
+
+    Zone::Zone(const char* name) {
+        this->name = name;
+        this->begin_ns = recording.load(std::memory_order_relaxed) ? now_ns() : 0;
+    }
+
+    Zone::~Zone() {
+        if (this->begin_ns != 0 && recording.load(std::memory_order_relaxed)) {
+            record(this->name, this->begin_ns, now_ns());
+        }
+    }
+
+    void begin_zone(const char* name) {
+        if (zone_depth < TRACE_MAX_DEPTH) {
+            zone_names[zone_depth] = name;
+            zone_begin_ns[zone_depth] = recording.load(std::memory_order_relaxed) ? now_ns() : 0;
+        }
+        zone_depth++;
+    }
+
+    void end_zone() {
+        if (zone_depth == 0) {
+            return;
+        }
+
+        zone_depth--;
+        if (zone_depth < TRACE_MAX_DEPTH && zone_begin_ns[zone_depth] != 0 && recording.load(std::memory_order_relaxed)) {
+            record(zone_names[zone_depth], zone_begin_ns[zone_depth], now_ns());
+        }
+    }
+
+    void install_rp3d_hooks() {
+        if (!rp3d_hooks_installed) {
+            reactphysics3d::setTraceHooks(&begin_zone, &end_zone);
+            rp3d_hooks_installed = true;
+        }
+    }
+
+    void set_thread_name(const char* name) {
+        thread_name = name;
+    }
+
+    void capture_frames(uint64_t first_frame, uint32_t frame_count, const std::string& path) {
+        if (frame_count == 0) {
+            return;
+        }
+
+        capture_first_frame = first_frame < frame + 1 ? frame + 1 : first_frame;
+        capture_last_frame = capture_first_frame + frame_count - 1;
+        capture_path = path;
+        capture_requested = true;
+
+        CLOG_INFO("Trace capture scheduled [frames=%llu-%llu, path=%s]", static_cast<unsigned long long>(capture_first_frame),
+            static_cast<unsigned long long>(capture_last_frame), path.c_str());
+    }
+
+    void next_frame() {
+        frame++;
+
+        if (!capture_requested) {
+            return;
+        }
+
+        if (frame == capture_first_frame) {
+            capture_begin_ns = now_ns();
+            recording = true;
+        } else if (frame == capture_last_frame + 1) {
+            recording = false;
+            capture_requested = false;
+
+            write_chrome_trace(capture_path, capture_begin_ns, now_ns());
+        }
+    }
+
+    uint64_t get_frame() {
+        return frame;
+    }
+
+    bool is_capturing() {
+        return capture_requested;
+    }
+
+    bool write_chrome_trace(const std::string& path, uint64_t begin_ns, uint64_t end_ns) {
+        FILE* file = fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            CLOG_ERROR("Cannot write trace [path=%s]", path.c_str());
+            return false;
+        }
+
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+        uint64_t written = 0;
+        bool overflowed = false;
+        std::vector<TraceEvent> events;
+        events.reserve(TRACE_RING_BUFFER_SIZE);
+
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for (auto& buffer : buffers) {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", written > 0 ? ",\n" : "", buffer->thread_id);
+            write_json_string(file, buffer->thread_name.c_str());
+            fprintf(file, "}}");
+            written++;
+
+            const uint64_t count = buffer->count.load(std::memory_order_acquire);
+            const uint64_t first = count > TRACE_RING_BUFFER_SIZE ? count - TRACE_RING_BUFFER_SIZE : 0;
+
+            events.clear();
+            for (uint64_t i = first; i < count; i++) {
+                events.push_back(buffer->events[i % TRACE_RING_BUFFER_SIZE]);
+            }
+
+            // Slots the owning thread may have overwritten while they were copied are skipped
+            const uint64_t count_after = buffer->count.load(std::memory_order_acquire);
+            const uint64_t first_valid = count_after > TRACE_RING_BUFFER_SIZE ? count_after - TRACE_RING_BUFFER_SIZE : 0;
+
+            // Oldest kept zone started after capture began, so earlier zones of capture were overwritten
+            if (first_valid > 0 && first_valid < count && events[first_valid - first].begin_ns > begin_ns) {
+                overflowed = true;
+            }
+
+            for (uint64_t i = first; i < count; i++) {
+                const TraceEvent& event = events[i - first];
+                if (i < first_valid || event.begin_ns < begin_ns || event.end_ns > end_ns) {
+                    continue;
+                }
+
+                fprintf(file, ",\n{\"name\":");
+                write_json_string(file, event.name);
+                fprintf(file, ",\"cat\":\"bullseye\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->thread_id,
+                    (event.begin_ns - begin_ns) / 1000.0, (event.end_ns - event.begin_ns) / 1000.0);
+                written++;
+            }
+        }
+
+        fprintf(file, "\n]}\n");
+        fclose(file);
+
+        if (overflowed) {
+            CLOG_WARN("Trace ring buffer overflowed, oldest zones of capture were dropped [size=%u]", TRACE_RING_BUFFER_SIZE);
+        }
+        CLOG_INFO("Trace written [path=%s, events=%llu]", path.c_str(), static_cast<unsigned long long>(written));
+
+        return true;
+    }
+}
\ No newline at end of file